@@ -58,6 +58,11 @@
 #include "../models/yang@2025-01-29.h"
 #define IETF_YANG_LIB_REV "2019-01-04"
 
+/**
+ * @brief Counter of created contexts used for generating ::ly_ctx.err_id.
+ */
+static uint32_t ly_ctx_err_id;
+
 static struct internal_modules_s {
     const char *name;
     const char *revision;
@@ -264,7 +269,7 @@ cleanup:
 static ly_bool
 ly_ctx_ht_err_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
 {
-    struct ly_ctx_err_rec *err1 = val1_p, *err2 = val2_p;
+    struct ly_ctx_err_rec *err1 = *(struct ly_ctx_err_rec **)val1_p, *err2 = *(struct ly_ctx_err_rec **)val2_p;
 
     return !memcmp(&err1->tid, &err2->tid, sizeof err1->tid);
 }
@@ -315,6 +320,12 @@ ly_ctx_new(const char *search_dir, uint16_t options, struct ly_ctx **new_ctx)
     /* dictionary */
     lydict_init(&ctx->dict);
 
+    /* locks, destroyed on any error */
+    pthread_mutex_init(&ctx->err_lock, NULL);
+    pthread_mutex_init(&ctx->lyb_hash_lock, NULL);
+    pthread_mutex_init(&ctx->val_prof_lock, NULL);
+    pthread_mutex_init(&ctx->uniq_idx_lock, NULL);
+
     /* plugins */
     builtin_plugins_only = (options & LY_CTX_BUILTIN_PLUGINS_ONLY) ? 1 : 0;
     LY_CHECK_ERR_GOTO(lyplg_init(builtin_plugins_only), LOGINT(NULL); rc = LY_EINT, cleanup);
@@ -329,12 +340,11 @@ ly_ctx_new(const char *search_dir, uint16_t options, struct ly_ctx **new_ctx)
         LY_CHECK_ERR_GOTO(!ctx->leafref_links_ht, rc = LY_EMEM, cleanup);
     }
 
-    /* initialize thread-specific error hash table */
-    ctx->err_ht = lyht_new(1, sizeof(struct ly_ctx_err_rec), ly_ctx_ht_err_equal_cb, NULL, 1);
+    /* initialize thread-specific error hash table, records are stored as pointers so that they can be cached by
+     * their threads */
+    ctx->err_ht = lyht_new(1, sizeof(struct ly_ctx_err_rec *), ly_ctx_ht_err_equal_cb, NULL, 1);
     LY_CHECK_ERR_GOTO(!ctx->err_ht, rc = LY_EMEM, cleanup);
-
-    /* init LYB hash lock */
-    pthread_mutex_init(&ctx->lyb_hash_lock, NULL);
+    ctx->err_id = LY_ATOMIC_INC_BARRIER(ly_ctx_err_id) + 1;
 
     /* modules list */
     ctx->flags = options;
@@ -712,6 +722,10 @@ ly_ctx_unset_options(struct ly_ctx *ctx, uint16_t option)
         ctx->leafref_links_ht = NULL;
     }
 
+    if ((ctx->flags & LY_CTX_VAL_PROFILE) && (option & LY_CTX_VAL_PROFILE)) {
+        lyd_validate_profile_clear(ctx);
+    }
+
     if ((ctx->flags & LY_CTX_SET_PRIV_PARSED) && (option & LY_CTX_SET_PRIV_PARSED)) {
         struct lys_module *mod;
         uint32_t index;
@@ -1364,14 +1378,15 @@ error:
 /**
  * @brief Callback for freeing context error hash table values.
  *
- * @param[in] val_p Pointer to a pointer to an error item to free with all the siblings.
+ * @param[in] val_p Pointer to a pointer to an error record to free with all its error items.
  */
 static void
 ly_ctx_ht_err_rec_free(void *val_p)
 {
-    struct ly_ctx_err_rec *err = val_p;
+    struct ly_ctx_err_rec *err = *(struct ly_ctx_err_rec **)val_p;
 
     ly_err_free(err->err);
+    free(err);
 }
 
 LIBYANG_API_DEF void
@@ -1413,6 +1428,7 @@ ly_ctx_destroy(struct ly_ctx *ctx)
 
     /* clean the error hash table */
     lyht_free(ctx->err_ht, ly_ctx_ht_err_rec_free);
+    pthread_mutex_destroy(&ctx->err_lock);
 
     /* dictionary */
     lydict_clean(&ctx->dict);
@@ -1420,6 +1436,15 @@ ly_ctx_destroy(struct ly_ctx *ctx)
     /* LYB hash lock */
     pthread_mutex_destroy(&ctx->lyb_hash_lock);
 
+    /* validation profiler */
+    lyht_free(ctx->val_prof_ht, NULL);
+    pthread_mutex_destroy(&ctx->val_prof_lock);
+
+    /* unique indexes, any left belong to data trees that were not freed */
+    lyht_free(ctx->uniq_idx_ht, NULL);
+    lyht_free(ctx->uniq_top_ht, NULL);
+    pthread_mutex_destroy(&ctx->uniq_idx_lock);
+
     /* context specific plugins */
     ly_set_erase(&ctx->plugins_types, NULL);
     ly_set_erase(&ctx->plugins_extensions, NULL);
@@ -207,6 +207,27 @@ struct ly_ctx;
                                         loaded except for built-in YANG types so all derived types will use these and
                                         for all purposes behave as the base type. The option can be used for cases when
                                         invalid data needs to be stored in YANG node values. */
+#define LY_CTX_LAZY_CANONICAL 0x1000 /**< Do not generate canonical string values of data nodes when storing them but
+                                        only when they are first needed, for example by ::lyd_get_value() or a printer.
+                                        Supported by built-in numeric, binary, inet address and date-and-time type plugins.
+                                        Saves the dictionary traffic and memory for values that are never used as strings,
+                                        which is typical for data only compared, hashed, or printed in LYB format.
+                                        The generated value is published atomically so it can also be read from
+                                        a tree shared by several reading threads. */
+#define LY_CTX_VAL_PROFILE 0x2000 /**< Measure the evaluation of every when, must, and unique constraint and type plugin
+                                        callback during data parsing and validation. The collected statistics can be
+                                        printed by ::lyd_validate_profile_print(). Note that the measurement has
+                                        a noticeable overhead. */
+#define LY_CTX_VIRTUAL_DEFAULTS 0x4000 /**< Do not create default leaves and leaf-lists of nested data nodes when parsing
+                                        and validating data, resolve them from their schema nodes only when needed
+                                        instead. Such virtual default nodes are printed by the data printers the same
+                                        way as created default nodes in all the with-defaults modes and XPath
+                                        expressions, including when and must constraints, are evaluated as if they
+                                        existed, without modifying the tree. They are created in the tree only by
+                                        ::lyd_find_child_dflt(). Top-level defaults, the defaults requiring an
+                                        instance (leafref, instance-identifier) so that they are validated, and
+                                        the defaults created by the lyd_new_implicit_*() functions are always
+                                        created. */
 
 /** @} contextoptions */
 
@@ -60,8 +60,9 @@ lydict_init(struct ly_dict *dict)
 {
     LY_CHECK_ARG_RET(NULL, dict, );
 
-    dict->hash_tab = lyht_new(LYDICT_MIN_SIZE, sizeof(struct ly_dict_rec), lydict_val_eq, NULL, 1);
+    dict->hash_tab = lyht_new_open(LYDICT_MIN_SIZE, sizeof(struct ly_dict_rec), lydict_val_eq, NULL, 1);
     LY_CHECK_ERR_RET(!dict->hash_tab, LOGINT(NULL), );
+    lyht_set_resize_step(dict->hash_tab, LYHT_RESIZE_STEP);
     pthread_mutex_init(&dict->lock, NULL);
 }
 
@@ -75,6 +76,7 @@ lydict_clean(struct ly_dict *dict)
 
     LY_CHECK_ARG_RET(NULL, dict, );
 
+    lyht_resize_finish(dict->hash_tab);
     LYHT_ITER_ALL_RECS(dict->hash_tab, hlist_idx, rec_idx, rec) {
         /*
          * this should not happen, all records inserted into
@@ -265,6 +267,37 @@ lydict_insert_zc(const struct ly_ctx *ctx, char *value, const char **str_p)
     return result;
 }
 
+LY_ERR
+lydict_insert_zc_once(const struct ly_ctx *ctx, char *value, const char **str_p)
+{
+    LY_ERR result;
+    const char *str;
+
+    LY_CHECK_ARG_RET(ctx, ctx, str_p, LY_EINVAL);
+
+    if (!value) {
+        return LY_SUCCESS;
+    }
+
+    if (LY_ATOMIC_LOAD_ACQUIRE_PTR(*str_p)) {
+        /* already stored by someone else */
+        free(value);
+        return LY_SUCCESS;
+    }
+
+    pthread_mutex_lock((pthread_mutex_t *)&ctx->dict.lock);
+    result = dict_insert(ctx, value, strlen(value), 1, &str);
+    pthread_mutex_unlock((pthread_mutex_t *)&ctx->dict.lock);
+    LY_CHECK_RET(result);
+
+    /* publish the string for concurrent readers, which may have stored it meanwhile */
+    if (!LY_ATOMIC_CAS_PTR(*str_p, NULL, str)) {
+        lydict_remove(ctx, str);
+    }
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 dict_dup(const struct ly_ctx *ctx, char *value, const char **str_p)
 {
@@ -16,11 +16,15 @@
 #include "diff.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef _WIN32
+# include <unistd.h>
+#endif
 
 #include "compat.h"
 #include "context.h"
@@ -498,6 +502,14 @@ lyd_diff_add(const struct lyd_node *node, enum lyd_diff_op op, const char *orig_
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Record of the user-ordered instances hash table.
+ */
+struct lyd_diff_userord_rec {
+    const struct lyd_node *node;    /**< instance, must be the first member to use lyd_hash_table_val_equal() */
+    uint32_t idx;                   /**< index of the instance in ::lyd_diff_userord.vinst */
+};
+
 /**
  * @brief Get a userord entry for a specific user-ordered list/leaf-list. Create if does not exist yet.
  *
@@ -510,6 +522,8 @@ static struct lyd_diff_userord *
 lyd_diff_userord_get(const struct lyd_node *first, const struct lysc_node *schema, struct lyd_diff_userord **userord)
 {
     struct lyd_diff_userord *item;
+    struct lyd_diff_userord_inst *vinst;
+    struct lyd_diff_userord_rec rec;
     struct lyd_node *iter;
     const struct lyd_node **node;
     LY_ARRAY_COUNT_TYPE u;
@@ -526,18 +540,211 @@ lyd_diff_userord_get(const struct lyd_node *first, const struct lysc_node *schem
     item->schema = schema;
     item->pos = 0;
     item->inst = NULL;
+    item->vinst = NULL;
+    item->vinst_ht = NULL;
+    item->head = LYD_DIFF_USERORD_NONE;
+    item->last = LYD_DIFF_USERORD_NONE;
+    item->stable_done = 0;
 
-    /* store all the instance pointers in the current order */
-    if (first) {
+    if (!first) {
+        return item;
+    }
+
+    if (lysc_is_dup_inst_list(schema)) {
+        /* store all the instance pointers in the current order */
         LYD_LIST_FOR_INST(lyd_first_sibling(first), first->schema, iter) {
             LY_ARRAY_NEW_RET(schema->module->ctx, item->inst, node, NULL);
             *node = iter;
         }
+        return item;
+    }
+
+    /* link all the instances in the current order and store them in a hash table */
+    item->vinst_ht = lyht_new(LYHT_MIN_SIZE, sizeof rec, lyd_hash_table_val_equal, NULL, 1);
+    LY_CHECK_ERR_RET(!item->vinst_ht, LOGMEM(schema->module->ctx), NULL);
+    LYD_LIST_FOR_INST(lyd_first_sibling(first), first->schema, iter) {
+        LY_ARRAY_NEW_RET(schema->module->ctx, item->vinst, vinst, NULL);
+        rec.node = iter;
+        rec.idx = LY_ARRAY_COUNT(item->vinst) - 1;
+
+        vinst->node = iter;
+        vinst->prev = rec.idx ? rec.idx - 1 : LYD_DIFF_USERORD_NONE;
+        vinst->next = LYD_DIFF_USERORD_NONE;
+        vinst->stable = 0;
+        if (rec.idx) {
+            item->vinst[rec.idx - 1].next = rec.idx;
+        } else {
+            item->head = rec.idx;
+        }
+
+        if (lyht_insert(item->vinst_ht, &rec, iter->hash, NULL)) {
+            /* invalid data with duplicate instances */
+            LOGINT(schema->module->ctx);
+            return NULL;
+        }
     }
 
     return item;
 }
 
+/**
+ * @brief Free a userord entry.
+ *
+ * @param[in] item Userord item to free.
+ */
+static void
+lyd_diff_userord_erase(struct lyd_diff_userord *item)
+{
+    LY_ARRAY_FREE(item->inst);
+    LY_ARRAY_FREE(item->vinst);
+    lyht_free(item->vinst_ht, NULL);
+}
+
+/**
+ * @brief Find an instance matching a node in the linked instances of a userord entry.
+ *
+ * @param[in] item Userord item.
+ * @param[in] node Node to find, from any tree.
+ * @return Index of the matching first tree instance, ::LYD_DIFF_USERORD_NONE if there is none.
+ */
+static uint32_t
+lyd_diff_userord_find(const struct lyd_diff_userord *item, const struct lyd_node *node)
+{
+    struct lyd_diff_userord_rec rec = {.node = node}, *match;
+
+    if (!item->vinst_ht || lyht_find(item->vinst_ht, &rec, node->hash, (void **)&match)) {
+        return LYD_DIFF_USERORD_NONE;
+    }
+    return match->idx;
+}
+
+/**
+ * @brief Unlink an instance from the linked instances of a userord entry.
+ *
+ * @param[in] item Userord item.
+ * @param[in] idx Index of the instance to unlink.
+ */
+static void
+lyd_diff_userord_unlink(struct lyd_diff_userord *item, uint32_t idx)
+{
+    struct lyd_diff_userord_inst *vinst = &item->vinst[idx];
+
+    if (vinst->prev != LYD_DIFF_USERORD_NONE) {
+        item->vinst[vinst->prev].next = vinst->next;
+    } else {
+        item->head = vinst->next;
+    }
+    if (vinst->next != LYD_DIFF_USERORD_NONE) {
+        item->vinst[vinst->next].prev = vinst->prev;
+    }
+    vinst->prev = LYD_DIFF_USERORD_NONE;
+    vinst->next = LYD_DIFF_USERORD_NONE;
+}
+
+/**
+ * @brief Link an unlinked instance into the linked instances of a userord entry.
+ *
+ * @param[in] item Userord item.
+ * @param[in] idx Index of the instance to link.
+ * @param[in] anchor Index of the instance to link after, ::LYD_DIFF_USERORD_NONE to link as the first instance.
+ */
+static void
+lyd_diff_userord_link(struct lyd_diff_userord *item, uint32_t idx, uint32_t anchor)
+{
+    struct lyd_diff_userord_inst *vinst = &item->vinst[idx];
+
+    vinst->prev = anchor;
+    if (anchor == LYD_DIFF_USERORD_NONE) {
+        vinst->next = item->head;
+        item->head = idx;
+    } else {
+        vinst->next = item->vinst[anchor].next;
+        item->vinst[anchor].next = idx;
+    }
+    if (vinst->next != LYD_DIFF_USERORD_NONE) {
+        item->vinst[vinst->next].prev = idx;
+    }
+}
+
+/**
+ * @brief Find the instances of a userord entry that are never moved.
+ *
+ * These are the longest increasing subsequence of the first tree instance positions in the second tree order so
+ * all the other instances are moved with the minimal number of moves.
+ *
+ * @param[in] item Userord item.
+ * @param[in] second Any instance from the second tree.
+ * @param[in] options Diff options.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_userord_stable(struct lyd_diff_userord *item, const struct lyd_node *second, uint16_t options)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_node *iter;
+    uint32_t *seq = NULL, *tails = NULL, *prevs = NULL, inst_count, count = 0, len = 0, lo, hi, mid, idx, i;
+
+    item->stable_done = 1;
+    inst_count = LY_ARRAY_COUNT(item->vinst);
+    if (!inst_count) {
+        return LY_SUCCESS;
+    }
+
+    seq = malloc(inst_count * sizeof *seq);
+    tails = malloc(inst_count * sizeof *tails);
+    prevs = malloc(inst_count * sizeof *prevs);
+    LY_CHECK_ERR_GOTO(!seq || !tails || !prevs, LOGMEM(item->schema->module->ctx); rc = LY_EMEM, cleanup);
+
+    /* first tree positions of the matching instances in the second tree order, the same as found by the diff */
+    LYD_LIST_FOR_INST(lyd_first_sibling(second), item->schema, iter) {
+        if ((iter->flags & LYD_DEFAULT) && !(options & LYD_DIFF_DEFAULTS)) {
+            continue;
+        }
+
+        idx = lyd_diff_userord_find(item, iter);
+        if ((idx == LYD_DIFF_USERORD_NONE) ||
+                ((item->vinst[idx].node->flags & LYD_DEFAULT) && !(options & LYD_DIFF_DEFAULTS))) {
+            continue;
+        }
+
+        seq[count++] = idx;
+        if (count == inst_count) {
+            break;
+        }
+    }
+
+    /* patience sorting, tails are the indices of the lowest last items of increasing subsequences of each length */
+    for (i = 0; i < count; ++i) {
+        lo = 0;
+        hi = len;
+        while (lo < hi) {
+            mid = (lo + hi) / 2;
+            if (seq[tails[mid]] < seq[i]) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        prevs[i] = lo ? tails[lo - 1] : LYD_DIFF_USERORD_NONE;
+        tails[lo] = i;
+        if (lo == len) {
+            ++len;
+        }
+    }
+
+    /* mark the instances of the longest one */
+    for (i = len ? tails[len - 1] : LYD_DIFF_USERORD_NONE; i != LYD_DIFF_USERORD_NONE; i = prevs[i]) {
+        item->vinst[seq[i]].stable = 1;
+    }
+
+cleanup:
+    free(seq);
+    free(tails);
+    free(prevs);
+    return rc;
+}
+
 /**
  * @brief Check whether there are any metadata differences on 2 nodes.
  *
@@ -650,8 +857,11 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
 {
     LY_ERR rc = LY_SUCCESS;
     const struct lysc_node *schema;
+    const struct lyd_node *anchor = NULL, *orig_anchor = NULL;
+    struct lyd_diff_userord_inst *vinst;
     size_t buflen, bufused;
-    uint32_t first_pos, second_pos, comp_opts;
+    uint32_t first_pos = 0, second_pos = 0, comp_opts, idx = LYD_DIFF_USERORD_NONE;
+    ly_bool dup_inst;
 
     assert(first || second);
 
@@ -665,21 +875,33 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
 
     schema = first ? first->schema : second->schema;
     assert(lysc_is_userordered(schema));
+    dup_inst = lysc_is_dup_inst_list(schema);
 
-    /* find user-ordered first position */
-    if (first) {
-        for (first_pos = 0; first_pos < LY_ARRAY_COUNT(userord_item->inst); ++first_pos) {
-            if (userord_item->inst[first_pos] == first) {
-                break;
+    if (dup_inst) {
+        /* find user-ordered first position */
+        if (first) {
+            for (first_pos = 0; first_pos < LY_ARRAY_COUNT(userord_item->inst); ++first_pos) {
+                if (userord_item->inst[first_pos] == first) {
+                    break;
+                }
             }
+            assert(first_pos < LY_ARRAY_COUNT(userord_item->inst));
         }
-        assert(first_pos < LY_ARRAY_COUNT(userord_item->inst));
+
+        /* prepare position of the next instance */
+        second_pos = userord_item->pos++;
     } else {
-        first_pos = 0;
-    }
+        if (second && !userord_item->stable_done) {
+            /* find the instances that are not moved */
+            LY_CHECK_RET(lyd_diff_userord_stable(userord_item, second, options));
+        }
 
-    /* prepare position of the next instance */
-    second_pos = userord_item->pos++;
+        /* find the linked first instance */
+        if (first) {
+            idx = lyd_diff_userord_find(userord_item, first);
+            assert(idx != LYD_DIFF_USERORD_NONE);
+        }
+    }
 
     /* learn operation first */
     if (!second) {
@@ -687,10 +909,13 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     } else if (!first) {
         *op = LYD_DIFF_OP_CREATE;
     } else {
-        comp_opts = lysc_is_dup_inst_list(second->schema) ? LYD_COMPARE_FULL_RECURSION : 0;
-        if (lyd_compare_single(second, userord_item->inst[second_pos], comp_opts)) {
+        comp_opts = dup_inst ? LYD_COMPARE_FULL_RECURSION : 0;
+        if (dup_inst && lyd_compare_single(second, userord_item->inst[second_pos], comp_opts)) {
             /* in first, there is a different instance on the second position, we are going to move 'first' node */
             *op = LYD_DIFF_OP_REPLACE;
+        } else if (!dup_inst && !userord_item->vinst[idx].stable && (userord_item->vinst[idx].prev != userord_item->last)) {
+            /* the instance is not right after the previous second instance, we are going to move 'first' node */
+            *op = LYD_DIFF_OP_REPLACE;
         } else if ((options & LYD_DIFF_DEFAULTS) && ((first->flags & LYD_DEFAULT) != (second->flags & LYD_DEFAULT))) {
             /* default flag change */
             *op = LYD_DIFF_OP_NONE;
@@ -699,10 +924,26 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
             *op = LYD_DIFF_OP_NONE;
         } else {
             /* no changes */
+            if (!dup_inst) {
+                userord_item->last = idx;
+            }
             return LY_ENOT;
         }
     }
 
+    /* learn the preceding instances after the change and before the change */
+    if (dup_inst) {
+        anchor = second_pos ? userord_item->inst[second_pos - 1] : NULL;
+        orig_anchor = first_pos ? userord_item->inst[first_pos - 1] : NULL;
+    } else {
+        if (userord_item->last != LYD_DIFF_USERORD_NONE) {
+            anchor = userord_item->vinst[userord_item->last].node;
+        }
+        if ((idx != LYD_DIFF_USERORD_NONE) && (userord_item->vinst[idx].prev != LYD_DIFF_USERORD_NONE)) {
+            orig_anchor = userord_item->vinst[userord_item->vinst[idx].prev].node;
+        }
+    }
+
     /*
      * set each attribute correctly based on the operation and node type
      */
@@ -717,35 +958,22 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     }
 
     /* value */
-    if ((schema->nodetype == LYS_LEAFLIST) && !lysc_is_dup_inst_list(schema) &&
-            ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
-        if (second_pos) {
-            *value = strdup(lyd_get_value(userord_item->inst[second_pos - 1]));
-            LY_CHECK_ERR_GOTO(!*value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
-        } else {
-            *value = strdup("");
-            LY_CHECK_ERR_GOTO(!*value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
-        }
+    if ((schema->nodetype == LYS_LEAFLIST) && !dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
+        *value = strdup(anchor ? lyd_get_value(anchor) : "");
+        LY_CHECK_ERR_GOTO(!*value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
     }
 
     /* orig-value */
-    if ((schema->nodetype == LYS_LEAFLIST) && !lysc_is_dup_inst_list(schema) &&
-            ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
-        if (first_pos) {
-            *orig_value = strdup(lyd_get_value(userord_item->inst[first_pos - 1]));
-            LY_CHECK_ERR_GOTO(!*orig_value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
-        } else {
-            *orig_value = strdup("");
-            LY_CHECK_ERR_GOTO(!*orig_value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
-        }
+    if ((schema->nodetype == LYS_LEAFLIST) && !dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
+        *orig_value = strdup(orig_anchor ? lyd_get_value(orig_anchor) : "");
+        LY_CHECK_ERR_GOTO(!*orig_value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
     }
 
     /* key */
-    if ((schema->nodetype == LYS_LIST) && !lysc_is_dup_inst_list(schema) &&
-            ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
-        if (second_pos) {
+    if ((schema->nodetype == LYS_LIST) && !dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
+        if (anchor) {
             buflen = bufused = 0;
-            LY_CHECK_GOTO(rc = lyd_path_list_predicate(userord_item->inst[second_pos - 1], key, &buflen, &bufused, 0), cleanup);
+            LY_CHECK_GOTO(rc = lyd_path_list_predicate(anchor, key, &buflen, &bufused, 0), cleanup);
         } else {
             *key = strdup("");
             LY_CHECK_ERR_GOTO(!*key, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
@@ -753,11 +981,10 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     }
 
     /* orig-key */
-    if ((schema->nodetype == LYS_LIST) && !lysc_is_dup_inst_list(schema) &&
-            ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
-        if (first_pos) {
+    if ((schema->nodetype == LYS_LIST) && !dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
+        if (orig_anchor) {
             buflen = bufused = 0;
-            LY_CHECK_GOTO(rc = lyd_path_list_predicate(userord_item->inst[first_pos - 1], orig_key, &buflen, &bufused, 0), cleanup);
+            LY_CHECK_GOTO(rc = lyd_path_list_predicate(orig_anchor, orig_key, &buflen, &bufused, 0), cleanup);
         } else {
             *orig_key = strdup("");
             LY_CHECK_ERR_GOTO(!*orig_key, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
@@ -765,7 +992,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     }
 
     /* position */
-    if (lysc_is_dup_inst_list(schema) && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
+    if (dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
         if (second_pos) {
             if (asprintf(position, "%" PRIu32, second_pos) == -1) {
                 LOGMEM(schema->module->ctx);
@@ -779,7 +1006,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     }
 
     /* orig-position */
-    if (lysc_is_dup_inst_list(schema) && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
+    if (dup_inst && ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
         if (first_pos) {
             if (asprintf(orig_position, "%" PRIu32, first_pos) == -1) {
                 LOGMEM(schema->module->ctx);
@@ -795,7 +1022,27 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     /*
      * update our instances - apply the change
      */
-    if (*op == LYD_DIFF_OP_CREATE) {
+    if (!dup_inst) {
+        if (*op == LYD_DIFF_OP_CREATE) {
+            /* link a new instance */
+            LY_ARRAY_NEW_GOTO(schema->module->ctx, userord_item->vinst, vinst, rc, cleanup);
+            vinst->node = second;
+            vinst->stable = 1;
+            idx = LY_ARRAY_COUNT(userord_item->vinst) - 1;
+            lyd_diff_userord_link(userord_item, idx, userord_item->last);
+            userord_item->last = idx;
+        } else if (*op == LYD_DIFF_OP_DELETE) {
+            /* unlink the instance */
+            lyd_diff_userord_unlink(userord_item, idx);
+        } else {
+            /* move the instance after the previous one, if needed */
+            if (*op == LYD_DIFF_OP_REPLACE) {
+                lyd_diff_userord_unlink(userord_item, idx);
+                lyd_diff_userord_link(userord_item, idx, userord_item->last);
+            }
+            userord_item->last = idx;
+        }
+    } else if (*op == LYD_DIFF_OP_CREATE) {
         /* insert the instance */
         LY_ARRAY_CREATE_GOTO(schema->module->ctx, userord_item->inst, 1, rc, cleanup);
         if (second_pos < LY_ARRAY_COUNT(userord_item->inst)) {
@@ -948,6 +1195,63 @@ lyd_diff_attrs(const struct lyd_node *first, const struct lyd_node *second, uint
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Find a matching node in siblings using a transient hash table of the siblings.
+ *
+ * The hash table is used only if the siblings have no parent with a children hash table, which means they are
+ * top-level or there are only few of them, and it is created on the first search.
+ *
+ * @param[in] siblings First sibling to search in.
+ * @param[in] target Target node to search for, cannot be a duplicate-instance list or leaf-list.
+ * @param[in,out] sibling_ht Transient hash table of @p siblings.
+ * @param[out] match Found match, NULL if no matching node found.
+ * @return LY_SUCCESS if the hash table was used;
+ * @return LY_ENOT if the hash table cannot be used;
+ * @return LY_ERR value on error.
+ */
+static LY_ERR
+lyd_diff_find_sibling_ht(const struct lyd_node *siblings, const struct lyd_node *target, struct ly_ht **sibling_ht,
+        struct lyd_node **match)
+{
+    const struct lyd_node *iter;
+    struct lyd_node **match_p;
+    uint32_t count = 0;
+
+    if (!*sibling_ht) {
+        if ((siblings->parent && siblings->parent->children_ht) || (LYD_CTX(siblings) != LYD_CTX(target))) {
+            /* standard search is efficient or required */
+            return LY_ENOT;
+        }
+
+        /* count the siblings */
+        LY_LIST_FOR(siblings, iter) {
+            if (++count == LYD_HT_MIN_ITEMS) {
+                break;
+            }
+        }
+        if (count < LYD_HT_MIN_ITEMS) {
+            return LY_ENOT;
+        }
+
+        /* create the hash table of all the siblings except duplicate instances */
+        *sibling_ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
+        LY_CHECK_ERR_RET(!*sibling_ht, LOGMEM(LYD_CTX(siblings)), LY_EMEM);
+        LY_LIST_FOR(siblings, iter) {
+            if (!iter->schema || lysc_is_dup_inst_list(iter->schema)) {
+                continue;
+            }
+            LY_CHECK_RET(lyht_insert_no_check(*sibling_ht, (void *)&iter, iter->hash, NULL));
+        }
+    }
+
+    if (lyht_find(*sibling_ht, (void *)&target, target->hash, (void **)&match_p)) {
+        *match = NULL;
+    } else {
+        *match = *match_p;
+    }
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Find a matching instance of a node in a data tree.
  *
@@ -955,16 +1259,27 @@ lyd_diff_attrs(const struct lyd_node *first, const struct lyd_node *second, uint
  * @param[in] target Target node to search for.
  * @param[in] defaults Whether to consider (or ignore) default values.
  * @param[in,out] dup_inst_ht Duplicate instance cache.
+ * @param[in,out] sibling_ht Optional transient hash table of @p siblings (first sibling), which must not be modified.
  * @param[out] match Found match, NULL if no matching node found.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_diff_find_match(const struct lyd_node *siblings, const struct lyd_node *target, ly_bool defaults,
-        struct ly_ht **dup_inst_ht, struct lyd_node **match)
+        struct ly_ht **dup_inst_ht, struct ly_ht **sibling_ht, struct lyd_node **match)
 {
-    LY_ERR r;
+    LY_ERR r = LY_ENOT;
+
+    if (sibling_ht && siblings && target->schema && !lysc_is_dup_inst_list(target->schema)) {
+        /* try to use the transient hash table */
+        r = lyd_diff_find_sibling_ht(siblings, target, sibling_ht, match);
+        if (r && (r != LY_ENOT)) {
+            return r;
+        }
+    }
 
-    if (!target->schema) {
+    if (!r) {
+        /* found using the hash table */
+    } else if (!target->schema) {
         /* try to find the same opaque node */
         r = lyd_find_sibling_opaq_next(siblings, LYD_NAME(target), match);
     } else if (target->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) {
@@ -1150,6 +1465,81 @@ lyd_diff_node_metadata_r(const struct lyd_node *first_subtree, const struct lyd_
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Connect a partial diff created by a worker thread into the diff.
+ *
+ * The partial diff was created as if all the task node parents were already in the diff so it is adjusted
+ * according to the parents actually in the diff. The result is the same as if all the changes from the partial
+ * diff were added into the diff using ::lyd_diff_add(). That holds only if the task node is not in the diff yet,
+ * which happens if its ancestor was added with all its descendants.
+ *
+ * @param[in] task Task with the partial diff of its node descendants, is spent on success.
+ * @param[in,out] diff Diff to append to.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOT if the task node is already in the diff and the partial diff cannot be used.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+lyd_diff_par_stitch(struct lyd_diff_task *task, struct lyd_node **diff)
+{
+    struct lyd_node *partial, *task_node, *node, *siblings, *match, *diff_parent = NULL;
+    const struct lyd_node *parent;
+
+    /* find the task node in the partial diff, it was created only if there are any changes */
+    partial = task->diff;
+    task_node = partial;
+    for (parent = lyd_parent(task->first); task_node && parent; parent = lyd_parent(parent)) {
+        task_node = lyd_child_no_keys(task_node);
+        assert(!task_node || !task_node->next);
+    }
+    if (!task_node) {
+        /* no changes */
+        return LY_SUCCESS;
+    }
+
+    /* find the first node of the partial diff parents chain missing in the diff */
+    node = partial;
+    siblings = *diff;
+    while (1) {
+        if (lysc_is_dup_inst_list(node->schema) || lyd_find_sibling_first(siblings, node, &match)) {
+            break;
+        }
+        if (node == task_node) {
+            /* the task node itself is in the diff */
+            return LY_ENOT;
+        }
+
+        diff_parent = match;
+        siblings = lyd_child_no_keys(match);
+        node = lyd_child_no_keys(node);
+    }
+    task->diff = NULL;
+
+    if (node != task_node) {
+        /* the task node parents are missing, the task node has no operation then and only the first parent has one
+         * if there are no parents at all */
+        lyd_diff_del_meta(task_node, "operation");
+        if (!diff_parent) {
+            LY_CHECK_RET(lyd_new_meta(NULL, node, NULL, "yang:operation", "none", LYD_NEW_VAL_STORE_ONLY, NULL));
+        }
+    }
+
+    /* connect it the same way as a duplicated parent would be */
+    if (diff_parent) {
+        lyd_unlink_ignore_lyds(NULL, node);
+        lyd_insert_node(diff_parent, NULL, node, LYD_INSERT_NODE_DEFAULT);
+    } else {
+        lyd_diff_insert_sibling(*diff, node, diff);
+    }
+
+    if (node != partial) {
+        /* free the rest of the partial diff */
+        lyd_free_tree(partial);
+    }
+
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Perform diff for all siblings at certain depth, recursively.
  *
@@ -1188,18 +1578,20 @@ lyd_diff_node_metadata_r(const struct lyd_node *first_subtree, const struct lyd_
  * @param[in] second Second tree first sibling.
  * @param[in] options Diff options.
  * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in] par Optional parallel diff with partial diffs created in advance.
  * @param[in,out] diff Diff to append to.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
-        struct lyd_node **diff)
+        struct lyd_diff_par *par, struct lyd_node **diff)
 {
     LY_ERR rc = LY_SUCCESS, r;
     const struct lyd_node *iter_first, *iter_second;
     struct lyd_node *match_second, *match_first, *diff_node;
     struct lyd_diff_userord *userord = NULL, *userord_item;
-    struct ly_ht *dup_inst_first = NULL, *dup_inst_second = NULL;
+    struct lyd_diff_task *task;
+    struct ly_ht *dup_inst_first = NULL, *dup_inst_second = NULL, *first_ht = NULL, *second_ht = NULL;
     LY_ARRAY_COUNT_TYPE u;
     enum lyd_diff_op op;
     const char *orig_default;
@@ -1221,7 +1613,7 @@ lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second,
 
         /* find a match in the second tree */
         LY_CHECK_GOTO(rc = lyd_diff_find_match(second, iter_first, options & LYD_DIFF_DEFAULTS, &dup_inst_second,
-                &match_second), cleanup);
+                nosiblings ? NULL : &second_ht, &match_second), cleanup);
 
         if (lysc_is_userordered(iter_first->schema)) {
             /* get (create) userord entry */
@@ -1272,9 +1664,22 @@ lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second,
                 LY_CHECK_GOTO(rc = lyd_diff_node_metadata_r(iter_first, match_second, 1, diff_node), cleanup);
             }
 
-            /* check descendants, if any, recursively */
-            LY_CHECK_GOTO(rc = lyd_diff_siblings_r(lyd_child_no_keys(iter_first), lyd_child_no_keys(match_second),
-                    options, 0, diff), cleanup);
+            /* get the descendants diff created in advance, if any */
+            task = NULL;
+            if (par && (par->next_use < LY_ARRAY_COUNT(par->tasks)) && (par->tasks[par->next_use].first == iter_first)) {
+                task = &par->tasks[par->next_use++];
+            }
+
+            r = LY_ENOT;
+            if (task && !task->rc && !diff_node) {
+                r = lyd_diff_par_stitch(task, diff);
+                LY_CHECK_ERR_GOTO(r && (r != LY_ENOT), rc = r, cleanup);
+            }
+            if (r) {
+                /* check descendants, if any, recursively */
+                LY_CHECK_GOTO(rc = lyd_diff_siblings_r(lyd_child_no_keys(iter_first), lyd_child_no_keys(match_second),
+                        options, 0, par, diff), cleanup);
+            }
         } else {
             if ((options & LYD_DIFF_META) && diff_node) {
                 /* create metadata diff for the node and all its descendants */
@@ -1308,7 +1713,7 @@ lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second,
 
         /* find a match in the first tree */
         LY_CHECK_GOTO(rc = lyd_diff_find_match(first, iter_second, options & LYD_DIFF_DEFAULTS, &dup_inst_first,
-                &match_first), cleanup);
+                nosiblings ? NULL : &first_ht, &match_first), cleanup);
 
         if (lysc_is_userordered(iter_second->schema)) {
             /* get userord entry */
@@ -1358,8 +1763,10 @@ lyd_diff_siblings_r(const struct lyd_node *first, const struct lyd_node *second,
 cleanup:
     lyd_dup_inst_free(dup_inst_first);
     lyd_dup_inst_free(dup_inst_second);
+    lyht_free(first_ht, NULL);
+    lyht_free(second_ht, NULL);
     LY_ARRAY_FOR(userord, u) {
-        LY_ARRAY_FREE(userord[u].inst);
+        lyd_diff_userord_erase(&userord[u]);
     }
     LY_ARRAY_FREE(userord);
     if (rc) {
@@ -1369,6 +1776,174 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Collect tasks for all the sibling subtrees with descendants to compare.
+ *
+ * @param[in] first First tree first sibling.
+ * @param[in] second Second tree first sibling.
+ * @param[in] options Diff options.
+ * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in,out] tasks Sized array of tasks to add to.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_par_collect(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
+        struct lyd_diff_task **tasks)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *iter_first;
+    struct lyd_node *match_second;
+    struct lyd_diff_task *task;
+    struct ly_ht *dup_inst_second = NULL, *second_ht = NULL;
+
+    /* the same node matching as in the first loop of lyd_diff_siblings_r() */
+    LY_LIST_FOR(first, iter_first) {
+        if (!iter_first->schema) {
+            continue;
+        }
+
+        if ((iter_first->flags & LYD_DEFAULT) && !(options & LYD_DIFF_DEFAULTS)) {
+            /* skip default nodes */
+            continue;
+        }
+
+        LY_CHECK_GOTO(rc = lyd_diff_find_match(second, iter_first, options & LYD_DIFF_DEFAULTS, &dup_inst_second,
+                nosiblings ? NULL : &second_ht, &match_second), cleanup);
+        if (match_second && (lyd_child_no_keys(iter_first) || lyd_child_no_keys(match_second))) {
+            LY_ARRAY_NEW_GOTO(LYD_CTX(iter_first), *tasks, task, rc, cleanup);
+            task->first = iter_first;
+            task->second = match_second;
+        }
+
+        if (nosiblings) {
+            break;
+        }
+    }
+
+cleanup:
+    lyd_dup_inst_free(dup_inst_second);
+    lyht_free(second_ht, NULL);
+    return rc;
+}
+
+/**
+ * @brief Worker thread of a parallel diff creating partial diffs of the tasks.
+ *
+ * @param[in] arg Parallel diff structure.
+ * @return NULL.
+ */
+static void *
+lyd_diff_par_worker(void *arg)
+{
+    struct lyd_diff_par *par = arg;
+    struct lyd_diff_task *task;
+    struct lyd_node *diff_parent;
+    uint32_t idx, temp_lo = 0, *prev_lo;
+
+    /* no errors are logged, the failed tasks are performed again in the final diff */
+    prev_lo = ly_temp_log_options(&temp_lo);
+
+    while ((idx = LY_ATOMIC_INC_BARRIER(par->next_run)) < LY_ARRAY_COUNT(par->tasks)) {
+        task = &par->tasks[idx];
+
+        if (lyd_parent(task->first)) {
+            /* create the diff as if all the parents were already in the diff */
+            task->rc = lyd_dup_single(lyd_parent(task->first), NULL, LYD_DUP_NO_META | LYD_DUP_WITH_PARENTS |
+                    LYD_DUP_WITH_FLAGS | LYD_DUP_NO_LYDS, &diff_parent);
+            if (task->rc) {
+                continue;
+            }
+            for (task->diff = diff_parent; task->diff->parent; task->diff = lyd_parent(task->diff)) {}
+        }
+
+        task->rc = lyd_diff_siblings_r(lyd_child_no_keys(task->first), lyd_child_no_keys(task->second), par->options, 0,
+                NULL, &task->diff);
+    }
+
+    ly_temp_log_options(prev_lo);
+    return NULL;
+}
+
+/**
+ * @brief Perform diff with the descendants of independent subtrees compared concurrently.
+ *
+ * The first sibling level with more than one subtree to compare is found and the subtrees are compared by worker
+ * threads. Then the standard diff is performed using the partial diffs instead of comparing the subtrees again.
+ *
+ * @param[in] first First tree first sibling.
+ * @param[in] second Second tree first sibling.
+ * @param[in] options Diff options.
+ * @param[in] nosiblings Whether to skip following siblings.
+ * @param[in,out] diff Diff to append to.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_diff_siblings_par(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
+        struct lyd_node **diff)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_diff_par par = {.options = options};
+    const struct lyd_node *par_first = first, *par_second = second;
+    ly_bool par_nosiblings = nosiblings;
+    pthread_t *threads = NULL;
+    uint32_t thread_count = 0, i;
+    long cpus;
+    LY_ARRAY_COUNT_TYPE u;
+
+    /* find the sibling level to parallelize */
+    while (1) {
+        LY_CHECK_GOTO(rc = lyd_diff_par_collect(par_first, par_second, options, par_nosiblings, &par.tasks), cleanup);
+        if (LY_ARRAY_COUNT(par.tasks) != 1) {
+            break;
+        }
+
+        /* single subtree, try its children */
+        par_first = lyd_child_no_keys(par.tasks[0].first);
+        par_second = lyd_child_no_keys(par.tasks[0].second);
+        par_nosiblings = 0;
+        LY_ARRAY_FREE(par.tasks);
+        par.tasks = NULL;
+    }
+
+    if (LY_ARRAY_COUNT(par.tasks) > 1) {
+        /* start the worker threads, the current thread is one of them */
+#ifndef _WIN32
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+        cpus = 1;
+#endif
+        if (cpus > (long)LY_ARRAY_COUNT(par.tasks)) {
+            cpus = LY_ARRAY_COUNT(par.tasks);
+        }
+        if (cpus > 1) {
+            threads = malloc((cpus - 1) * sizeof *threads);
+            LY_CHECK_ERR_GOTO(!threads, LOGMEM(LYD_CTX(first ? first : second)); rc = LY_EMEM, cleanup);
+            for (i = 0; i < (uint32_t)cpus - 1; ++i) {
+                if (pthread_create(&threads[i], NULL, lyd_diff_par_worker, &par)) {
+                    /* use only the threads created so far */
+                    break;
+                }
+                ++thread_count;
+            }
+        }
+        lyd_diff_par_worker(&par);
+        for (i = 0; i < thread_count; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    /* create the final diff */
+    rc = lyd_diff_siblings_r(first, second, options, nosiblings, &par, diff);
+
+cleanup:
+    LY_ARRAY_FOR(par.tasks, u) {
+        lyd_free_siblings(par.tasks[u].diff);
+    }
+    LY_ARRAY_FREE(par.tasks);
+    free(threads);
+    return rc;
+}
+
 static LY_ERR
 lyd_diff(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
         struct lyd_node **diff)
@@ -1392,7 +1967,10 @@ lyd_diff(const struct lyd_node *first, const struct lyd_node *second, uint16_t o
 
     *diff = NULL;
 
-    return lyd_diff_siblings_r(first, second, options, nosiblings, diff);
+    if ((options & LYD_DIFF_PARALLEL) && ctx && !(ctx->flags & LY_CTX_LEAFREF_LINKING)) {
+        return lyd_diff_siblings_par(first, second, options, nosiblings, diff);
+    }
+    return lyd_diff_siblings_r(first, second, options, nosiblings, NULL, diff);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1784,7 +2362,7 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
     if (lysc_is_userordered(diff_node->schema) && ((op == LYD_DIFF_OP_CREATE) || (op == LYD_DIFF_OP_REPLACE))) {
         if (op == LYD_DIFF_OP_REPLACE) {
             /* find the node (we must have some siblings because the node was only moved) */
-            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, &match));
+            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, NULL, &match));
             LY_CHECK_ERR_RET(!match, LOGERR_NOINST(ctx, diff_node), LY_EINVAL);
         } else {
             /* duplicate the node */
@@ -1820,7 +2398,7 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
         switch (op) {
         case LYD_DIFF_OP_NONE:
             /* find the node */
-            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, &match));
+            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, NULL, &match));
             LY_CHECK_ERR_RET(!match, LOGERR_NOINST(ctx, diff_node), LY_EINVAL);
 
             if (match->schema->nodetype & LYD_NODE_TERM) {
@@ -1854,7 +2432,7 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
             break;
         case LYD_DIFF_OP_DELETE:
             /* find the node */
-            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, &match));
+            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, NULL, &match));
             LY_CHECK_ERR_RET(!match, LOGERR_NOINST(ctx, diff_node), LY_EINVAL);
 
             /* remove it */
@@ -1875,7 +2453,7 @@ lyd_diff_apply_r(struct lyd_node **first_node, struct lyd_node *parent_node, con
             }
 
             /* find the node */
-            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, &match));
+            LY_CHECK_RET(lyd_diff_find_match(*first_node, diff_node, 1, dup_inst, NULL, &match));
             LY_CHECK_ERR_RET(!match, LOGERR_NOINST(ctx, diff_node), LY_EINVAL);
 
             /* update the value */
@@ -2705,7 +3283,7 @@ lyd_diff_merge_r(const struct lyd_node *src_diff, struct lyd_node *diff_parent,
     LY_CHECK_RET(lyd_diff_get_op(src_diff, &src_op, NULL));
 
     /* find an equal node in the current diff */
-    LY_CHECK_RET(lyd_diff_find_match(diff_parent ? lyd_child_no_keys(diff_parent) : *diff, src_diff, 1, dup_inst, &diff_node));
+    LY_CHECK_RET(lyd_diff_find_match(diff_parent ? lyd_child_no_keys(diff_parent) : *diff, src_diff, 1, dup_inst, NULL, &diff_node));
 
     if (diff_node) {
         /* get target (current) operation */
@@ -21,13 +21,57 @@
 
 struct lyd_node;
 
+/**
+ * @brief Internal structure for a (virtual) user-ordered instance linked in the current order.
+ */
+struct lyd_diff_userord_inst {
+    const struct lyd_node *node;    /**< Instance from the first tree or a created instance from the second tree. */
+    uint32_t prev;                  /**< Index of the previous instance, ::LYD_DIFF_USERORD_NONE for the first one. */
+    uint32_t next;                  /**< Index of the next instance, ::LYD_DIFF_USERORD_NONE for the last one. */
+    ly_bool stable;                 /**< Whether the instance keeps its relative position and is never moved. */
+};
+
+/** no user-ordered instance index */
+#define LYD_DIFF_USERORD_NONE UINT32_MAX
+
 /**
  * @brief Internal structure for storing current (virtual) user-ordered instances order.
+ *
+ * Duplicate-instance lists and leaf-lists use position-based changes and keep the order in an array. Other
+ * (leaf-)lists keep the instances linked in a list with a hash table for finding them so that every change
+ * takes constant time and the instances not moved are found once as the longest increasing subsequence of
+ * the first tree positions in the second tree order, which minimizes the number of moves.
  */
 struct lyd_diff_userord {
     const struct lysc_node *schema; /**< User-ordered list/leaf-list schema node. */
     uint64_t pos;                   /**< Current position in the second tree. */
-    const struct lyd_node **inst;   /**< Sized array of current instance order. */
+    const struct lyd_node **inst;   /**< Sized array of current instance order, only for duplicate-instance lists. */
+
+    struct lyd_diff_userord_inst *vinst;    /**< Sized array of instances linked in the current order. */
+    struct ly_ht *vinst_ht;         /**< Hash table of the first tree instances in ::lyd_diff_userord.vinst. */
+    uint32_t head;                  /**< Index of the first instance in the current order. */
+    uint32_t last;                  /**< Index of the last instance processed in the second tree order. */
+    ly_bool stable_done;            /**< Whether the stable instances were already found. */
+};
+
+/**
+ * @brief Internal structure for a diff of descendants of a single node created in advance by a worker thread.
+ */
+struct lyd_diff_task {
+    const struct lyd_node *first;   /**< Node from the first tree whose descendants are compared. */
+    const struct lyd_node *second;  /**< Matching node from the second tree. */
+    struct lyd_node *diff;          /**< Partial diff of the descendants, NULL if there are no changes. */
+    LY_ERR rc;                      /**< Result of creating the partial diff. */
+};
+
+/**
+ * @brief Internal structure for a parallel diff, see ::LYD_DIFF_PARALLEL.
+ */
+struct lyd_diff_par {
+    struct lyd_diff_task *tasks;    /**< Sized array of tasks in the order their nodes are visited by the diff. */
+    uint32_t next_run;              /**< Index of the next task to run by a worker, accessed atomically. */
+    uint32_t next_use;              /**< Index of the next task to use in the final diff. */
+    uint16_t options;               /**< Diff options. */
 };
 
 /**
@@ -79,6 +79,14 @@ lyht_init_hlists_and_records(struct ly_ht *ht)
 
     ht->recs = calloc(ht->size, ht->rec_size);
     LY_CHECK_ERR_RET(!ht->recs, LOGMEM(NULL), LY_EMEM);
+
+    if (ht->open_addr) {
+        /* all the records are empty, zeroed */
+        ht->hlists = NULL;
+        ht->first_free_rec = LYHT_NO_RECORD;
+        return LY_SUCCESS;
+    }
+
     for (i = 0; i < ht->size; i++) {
         rec = lyht_get_rec(ht->recs, ht->rec_size, i);
         if (i != ht->size) {
@@ -99,8 +107,20 @@ lyht_init_hlists_and_records(struct ly_ht *ht)
     return LY_SUCCESS;
 }
 
-LIBYANG_API_DEF struct ly_ht *
-lyht_new(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *cb_data, uint16_t resize)
+/**
+ * @brief Create new hash table.
+ *
+ * @param[in] size Starting size of the hash table (capacity of values), must be power of 2.
+ * @param[in] val_size Size in bytes of value (the stored hashed item).
+ * @param[in] val_equal Callback for checking value equivalence.
+ * @param[in] cb_data User data always passed to @p val_equal.
+ * @param[in] resize Whether to resize the table on too few/too many records taken.
+ * @param[in] open_addr Whether to use open addressing instead of chaining.
+ * @return Empty hash table, NULL on error.
+ */
+static struct ly_ht *
+lyht_new_(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *cb_data, uint16_t resize,
+        ly_bool open_addr)
 {
     struct ly_ht *ht;
 
@@ -121,6 +141,10 @@ lyht_new(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *
     ht->val_equal = val_equal;
     ht->cb_data = cb_data;
     ht->resize = resize;
+    ht->open_addr = open_addr;
+    ht->resize_step = 0;
+    ht->migrate_idx = 0;
+    ht->old = NULL;
 
     ht->rec_size = SIZEOF_LY_HT_REC + val_size;
     if (lyht_init_hlists_and_records(ht) != LY_SUCCESS) {
@@ -131,6 +155,18 @@ lyht_new(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *
     return ht;
 }
 
+LIBYANG_API_DEF struct ly_ht *
+lyht_new(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *cb_data, uint16_t resize)
+{
+    return lyht_new_(size, val_size, val_equal, cb_data, resize, 0);
+}
+
+LIBYANG_API_DEF struct ly_ht *
+lyht_new_open(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *cb_data, uint16_t resize)
+{
+    return lyht_new_(size, val_size, val_equal, cb_data, resize, 1);
+}
+
 LIBYANG_API_DEF lyht_value_equal_cb
 lyht_set_cb(struct ly_ht *ht, lyht_value_equal_cb new_val_equal)
 {
@@ -138,6 +174,9 @@ lyht_set_cb(struct ly_ht *ht, lyht_value_equal_cb new_val_equal)
 
     prev = ht->val_equal;
     ht->val_equal = new_val_equal;
+    if (ht->old) {
+        ht->old->val_equal = new_val_equal;
+    }
     return prev;
 }
 
@@ -148,9 +187,311 @@ lyht_set_cb_data(struct ly_ht *ht, void *new_cb_data)
 
     prev = ht->cb_data;
     ht->cb_data = new_cb_data;
+    if (ht->old) {
+        ht->old->cb_data = new_cb_data;
+    }
     return prev;
 }
 
+LIBYANG_API_DEF uint32_t
+lyht_set_resize_step(struct ly_ht *ht, uint32_t step)
+{
+    uint32_t prev;
+
+    prev = ht->resize_step;
+    ht->resize_step = step;
+    if (!step) {
+        /* no more incremental resizing */
+        lyht_resize_finish(ht);
+    }
+    return prev;
+}
+
+/**
+ * @brief Store a new record into a chained hash table, without any checks.
+ *
+ * @param[in] ht Hash table to insert into.
+ * @param[in] val_p Pointer to the value to insert.
+ * @param[in] hash Hash of the value.
+ * @return Stored record.
+ */
+static struct ly_ht_rec *
+lyht_chain_insert_rec(struct ly_ht *ht, void *val_p, uint32_t hash)
+{
+    uint32_t hlist_idx = hash & (ht->size - 1);
+    struct ly_ht_rec *rec, *prev_rec;
+    uint32_t rec_idx;
+
+    rec_idx = ht->first_free_rec;
+    assert(rec_idx < ht->size);
+    rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx);
+    ht->first_free_rec = rec->next;
+
+    if (ht->hlists[hlist_idx].first == LYHT_NO_RECORD) {
+        ht->hlists[hlist_idx].first = rec_idx;
+    } else {
+        prev_rec = lyht_get_rec(ht->recs, ht->rec_size, ht->hlists[hlist_idx].last);
+        prev_rec->next = rec_idx;
+    }
+    rec->next = LYHT_NO_RECORD;
+    ht->hlists[hlist_idx].last = rec_idx;
+
+    rec->hash = hash;
+    memcpy(&rec->val, val_p, ht->rec_size - SIZEOF_LY_HT_REC);
+    return rec;
+}
+
+/**
+ * @brief Remove a record from a chained hash table.
+ *
+ * @param[in] ht Hash table to remove from.
+ * @param[in] found_rec Record to remove.
+ */
+static void
+lyht_chain_remove_rec(struct ly_ht *ht, struct ly_ht_rec *found_rec)
+{
+    struct ly_ht_rec *prev_rec, *rec;
+    uint32_t hlist_idx = found_rec->hash & (ht->size - 1);
+    uint32_t prev_rec_idx;
+    uint32_t rec_idx;
+
+    prev_rec_idx = LYHT_NO_RECORD;
+    LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec) {
+        if (rec == found_rec) {
+            break;
+        }
+        prev_rec_idx = rec_idx;
+    }
+
+    if (prev_rec_idx == LYHT_NO_RECORD) {
+        ht->hlists[hlist_idx].first = rec->next;
+        if (rec->next == LYHT_NO_RECORD) {
+            ht->hlists[hlist_idx].last = LYHT_NO_RECORD;
+        }
+    } else {
+        prev_rec = lyht_get_rec(ht->recs, ht->rec_size, prev_rec_idx);
+        prev_rec->next = rec->next;
+        if (rec->next == LYHT_NO_RECORD) {
+            ht->hlists[hlist_idx].last = prev_rec_idx;
+        }
+    }
+
+    rec->next = ht->first_free_rec;
+    ht->first_free_rec = rec_idx;
+}
+
+/**
+ * @brief Store a new record into an open addressing hash table.
+ *
+ * @param[in] ht Hash table to insert into.
+ * @param[in] val_p Pointer to the value to insert.
+ * @param[in] hash Hash of the value.
+ * @param[in] check Whether to check if the value has already been inserted or not.
+ * @param[out] rec_p Stored record, the existing one if already inserted.
+ * @return LY_SUCCESS on success.
+ * @return LY_EEXIST if the value was already inserted.
+ */
+static LY_ERR
+lyht_open_insert_rec(struct ly_ht *ht, void *val_p, uint32_t hash, int check, struct ly_ht_rec **rec_p)
+{
+    struct ly_ht_rec *rec;
+    uint32_t idx, dist, i, prev;
+
+    assert(ht->used < ht->size);
+
+    /* find the position after all the records with the same or smaller index given by the hash, an equal value
+     * can only be one of these records */
+    for (idx = hash & (ht->size - 1), dist = 1, rec = lyht_get_rec(ht->recs, ht->rec_size, idx);
+            rec->next >= dist;
+            idx = (idx + 1) & (ht->size - 1), ++dist, rec = lyht_get_rec(ht->recs, ht->rec_size, idx)) {
+        if (check && (rec->hash == hash) && ht->val_equal(val_p, &rec->val, 1, ht->cb_data)) {
+            *rec_p = rec;
+            return LY_EEXIST;
+        }
+    }
+
+    if (rec->next) {
+        /* shift all the following records up to an empty one */
+        for (i = idx; lyht_get_rec(ht->recs, ht->rec_size, i)->next; i = (i + 1) & (ht->size - 1)) {}
+        while (i != idx) {
+            prev = (i - 1) & (ht->size - 1);
+            memcpy(lyht_get_rec(ht->recs, ht->rec_size, i), lyht_get_rec(ht->recs, ht->rec_size, prev), ht->rec_size);
+            ++lyht_get_rec(ht->recs, ht->rec_size, i)->next;
+            i = prev;
+        }
+    }
+
+    rec->hash = hash;
+    rec->next = dist;
+    memcpy(&rec->val, val_p, ht->rec_size - SIZEOF_LY_HT_REC);
+    *rec_p = rec;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Remove a record from an open addressing hash table.
+ *
+ * @param[in] ht Hash table to remove from.
+ * @param[in] rec Record to remove.
+ */
+static void
+lyht_open_remove_rec(struct ly_ht *ht, struct ly_ht_rec *rec)
+{
+    struct ly_ht_rec *next_rec;
+    uint32_t idx;
+
+    /* shift back all the following records not at their index given by the hash */
+    idx = ((unsigned char *)rec - ht->recs) / ht->rec_size;
+    for (idx = (idx + 1) & (ht->size - 1), next_rec = lyht_get_rec(ht->recs, ht->rec_size, idx);
+            next_rec->next > 1;
+            idx = (idx + 1) & (ht->size - 1), next_rec = lyht_get_rec(ht->recs, ht->rec_size, idx)) {
+        memcpy(rec, next_rec, ht->rec_size);
+        --rec->next;
+        rec = next_rec;
+    }
+
+    rec->next = 0;
+}
+
+/**
+ * @brief Store a new record into a hash table of any kind, without any checks.
+ *
+ * @param[in] ht Hash table to insert into.
+ * @param[in] val_p Pointer to the value to insert.
+ * @param[in] hash Hash of the value.
+ */
+static void
+lyht_insert_rec(struct ly_ht *ht, void *val_p, uint32_t hash)
+{
+    struct ly_ht_rec *rec;
+
+    if (ht->open_addr) {
+        lyht_open_insert_rec(ht, val_p, hash, 0, &rec);
+    } else {
+        lyht_chain_insert_rec(ht, val_p, hash);
+    }
+}
+
+/**
+ * @brief Store all the records of a hash table into another one, keeping the order of records with equal hashes.
+ *
+ * @param[in] ht Hash table to insert into.
+ * @param[in] src Hash table with the records.
+ */
+static void
+lyht_insert_all_recs(struct ly_ht *ht, const struct ly_ht *src)
+{
+    struct ly_ht_rec *rec;
+    uint32_t i, start, rec_idx;
+
+    if (src->open_addr) {
+        /* start after an empty record so that the records with equal hashes are added in the same order */
+        for (start = 0; lyht_get_rec(src->recs, src->rec_size, start)->next; ++start) {}
+        for (i = 1; i <= src->size; i++) {
+            rec = lyht_get_rec(src->recs, src->rec_size, (start + i) & (src->size - 1));
+            if (rec->next) {
+                lyht_insert_rec(ht, rec->val, rec->hash);
+            }
+        }
+    } else {
+        for (i = 0; i < src->size; i++) {
+            LYHT_ITER_HLIST_RECS(src, i, rec_idx, rec) {
+                lyht_insert_rec(ht, rec->val, rec->hash);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Move all the records of a single index of the previous table into a hash table being resized.
+ *
+ * @param[in] ht Hash table being resized.
+ * @param[in] idx Index given by the hash in the previous table.
+ */
+static void
+lyht_migrate_idx(struct ly_ht *ht, uint32_t idx)
+{
+    struct ly_ht *old = ht->old;
+    struct ly_ht_rec *rec;
+    uint32_t i, dist;
+
+    if (old->open_addr) {
+        while (1) {
+            /* find the first record with this index, all of them have a distance equal to their offset */
+            for (i = idx, dist = 1, rec = lyht_get_rec(old->recs, old->rec_size, i);
+                    rec->next > dist;
+                    i = (i + 1) & (old->size - 1), ++dist, rec = lyht_get_rec(old->recs, old->rec_size, i)) {}
+            if (rec->next != dist) {
+                break;
+            }
+
+            lyht_insert_rec(ht, rec->val, rec->hash);
+            lyht_open_remove_rec(old, rec);
+        }
+    } else {
+        while (old->hlists[idx].first != LYHT_NO_RECORD) {
+            rec = lyht_get_rec(old->recs, old->rec_size, old->hlists[idx].first);
+            lyht_insert_rec(ht, rec->val, rec->hash);
+            lyht_chain_remove_rec(old, rec);
+        }
+    }
+}
+
+/**
+ * @brief Free the previous table of a hash table being resized.
+ *
+ * @param[in] ht Hash table being resized.
+ */
+static void
+lyht_free_old(struct ly_ht *ht)
+{
+    free(ht->old->hlists);
+    free(ht->old->recs);
+    free(ht->old);
+    ht->old = NULL;
+}
+
+/**
+ * @brief Perform a step of an incremental resize before modifying a hash table.
+ *
+ * Moves all the records with the index given by @p hash so that all the records with equal hashes are in the new
+ * table and then moves the records of the next indexes.
+ *
+ * @param[in] ht Hash table being resized.
+ * @param[in] hash Hash of the value to be inserted or removed.
+ */
+static void
+lyht_migrate_step(struct ly_ht *ht, uint32_t hash)
+{
+    uint32_t i;
+
+    if ((hash & (ht->old->size - 1)) >= ht->migrate_idx) {
+        lyht_migrate_idx(ht, hash & (ht->old->size - 1));
+    }
+
+    for (i = 0; (i < ht->resize_step) && (ht->migrate_idx < ht->old->size); ++i) {
+        lyht_migrate_idx(ht, ht->migrate_idx++);
+    }
+
+    if (ht->migrate_idx == ht->old->size) {
+        /* all moved */
+        lyht_free_old(ht);
+    }
+}
+
+void
+lyht_resize_finish(struct ly_ht *ht)
+{
+    if (!ht->old) {
+        return;
+    }
+
+    while (ht->migrate_idx < ht->old->size) {
+        lyht_migrate_idx(ht, ht->migrate_idx++);
+    }
+    lyht_free_old(ht);
+}
+
 LIBYANG_API_DEF struct ly_ht *
 lyht_dup(const struct ly_ht *orig)
 {
@@ -158,13 +499,24 @@ lyht_dup(const struct ly_ht *orig)
 
     LY_CHECK_ARG_RET(NULL, orig, NULL);
 
-    ht = lyht_new(orig->size, orig->rec_size - SIZEOF_LY_HT_REC, orig->val_equal, orig->cb_data, orig->resize ? 1 : 0);
+    ht = lyht_new_(orig->size, orig->rec_size - SIZEOF_LY_HT_REC, orig->val_equal, orig->cb_data, orig->resize ? 1 : 0,
+            orig->open_addr);
     if (!ht) {
         return NULL;
     }
+    ht->resize_step = orig->resize_step;
 
-    memcpy(ht->hlists, orig->hlists, sizeof(ht->hlists[0]) * orig->size);
-    memcpy(ht->recs, orig->recs, (size_t)orig->size * orig->rec_size);
+    if (orig->old) {
+        /* add the records of both the tables, those with equal hashes are always in one of them */
+        lyht_insert_all_recs(ht, orig->old);
+        lyht_insert_all_recs(ht, orig);
+    } else {
+        if (!orig->open_addr) {
+            memcpy(ht->hlists, orig->hlists, sizeof(ht->hlists[0]) * orig->size);
+        }
+        memcpy(ht->recs, orig->recs, (size_t)orig->size * orig->rec_size);
+        ht->first_free_rec = orig->first_free_rec;
+    }
     ht->used = orig->used;
     return ht;
 }
@@ -184,6 +536,14 @@ lyht_free(struct ly_ht *ht, void (*val_free)(void *val_p))
         LYHT_ITER_ALL_RECS(ht, hlist_idx, rec_idx, rec) {
             val_free(&rec->val);
         }
+        if (ht->old) {
+            LYHT_ITER_ALL_RECS(ht->old, hlist_idx, rec_idx, rec) {
+                val_free(&rec->val);
+            }
+        }
+    }
+    if (ht->old) {
+        lyht_free_old(ht);
     }
     free(ht->hlists);
     free(ht->recs);
@@ -193,26 +553,21 @@ lyht_free(struct ly_ht *ht, void (*val_free)(void *val_p))
 /**
  * @brief Resize a hash table.
  *
+ * With a resize step set, only the new table is allocated and the records are moved by the following operations.
+ *
  * @param[in] ht Hash table to resize.
  * @param[in] operation Operation to perform. 1 to enlarge, -1 to shrink, 0 to only rehash all records.
- * @param[in] check Whether to check if the value has already been inserted or not.
  * @return LY_ERR value.
  */
 static LY_ERR
-lyht_resize(struct ly_ht *ht, int operation, int check)
+lyht_resize(struct ly_ht *ht, int operation)
 {
-    struct ly_ht_rec *rec;
-    struct ly_ht_hlist *old_hlists;
-    unsigned char *old_recs;
-    uint32_t old_first_free_rec;
-    uint32_t i, old_size;
-    uint32_t rec_idx;
+    struct ly_ht old;
 
-    old_hlists = ht->hlists;
-    old_recs = ht->recs;
-    old_size = ht->size;
-    old_first_free_rec = ht->first_free_rec;
+    /* finish any previous resize */
+    lyht_resize_finish(ht);
 
+    old = *ht;
     if (operation > 0) {
         /* double the size */
         ht->size <<= 1;
@@ -222,42 +577,30 @@ lyht_resize(struct ly_ht *ht, int operation, int check)
     }
 
     if (lyht_init_hlists_and_records(ht) != LY_SUCCESS) {
-        ht->hlists = old_hlists;
-        ht->recs = old_recs;
-        ht->size = old_size;
-        ht->first_free_rec = old_first_free_rec;
+        *ht = old;
         return LY_EMEM;
     }
 
-    /* reset used, it will increase again */
-    ht->used = 0;
+    if (ht->resize_step) {
+        /* keep the previous table, its records will be moved gradually */
+        ht->old = malloc(sizeof *ht->old);
+        LY_CHECK_ERR_RET(!ht->old, free(ht->hlists); free(ht->recs); *ht = old; LOGMEM(NULL), LY_EMEM);
+        *ht->old = old;
+        ht->migrate_idx = 0;
+        return LY_SUCCESS;
+    }
 
     /* add all the old records into the new records array */
-    for (i = 0; i < old_size; i++) {
-        for (rec_idx = old_hlists[i].first, rec = lyht_get_rec(old_recs, ht->rec_size, rec_idx);
-                rec_idx != LYHT_NO_RECORD;
-                rec_idx = rec->next, rec = lyht_get_rec(old_recs, ht->rec_size, rec_idx)) {
-            LY_ERR ret;
-
-            if (check) {
-                ret = lyht_insert(ht, rec->val, rec->hash, NULL);
-            } else {
-                ret = lyht_insert_no_check(ht, rec->val, rec->hash, NULL);
-            }
-
-            assert(!ret);
-            (void)ret;
-        }
-    }
+    lyht_insert_all_recs(ht, &old);
 
     /* final touches */
-    free(old_recs);
-    free(old_hlists);
+    free(old.recs);
+    free(old.hlists);
     return LY_SUCCESS;
 }
 
 /**
- * @brief Search for a record with specific value and hash.
+ * @brief Search for a record with specific value and hash in a single table.
  *
  * @param[in] ht Hash table to search in.
  * @param[in] val_p Pointer to the value to find.
@@ -270,7 +613,7 @@ lyht_resize(struct ly_ht *ht, int operation, int check)
  * @return LY_SUCCESS if record was found.
  */
 static LY_ERR
-lyht_find_rec(const struct ly_ht *ht, void *val_p, uint32_t hash, ly_bool mod, lyht_value_equal_cb val_equal,
+lyht_find_table_rec(const struct ly_ht *ht, void *val_p, uint32_t hash, ly_bool mod, lyht_value_equal_cb val_equal,
         uint32_t *col, struct ly_ht_rec **rec_p)
 {
     uint32_t hlist_idx = hash & (ht->size - 1);
@@ -281,6 +624,26 @@ lyht_find_rec(const struct ly_ht *ht, void *val_p, uint32_t hash, ly_bool mod, l
         *col = 0;
     }
 
+    if (ht->open_addr) {
+        /* probe the records until one with a smaller distance or an empty one */
+        for (rec_idx = 1, rec = lyht_get_rec(ht->recs, ht->rec_size, hlist_idx);
+                rec->next >= rec_idx;
+                ++rec_idx, hlist_idx = (hlist_idx + 1) & (ht->size - 1),
+                rec = lyht_get_rec(ht->recs, ht->rec_size, hlist_idx)) {
+            if ((rec->hash == hash) && val_equal(val_p, &rec->val, mod, ht->cb_data)) {
+                *rec_p = rec;
+                return LY_SUCCESS;
+            }
+
+            if (col) {
+                *col = *col + 1;
+            }
+        }
+
+        *rec_p = NULL;
+        return LY_ENOTFOUND;
+    }
+
     LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec) {
         if ((rec->hash == hash) && val_equal(val_p, &rec->val, mod, ht->cb_data)) {
             *rec_p = rec;
@@ -297,12 +660,46 @@ lyht_find_rec(const struct ly_ht *ht, void *val_p, uint32_t hash, ly_bool mod, l
     return LY_ENOTFOUND;
 }
 
+/**
+ * @brief Search for a record with specific value and hash.
+ *
+ * @param[in] ht Hash table to search in.
+ * @param[in] val_p Pointer to the value to find.
+ * @param[in] hash Hash to find.
+ * @param[in] mod Whether the operation modifies the hash table (insert or remove) or not (find).
+ * @param[in] val_equal Callback for checking value equivalence.
+ * @param[out] col Optional collision number of @p rec_p, 0 for no collision.
+ * @param[out] table_p Optional table of @p rec_p, @p ht or its previous table being resized.
+ * @param[out] rec_p Found exact matching record, may be a collision of @p crec_p.
+ * @return LY_ENOTFOUND if no record found,
+ * @return LY_SUCCESS if record was found.
+ */
+static LY_ERR
+lyht_find_rec(const struct ly_ht *ht, void *val_p, uint32_t hash, ly_bool mod, lyht_value_equal_cb val_equal,
+        uint32_t *col, const struct ly_ht **table_p, struct ly_ht_rec **rec_p)
+{
+    if (ht->old && ((hash & (ht->old->size - 1)) >= ht->migrate_idx)) {
+        /* records with this index may not have been moved yet */
+        if (!lyht_find_table_rec(ht->old, val_p, hash, mod, val_equal, col, rec_p)) {
+            if (table_p) {
+                *table_p = ht->old;
+            }
+            return LY_SUCCESS;
+        }
+    }
+
+    if (table_p) {
+        *table_p = ht;
+    }
+    return lyht_find_table_rec(ht, val_p, hash, mod, val_equal, col, rec_p);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyht_find(const struct ly_ht *ht, void *val_p, uint32_t hash, void **match_p)
 {
     struct ly_ht_rec *rec;
 
-    lyht_find_rec(ht, val_p, hash, 0, ht->val_equal, NULL, &rec);
+    lyht_find_rec(ht, val_p, hash, 0, ht->val_equal, NULL, NULL, &rec);
 
     if (match_p) {
         *match_p = rec ? rec->val : NULL;
@@ -315,7 +712,7 @@ lyht_find_with_val_cb(const struct ly_ht *ht, void *val_p, uint32_t hash, lyht_v
 {
     struct ly_ht_rec *rec;
 
-    lyht_find_rec(ht, val_p, hash, 0, val_equal ? val_equal : ht->val_equal, NULL, &rec);
+    lyht_find_rec(ht, val_p, hash, 0, val_equal ? val_equal : ht->val_equal, NULL, NULL, &rec);
 
     if (rec && match_p) {
         *match_p = rec->val;
@@ -327,19 +724,38 @@ LIBYANG_API_DEF LY_ERR
 lyht_find_next_with_collision_cb(const struct ly_ht *ht, void *val_p, uint32_t hash,
         lyht_value_equal_cb val_equal, void **match_p)
 {
+    const struct ly_ht *table;
     struct ly_ht_rec *rec;
     uint32_t rec_idx;
     uint32_t i;
 
-    /* find the record of the previously found value */
-    if (lyht_find_rec(ht, val_p, hash, 1, val_equal ? val_equal : ht->val_equal, &i, &rec)) {
+    /* find the record of the previously found value, all the records with equal hashes are in its table */
+    if (lyht_find_rec(ht, val_p, hash, 1, val_equal ? val_equal : ht->val_equal, &i, &table, &rec)) {
         /* not found, cannot happen */
         LOGINT_RET(NULL);
     }
 
-    for (rec_idx = rec->next, rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx);
+    if (table->open_addr) {
+        /* continue probing after the record */
+        rec_idx = ((unsigned char *)rec - table->recs) / table->rec_size;
+        for (i = rec->next + 1, rec_idx = (rec_idx + 1) & (table->size - 1),
+                rec = lyht_get_rec(table->recs, table->rec_size, rec_idx);
+                rec->next >= i;
+                ++i, rec_idx = (rec_idx + 1) & (table->size - 1), rec = lyht_get_rec(table->recs, table->rec_size, rec_idx)) {
+            if ((rec->hash == hash) && (val_equal ? val_equal : ht->val_equal)(val_p, &rec->val, 0, ht->cb_data)) {
+                if (match_p) {
+                    *match_p = rec->val;
+                }
+                return LY_SUCCESS;
+            }
+        }
+
+        return LY_ENOTFOUND;
+    }
+
+    for (rec_idx = rec->next, rec = lyht_get_rec(table->recs, table->rec_size, rec_idx);
             rec_idx != LYHT_NO_RECORD;
-            rec_idx = rec->next, rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx)) {
+            rec_idx = rec->next, rec = lyht_get_rec(table->recs, table->rec_size, rec_idx)) {
 
         if (rec->hash != hash) {
             continue;
@@ -376,37 +792,34 @@ static LY_ERR
 _lyht_insert_with_resize_cb(struct ly_ht *ht, void *val_p, uint32_t hash, lyht_value_equal_cb resize_val_equal,
         void **match_p, int check)
 {
-    uint32_t hlist_idx = hash & (ht->size - 1);
     LY_ERR r, ret = LY_SUCCESS;
-    struct ly_ht_rec *rec, *prev_rec;
+    struct ly_ht_rec *rec;
     lyht_value_equal_cb old_val_equal = NULL;
-    uint32_t rec_idx;
 
-    if (check) {
-        if (lyht_find_rec(ht, val_p, hash, 1, ht->val_equal, NULL, &rec) == LY_SUCCESS) {
-            if (rec && match_p) {
+    if (ht->old) {
+        /* move some records, including all the ones with the hash */
+        lyht_migrate_step(ht, hash);
+    }
+
+    if (ht->open_addr) {
+        if (lyht_open_insert_rec(ht, val_p, hash, check, &rec)) {
+            if (match_p) {
                 *match_p = rec->val;
             }
             return LY_EEXIST;
         }
-    }
-
-    rec_idx = ht->first_free_rec;
-    assert(rec_idx < ht->size);
-    rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx);
-    ht->first_free_rec = rec->next;
-
-    if (ht->hlists[hlist_idx].first == LYHT_NO_RECORD) {
-        ht->hlists[hlist_idx].first = rec_idx;
     } else {
-        prev_rec = lyht_get_rec(ht->recs, ht->rec_size, ht->hlists[hlist_idx].last);
-        prev_rec->next = rec_idx;
-    }
-    rec->next = LYHT_NO_RECORD;
-    ht->hlists[hlist_idx].last = rec_idx;
+        if (check) {
+            if (lyht_find_table_rec(ht, val_p, hash, 1, ht->val_equal, NULL, &rec) == LY_SUCCESS) {
+                if (rec && match_p) {
+                    *match_p = rec->val;
+                }
+                return LY_EEXIST;
+            }
+        }
 
-    rec->hash = hash;
-    memcpy(&rec->val, val_p, ht->rec_size - SIZEOF_LY_HT_REC);
+        rec = lyht_chain_insert_rec(ht, val_p, hash);
+    }
     if (match_p) {
         *match_p = (void *)&rec->val;
     }
@@ -425,7 +838,7 @@ _lyht_insert_with_resize_cb(struct ly_ht *ht, void *val_p, uint32_t hash, lyht_v
             }
 
             /* enlarge */
-            ret = lyht_resize(ht, 1, check);
+            ret = lyht_resize(ht, 1);
             /* if hash_table was resized, we need to find new matching value */
             if ((ret == LY_SUCCESS) && match_p) {
                 ret = lyht_find(ht, val_p, hash, match_p);
@@ -462,42 +875,26 @@ lyht_insert_no_check(struct ly_ht *ht, void *val_p, uint32_t hash, void **match_
 LIBYANG_API_DEF LY_ERR
 lyht_remove_with_resize_cb(struct ly_ht *ht, void *val_p, uint32_t hash, lyht_value_equal_cb resize_val_equal)
 {
-    struct ly_ht_rec *found_rec, *prev_rec, *rec;
-    uint32_t hlist_idx = hash & (ht->size - 1);
+    struct ly_ht_rec *found_rec;
     LY_ERR r, ret = LY_SUCCESS;
     lyht_value_equal_cb old_val_equal = NULL;
-    uint32_t prev_rec_idx;
-    uint32_t rec_idx;
 
-    if (lyht_find_rec(ht, val_p, hash, 1, ht->val_equal, NULL, &found_rec)) {
-        LOGARG(NULL, hash);
-        return LY_ENOTFOUND;
+    if (ht->old) {
+        /* move some records, including all the ones with the hash */
+        lyht_migrate_step(ht, hash);
     }
 
-    prev_rec_idx = LYHT_NO_RECORD;
-    LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec) {
-        if (rec == found_rec) {
-            break;
-        }
-        prev_rec_idx = rec_idx;
+    if (lyht_find_table_rec(ht, val_p, hash, 1, ht->val_equal, NULL, &found_rec)) {
+        LOGARG(NULL, hash);
+        return LY_ENOTFOUND;
     }
 
-    if (prev_rec_idx == LYHT_NO_RECORD) {
-        ht->hlists[hlist_idx].first = rec->next;
-        if (rec->next == LYHT_NO_RECORD) {
-            ht->hlists[hlist_idx].last = LYHT_NO_RECORD;
-        }
+    if (ht->open_addr) {
+        lyht_open_remove_rec(ht, found_rec);
     } else {
-        prev_rec = lyht_get_rec(ht->recs, ht->rec_size, prev_rec_idx);
-        prev_rec->next = rec->next;
-        if (rec->next == LYHT_NO_RECORD) {
-            ht->hlists[hlist_idx].last = prev_rec_idx;
-        }
+        lyht_chain_remove_rec(ht, found_rec);
     }
 
-    rec->next = ht->first_free_rec;
-    ht->first_free_rec = rec_idx;
-
     /* check size & shrink if needed */
     --ht->used;
     if (ht->resize == 2) {
@@ -508,7 +905,7 @@ lyht_remove_with_resize_cb(struct ly_ht *ht, void *val_p, uint32_t hash, lyht_va
             }
 
             /* shrink */
-            ret = lyht_resize(ht, -1, 1);
+            ret = lyht_resize(ht, -1);
 
             if (resize_val_equal) {
                 lyht_set_cb(ht, old_val_equal);
@@ -86,6 +86,23 @@ typedef ly_bool (*lyht_value_equal_cb)(void *val1_p, void *val2_p, ly_bool mod,
 LIBYANG_API_DECL struct ly_ht *lyht_new(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal, void *cb_data,
         uint16_t resize);
 
+/**
+ * @brief Create new hash table using open addressing.
+ *
+ * The values are stored directly in the table instead of in collision lists so finding a value accesses only
+ * consecutive memory. The table can be used exactly as one created by ::lyht_new() except that inserting or removing
+ * a value may move the other values so no pointer to a stored value is valid after the table is modified.
+ *
+ * @param[in] size Starting size of the hash table (capacity of values), must be power of 2.
+ * @param[in] val_size Size in bytes of value (the stored hashed item).
+ * @param[in] val_equal Callback for checking value equivalence.
+ * @param[in] cb_data User data always passed to @p val_equal.
+ * @param[in] resize Whether to resize the table on too few/too many records taken.
+ * @return Empty hash table, NULL on error.
+ */
+LIBYANG_API_DECL struct ly_ht *lyht_new_open(uint32_t size, uint16_t val_size, lyht_value_equal_cb val_equal,
+        void *cb_data, uint16_t resize);
+
 /**
  * @brief Set hash table value equal callback.
  *
@@ -104,6 +121,21 @@ LIBYANG_API_DECL lyht_value_equal_cb lyht_set_cb(struct ly_ht *ht, lyht_value_eq
  */
 LIBYANG_API_DECL void *lyht_set_cb_data(struct ly_ht *ht, void *new_cb_data);
 
+/**
+ * @brief Set the number of records moved on every operation while resizing a hash table.
+ *
+ * By default, a hash table is resized at once when it becomes too full or too empty, which makes the insert or
+ * remove triggering it take time proportional to the size of the table. With a non-zero @p step, the records are
+ * moved into the resized table gradually by the following operations, @p step indexes of the previous table
+ * on each one, so that no single operation takes long.
+ *
+ * @param[in] ht Hash table to modify.
+ * @param[in] step Number of indexes of the previous table moved on every insert/remove, 0 to resize at once.
+ * A running incremental resize is finished if 0.
+ * @return Previous resize step.
+ */
+LIBYANG_API_DECL uint32_t lyht_set_resize_step(struct ly_ht *ht, uint32_t step);
+
 /**
  * @brief Make a duplicate of an existing hash table.
  *
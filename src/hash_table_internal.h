@@ -38,6 +38,9 @@
 /** never shrink beyond this size */
 #define LYHT_MIN_SIZE 8
 
+/** number of indexes of the previous table moved on every operation of the internal tables resized incrementally */
+#define LYHT_RESIZE_STEP 8
+
 /**
  * @brief Generic hash table record.
  */
@@ -74,6 +77,21 @@ struct ly_ht_hlist {
  * The unused records are chained in first_free_rec, which contains the index
  * of the first unused record entry in the records table.
  *
+ * An open addressing hash table (::lyht_new_open()) has no table of list heads,
+ * the record of a value is stored directly in the records table, at the index
+ * given by the hash or, on collision, in one of the following records (linear
+ * probing). The next index of a record is used for the distance of the record
+ * from its index given by the hash plus one, 0 for an empty record so that
+ * a zeroed records table is empty. The records are kept ordered by this index
+ * (Robin Hood hashing) so a lookup can stop at the first record with smaller
+ * distance than the distance searched.
+ *
+ * With a resize step set (::lyht_set_resize_step()), a resized hash table keeps
+ * the previous table in old and every following insert or remove moves the records
+ * of a few of its indexes into the new table. All the records with the same index
+ * in the previous table are always moved at once so equal hashes are never split
+ * between the tables.
+ *
  * The LYHT_NO_RECORD magic value is used when an index points to nothing.
  */
 struct ly_ht {
@@ -85,9 +103,14 @@ struct ly_ht {
                            * 1 - enlarging is enabled, *
                            * 2 - both shrinking and enlarging is enabled */
     uint16_t rec_size;    /* real size (in bytes) of one record for accessing recs array */
-    uint32_t first_free_rec; /* index of the first free record */
-    struct ly_ht_hlist *hlists; /* pointer to the hlists table */
+    ly_bool open_addr;    /* whether the hash table uses open addressing, with no hlists */
+    uint32_t first_free_rec; /* index of the first free record, unused with open addressing */
+    struct ly_ht_hlist *hlists; /* pointer to the hlists table, NULL with open addressing */
     unsigned char *recs;  /* pointer to the hash table itself (array of struct ht_rec) */
+    uint32_t resize_step; /* number of indexes of the previous table moved on every insert/remove while resizing, *
+                           * 0 to resize the whole table at once */
+    uint32_t migrate_idx; /* first index of the previous table whose records have not been moved yet */
+    struct ly_ht *old;    /* previous table being resized, its records are moved gradually, NULL if none */
 };
 
 /* index that points to nothing */
@@ -100,7 +123,17 @@ lyht_get_rec(unsigned char *recs, uint16_t rec_size, uint32_t idx)
     return (struct ly_ht_rec *)&recs[idx * rec_size];
 }
 
-/* Iterate all records in a hlist */
+/* get the index of the first record in a hlist or in a single record of an open addressing hash table */
+static inline uint32_t
+lyht_iter_first(const struct ly_ht *ht, uint32_t hlist_idx)
+{
+    if (ht->open_addr) {
+        return lyht_get_rec(ht->recs, ht->rec_size, hlist_idx)->next ? hlist_idx : LYHT_NO_RECORD;
+    }
+    return ht->hlists[hlist_idx].first;
+}
+
+/* Iterate all records in a hlist, not usable with open addressing */
 #define LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec)               \
     for (rec_idx = ht->hlists[hlist_idx].first,                         \
              rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx);       \
@@ -109,9 +142,13 @@ lyht_get_rec(unsigned char *recs, uint16_t rec_size, uint32_t idx)
              rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx))
 
 /* Iterate all records in the hash table */
-#define LYHT_ITER_ALL_RECS(ht, hlist_idx, rec_idx, rec)              \
-    for (hlist_idx = 0; hlist_idx < ht->size; hlist_idx++)           \
-        LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec)
+#define LYHT_ITER_ALL_RECS(ht, hlist_idx, rec_idx, rec)                     \
+    for (hlist_idx = 0; hlist_idx < ht->size; hlist_idx++)                  \
+        for (rec_idx = lyht_iter_first(ht, hlist_idx),                      \
+                 rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx);       \
+             rec_idx != LYHT_NO_RECORD;                                     \
+             rec_idx = ht->open_addr ? LYHT_NO_RECORD : rec->next,          \
+                 rec = lyht_get_rec(ht->recs, ht->rec_size, rec_idx))
 
 /**
  * @brief Dictionary hash table record.
@@ -121,6 +158,16 @@ struct ly_dict_rec {
     uint32_t refcount;  /**< reference count of the string */
 };
 
+/**
+ * @brief Finish an incremental resize of a hash table, if any, by moving all the remaining records of the previous
+ * table.
+ *
+ * Needs to be called before iterating over all the records with ::LYHT_ITER_ALL_RECS.
+ *
+ * @param[in] ht Hash table to finish resizing.
+ */
+void lyht_resize_finish(struct ly_ht *ht);
+
 /**
  * @brief Dictionary for storing repeated strings.
  */
@@ -143,4 +190,17 @@ void lydict_init(struct ly_dict *dict);
  */
 void lydict_clean(struct ly_dict *dict);
 
+/**
+ * @brief Insert string into dictionary - zerocopy version, but only if the target pointer is still unset.
+ *
+ * The check and the assignment are both performed while holding the dictionary lock so that a value lazily
+ * cached by several threads at once is stored exactly once.
+ *
+ * @param[in] ctx libyang context handler.
+ * @param[in] value NULL-terminated string to be stored in the dictionary, is always spent (stored or freed).
+ * @param[in,out] str_p Pointer to set to the stored string, left unchanged if already set.
+ * @return LY_ERR value.
+ */
+LY_ERR lydict_insert_zc_once(const struct ly_ctx *ctx, char *value, const char **str_p);
+
 #endif /* LY_HASH_TABLE_INTERNAL_H_ */
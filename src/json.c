@@ -705,17 +705,19 @@ invalid_character:
     return LY_SUCCESS;
 }
 
-LY_ERR
-lyjson_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyjson_ctx **jsonctx_p)
+/**
+ * @brief Start parsing an input with a new or reset JSON context.
+ *
+ * @param[in] jsonctx JSON context with no input.
+ * @param[in] ctx libyang context.
+ * @param[in] in Input structure.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyjson_ctx_start(struct lyjson_ctx *jsonctx, const struct ly_ctx *ctx, struct ly_in *in)
 {
-    LY_ERR ret = LY_SUCCESS;
-    struct lyjson_ctx *jsonctx;
-
-    assert(ctx && in && jsonctx_p);
+    assert(!jsonctx->in);
 
-    /* new context */
-    jsonctx = calloc(1, sizeof *jsonctx);
-    LY_CHECK_ERR_RET(!jsonctx, LOGMEM(ctx), LY_EMEM);
     jsonctx->ctx = ctx;
     jsonctx->in = in;
 
@@ -728,14 +730,26 @@ lyjson_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyjson_ctx **j
     if (jsonctx->in->current[0] == '\0') {
         /* empty file, invalid */
         LOGVAL(jsonctx->ctx, LYVE_SYNTAX, "Empty JSON file.");
-        ret = LY_EVALID;
-        goto cleanup;
+        return LY_EVALID;
     }
 
     /* start JSON parsing */
-    LY_CHECK_GOTO(ret = lyjson_ctx_next(jsonctx, NULL), cleanup);
+    return lyjson_ctx_next(jsonctx, NULL);
+}
 
-cleanup:
+LY_ERR
+lyjson_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyjson_ctx **jsonctx_p)
+{
+    LY_ERR ret;
+    struct lyjson_ctx *jsonctx;
+
+    assert(ctx && in && jsonctx_p);
+
+    /* new context */
+    jsonctx = calloc(1, sizeof *jsonctx);
+    LY_CHECK_ERR_RET(!jsonctx, LOGMEM(ctx), LY_EMEM);
+
+    ret = lyjson_ctx_start(jsonctx, ctx, in);
     if (ret) {
         lyjson_ctx_free(jsonctx);
     } else {
@@ -744,6 +758,20 @@ cleanup:
     return ret;
 }
 
+LY_ERR
+lyjson_ctx_renew(struct lyjson_ctx *jsonctx, const struct ly_ctx *ctx, struct ly_in *in)
+{
+    LY_ERR ret;
+
+    assert(jsonctx && ctx && in);
+
+    ret = lyjson_ctx_start(jsonctx, ctx, in);
+    if (ret) {
+        lyjson_ctx_reset(jsonctx);
+    }
+    return ret;
+}
+
 /**
  * @brief Parse next JSON token, object-name is expected.
  *
@@ -1075,13 +1103,13 @@ lyjson_ctx_restore(struct lyjson_ctx *jsonctx)
 }
 
 void
-lyjson_ctx_free(struct lyjson_ctx *jsonctx)
+lyjson_ctx_reset(struct lyjson_ctx *jsonctx)
 {
-    if (!jsonctx) {
-        return;
-    }
+    struct ly_set status;
 
-    ly_log_location_revert(0, 0, 0, 1);
+    if (jsonctx->in) {
+        ly_log_location_revert(0, 0, 0, 1);
+    }
 
     if (jsonctx->dynamic) {
         free((char *)jsonctx->value);
@@ -1090,6 +1118,21 @@ lyjson_ctx_free(struct lyjson_ctx *jsonctx)
         free((char *)jsonctx->backup.value);
     }
 
+    /* keep only the status stack */
+    status = jsonctx->status;
+    status.count = 0;
+    memset(jsonctx, 0, sizeof *jsonctx);
+    jsonctx->status = status;
+}
+
+void
+lyjson_ctx_free(struct lyjson_ctx *jsonctx)
+{
+    if (!jsonctx) {
+        return;
+    }
+
+    lyjson_ctx_reset(jsonctx);
     ly_set_erase(&jsonctx->status, NULL);
 
     free(jsonctx);
@@ -117,6 +117,16 @@ uint32_t lyjson_ctx_depth(struct lyjson_ctx *jsonctx);
  */
 LY_ERR lyjson_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyjson_ctx **jsonctx);
 
+/**
+ * @brief Start parsing another input with a JSON parser context reset by ::lyjson_ctx_reset().
+ *
+ * @param[in] jsonctx JSON parser context to reuse, is reset again on error.
+ * @param[in] ctx libyang context.
+ * @param[in] in JSON string data to parse.
+ * @return LY_ERR value.
+ */
+LY_ERR lyjson_ctx_renew(struct lyjson_ctx *jsonctx, const struct ly_ctx *ctx, struct ly_in *in);
+
 /**
  * @brief Move to the next JSON artifact and update parser status.
  *
@@ -147,4 +157,11 @@ void lyjson_ctx_restore(struct lyjson_ctx *jsonctx);
  */
 void lyjson_ctx_free(struct lyjson_ctx *jsonctx);
 
+/**
+ * @brief Remove all the parsing state of the context but keep its allocated working memory for reuse.
+ *
+ * @param[in] jsonctx JSON parser context to reset.
+ */
+void lyjson_ctx_reset(struct lyjson_ctx *jsonctx);
+
 #endif /* LY_JSON_H_ */
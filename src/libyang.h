@@ -53,6 +53,7 @@ extern "C" {
  * The following headers are supposed to be included explicitly:
  * - hash_table.h
  * - metadata.h
+ * - nacm.h
  * - plugins_types.h
  * - plugins_exts.h
  */
@@ -162,6 +163,12 @@ extern "C" {
  * Data trees are not internally synchronized so the general safe practice of a single writer **or** several concurrent
  * readers should be followed. Specifically, only the functions with non-const ::lyd_node parameters modify the node(s)
  * and no concurrent execution of such functions should be allowed on a single data tree or subtrees of one.
+ *
+ * Some functions with const ::lyd_node parameters still store information generated only when first needed into
+ * the tree (such as canonical values of some types with ::LY_CTX_LAZY_CANONICAL). Such information is published
+ * under the context dictionary lock, but a data tree shared by many readers should first be frozen by ::lyd_freeze().
+ * Then no reader writes into the tree and the searching (such as ::lyd_find_xpath()), printing (\b lyd_print_*()),
+ * and comparison (\b lyd_compare_*()) functions can be used concurrently without any synchronization.
  */
 
 /**
@@ -175,8 +175,61 @@ ly_err_new(struct ly_err_item **err, LY_ERR ecode, LY_VECODE vecode, char *data_
     return e->err;
 }
 
+/** size of the thread-local context error record cache */
+#define LY_ERR_REC_CACHE_SIZE 8
+
+/**
+ * @brief Thread-local cache entry of a context error record.
+ */
+struct ly_err_rec_cache {
+    const struct ly_ctx *ctx;         /**< cached context, NULL for an empty entry */
+    uint32_t ctx_id;                  /**< ::ly_ctx.err_id of the cached context, detects a reused context address */
+    struct ly_ctx_err_rec *rec;       /**< error record of this thread in the context, NULL if there is none yet */
+};
+
+/**
+ * @brief Error records of the current thread in the recently used contexts. Only the owning thread ever creates
+ * its error record so the cached records (or their absence) remain valid until the context is destroyed, which is
+ * detected by the context ID. The context error hash table (and its lock) is accessed only on a cache miss.
+ */
+static THREAD_LOCAL struct ly_err_rec_cache err_rec_cache[LY_ERR_REC_CACHE_SIZE];
+
+/** index of the next ::err_rec_cache entry to be replaced */
+static THREAD_LOCAL uint32_t err_rec_cache_next;
+
+/**
+ * @brief Store an error record of the current thread into the thread-local cache.
+ *
+ * @param[in] ctx Context of the record.
+ * @param[in] rec Error record to store, may be NULL.
+ * @return Cached error record.
+ */
+static struct ly_ctx_err_rec *
+ly_err_cache_rec(const struct ly_ctx *ctx, struct ly_ctx_err_rec *rec)
+{
+    struct ly_err_rec_cache *entry = NULL;
+    uint32_t i;
+
+    /* reuse an entry of this context, if any */
+    for (i = 0; i < LY_ERR_REC_CACHE_SIZE; ++i) {
+        if (err_rec_cache[i].ctx == ctx) {
+            entry = &err_rec_cache[i];
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &err_rec_cache[err_rec_cache_next];
+        err_rec_cache_next = (err_rec_cache_next + 1) % LY_ERR_REC_CACHE_SIZE;
+    }
+
+    entry->ctx = ctx;
+    entry->ctx_id = ctx->err_id;
+    entry->rec = rec;
+    return rec;
+}
+
 /**
- * @brief Get error record from error hash table of a context for the current thread.
+ * @brief Get error record of a context for the current thread.
  *
  * @param[in] ctx Context to use.
  * @return Thread error record, if any.
@@ -184,22 +237,29 @@ ly_err_new(struct ly_err_item **err, LY_ERR ecode, LY_VECODE vecode, char *data_
 static struct ly_ctx_err_rec *
 ly_err_get_rec(const struct ly_ctx *ctx)
 {
-    struct ly_ctx_err_rec rec, *match;
+    struct ly_ctx_err_rec rec, *rec_p = &rec, **match_p;
+    uint32_t i;
+
+    /* thread-local cache */
+    for (i = 0; i < LY_ERR_REC_CACHE_SIZE; ++i) {
+        if ((err_rec_cache[i].ctx == ctx) && (err_rec_cache[i].ctx_id == ctx->err_id)) {
+            return err_rec_cache[i].rec;
+        }
+    }
 
     /* prepare record */
     rec.tid = pthread_self();
 
-    /* reuse lock */
     /* LOCK */
-    pthread_mutex_lock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+    pthread_mutex_lock((pthread_mutex_t *)&ctx->err_lock);
 
     /* get the pointer to the matching record */
-    lyht_find(ctx->err_ht, &rec, lyht_hash((void *)&rec.tid, sizeof rec.tid), (void **)&match);
+    lyht_find(ctx->err_ht, &rec_p, lyht_hash((void *)&rec.tid, sizeof rec.tid), (void **)&match_p);
 
     /* UNLOCK */
-    pthread_mutex_unlock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+    pthread_mutex_unlock((pthread_mutex_t *)&ctx->err_lock);
 
-    return match;
+    return ly_err_cache_rec(ctx, match_p ? *match_p : NULL);
 }
 
 /**
@@ -211,23 +271,29 @@ ly_err_get_rec(const struct ly_ctx *ctx)
 static struct ly_ctx_err_rec *
 ly_err_new_rec(const struct ly_ctx *ctx)
 {
-    struct ly_ctx_err_rec new, *rec;
+    struct ly_ctx_err_rec *new;
     LY_ERR r;
 
-    /* insert a new record */
-    new.err = NULL;
-    new.tid = pthread_self();
+    /* create a new record */
+    new = calloc(1, sizeof *new);
+    if (!new) {
+        return NULL;
+    }
+    new->tid = pthread_self();
 
-    /* reuse lock */
     /* LOCK */
-    pthread_mutex_lock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+    pthread_mutex_lock((pthread_mutex_t *)&ctx->err_lock);
 
-    r = lyht_insert(ctx->err_ht, &new, lyht_hash((void *)&new.tid, sizeof new.tid), (void **)&rec);
+    r = lyht_insert(ctx->err_ht, &new, lyht_hash((void *)&new->tid, sizeof new->tid), NULL);
 
     /* UNLOCK */
-    pthread_mutex_unlock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+    pthread_mutex_unlock((pthread_mutex_t *)&ctx->err_lock);
 
-    return r ? NULL : rec;
+    if (r) {
+        free(new);
+        return NULL;
+    }
+    return ly_err_cache_rec(ctx, new);
 }
 
 LIBYANG_API_DEF const struct ly_err_item *
@@ -283,6 +349,21 @@ ly_err_move(struct ly_ctx *src_ctx, struct ly_ctx *trg_ctx)
     rec->err = err;
 }
 
+struct ly_err_item *
+ly_err_take(const struct ly_ctx *ctx)
+{
+    struct ly_ctx_err_rec *rec;
+    struct ly_err_item *err = NULL;
+
+    rec = ly_err_get_rec(ctx);
+    if (rec) {
+        err = rec->err;
+        rec->err = NULL;
+    }
+
+    return err;
+}
+
 LIBYANG_API_DEF void
 ly_err_free(void *ptr)
 {
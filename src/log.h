@@ -209,6 +209,8 @@ LIBYANG_API_DECL ly_log_clb ly_get_log_clb(void);
  * All the errors arisen in connection with manipulation with the [context](@ref howtoContext), [YANG modules](@ref howtoSchema)
  * or [YANG data](@ref howtoData), are recorded into the context and can be examined for the more detailed information. These
  * records are stored as ::ly_err_item structures and they are not only context-specific, but also thread-specific.
+ * Each thread keeps its own records so storing, examining, and cleaning errors in one thread never waits for another
+ * thread working with the same context.
  *
  * Storing error information is tightly connected with
  * [logging](@ref howtoLogger). So the @ref logopts control if and which errors are stored in the context. By default, only the
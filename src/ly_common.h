@@ -121,6 +121,14 @@ void ly_vlog(const struct ly_ctx *ctx, const char *apptag, LY_VECODE code, const
  */
 void ly_err_move(struct ly_ctx *src_ctx, struct ly_ctx *trg_ctx);
 
+/**
+ * @brief Remove all the error items of the current thread from a context and return them.
+ *
+ * @param[in] ctx Context to read errors from.
+ * @return Removed error items, NULL if none.
+ */
+struct ly_err_item *ly_err_take(const struct ly_ctx *ctx);
+
 /**
  * @brief Logger location data setter.
  *
@@ -335,7 +343,8 @@ int LY_VCODE_INSTREXP_len(const char *str);
  *****************************************************************************/
 
 /**
- * @brief Context error hash table record.
+ * @brief Context error hash table record, allocated separately so that its address stays valid for the
+ * thread-local record cache of its thread.
  */
 struct ly_ctx_err_rec {
     struct ly_err_item *err;          /** pointer to the error items, if any */
@@ -361,9 +370,17 @@ struct ly_ctx {
 
     ly_ext_data_clb ext_clb;          /**< optional callback for providing extension-specific run-time data for extensions */
     void *ext_clb_data;               /**< optional private data for ::ly_ctx.ext_clb */
-    struct ly_ht *err_ht;             /**< hash table of thread-specific list of errors related to the context */
+    struct ly_ht *err_ht;             /**< hash table of pointers to thread-specific error records related to the context,
+                                           accessed only when a thread registers its record, see ::ly_ctx_err_rec */
+    pthread_mutex_t err_lock;         /**< lock for accessing ::ly_ctx.err_ht */
+    uint32_t err_id;                  /**< unique context ID distinguishing it in the thread-local error record caches */
     pthread_mutex_t lyb_hash_lock;    /**< lock for storing LYB schema hashes in schema nodes */
     struct ly_ht *leafref_links_ht;   /**< hash table of leafref links between term data nodes */
+    struct ly_ht *val_prof_ht;        /**< hash table of validation profiler records, see ::LY_CTX_VAL_PROFILE */
+    pthread_mutex_t val_prof_lock;    /**< lock for accessing ::ly_ctx.val_prof_ht */
+    struct ly_ht *uniq_idx_ht;        /**< hash table of unique indexes of list instances by their data parents */
+    struct ly_ht *uniq_top_ht;        /**< hash table of unique indexes of top-level list instances by the instances */
+    pthread_mutex_t uniq_idx_lock;    /**< lock for accessing ::ly_ctx.uniq_idx_ht and ::ly_ctx.uniq_top_ht */
     struct ly_set plugins_types;      /**< context specific set of type plugins */
     struct ly_set plugins_extensions; /**< contets specific set of extension plugins */
 };
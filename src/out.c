@@ -32,6 +32,7 @@
 #include "metadata.h"
 #include "printer_data.h"
 #include "tree_data.h"
+#include "tree_data_internal.h"
 #include "tree_schema.h"
 
 /**
@@ -40,6 +41,24 @@
 #define REALLOC_CHUNK(NEW_SIZE) \
     NEW_SIZE + (1024 - (NEW_SIZE % 1024))
 
+/**
+ * @brief Check whether a node has any virtual default children to print.
+ *
+ * @param[in] node Data node to check.
+ * @param[in] options Printer options.
+ * @return Whether there are any virtual default children to print.
+ */
+static ly_bool
+lyd_node_has_print_dflts(const struct lyd_node *node, uint32_t options)
+{
+    if (options & LYD_PRINT_WD_TRIM) {
+        return 0;
+    }
+
+    /* only the state default nodes are printed in the explicit mode */
+    return lyd_dflt_virtual_exists(node, (options & LYD_PRINT_WD_MASK) ? 0 : 1);
+}
+
 LIBYANG_API_DEF ly_bool
 lyd_node_should_print(const struct lyd_node *node, uint32_t options)
 {
@@ -81,6 +100,10 @@ lyd_node_should_print(const struct lyd_node *node, uint32_t options)
             if ((elem != node) && lyd_node_should_print(elem, options)) {
                 return 1;
             }
+            if (lyd_node_has_print_dflts(elem, options)) {
+                /* virtual default nodes */
+                return 1;
+            }
             assert(elem->flags & LYD_DEFAULT);
             LYD_TREE_DFS_END(node, elem)
         }
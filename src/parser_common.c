@@ -69,6 +69,23 @@ lyd_ctx_free(struct lyd_ctx *lydctx)
     lyd_val_getnext_ht_free(lydctx->val_getnext_ht);
 }
 
+void
+lyd_ctx_reset(struct lyd_ctx *lydctx)
+{
+    ly_set_clean(&lydctx->node_types, NULL);
+    ly_set_clean(&lydctx->meta_types, NULL);
+    ly_set_clean(&lydctx->node_when, NULL);
+    ly_set_clean(&lydctx->ext_node, free);
+    ly_set_clean(&lydctx->ext_val, free);
+
+    lydctx->ext = NULL;
+    lydctx->parse_opts = 0;
+    lydctx->val_opts = 0;
+    lydctx->int_opts = 0;
+    lydctx->path_len = 0;
+    lydctx->op_node = NULL;
+}
+
 LY_ERR
 lyd_parser_notif_eventtime_validate(const struct lyd_node *node)
 {
@@ -469,8 +486,8 @@ lyd_parser_validate_new_implicit(struct lyd_ctx *lydctx, struct lyd_node *node)
 
     /* add any missing default children */
     r = lyd_new_implicit_r(node, lyd_node_child_p(node), NULL, NULL, &lydctx->node_when, &lydctx->node_types,
-            &lydctx->ext_node, (lydctx->val_opts & LYD_VALIDATE_NO_STATE) ? LYD_IMPLICIT_NO_STATE : 0,
-            lydctx->val_getnext_ht, NULL);
+            &lydctx->ext_node, ((lydctx->val_opts & LYD_VALIDATE_NO_STATE) ? LYD_IMPLICIT_NO_STATE : 0) |
+            LYD_IMPLICIT_VIRTUAL, lydctx->val_getnext_ht, NULL);
     LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
 
 cleanup:
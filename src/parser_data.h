@@ -23,6 +23,7 @@ extern "C" {
 #endif
 
 struct ly_in;
+struct ly_out;
 
 /**
  * @page howtoDataParsers Parsing Data
@@ -65,6 +66,16 @@ struct ly_in;
  *   notification messages are supported.
  * - ::lyd_parse_ext_op() is used for parsing RPCs/actions, replies, and notifications defined inside extension instances.
  *
+ * Every parsing call allocates its internal parser context and frees it when finished. When parsing many small inputs,
+ * such as RPCs, in a loop, a parser handle created by ::lyd_parser_new() can be used with ::lyd_parser_parse_data()
+ * and ::lyd_parser_parse_op() instead. It keeps all the internal buffers and sets, only resetting them between
+ * the calls. The handle must not be used by several threads at once.
+ *
+ * A stream of independent messages of the same type can be processed by a pipeline created by ::lyd_pipeline_new().
+ * Messages added by ::lyd_pipeline_push() are parsed by a set of worker threads and then validated by another set,
+ * so that parsing of the next messages overlaps with validation of the previous ones. The results are passed
+ * to a callback in the order of the pushed messages.
+ *
  * Further information regarding the processing input instance data can be found on the following pages.
  * - @subpage howtoDataValidation
  * - @subpage howtoDataWD
@@ -78,6 +89,14 @@ struct ly_in;
  * - ::lyd_parse_ext_data()
  * - ::lyd_parse_op()
  * - ::lyd_parse_ext_op()
+ * - ::lyd_parser_new()
+ * - ::lyd_parser_parse_data()
+ * - ::lyd_parser_parse_op()
+ * - ::lyd_parser_free()
+ * - ::lyd_pipeline_new()
+ * - ::lyd_pipeline_push()
+ * - ::lyd_pipeline_flush()
+ * - ::lyd_pipeline_free()
  */
 
 /**
@@ -100,11 +119,18 @@ struct ly_in;
  * difference in contrast to the parsing process, when the data are loaded from an external source and invalid reference
  * outside the operation tree is acceptable.
  *
+ * To find out which constraints make the validation slow, the context can be created with ::LY_CTX_VAL_PROFILE option.
+ * The number of evaluations and their duration is then recorded for every when, must, and unique constraint and type
+ * plugin callback. The statistics can be printed in JSON by ::lyd_validate_profile_print().
+ *
  * Functions List
  * --------------
  * - ::lyd_validate_all()
  * - ::lyd_validate_module()
  * - ::lyd_validate_op()
+ *
+ * - ::lyd_validate_profile_print()
+ * - ::lyd_validate_profile_clear()
  */
 
 /**
@@ -181,6 +207,12 @@ struct ly_in;
                                                        format according to RFC 7951 based on their type. Using this
                                                        option the validation can be softened to accept boolean and
                                                        number type values enclosed in quotes. */
+#define LYD_PARSE_BULK 0x10000000           /**< Append the parsed nodes without keeping the (leaf-)list instances sorted
+                                                 and the children hashed after every node. Instead, once the whole input is
+                                                 parsed, the instances are sorted and their sorting trees built at once
+                                                 and the children hash tables are created with their final size. Faster
+                                                 for data with many (leaf-)list instances, the resulting data are the
+                                                 same. Ignored with ::LYD_PARSE_ORDERED. */
 #define LYD_PARSE_OPTS_MASK 0xFFFF0000      /**< Mask for all the LYD_PARSE_ options. */
 
 /** @} dataparseroptions */
@@ -474,6 +506,136 @@ LIBYANG_API_DECL LY_ERR lyd_parse_op(const struct ly_ctx *ctx, struct lyd_node *
 LIBYANG_API_DECL LY_ERR lyd_parse_ext_op(const struct lysc_ext_instance *ext, struct lyd_node *parent, struct ly_in *in,
         LYD_FORMAT format, enum lyd_type data_type, struct lyd_node **tree, struct lyd_node **op);
 
+/**
+ * @brief Reusable data parser handle.
+ */
+struct lyd_parser;
+
+/**
+ * @brief Create a reusable data parser handle.
+ *
+ * @param[in] ctx libyang context of all the parsed data.
+ * @param[out] parser Created parser handle.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_parser_new(const struct ly_ctx *ctx, struct lyd_parser **parser);
+
+/**
+ * @brief Parse (and validate) data from the input handle as a YANG data tree reusing the internal parser context.
+ *
+ * Behaves exactly as ::lyd_parse_data() but keeps all the internal buffers of @p parser for the next calls.
+ *
+ * @param[in] parser Parser handle.
+ * @param[in] parent Optional parent to connect the parsed nodes to.
+ * @param[in] in Input handle to read the input from.
+ * @param[in] format Format of the input data to be parsed. Can be 0 to try to detect format from the input handle.
+ * @param[in] parse_options Options for parser, see @ref dataparseroptions.
+ * @param[in] validate_options Options for the validation phase, see @ref datavalidationoptions.
+ * @param[out] tree Full parsed data tree, note that NULL can be a valid tree. If @p parent is set, set to NULL.
+ * @return LY_ERR value, see ::lyd_parse_data().
+ */
+LIBYANG_API_DECL LY_ERR lyd_parser_parse_data(struct lyd_parser *parser, struct lyd_node *parent, struct ly_in *in,
+        LYD_FORMAT format, uint32_t parse_options, uint32_t validate_options, struct lyd_node **tree);
+
+/**
+ * @brief Parse YANG data into an operation data tree reusing the internal parser context.
+ *
+ * Behaves exactly as ::lyd_parse_op() but keeps all the internal buffers of @p parser for the next calls.
+ *
+ * @param[in] parser Parser handle.
+ * @param[in] parent Optional parent to connect the parsed nodes to.
+ * @param[in] in Input handle to read the input from.
+ * @param[in] format Expected format of the data in @p in.
+ * @param[in] data_type Expected operation to parse (@ref datatype).
+ * @param[out] tree Optional full parsed data tree. If @p parent is set, set to NULL.
+ * @param[out] op Optional pointer to the operation (action/RPC/notification) node.
+ * @return LY_ERR value, see ::lyd_parse_op().
+ */
+LIBYANG_API_DECL LY_ERR lyd_parser_parse_op(struct lyd_parser *parser, struct lyd_node *parent, struct ly_in *in,
+        LYD_FORMAT format, enum lyd_type data_type, struct lyd_node **tree, struct lyd_node **op);
+
+/**
+ * @brief Free a reusable data parser handle.
+ *
+ * @param[in] parser Parser handle to free.
+ */
+LIBYANG_API_DECL void lyd_parser_free(struct lyd_parser *parser);
+
+/**
+ * @brief Pipeline of parse and validate worker threads processing a message stream.
+ */
+struct lyd_pipeline;
+
+/**
+ * @brief Callback for a processed pipeline message.
+ *
+ * Called from a pipeline worker thread for every pushed message in the order of the messages, never concurrently.
+ * No pipeline functions may be called from the callback.
+ *
+ * @param[in] in Input handle of the message, the caller may free it now.
+ * @param[in] rc Result of parsing and validating the message.
+ * @param[in] err Errors of a failed message, valid only during the callback.
+ * @param[in] tree Parsed data tree, owned by the callback. NULL if @p rc is not ::LY_SUCCESS.
+ * @param[in] op Parsed operation node in @p tree or in a separate tree for NETCONF and RESTCONF messages, which is
+ * also owned by the callback. NULL for YANG data or if @p rc is not ::LY_SUCCESS.
+ * @param[in] user_data Arbitrary user data.
+ */
+typedef void (*lyd_pipeline_clb)(struct ly_in *in, LY_ERR rc, const struct ly_err_item *err, struct lyd_node *tree,
+        struct lyd_node *op, void *user_data);
+
+/**
+ * @brief Create a pipeline parsing and validating messages on worker threads.
+ *
+ * Every parse thread uses its own parser handle (::lyd_parser_new()). YANG data messages are parsed with
+ * ::LYD_PARSE_ONLY and validated by ::lyd_validate_all(), unless @p parse_options include ::LYD_PARSE_ONLY. RPCs and
+ * notifications are parsed by ::lyd_parser_parse_op() and validated by ::lyd_validate_op() with no dependency tree.
+ * Replies are not supported because they require the RPC.
+ *
+ * The errors of the worker threads are not logged, they are only passed to the callback.
+ *
+ * @param[in] ctx libyang context of all the parsed data, must not be changed while the pipeline exists.
+ * @param[in] format Format of the messages.
+ * @param[in] data_type Type of the messages, one of ::LYD_TYPE_DATA_YANG, ::LYD_TYPE_RPC_YANG, ::LYD_TYPE_NOTIF_YANG,
+ * ::LYD_TYPE_RPC_NETCONF, ::LYD_TYPE_NOTIF_NETCONF, or ::LYD_TYPE_NOTIF_RESTCONF.
+ * @param[in] parse_options Parse options of YANG data messages, see @ref dataparseroptions.
+ * @param[in] validate_options Validation options of YANG data messages, see @ref datavalidationoptions.
+ * @param[in] parse_threads Number of parse worker threads.
+ * @param[in] validate_threads Number of validate worker threads.
+ * @param[in] queue_size Maximum number of messages being processed, ::lyd_pipeline_push() blocks if reached.
+ * @param[in] clb Callback called for every processed message.
+ * @param[in] user_data Arbitrary user data passed to @p clb.
+ * @param[out] pipeline Created pipeline.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_pipeline_new(const struct ly_ctx *ctx, LYD_FORMAT format, enum lyd_type data_type,
+        uint32_t parse_options, uint32_t validate_options, uint32_t parse_threads, uint32_t validate_threads,
+        uint32_t queue_size, lyd_pipeline_clb clb, void *user_data, struct lyd_pipeline **pipeline);
+
+/**
+ * @brief Add a message to a pipeline.
+ *
+ * Blocks while there are the maximum number of messages being processed.
+ *
+ * @param[in] pipeline Pipeline to use.
+ * @param[in] in Input handle of the message, must not be used until passed to the callback.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_pipeline_push(struct lyd_pipeline *pipeline, struct ly_in *in);
+
+/**
+ * @brief Wait until all the messages added to a pipeline are processed and passed to the callback.
+ *
+ * @param[in] pipeline Pipeline to use.
+ */
+LIBYANG_API_DECL void lyd_pipeline_flush(struct lyd_pipeline *pipeline);
+
+/**
+ * @brief Process all the remaining messages and free a pipeline.
+ *
+ * @param[in] pipeline Pipeline to free.
+ */
+LIBYANG_API_DECL void lyd_pipeline_free(struct lyd_pipeline *pipeline);
+
 /**
  * @brief Fully validate a data tree.
  *
@@ -539,6 +701,27 @@ LIBYANG_API_DECL LY_ERR lyd_validate_module_final(struct lyd_node *tree, const s
 LIBYANG_API_DECL LY_ERR lyd_validate_op(struct lyd_node *op_tree, const struct lyd_node *dep_tree, enum lyd_type data_type,
         struct lyd_node **diff);
 
+/**
+ * @brief Print the validation statistics collected in a context with ::LY_CTX_VAL_PROFILE option as JSON.
+ *
+ * There is a record for every measured when, must, and unique constraint and for every type plugin store and validate
+ * callback of a schema node. It includes the module and data path of the schema node, the constraint, the number of
+ * evaluations, and their total and maximal duration in nanoseconds. Records are ordered by their total duration,
+ * the most expensive first. All the statistics are discarded whenever the context is recompiled.
+ *
+ * @param[in] out Output handler to print into.
+ * @param[in] ctx Context with the statistics.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_validate_profile_print(struct ly_out *out, const struct ly_ctx *ctx);
+
+/**
+ * @brief Discard all the validation statistics collected in a context.
+ *
+ * @param[in] ctx Context with the statistics.
+ */
+LIBYANG_API_DECL void lyd_validate_profile_clear(const struct ly_ctx *ctx);
+
 /** @} datatree */
 
 #ifdef __cplusplus
@@ -64,6 +64,15 @@ typedef void (*lyd_ctx_free_clb)(struct lyd_ctx *ctx);
 #define LYD_INTOPT_NO_SIBLINGS      0x40    /**< If there are any siblings, return an error. */
 #define LYD_INTOPT_EVENTTIME        0x80    /**< Parse notification eventTime node. */
 
+/**
+ * @brief Get the order of inserting parsed nodes (@ref insertorder) based on the parse options.
+ *
+ * @param[in] PARSE_OPTS Parse options (@ref dataparseroptions).
+ */
+#define LYD_PARSER_INSERT_ORDER(PARSE_OPTS) \
+    (((PARSE_OPTS) & LYD_PARSE_ORDERED) ? LYD_INSERT_NODE_LAST : \
+    (((PARSE_OPTS) & LYD_PARSE_BULK) ? LYD_INSERT_NODE_BULK : LYD_INSERT_NODE_DEFAULT))
+
 /**
  * @brief Internal (common) context for YANG data parsers.
  *
@@ -195,11 +204,63 @@ struct lyd_ctx_ext_node {
     struct lyd_node *node;
 };
 
+/**
+ * @brief Reusable data parser handle with pooled parser contexts.
+ */
+struct lyd_parser {
+    const struct ly_ctx *ctx;       /**< libyang context */
+    uint16_t change_count;          /**< context change count the cached getnext schema nodes are valid for */
+    struct lyd_ctx *xml;            /**< pooled XML data parser context */
+    struct lyd_ctx *json;           /**< pooled JSON data parser context */
+};
+
 /**
  * @brief Common part to supplement the specific ::lyd_ctx_free_clb callbacks.
  */
 void lyd_ctx_free(struct lyd_ctx *ctx);
 
+/**
+ * @brief Common part to supplement the specific ::lyd_ctx_free_clb callbacks of pooled parser contexts.
+ *
+ * Removes all the parsing state but keeps the allocated memory of the sets and the cached getnext schema nodes.
+ *
+ * @param[in] ctx Data parser context to reset.
+ */
+void lyd_ctx_reset(struct lyd_ctx *ctx);
+
+/**
+ * @brief Create a pooled XML data parser context to be reused by ::lyd_parse_xml() and ::lyd_parse_xml_netconf().
+ *
+ * @param[in] ctx libyang context.
+ * @param[out] lydctx_p Created data parser context, its free callback only resets it, use ::lyd_xml_ctx_free() to free it.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_xml_ctx_new_pooled(const struct ly_ctx *ctx, struct lyd_ctx **lydctx_p);
+
+/**
+ * @brief Free an XML data parser context.
+ *
+ * @param[in] lydctx Data parser context to free.
+ */
+void lyd_xml_ctx_free(struct lyd_ctx *lydctx);
+
+/**
+ * @brief Create a pooled JSON data parser context to be reused by ::lyd_parse_json() and ::lyd_parse_json_restconf().
+ *
+ * @param[in] ctx libyang context.
+ * @param[out] lydctx_p Created data parser context, its free callback only resets it, use ::lyd_json_ctx_free() to free
+ * it.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_json_ctx_new_pooled(const struct ly_ctx *ctx, struct lyd_ctx **lydctx_p);
+
+/**
+ * @brief Free a JSON data parser context.
+ *
+ * @param[in] lydctx Data parser context to free.
+ */
+void lyd_json_ctx_free(struct lyd_ctx *lydctx);
+
 /**
  * @brief Parse submodule from YANG data.
  * @param[in,out] context Parser context.
@@ -259,7 +320,7 @@ LY_ERR yin_parse_submodule(struct lysp_yin_ctx **yin_ctx, struct ly_ctx *ctx, st
  * @param[in] int_opts Internal data parser options.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
- * @param[out] lydctx_p Data parser context to finish validation.
+ * @param[in,out] lydctx_p Data parser context to finish validation. If set, it is a pooled context to be reused.
  * @return LY_ERR value.
  */
 LY_ERR lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
@@ -280,7 +341,7 @@ LY_ERR lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *e
  * @param[out] envp Individual parsed envelopes tree, may be returned possibly even on an error.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
- * @param[out] lydctx_p Data parser context to finish validation.
+ * @param[in,out] lydctx_p Data parser context to finish validation. If set, it is a pooled context to be reused.
  * @return LY_ERR value.
  */
 LY_ERR lyd_parse_xml_netconf(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
@@ -300,7 +361,7 @@ LY_ERR lyd_parse_xml_netconf(const struct ly_ctx *ctx, const struct lysc_ext_ins
  * @param[in] int_opts Internal data parser options.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
- * @param[out] lydctx_p Data parser context to finish validation.
+ * @param[in,out] lydctx_p Data parser context to finish validation. If set, it is a pooled context to be reused.
  * @return LY_ERR value.
  */
 LY_ERR lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
@@ -321,7 +382,7 @@ LY_ERR lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *
  * @param[out] envp Individual parsed envelopes tree, may be returned possibly even on an error.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
- * @param[out] lydctx_p Data parser context to finish validation.
+ * @param[in,out] lydctx_p Data parser context to finish validation. If set, it is a pooled context to be reused.
  * @return LY_ERR value.
  */
 LY_ERR lyd_parse_json_restconf(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
@@ -43,7 +43,7 @@
  *
  * JSON implementation of lyd_ctx_free_clb().
  */
-static void
+void
 lyd_json_ctx_free(struct lyd_ctx *lydctx)
 {
     struct lyd_json_ctx *ctx = (struct lyd_json_ctx *)lydctx;
@@ -55,6 +55,54 @@ lyd_json_ctx_free(struct lyd_ctx *lydctx)
     }
 }
 
+/**
+ * @brief Reset a pooled JSON data parser context.
+ *
+ * Implementation of ::lyd_ctx_free_clb for contexts created by ::lyd_json_ctx_new_pooled().
+ */
+static void
+lyd_json_ctx_reset(struct lyd_ctx *lydctx)
+{
+    struct lyd_json_ctx *ctx = (struct lyd_json_ctx *)lydctx;
+
+    lyd_ctx_reset(lydctx);
+    lyjson_ctx_reset(ctx->jsonctx);
+    ctx->any_schema = NULL;
+}
+
+LY_ERR
+lyd_json_ctx_new_pooled(const struct ly_ctx *ctx, struct lyd_ctx **lydctx_p)
+{
+    struct lyd_json_ctx *lydctx;
+
+    lydctx = calloc(1, sizeof *lydctx);
+    LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
+    lydctx->jsonctx = calloc(1, sizeof *lydctx->jsonctx);
+    LY_CHECK_ERR_RET(!lydctx->jsonctx, free(lydctx); LOGMEM(ctx), LY_EMEM);
+    lydctx->free = lyd_json_ctx_reset;
+
+    *lydctx_p = (struct lyd_ctx *)lydctx;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Finish parsing with a JSON data parser context that is kept for validation, the JSON context is no more needed.
+ *
+ * @param[in] lydctx Data parser context.
+ */
+static void
+lyd_json_ctx_finish(struct lyd_json_ctx *lydctx)
+{
+    /* freeing the JSON context also stops logging line numbers which would be confusing now */
+    if (lydctx->free == lyd_json_ctx_reset) {
+        /* keep the JSON context of the pooled context */
+        lyjson_ctx_reset(lydctx->jsonctx);
+    } else {
+        lyjson_ctx_free(lydctx->jsonctx);
+        lydctx->jsonctx = NULL;
+    }
+}
+
 /**
  * @brief Pass the responsibility for releasing the dynamic values to @p dst.
  *
@@ -1085,7 +1133,7 @@ lydjson_parse_opaq(struct lyd_json_ctx *lydctx, const char *name, size_t name_le
         LY_CHECK_GOTO(ret = lyjson_ctx_next(lydctx->jsonctx, status_inner_p), cleanup);
         assert(*node_p);
         lydjson_maintain_children(parent, first_p, node_p,
-                lydctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT, NULL);
+                LYD_PARSER_INSERT_ORDER(lydctx->parse_opts), NULL);
 
         LOG_LOCBACK(0, 1);
 
@@ -1308,7 +1356,7 @@ lydjson_parse_any(struct lyd_json_ctx *lydctx, const struct lysc_node *snode, st
 
         /* parse any data tree with correct options, first backup the current options and then make the parser
          * process data as opaq nodes */
-        lydctx->parse_opts &= ~LYD_PARSE_STRICT;
+        lydctx->parse_opts &= ~(LYD_PARSE_STRICT | LYD_PARSE_BULK);
         lydctx->parse_opts |= LYD_PARSE_OPAQ | (ext ? LYD_PARSE_ONLY : 0);
         lydctx->int_opts |= LYD_INTOPT_ANY | LYD_INTOPT_WITH_SIBLINGS;
         lydctx->any_schema = snode;
@@ -1449,6 +1497,12 @@ lydjson_parse_instance_inner(struct lyd_json_ctx *lydctx, const struct lysc_node
         LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
     }
 
+    if (LYD_PARSER_INSERT_ORDER(lydctx->parse_opts) == LYD_INSERT_NODE_BULK) {
+        /* sort and hash the children */
+        r = lyd_insert_bulk_finish(*node, NULL);
+        LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+    }
+
     if (!(lydctx->parse_opts & LYD_PARSE_ONLY) && !rc) {
         /* new node validation */
         r = lyd_parser_validate_new_implicit((struct lyd_ctx *)lydctx, *node);
@@ -1749,7 +1803,7 @@ lydjson_subtree_r(struct lyd_json_ctx *lydctx, struct lyd_node *parent, struct l
                 LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
 
                 lydjson_maintain_children(parent, first_p, &node,
-                        lydctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT, ext);
+                        LYD_PARSER_INSERT_ORDER(lydctx->parse_opts), ext);
 
                 /* move after the item(s) */
                 r = lyjson_ctx_next(lydctx->jsonctx, &status);
@@ -1788,7 +1842,7 @@ node_parsed:
 
     /* finally connect the parsed node, is zeroed */
     lydjson_maintain_children(parent, first_p, &node,
-            lydctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT, ext);
+            LYD_PARSER_INSERT_ORDER(lydctx->parse_opts), ext);
 
     if (!parse_subtree) {
         /* move after the item(s) */
@@ -1823,27 +1877,34 @@ cleanup:
  * @param[in] in Input structure.
  * @param[in] parse_opts Options for parser, see @ref dataparseroptions.
  * @param[in] val_opts Options for the validation phase, see @ref datavalidationoptions.
+ * @param[in,out] pooled_p Pooled data parser context to reuse, if any, is always set to NULL.
  * @param[out] lydctx_p Data parser context to finish validation.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_parse_json_init(const struct ly_ctx *ctx, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts,
-        struct lyd_json_ctx **lydctx_p)
+        struct lyd_ctx **pooled_p, struct lyd_json_ctx **lydctx_p)
 {
     LY_ERR ret = LY_SUCCESS;
     struct lyd_json_ctx *lydctx;
     enum LYJSON_PARSER_STATUS status;
 
-    assert(lydctx_p);
+    assert(pooled_p && lydctx_p);
 
     /* init context */
-    lydctx = calloc(1, sizeof *lydctx);
-    LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
+    if (*pooled_p) {
+        /* reuse the pooled context */
+        lydctx = (struct lyd_json_ctx *)*pooled_p;
+        *pooled_p = NULL;
+        LY_CHECK_RET(lyjson_ctx_renew(lydctx->jsonctx, ctx, in));
+    } else {
+        lydctx = calloc(1, sizeof *lydctx);
+        LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
+        lydctx->free = lyd_json_ctx_free;
+        LY_CHECK_ERR_RET(ret = lyjson_ctx_new(ctx, in, &lydctx->jsonctx), free(lydctx), ret);
+    }
     lydctx->parse_opts = parse_opts;
     lydctx->val_opts = val_opts;
-    lydctx->free = lyd_json_ctx_free;
-
-    LY_CHECK_ERR_RET(ret = lyjson_ctx_new(ctx, in, &lydctx->jsonctx), free(lydctx), ret);
     status = lyjson_ctx_status(lydctx->jsonctx);
 
     /* parse_opts & LYD_PARSE_SUBTREE not implemented */
@@ -1851,7 +1912,7 @@ lyd_parse_json_init(const struct ly_ctx *ctx, struct ly_in *in, uint32_t parse_o
         /* expecting top-level object */
         LOGVAL(ctx, LYVE_SYNTAX_JSON, "Expected top-level JSON object, but %s found.", lyjson_token2str(status));
         *lydctx_p = NULL;
-        lyd_json_ctx_free((struct lyd_ctx *)lydctx);
+        lydctx->free((struct lyd_ctx *)lydctx);
         return LY_EVALID;
     }
 
@@ -1868,7 +1929,7 @@ lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, st
     struct lyd_json_ctx *lydctx = NULL;
     enum LYJSON_PARSER_STATUS status;
 
-    rc = lyd_parse_json_init(ctx, in, parse_opts, val_opts, &lydctx);
+    rc = lyd_parse_json_init(ctx, in, parse_opts, val_opts, lydctx_p, &lydctx);
     LY_CHECK_GOTO(rc, cleanup);
 
     lydctx->int_opts = int_opts;
@@ -1923,13 +1984,14 @@ cleanup:
             !lydctx->node_when.count));
 
     if (rc && (!lydctx || !(lydctx->val_opts & LYD_VALIDATE_MULTI_ERROR) || (rc != LY_EVALID))) {
-        lyd_json_ctx_free((struct lyd_ctx *)lydctx);
+        if (lydctx) {
+            lydctx->free((struct lyd_ctx *)lydctx);
+        }
     } else {
         *lydctx_p = (struct lyd_ctx *)lydctx;
 
-        /* the JSON context is no more needed, freeing it also stops logging line numbers which would be confusing now */
-        lyjson_ctx_free(lydctx->jsonctx);
-        lydctx->jsonctx = NULL;
+        /* the JSON context is no more needed */
+        lyd_json_ctx_finish(lydctx);
     }
     return rc;
 }
@@ -2018,7 +2080,7 @@ lyd_parse_json_restconf(const struct ly_ctx *ctx, const struct lysc_ext_instance
     assert(!(parse_opts & LYD_PARSE_SUBTREE));
 
     /* init context */
-    rc = lyd_parse_json_init(ctx, in, parse_opts, val_opts, &lydctx);
+    rc = lyd_parse_json_init(ctx, in, parse_opts, val_opts, lydctx_p, &lydctx);
     LY_CHECK_GOTO(rc, cleanup);
     lydctx->ext = ext;
 
@@ -2115,13 +2177,14 @@ cleanup:
             !lydctx->node_when.count));
 
     if (rc) {
-        lyd_json_ctx_free((struct lyd_ctx *)lydctx);
+        if (lydctx) {
+            lydctx->free((struct lyd_ctx *)lydctx);
+        }
     } else {
         *lydctx_p = (struct lyd_ctx *)lydctx;
 
-        /* the JSON context is no more needed, freeing it also stops logging line numbers which would be confusing now */
-        lyjson_ctx_free(lydctx->jsonctx);
-        lydctx->jsonctx = NULL;
+        /* the JSON context is no more needed */
+        lyd_json_ctx_finish(lydctx);
     }
     return rc;
 }
@@ -868,7 +868,7 @@ lyb_insert_node(struct lyd_lyb_ctx *lybctx, struct lyd_node *parent, struct lyd_
         lyplg_ext_insert(parent, node);
     } else {
         lyd_insert_node(parent, first_p, node,
-                lybctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT);
+                LYD_PARSER_INSERT_ORDER(lybctx->parse_opts));
     }
     while (!parent && (*first_p)->prev->next) {
         *first_p = (*first_p)->prev;
@@ -1023,6 +1023,11 @@ lyb_validate_node_inner(struct lyd_lyb_ctx *lybctx, struct lyd_node *node)
 {
     LY_ERR rc = LY_SUCCESS;
 
+    if (LYD_PARSER_INSERT_ORDER(lybctx->parse_opts) == LYD_INSERT_NODE_BULK) {
+        /* sort and hash the children */
+        LY_CHECK_RET(lyd_insert_bulk_finish(node, NULL));
+    }
+
     if (!(lybctx->parse_opts & LYD_PARSE_ONLY)) {
         /* new node validation */
         rc = lyd_parser_validate_new_implicit((struct lyd_ctx *)lybctx, node);
@@ -0,0 +1,409 @@
+/**
+ * @file parser_pipeline.c
+ * @brief Pipeline parsing and validating data messages on worker threads.
+ *
+ * Copyright (c) 2025 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compat.h"
+#include "context.h"
+#include "in.h"
+#include "log.h"
+#include "ly_common.h"
+#include "parser_data.h"
+#include "plugins_types.h"
+#include "tree_data.h"
+
+/**
+ * @brief Pipeline message state.
+ */
+enum lyd_pipeline_state {
+    LYD_PIPE_QUEUED = 0,    /**< waiting to be parsed */
+    LYD_PIPE_PARSED,        /**< parsed, waiting to be validated */
+    LYD_PIPE_DONE           /**< processed, waiting to be delivered */
+};
+
+/**
+ * @brief Message in a pipeline.
+ */
+struct lyd_pipeline_msg {
+    struct ly_in *in;               /**< input of the message */
+    enum lyd_pipeline_state state;  /**< message state */
+    LY_ERR rc;                      /**< processing result */
+    struct ly_err_item *err;        /**< errors of a failed message */
+    struct lyd_node *tree;          /**< parsed data tree */
+    struct lyd_node *op;            /**< parsed operation node */
+};
+
+/**
+ * @brief Pipeline worker thread.
+ */
+struct lyd_pipeline_worker {
+    struct lyd_pipeline *pipeline;  /**< pipeline of the worker */
+    struct lyd_parser *parser;      /**< parser handle of a parse worker, NULL for a validate worker */
+    pthread_t tid;                  /**< thread ID */
+};
+
+struct lyd_pipeline {
+    const struct ly_ctx *ctx;       /**< context of the parsed data */
+    LYD_FORMAT format;              /**< format of the messages */
+    enum lyd_type data_type;        /**< type of the messages */
+    uint32_t parse_opts;            /**< parse options of YANG data messages */
+    uint32_t val_opts;              /**< validation options of YANG data messages */
+    lyd_pipeline_clb clb;           /**< message callback */
+    void *user_data;                /**< callback user data */
+
+    struct lyd_pipeline_worker *workers;    /**< worker threads, parse workers first */
+    uint32_t worker_count;          /**< number of all the workers */
+    uint32_t started_count;         /**< number of started worker threads */
+
+    pthread_mutex_t lock;           /**< lock for all the following members */
+    pthread_cond_t work_cond;       /**< signalled when there is new work for the workers or when stopping */
+    pthread_cond_t done_cond;       /**< signalled when a message is delivered */
+    struct lyd_pipeline_msg *msgs;  /**< ring buffer of the messages, indexed by sequence numbers */
+    uint64_t *val_queue;            /**< ring buffer of the sequence numbers of parsed messages to validate */
+    uint32_t size;                  /**< size of both ring buffers */
+    uint64_t head;                  /**< sequence number of the first message to deliver */
+    uint64_t parse_next;            /**< sequence number of the next message to parse */
+    uint64_t tail;                  /**< sequence number of the next pushed message */
+    uint64_t val_head;              /**< first item in the validation queue */
+    uint64_t val_tail;              /**< next item in the validation queue */
+    ly_bool delivering;             /**< whether some thread is delivering messages */
+    ly_bool stop;                   /**< whether the workers should terminate */
+};
+
+/**
+ * @brief Deliver all the processed messages in order, the lock is expected to be held.
+ *
+ * @param[in] pipeline Pipeline to use.
+ */
+static void
+lyd_pipeline_deliver(struct lyd_pipeline *pipeline)
+{
+    struct lyd_pipeline_msg *slot, msg;
+
+    if (pipeline->delivering) {
+        /* the delivering thread will deliver our messages, too */
+        return;
+    }
+
+    pipeline->delivering = 1;
+    while (pipeline->head < pipeline->tail) {
+        slot = &pipeline->msgs[pipeline->head % pipeline->size];
+        if (slot->state != LYD_PIPE_DONE) {
+            break;
+        }
+        msg = *slot;
+
+        /* UNLOCK */
+        pthread_mutex_unlock(&pipeline->lock);
+
+        pipeline->clb(msg.in, msg.rc, msg.err, msg.tree, msg.op, pipeline->user_data);
+        ly_err_free(msg.err);
+
+        /* LOCK */
+        pthread_mutex_lock(&pipeline->lock);
+
+        /* the slot can be reused now */
+        ++pipeline->head;
+        pthread_cond_broadcast(&pipeline->done_cond);
+    }
+    pipeline->delivering = 0;
+}
+
+/**
+ * @brief Free the parsed trees of a failed message.
+ *
+ * @param[in,out] msg Message with the trees to free.
+ */
+static void
+lyd_pipeline_msg_free_trees(struct lyd_pipeline_msg *msg)
+{
+    struct lyd_node *op_top;
+
+    if (msg->op) {
+        /* the operation of a NETCONF or RESTCONF message is in a separate tree */
+        for (op_top = msg->op; op_top->parent; op_top = lyd_parent(op_top)) {}
+        if (op_top != msg->tree) {
+            lyd_free_all(op_top);
+        }
+    }
+    lyd_free_all(msg->tree);
+    msg->tree = NULL;
+    msg->op = NULL;
+}
+
+/**
+ * @brief Parse a message.
+ *
+ * @param[in] pipeline Pipeline to use.
+ * @param[in] parser Parser handle to use.
+ * @param[in,out] msg Message to parse.
+ */
+static void
+lyd_pipeline_parse(const struct lyd_pipeline *pipeline, struct lyd_parser *parser, struct lyd_pipeline_msg *msg)
+{
+    if (pipeline->data_type == LYD_TYPE_DATA_YANG) {
+        msg->rc = lyd_parser_parse_data(parser, NULL, msg->in, pipeline->format, pipeline->parse_opts | LYD_PARSE_ONLY, 0,
+                &msg->tree);
+    } else {
+        msg->rc = lyd_parser_parse_op(parser, NULL, msg->in, pipeline->format, pipeline->data_type, &msg->tree, &msg->op);
+    }
+}
+
+/**
+ * @brief Validate a parsed message.
+ *
+ * @param[in] pipeline Pipeline to use.
+ * @param[in,out] msg Message to validate.
+ */
+static void
+lyd_pipeline_validate(const struct lyd_pipeline *pipeline, struct lyd_pipeline_msg *msg)
+{
+    switch (pipeline->data_type) {
+    case LYD_TYPE_DATA_YANG:
+        msg->rc = lyd_validate_all(&msg->tree, pipeline->ctx, pipeline->val_opts, NULL);
+        break;
+    case LYD_TYPE_RPC_YANG:
+    case LYD_TYPE_RPC_NETCONF:
+        msg->rc = lyd_validate_op(msg->op, NULL, LYD_TYPE_RPC_YANG, NULL);
+        break;
+    default:
+        msg->rc = lyd_validate_op(msg->op, NULL, LYD_TYPE_NOTIF_YANG, NULL);
+        break;
+    }
+}
+
+/**
+ * @brief Pipeline worker thread parsing or validating messages.
+ *
+ * @param[in] arg Pipeline worker structure.
+ * @return NULL.
+ */
+static void *
+lyd_pipeline_worker(void *arg)
+{
+    struct lyd_pipeline_worker *worker = arg;
+    struct lyd_pipeline *pipeline = worker->pipeline;
+    struct lyd_pipeline_msg *msg;
+    uint64_t seq;
+    uint32_t temp_lo = LY_LOSTORE, *prev_lo;
+
+    /* errors are only stored and passed to the callback */
+    prev_lo = ly_temp_log_options(&temp_lo);
+
+    /* LOCK */
+    pthread_mutex_lock(&pipeline->lock);
+
+    while (1) {
+        /* get the next message to process */
+        if (worker->parser && (pipeline->parse_next < pipeline->tail)) {
+            seq = pipeline->parse_next++;
+        } else if (!worker->parser && (pipeline->val_head < pipeline->val_tail)) {
+            seq = pipeline->val_queue[pipeline->val_head++ % pipeline->size];
+        } else if (pipeline->stop) {
+            break;
+        } else {
+            pthread_cond_wait(&pipeline->work_cond, &pipeline->lock);
+            continue;
+        }
+        msg = &pipeline->msgs[seq % pipeline->size];
+
+        /* UNLOCK */
+        pthread_mutex_unlock(&pipeline->lock);
+
+        if (worker->parser) {
+            lyd_pipeline_parse(pipeline, worker->parser, msg);
+        } else {
+            lyd_pipeline_validate(pipeline, msg);
+        }
+        if (msg->rc) {
+            /* keep the errors of the message, the trees are not passed to the callback */
+            msg->err = ly_err_take(pipeline->ctx);
+            lyd_pipeline_msg_free_trees(msg);
+        } else {
+            /* discard any warnings */
+            ly_err_free(ly_err_take(pipeline->ctx));
+        }
+
+        /* LOCK */
+        pthread_mutex_lock(&pipeline->lock);
+
+        if (worker->parser && !msg->rc && !(pipeline->parse_opts & LYD_PARSE_ONLY)) {
+            /* pass to the validate workers */
+            msg->state = LYD_PIPE_PARSED;
+            pipeline->val_queue[pipeline->val_tail++ % pipeline->size] = seq;
+            pthread_cond_broadcast(&pipeline->work_cond);
+        } else {
+            msg->state = LYD_PIPE_DONE;
+            lyd_pipeline_deliver(pipeline);
+        }
+    }
+
+    /* UNLOCK */
+    pthread_mutex_unlock(&pipeline->lock);
+
+    ly_temp_log_options(prev_lo);
+    return NULL;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_pipeline_new(const struct ly_ctx *ctx, LYD_FORMAT format, enum lyd_type data_type, uint32_t parse_options,
+        uint32_t validate_options, uint32_t parse_threads, uint32_t validate_threads, uint32_t queue_size,
+        lyd_pipeline_clb clb, void *user_data, struct lyd_pipeline **pipeline)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_pipeline *pl;
+    struct lyd_pipeline_worker *worker;
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(ctx, ctx, format, clb, pipeline, LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, parse_threads, validate_threads, queue_size, LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, (data_type == LYD_TYPE_DATA_YANG) || (data_type == LYD_TYPE_RPC_YANG) ||
+            (data_type == LYD_TYPE_NOTIF_YANG) || (data_type == LYD_TYPE_RPC_NETCONF) ||
+            (data_type == LYD_TYPE_NOTIF_NETCONF) || (data_type == LYD_TYPE_NOTIF_RESTCONF), LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), !(validate_options & ~LYD_VALIDATE_OPTS_MASK),
+            (data_type == LYD_TYPE_DATA_YANG) || (!parse_options && !validate_options), LY_EINVAL);
+
+    *pipeline = NULL;
+
+    pl = calloc(1, sizeof *pl);
+    LY_CHECK_ERR_RET(!pl, LOGMEM(ctx), LY_EMEM);
+    pl->ctx = ctx;
+    pl->format = format;
+    pl->data_type = data_type;
+    pl->parse_opts = parse_options;
+    pl->val_opts = validate_options;
+    pl->clb = clb;
+    pl->user_data = user_data;
+    pthread_mutex_init(&pl->lock, NULL);
+    pthread_cond_init(&pl->work_cond, NULL);
+    pthread_cond_init(&pl->done_cond, NULL);
+
+    /* queues */
+    pl->size = queue_size;
+    pl->msgs = calloc(queue_size, sizeof *pl->msgs);
+    pl->val_queue = malloc(queue_size * sizeof *pl->val_queue);
+    pl->workers = calloc(parse_threads + validate_threads, sizeof *pl->workers);
+    LY_CHECK_ERR_GOTO(!pl->msgs || !pl->val_queue || !pl->workers, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+
+    /* parser handles */
+    for (i = 0; i < parse_threads; ++i) {
+        LY_CHECK_GOTO(rc = lyd_parser_new(ctx, &pl->workers[i].parser), cleanup);
+    }
+
+    /* worker threads */
+    pl->worker_count = parse_threads + validate_threads;
+    for (i = 0; i < pl->worker_count; ++i) {
+        worker = &pl->workers[i];
+        worker->pipeline = pl;
+        if (pthread_create(&worker->tid, NULL, lyd_pipeline_worker, worker)) {
+            LOGERR(ctx, LY_ESYS, "Creating a pipeline thread failed.");
+            rc = LY_ESYS;
+            goto cleanup;
+        }
+        ++pl->started_count;
+    }
+
+cleanup:
+    if (rc) {
+        lyd_pipeline_free(pl);
+    } else {
+        *pipeline = pl;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_pipeline_push(struct lyd_pipeline *pipeline, struct ly_in *in)
+{
+    struct lyd_pipeline_msg *msg;
+
+    LY_CHECK_ARG_RET(NULL, pipeline, in, LY_EINVAL);
+
+    /* LOCK */
+    pthread_mutex_lock(&pipeline->lock);
+
+    /* wait for a free slot */
+    while (pipeline->tail - pipeline->head == pipeline->size) {
+        pthread_cond_wait(&pipeline->done_cond, &pipeline->lock);
+    }
+
+    msg = &pipeline->msgs[pipeline->tail % pipeline->size];
+    memset(msg, 0, sizeof *msg);
+    msg->in = in;
+    ++pipeline->tail;
+    pthread_cond_broadcast(&pipeline->work_cond);
+
+    /* UNLOCK */
+    pthread_mutex_unlock(&pipeline->lock);
+
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF void
+lyd_pipeline_flush(struct lyd_pipeline *pipeline)
+{
+    if (!pipeline) {
+        return;
+    }
+
+    /* LOCK */
+    pthread_mutex_lock(&pipeline->lock);
+
+    while (pipeline->head < pipeline->tail) {
+        pthread_cond_wait(&pipeline->done_cond, &pipeline->lock);
+    }
+
+    /* UNLOCK */
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+LIBYANG_API_DEF void
+lyd_pipeline_free(struct lyd_pipeline *pipeline)
+{
+    uint32_t i;
+
+    if (!pipeline) {
+        return;
+    }
+
+    if (pipeline->started_count) {
+        /* process all the pushed messages */
+        lyd_pipeline_flush(pipeline);
+    }
+
+    /* stop all the workers */
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->stop = 1;
+    pthread_cond_broadcast(&pipeline->work_cond);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    for (i = 0; i < pipeline->started_count; ++i) {
+        pthread_join(pipeline->workers[i].tid, NULL);
+    }
+
+    if (pipeline->workers) {
+        for (i = 0; i < pipeline->worker_count; ++i) {
+            lyd_parser_free(pipeline->workers[i].parser);
+        }
+    }
+    free(pipeline->workers);
+    free(pipeline->msgs);
+    free(pipeline->val_queue);
+    pthread_mutex_destroy(&pipeline->lock);
+    pthread_cond_destroy(&pipeline->work_cond);
+    pthread_cond_destroy(&pipeline->done_cond);
+    free(pipeline);
+}
@@ -53,6 +53,90 @@ lyd_xml_ctx_free(struct lyd_ctx *lydctx)
     free(ctx);
 }
 
+/**
+ * @brief Reset a pooled XML data parser context.
+ *
+ * Implementation of ::lyd_ctx_free_clb for contexts created by ::lyd_xml_ctx_new_pooled().
+ */
+static void
+lyd_xml_ctx_reset(struct lyd_ctx *lydctx)
+{
+    struct lyd_xml_ctx *ctx = (struct lyd_xml_ctx *)lydctx;
+
+    lyd_ctx_reset(lydctx);
+    lyxml_ctx_reset(ctx->xmlctx);
+}
+
+LY_ERR
+lyd_xml_ctx_new_pooled(const struct ly_ctx *ctx, struct lyd_ctx **lydctx_p)
+{
+    struct lyd_xml_ctx *lydctx;
+
+    lydctx = calloc(1, sizeof *lydctx);
+    LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
+    lydctx->xmlctx = calloc(1, sizeof *lydctx->xmlctx);
+    LY_CHECK_ERR_RET(!lydctx->xmlctx, free(lydctx); LOGMEM(ctx), LY_EMEM);
+    lydctx->free = lyd_xml_ctx_reset;
+
+    *lydctx_p = (struct lyd_ctx *)lydctx;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Initialize XML data parser context, either a new one or a pooled one.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] in Input structure.
+ * @param[in] parse_opts Options for parser, see @ref dataparseroptions.
+ * @param[in] val_opts Options for the validation phase, see @ref datavalidationoptions.
+ * @param[in,out] lydctx_p Pooled data parser context to reuse, if any, is always set to NULL.
+ * @param[out] lydctx Initialized data parser context.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_xml_ctx_init(const struct ly_ctx *ctx, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts,
+        struct lyd_ctx **lydctx_p, struct lyd_xml_ctx **lydctx)
+{
+    LY_ERR rc;
+
+    if (*lydctx_p) {
+        /* reuse the pooled context */
+        *lydctx = (struct lyd_xml_ctx *)*lydctx_p;
+        *lydctx_p = NULL;
+        LY_CHECK_RET(lyxml_ctx_renew((*lydctx)->xmlctx, ctx, in));
+    } else {
+        *lydctx = calloc(1, sizeof **lydctx);
+        LY_CHECK_ERR_RET(!*lydctx, LOGMEM(ctx), LY_EMEM);
+        (*lydctx)->free = lyd_xml_ctx_free;
+        if ((rc = lyxml_ctx_new(ctx, in, &(*lydctx)->xmlctx))) {
+            free(*lydctx);
+            return rc;
+        }
+    }
+    (*lydctx)->parse_opts = parse_opts;
+    (*lydctx)->val_opts = val_opts;
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Finish parsing with an XML data parser context that is kept for validation, the XML context is no more needed.
+ *
+ * @param[in] lydctx Data parser context.
+ */
+static void
+lyd_xml_ctx_finish(struct lyd_xml_ctx *lydctx)
+{
+    /* freeing the XML context also stops logging line numbers which would be confusing now */
+    if (lydctx->free == lyd_xml_ctx_reset) {
+        /* keep the XML context of the pooled context */
+        lyxml_ctx_reset(lydctx->xmlctx);
+    } else {
+        lyxml_ctx_free(lydctx->xmlctx);
+        lydctx->xmlctx = NULL;
+    }
+}
+
 /**
  * @brief Log namespace error.
  *
@@ -871,6 +955,12 @@ lydxml_subtree_inner(struct lyd_xml_ctx *lydctx, const struct lysc_node *snode,
         LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
     }
 
+    if (LYD_PARSER_INSERT_ORDER(lydctx->parse_opts) == LYD_INSERT_NODE_BULK) {
+        /* sort and hash the children */
+        r = lyd_insert_bulk_finish(*node, NULL);
+        LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+    }
+
     if (!(lydctx->parse_opts & LYD_PARSE_ONLY) && !rc) {
         /* new node validation */
         r = lyd_parser_validate_new_implicit((struct lyd_ctx *)lydctx, *node);
@@ -952,7 +1042,7 @@ lydxml_subtree_any(struct lyd_xml_ctx *lydctx, const struct lysc_node *snode, co
         LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
 
         /* update options so that generic data can be parsed */
-        lydctx->parse_opts &= ~LYD_PARSE_STRICT;
+        lydctx->parse_opts &= ~(LYD_PARSE_STRICT | LYD_PARSE_BULK);
         lydctx->parse_opts |= LYD_PARSE_OPAQ | (ext ? LYD_PARSE_ONLY : 0);
         lydctx->int_opts |= LYD_INTOPT_ANY | LYD_INTOPT_WITH_SIBLINGS;
 
@@ -1142,7 +1232,7 @@ node_parsed:
         LY_CHECK_ERR_GOTO(r, rc = r; lyd_free_tree(node), cleanup);
     } else {
         lyd_insert_node(parent, first_p, node,
-                lydctx->parse_opts & LYD_PARSE_ORDERED ? LYD_INSERT_NODE_LAST : LYD_INSERT_NODE_DEFAULT);
+                LYD_PARSER_INSERT_ORDER(lydctx->parse_opts));
     }
     while (!parent && (*first_p)->prev->next) {
         *first_p = (*first_p)->prev;
@@ -1254,13 +1344,8 @@ lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, str
     assert(!(val_opts & ~LYD_VALIDATE_OPTS_MASK));
 
     /* init context */
-    lydctx = calloc(1, sizeof *lydctx);
-    LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
-    LY_CHECK_GOTO(rc = lyxml_ctx_new(ctx, in, &lydctx->xmlctx), cleanup);
-    lydctx->parse_opts = parse_opts;
-    lydctx->val_opts = val_opts;
+    LY_CHECK_RET(lyd_xml_ctx_init(ctx, in, parse_opts, val_opts, lydctx_p, &lydctx));
     lydctx->int_opts = int_opts;
-    lydctx->free = lyd_xml_ctx_free;
     lydctx->ext = ext;
 
     /* find the operation node if it exists already */
@@ -1333,13 +1418,12 @@ cleanup:
 
     lyd_free_tree(act);
     if (rc && (!(lydctx->val_opts & LYD_VALIDATE_MULTI_ERROR) || (rc != LY_EVALID))) {
-        lyd_xml_ctx_free((struct lyd_ctx *)lydctx);
+        lydctx->free((struct lyd_ctx *)lydctx);
     } else {
         *lydctx_p = (struct lyd_ctx *)lydctx;
 
-        /* the XML context is no more needed, freeing it also stops logging line numbers which would be confusing now */
-        lyxml_ctx_free(lydctx->xmlctx);
-        lydctx->xmlctx = NULL;
+        /* the XML context is no more needed */
+        lyd_xml_ctx_finish(lydctx);
     }
     return rc;
 }
@@ -1499,12 +1583,7 @@ lyd_parse_xml_netconf(const struct ly_ctx *ctx, const struct lysc_ext_instance *
     assert(!(parse_opts & LYD_PARSE_SUBTREE));
 
     /* init context */
-    lydctx = calloc(1, sizeof *lydctx);
-    LY_CHECK_ERR_RET(!lydctx, LOGMEM(ctx), LY_EMEM);
-    LY_CHECK_GOTO(rc = lyxml_ctx_new(ctx, in, &lydctx->xmlctx), cleanup);
-    lydctx->parse_opts = parse_opts;
-    lydctx->val_opts = val_opts;
-    lydctx->free = lyd_xml_ctx_free;
+    LY_CHECK_RET(lyd_xml_ctx_init(ctx, in, parse_opts, val_opts, lydctx_p, &lydctx));
     lydctx->ext = ext;
 
     switch (data_type) {
@@ -1636,13 +1715,12 @@ cleanup:
             !lydctx->node_when.count));
 
     if (rc) {
-        lyd_xml_ctx_free((struct lyd_ctx *)lydctx);
+        lydctx->free((struct lyd_ctx *)lydctx);
     } else {
         *lydctx_p = (struct lyd_ctx *)lydctx;
 
-        /* the XML context is no more needed, freeing it also stops logging line numbers which would be confusing now */
-        lyxml_ctx_free(lydctx->xmlctx);
-        lydctx->xmlctx = NULL;
+        /* the XML context is no more needed */
+        lyd_xml_ctx_finish(lydctx);
     }
     return rc;
 }
@@ -967,7 +967,7 @@ ly_path_dup_predicates(const struct ly_ctx *ctx, const struct ly_path_predicate
     LY_ARRAY_CREATE_RET(ctx, *dup, LY_ARRAY_COUNT(pred), LY_EMEM);
     LY_ARRAY_FOR(pred, u) {
         LY_ARRAY_INCREMENT(*dup);
-        (*dup)[u].type = pred->type;
+        (*dup)[u].type = pred[u].type;
 
         switch (pred[u].type) {
         case LY_PATH_PREDTYPE_POSITION:
@@ -1467,6 +1467,53 @@ ly_path_dup(const struct ly_ctx *ctx, const struct ly_path *path, struct ly_path
     return LY_SUCCESS;
 }
 
+LY_ERR
+ly_path_dup_bind(const struct ly_ctx *ctx, const struct ly_path *path, const struct lyxp_var *vars, struct ly_path **dup)
+{
+    LY_ERR rc;
+    LY_ARRAY_COUNT_TYPE u, v;
+    struct ly_path_predicate *pred;
+    struct lyxp_var *var;
+    struct lyd_value val;
+
+    *dup = NULL;
+    LY_CHECK_GOTO(rc = ly_path_dup(ctx, path, dup), cleanup);
+
+    LY_ARRAY_FOR(*dup, u) {
+        LY_ARRAY_FOR((*dup)[u].predicates, v) {
+            pred = &(*dup)[u].predicates[v];
+            if (pred->type != LY_PATH_PREDTYPE_LIST_VAR) {
+                continue;
+            }
+
+            /* find the var */
+            LY_CHECK_GOTO(rc = lyxp_vars_find(ctx, vars, pred->variable, 0, &var), cleanup);
+
+            /* store the value */
+            LOG_LOCSET(pred->key, NULL);
+            rc = lyd_value_store(ctx, &val, ((struct lysc_node_leaf *)pred->key)->type, var->value, strlen(var->value),
+                    0, 0, NULL, LY_VALUE_JSON, NULL, LYD_HINT_DATA, pred->key, NULL);
+            LOG_LOCBACK(1, 0);
+            LY_CHECK_GOTO(rc, cleanup);
+
+            /* "allocate" the type to avoid problems when freeing the value after the type was freed */
+            LY_ATOMIC_INC_BARRIER(((struct lysc_type *)val.realtype)->refcount);
+
+            /* replace the variable with the value */
+            free(pred->variable);
+            pred->type = LY_PATH_PREDTYPE_LIST;
+            pred->value = val;
+        }
+    }
+
+cleanup:
+    if (rc) {
+        ly_path_free(*dup);
+        *dup = NULL;
+    }
+    return rc;
+}
+
 void
 ly_path_predicates_free(const struct ly_ctx *ctx, struct ly_path_predicate *predicates)
 {
@@ -265,6 +265,18 @@ LY_ERR ly_path_eval(const struct ly_path *path, const struct lyd_node *start, co
  */
 LY_ERR ly_path_dup(const struct ly_ctx *ctx, const struct ly_path *path, struct ly_path **dup);
 
+/**
+ * @brief Duplicate ly_path structure and replace all the variables in its predicates by their values.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] path Path to duplicate.
+ * @param[in] vars Array of defined variables to use in predicates, may be NULL.
+ * @param[out] dup Duplicated path without any ::LY_PATH_PREDTYPE_LIST_VAR predicates.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_path_dup_bind(const struct ly_ctx *ctx, const struct ly_path *path, const struct lyxp_var *vars,
+        struct ly_path **dup);
+
 /**
  * @brief Free ly_path_predicate structure.
  *
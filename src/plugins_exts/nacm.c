@@ -13,13 +13,20 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
+#define _GNU_SOURCE /* strdup */
+
+#include "nacm.h"
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "compat.h"
+#include "hash_table.h"
 #include "libyang.h"
+#include "ly_common.h"
 #include "plugins_exts.h"
+#include "tree_edit.h"
 
 struct nacm_dfs_arg {
     struct lysc_ext_instance *ext;
@@ -146,6 +153,880 @@ nacm_compile(struct lysc_ctx *UNUSED(cctx), const struct lysp_ext_instance *UNUS
     return lysc_tree_dfs_full(ext->parent, nacm_inherit_clb, &dfs_arg);
 }
 
+/* count of the NACM access operations */
+#define LYD_NACM_OP_COUNT 5
+
+/* no rule index */
+#define LYD_NACM_NO_RULE UINT32_MAX
+
+/* all the NACM access operations */
+#define LYD_NACM_ALL (LYD_NACM_CREATE | LYD_NACM_READ | LYD_NACM_UPDATE | LYD_NACM_DELETE | LYD_NACM_EXEC)
+
+/**
+ * @brief Types of the NACM rules.
+ */
+enum lyd_nacm_rule_type {
+    LYD_NACM_RULE_ANY,          /**< no rule-type, matches all the nodes */
+    LYD_NACM_RULE_RPC,          /**< protocol-operation, matches RPCs */
+    LYD_NACM_RULE_NOTIF,        /**< notification, matches notifications */
+    LYD_NACM_RULE_DATA_ALL,     /**< data-node with path "/", matches all the data nodes */
+    LYD_NACM_RULE_DATA          /**< data-node, matches the path targets and their descendants */
+};
+
+/**
+ * @brief Compiled NACM rule.
+ */
+struct lyd_nacm_rule {
+    char *module;               /**< module name, NULL for any */
+    char *name;                 /**< RPC or notification name, NULL for any */
+    char *path;                 /**< data path with predicates, evaluated on data trees; NULL if schema nodes suffice */
+    enum lyd_nacm_rule_type type;   /**< rule type */
+    uint8_t ops;                /**< access operations of the rule */
+    ly_bool permit;             /**< rule action */
+};
+
+/**
+ * @brief Compiled NACM rules for a schema node, record of ::lyd_nacm.snodes.
+ */
+struct lyd_nacm_snode {
+    const struct lysc_node *snode;  /**< schema node */
+    uint8_t permit;             /**< access operations permitted by the schema-level decision */
+    uint8_t cond;               /**< access operations with a rule with a data path preceding the schema-level decision */
+    uint32_t limit[LYD_NACM_OP_COUNT];  /**< index of the rule deciding every access operation, ::LYD_NACM_NO_RULE
+                                        if decided by the defaults */
+};
+
+struct lyd_nacm {
+    const struct ly_ctx *ctx;   /**< context of the compiled schema nodes */
+    ly_bool enabled;            /**< whether NACM is enabled at all */
+    uint8_t dflt_permit;        /**< access operations permitted by the read, write, and exec defaults */
+    struct lyd_nacm_rule *rules;    /**< applicable rules in the order of evaluation ([sized array](@ref sizedarrays)) */
+    ly_bool has_path;           /**< whether there are any rules with a data path */
+    struct ly_ht *snodes;       /**< compiled schema nodes with any matching rule, ::lyd_nacm_snode records */
+    char **unresolved;          /**< names of the deny rules with a data path not matching any schema node, they
+                                     match no data ([sized array](@ref sizedarrays)) */
+};
+
+/**
+ * @brief Rule indices of a schema or data node, record of the hash tables used while compiling and checking.
+ */
+struct lyd_nacm_idx {
+    const void *node;           /**< schema or data node */
+    uint32_t *idx;              /**< rule indices ([sized array](@ref sizedarrays)) */
+};
+
+/**
+ * @brief Hash table equal callback for records with a node pointer as the first member.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+nacm_ptr_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return *(void **)val1_p == *(void **)val2_p;
+}
+
+/**
+ * @brief Hash of a node pointer.
+ */
+static uint32_t
+nacm_ptr_hash(const void *ptr)
+{
+    return lyht_hash((const char *)&ptr, sizeof ptr);
+}
+
+/**
+ * @brief Free a rule indices record.
+ */
+static void
+nacm_idx_free(void *val_p)
+{
+    struct lyd_nacm_idx *rec = val_p;
+
+    LY_ARRAY_FREE(rec->idx);
+}
+
+/**
+ * @brief Add a rule index for a node.
+ *
+ * @param[in] ht Hash table of ::lyd_nacm_idx records.
+ * @param[in] node Node of the rule.
+ * @param[in] idx Index of the rule.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+nacm_idx_add(struct ly_ht *ht, const void *node, uint32_t idx)
+{
+    struct lyd_nacm_idx rec = {.node = node}, *match;
+    uint32_t hash = nacm_ptr_hash(node), *new_idx;
+
+    if (lyht_find(ht, &rec, hash, (void **)&match)) {
+        if (lyht_insert(ht, &rec, hash, (void **)&match)) {
+            return LY_EMEM;
+        }
+    }
+
+    LY_ARRAY_NEW_RET(NULL, match->idx, new_idx, LY_EMEM);
+    *new_idx = idx;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Get rule indices of a node.
+ *
+ * @param[in] ht Hash table of ::lyd_nacm_idx records.
+ * @param[in] node Node of the rules.
+ * @return Rule indices ([sized array](@ref sizedarrays)), NULL if none.
+ */
+static const uint32_t *
+nacm_idx_get(const struct ly_ht *ht, const void *node)
+{
+    struct lyd_nacm_idx rec = {.node = node}, *match;
+
+    if (!ht || lyht_find(ht, &rec, nacm_ptr_hash(node), (void **)&match)) {
+        return NULL;
+    }
+    return match->idx;
+}
+
+/**
+ * @brief Get the index of an access operation.
+ */
+static uint32_t
+nacm_op_idx(uint8_t op)
+{
+    uint32_t i;
+
+    for (i = 0; !(op & (1 << i)); ++i) {}
+    return i;
+}
+
+/**
+ * @brief Check whether a rule matches the module of a node.
+ */
+static ly_bool
+nacm_rule_match_mod(const struct lyd_nacm_rule *rule, const struct lysc_node *snode)
+{
+    return !rule->module || !strcmp(rule->module, snode->module->name);
+}
+
+/**
+ * @brief Learn the access operations permitted by the defaults for a schema node.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] snode Schema node.
+ * @return Permitted access operations.
+ */
+static uint8_t
+nacm_snode_dflt(const struct lyd_nacm *nacm, const struct lysc_node *snode)
+{
+    LY_ARRAY_COUNT_TYPE u;
+    uint8_t permit = nacm->dflt_permit;
+
+    /* the extension instances are inherited by the descendants */
+    LY_ARRAY_FOR(snode->exts, u) {
+        if (strcmp(snode->exts[u].def->module->name, "ietf-netconf-acm")) {
+            continue;
+        }
+
+        if (!strcmp(snode->exts[u].def->name, "default-deny-all")) {
+            permit = 0;
+        } else if (!strcmp(snode->exts[u].def->name, "default-deny-write")) {
+            permit &= ~(LYD_NACM_CREATE | LYD_NACM_UPDATE | LYD_NACM_DELETE);
+        }
+    }
+
+    return permit;
+}
+
+/**
+ * @brief Compile the rules for a schema node and all its descendants.
+ *
+ * @param[in] nacm Compiled NACM rules to add to.
+ * @param[in] targets Hash table with the data rule indices of their target schema nodes.
+ * @param[in] snode Schema node to compile.
+ * @param[in] inh Data rule indices inherited from the ancestors ([sized array](@ref sizedarrays)).
+ * @return LY_ERR value.
+ */
+static LY_ERR
+nacm_compile_snode_r(struct lyd_nacm *nacm, const struct ly_ht *targets, const struct lysc_node *snode,
+        const uint32_t *inh)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_nacm_snode rec = {.snode = snode};
+    const struct lyd_nacm_rule *rule;
+    const uint32_t *tgt;
+    uint32_t *idx = NULL, *new_idx, i, cmin[LYD_NACM_OP_COUNT];
+    const struct lysc_node *child;
+    LY_ARRAY_COUNT_TYPE u;
+    ly_bool match, stored = 0;
+    uint8_t dflt;
+
+    /* data rules of this node */
+    tgt = nacm_idx_get(targets, snode);
+    if (tgt) {
+        LY_ARRAY_CREATE_RET(NULL, idx, LY_ARRAY_COUNT(inh) + LY_ARRAY_COUNT(tgt), LY_EMEM);
+        LY_ARRAY_FOR(inh, u) {
+            LY_ARRAY_NEW_GOTO(NULL, idx, new_idx, rc, cleanup);
+            *new_idx = inh[u];
+        }
+        LY_ARRAY_FOR(tgt, u) {
+            LY_ARRAY_NEW_GOTO(NULL, idx, new_idx, rc, cleanup);
+            *new_idx = tgt[u];
+        }
+        inh = idx;
+    }
+
+    for (i = 0; i < LYD_NACM_OP_COUNT; ++i) {
+        rec.limit[i] = LYD_NACM_NO_RULE;
+        cmin[i] = LYD_NACM_NO_RULE;
+    }
+
+    /* the first matching rule without a target decides */
+    LY_ARRAY_FOR(nacm->rules, u) {
+        rule = &nacm->rules[u];
+        if (!nacm_rule_match_mod(rule, snode)) {
+            continue;
+        }
+
+        switch (rule->type) {
+        case LYD_NACM_RULE_ANY:
+            match = 1;
+            break;
+        case LYD_NACM_RULE_RPC:
+            match = (snode->nodetype == LYS_RPC) && (!rule->name || !strcmp(rule->name, snode->name));
+            break;
+        case LYD_NACM_RULE_NOTIF:
+            match = (snode->nodetype == LYS_NOTIF) && (!rule->name || !strcmp(rule->name, snode->name));
+            break;
+        case LYD_NACM_RULE_DATA_ALL:
+            match = snode->parent || !(snode->nodetype & (LYS_RPC | LYS_NOTIF));
+            break;
+        case LYD_NACM_RULE_DATA:
+        default:
+            /* handled below */
+            match = 0;
+            break;
+        }
+        if (!match) {
+            continue;
+        }
+
+        for (i = 0; i < LYD_NACM_OP_COUNT; ++i) {
+            if ((rule->ops & (1 << i)) && (rec.limit[i] == LYD_NACM_NO_RULE)) {
+                rec.limit[i] = u;
+            }
+        }
+    }
+
+    /* the data rules targeting this node or its ancestors */
+    LY_ARRAY_FOR(inh, u) {
+        rule = &nacm->rules[inh[u]];
+        if (!nacm_rule_match_mod(rule, snode)) {
+            continue;
+        }
+
+        for (i = 0; i < LYD_NACM_OP_COUNT; ++i) {
+            if (!(rule->ops & (1 << i))) {
+                continue;
+            }
+
+            if (rule->path) {
+                /* decided only for specific data nodes */
+                if (inh[u] < cmin[i]) {
+                    cmin[i] = inh[u];
+                }
+            } else if (inh[u] < rec.limit[i]) {
+                rec.limit[i] = inh[u];
+            }
+        }
+    }
+
+    /* permitted operations */
+    dflt = nacm_snode_dflt(nacm, snode);
+    for (i = 0; i < LYD_NACM_OP_COUNT; ++i) {
+        if (rec.limit[i] != LYD_NACM_NO_RULE) {
+            stored = 1;
+            if (nacm->rules[rec.limit[i]].permit) {
+                rec.permit |= (1 << i);
+            }
+        } else if (dflt & (1 << i)) {
+            rec.permit |= (1 << i);
+        }
+
+        if (cmin[i] < rec.limit[i]) {
+            stored = 1;
+            rec.cond |= (1 << i);
+        }
+    }
+
+    if (stored && lyht_insert(nacm->snodes, &rec, nacm_ptr_hash(snode), NULL)) {
+        rc = LY_EMEM;
+        goto cleanup;
+    }
+
+    /* descendants */
+    LY_LIST_FOR(lysc_node_child(snode), child) {
+        LY_CHECK_GOTO(rc = nacm_compile_snode_r(nacm, targets, child, inh), cleanup);
+    }
+    LY_LIST_FOR((const struct lysc_node *)lysc_node_actions(snode), child) {
+        LY_CHECK_GOTO(rc = nacm_compile_snode_r(nacm, targets, child, inh), cleanup);
+    }
+    LY_LIST_FOR((const struct lysc_node *)lysc_node_notifs(snode), child) {
+        LY_CHECK_GOTO(rc = nacm_compile_snode_r(nacm, targets, child, inh), cleanup);
+    }
+
+cleanup:
+    LY_ARRAY_FREE(idx);
+    return rc;
+}
+
+/**
+ * @brief Get the value of a child term node.
+ *
+ * @param[in] parent Parent node.
+ * @param[in] name Name of the child.
+ * @param[in] dflt Value to return if there is no such child.
+ * @return Value of the child.
+ */
+static const char *
+nacm_child_value(const struct lyd_node *parent, const char *name, const char *dflt)
+{
+    const struct lyd_node *node;
+
+    LY_LIST_FOR(lyd_child(parent), node) {
+        if (node->schema && !strcmp(node->schema->name, name)) {
+            return lyd_get_value(node);
+        }
+    }
+
+    return dflt;
+}
+
+/**
+ * @brief Check whether a leaf-list child of a node has a value.
+ *
+ * @param[in] parent Parent node.
+ * @param[in] name Name of the leaf-list.
+ * @param[in] value Value to look for.
+ * @return Whether the value was found.
+ */
+static ly_bool
+nacm_child_llist_has(const struct lyd_node *parent, const char *name, const char *value)
+{
+    const struct lyd_node *node;
+
+    LY_LIST_FOR(lyd_child(parent), node) {
+        if (node->schema && !strcmp(node->schema->name, name) && !strcmp(lyd_get_value(node), value)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Check whether a rule-list applies to the groups of a user.
+ *
+ * @param[in] rlist Rule-list node.
+ * @param[in] groups Set of the group names of the user.
+ * @return Whether the rule-list applies.
+ */
+static ly_bool
+nacm_rlist_match(const struct lyd_node *rlist, const struct ly_set *groups)
+{
+    uint32_t i;
+
+    if (nacm_child_llist_has(rlist, "group", "*")) {
+        return 1;
+    }
+    for (i = 0; i < groups->count; ++i) {
+        if (nacm_child_llist_has(rlist, "group", groups->objs[i])) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Compile a single rule.
+ *
+ * @param[in] nacm Compiled NACM rules to add to.
+ * @param[in] rule_node Rule node.
+ * @param[in] targets Hash table with the data rule indices of their target schema nodes to add to.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+nacm_compile_rule(struct lyd_nacm *nacm, const struct lyd_node *rule_node, struct ly_ht *targets)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_nacm_rule *rule;
+    const char *str, *path = NULL, *rule_name;
+    const char *bits[] = {"create", "read", "update", "delete", "exec"};
+    struct ly_set *set = NULL;
+    uint32_t i, temp_lo = 0, *prev_lo, idx;
+    size_t len;
+    char **unresolved;
+
+    LY_ARRAY_NEW_RET(nacm->ctx, nacm->rules, rule, LY_EMEM);
+    idx = LY_ARRAY_COUNT(nacm->rules) - 1;
+
+    /* module-name */
+    str = nacm_child_value(rule_node, "module-name", "*");
+    if (strcmp(str, "*")) {
+        rule->module = strdup(str);
+        LY_CHECK_ERR_RET(!rule->module, LOGMEM(nacm->ctx), LY_EMEM);
+    }
+
+    /* rule-type */
+    rule->type = LYD_NACM_RULE_ANY;
+    if ((str = nacm_child_value(rule_node, "rpc-name", NULL))) {
+        rule->type = LYD_NACM_RULE_RPC;
+    } else if ((str = nacm_child_value(rule_node, "notification-name", NULL))) {
+        rule->type = LYD_NACM_RULE_NOTIF;
+    } else if ((path = nacm_child_value(rule_node, "path", NULL))) {
+        rule->type = !strcmp(path, "/") ? LYD_NACM_RULE_DATA_ALL : LYD_NACM_RULE_DATA;
+    }
+    if (str && strcmp(str, "*")) {
+        rule->name = strdup(str);
+        LY_CHECK_ERR_RET(!rule->name, LOGMEM(nacm->ctx), LY_EMEM);
+    }
+
+    /* access-operations */
+    str = nacm_child_value(rule_node, "access-operations", "*");
+    if (!strcmp(str, "*")) {
+        rule->ops = LYD_NACM_ALL;
+    } else {
+        while (*str) {
+            len = strcspn(str, " ");
+            for (i = 0; i < LYD_NACM_OP_COUNT; ++i) {
+                if ((strlen(bits[i]) == len) && !strncmp(bits[i], str, len)) {
+                    rule->ops |= (1 << i);
+                }
+            }
+            str += len;
+            str += strspn(str, " ");
+        }
+    }
+
+    /* action */
+    str = nacm_child_value(rule_node, "action", "deny");
+    rule->permit = !strcmp(str, "permit");
+
+    if (rule->type == LYD_NACM_RULE_DATA) {
+        /* find the targets, a path not matching any schema node cannot match any data */
+        prev_lo = ly_temp_log_options(&temp_lo);
+        if (lys_find_xpath(nacm->ctx, NULL, path, 0, &set)) {
+            ly_set_free(set, NULL);
+            set = NULL;
+        }
+        ly_temp_log_options(prev_lo);
+
+        if (!set || !set->count) {
+            /* matches nothing, but a deny rule must not be lost silently */
+            rule_name = nacm_child_value(rule_node, "name", "");
+            LOGWRN(nacm->ctx, "NACM rule \"%s\" path \"%s\" does not match any schema node, the rule matches no data.",
+                    rule_name, path);
+            if (!rule->permit) {
+                LY_ARRAY_NEW_GOTO(nacm->ctx, nacm->unresolved, unresolved, rc, cleanup);
+                *unresolved = strdup(rule_name);
+                LY_CHECK_ERR_GOTO(!*unresolved, LOGMEM(nacm->ctx); rc = LY_EMEM, cleanup);
+            }
+            goto cleanup;
+        }
+
+        for (i = 0; i < set->count; ++i) {
+            LY_CHECK_ERR_GOTO(nacm_idx_add(targets, set->snodes[i], idx), LOGMEM(nacm->ctx); rc = LY_EMEM, cleanup);
+        }
+
+        if (strchr(path, '[')) {
+            /* predicates need to be evaluated on the data */
+            rule->path = strdup(path);
+            LY_CHECK_ERR_GOTO(!rule->path, LOGMEM(nacm->ctx); rc = LY_EMEM, cleanup);
+            nacm->has_path = 1;
+        }
+    }
+
+cleanup:
+    ly_set_free(set, NULL);
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_nacm_compile(const struct ly_ctx *ctx, const struct lyd_node *nacm_data, const char *user, const char **groups,
+        struct lyd_nacm **nacm)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *nacm_cont = NULL, *iter, *node, *rule_node;
+    const struct lys_module *mod;
+    const struct lysc_node *snode;
+    struct ly_set user_groups = {0};
+    struct ly_ht *targets = NULL;
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(ctx, ctx, user, nacm, LY_EINVAL);
+
+    *nacm = calloc(1, sizeof **nacm);
+    LY_CHECK_ERR_RET(!*nacm, LOGMEM(ctx), LY_EMEM);
+    (*nacm)->ctx = ctx;
+    (*nacm)->snodes = lyht_new(1, sizeof(struct lyd_nacm_snode), nacm_ptr_equal_cb, NULL, 1);
+    targets = lyht_new(1, sizeof(struct lyd_nacm_idx), nacm_ptr_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!(*nacm)->snodes || !targets, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+
+    LY_LIST_FOR(nacm_data, iter) {
+        if (iter->schema && !strcmp(iter->schema->module->name, "ietf-netconf-acm") &&
+                !strcmp(iter->schema->name, "nacm")) {
+            nacm_cont = iter;
+            break;
+        }
+    }
+
+    /* global settings */
+    (*nacm)->enabled = !strcmp(nacm_child_value(nacm_cont, "enable-nacm", "true"), "true");
+    if (!strcmp(nacm_child_value(nacm_cont, "read-default", "permit"), "permit")) {
+        (*nacm)->dflt_permit |= LYD_NACM_READ;
+    }
+    if (!strcmp(nacm_child_value(nacm_cont, "write-default", "deny"), "permit")) {
+        (*nacm)->dflt_permit |= LYD_NACM_CREATE | LYD_NACM_UPDATE | LYD_NACM_DELETE;
+    }
+    if (!strcmp(nacm_child_value(nacm_cont, "exec-default", "permit"), "permit")) {
+        (*nacm)->dflt_permit |= LYD_NACM_EXEC;
+    }
+    if (!(*nacm)->enabled) {
+        goto cleanup;
+    }
+
+    /* groups of the user */
+    if (groups && !strcmp(nacm_child_value(nacm_cont, "enable-external-groups", "true"), "true")) {
+        for (i = 0; groups[i]; ++i) {
+            LY_CHECK_GOTO(rc = ly_set_add(&user_groups, (void *)groups[i], 1, NULL), cleanup);
+        }
+    }
+    LY_LIST_FOR(lyd_child(nacm_cont), iter) {
+        if (strcmp(iter->schema->name, "groups")) {
+            continue;
+        }
+        LY_LIST_FOR(lyd_child(iter), node) {
+            if (nacm_child_llist_has(node, "user-name", user)) {
+                LY_CHECK_GOTO(rc = ly_set_add(&user_groups, (void *)nacm_child_value(node, "name", NULL), 1, NULL),
+                        cleanup);
+            }
+        }
+    }
+
+    /* rules of the matching rule-lists in their order */
+    LY_LIST_FOR(lyd_child(nacm_cont), iter) {
+        if (strcmp(iter->schema->name, "rule-list") || !nacm_rlist_match(iter, &user_groups)) {
+            continue;
+        }
+        LY_LIST_FOR(lyd_child(iter), rule_node) {
+            if (!strcmp(rule_node->schema->name, "rule")) {
+                LY_CHECK_GOTO(rc = nacm_compile_rule(*nacm, rule_node, targets), cleanup);
+            }
+        }
+    }
+
+    /* schema nodes */
+    i = 0;
+    while ((mod = ly_ctx_get_module_iter(ctx, &i))) {
+        if (!mod->implemented || !mod->compiled) {
+            continue;
+        }
+        LY_LIST_FOR(mod->compiled->data, snode) {
+            LY_CHECK_GOTO(rc = nacm_compile_snode_r(*nacm, targets, snode, NULL), cleanup);
+        }
+        LY_LIST_FOR((const struct lysc_node *)mod->compiled->rpcs, snode) {
+            LY_CHECK_GOTO(rc = nacm_compile_snode_r(*nacm, targets, snode, NULL), cleanup);
+        }
+        LY_LIST_FOR((const struct lysc_node *)mod->compiled->notifs, snode) {
+            LY_CHECK_GOTO(rc = nacm_compile_snode_r(*nacm, targets, snode, NULL), cleanup);
+        }
+    }
+
+cleanup:
+    ly_set_erase(&user_groups, NULL);
+    lyht_free(targets, nacm_idx_free);
+    if (rc) {
+        lyd_nacm_free(*nacm);
+        *nacm = NULL;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF void
+lyd_nacm_free(struct lyd_nacm *nacm)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (!nacm) {
+        return;
+    }
+
+    LY_ARRAY_FOR(nacm->rules, u) {
+        free(nacm->rules[u].module);
+        free(nacm->rules[u].name);
+        free(nacm->rules[u].path);
+    }
+    LY_ARRAY_FREE(nacm->rules);
+    lyht_free(nacm->snodes, NULL);
+    LY_ARRAY_FOR(nacm->unresolved, u) {
+        free(nacm->unresolved[u]);
+    }
+    LY_ARRAY_FREE(nacm->unresolved);
+    free(nacm);
+}
+
+LIBYANG_API_DEF const char *
+lyd_nacm_unresolved_rule(const struct lyd_nacm *nacm, uint32_t idx)
+{
+    LY_CHECK_ARG_RET(NULL, nacm, NULL);
+
+    if (idx >= LY_ARRAY_COUNT(nacm->unresolved)) {
+        return NULL;
+    }
+    return nacm->unresolved[idx];
+}
+
+/**
+ * @brief Evaluate the rules with a data path on a data tree.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] tree Any node of the data tree.
+ * @param[out] members Hash table of ::lyd_nacm_idx records with the indices of the rules whose path the data nodes
+ * are in, NULL if there are no such rules.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+nacm_members_new(const struct lyd_nacm *nacm, const struct lyd_node *tree, struct ly_ht **members)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_set *set = NULL;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t i;
+
+    *members = NULL;
+    if (!nacm->has_path || !tree) {
+        return LY_SUCCESS;
+    }
+
+    *members = lyht_new(1, sizeof(struct lyd_nacm_idx), nacm_ptr_equal_cb, NULL, 1);
+    LY_CHECK_ERR_RET(!*members, LOGMEM(nacm->ctx), LY_EMEM);
+
+    LY_ARRAY_FOR(nacm->rules, u) {
+        if (!nacm->rules[u].path) {
+            continue;
+        }
+
+        LY_CHECK_GOTO(rc = lyd_find_xpath(tree, nacm->rules[u].path, &set), cleanup);
+        for (i = 0; i < set->count; ++i) {
+            LY_CHECK_ERR_GOTO(nacm_idx_add(*members, set->dnodes[i], u), LOGMEM(nacm->ctx); rc = LY_EMEM, cleanup);
+        }
+        ly_set_free(set, NULL);
+        set = NULL;
+    }
+
+cleanup:
+    ly_set_free(set, NULL);
+    if (rc) {
+        lyht_free(*members, nacm_idx_free);
+        *members = NULL;
+    }
+    return rc;
+}
+
+/**
+ * @brief Check access to a data node.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] members Evaluated rules with a data path, if any.
+ * @param[in] node Data node to check.
+ * @param[in] op Access operation.
+ * @return Whether the access is permitted.
+ */
+static ly_bool
+nacm_node_permit(const struct lyd_nacm *nacm, const struct ly_ht *members, const struct lyd_node *node, uint8_t op)
+{
+    struct lyd_nacm_snode rec = {.snode = node->schema}, *match;
+    const struct lyd_node *iter;
+    const uint32_t *idx;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t first;
+
+    if (!nacm->enabled || !node->schema) {
+        return 1;
+    }
+
+    if (lyht_find(nacm->snodes, &rec, nacm_ptr_hash(node->schema), (void **)&match)) {
+        /* no rule matches */
+        return (nacm_snode_dflt(nacm, node->schema) & op) ? 1 : 0;
+    }
+
+    if (match->cond & op) {
+        /* the first rule with a data path this node or any of its ancestors is in */
+        first = match->limit[nacm_op_idx(op)];
+        for (iter = node; iter; iter = lyd_parent(iter)) {
+            idx = nacm_idx_get(members, iter);
+            LY_ARRAY_FOR(idx, u) {
+                if ((idx[u] < first) && (nacm->rules[idx[u]].ops & op) &&
+                        nacm_rule_match_mod(&nacm->rules[idx[u]], node->schema)) {
+                    first = idx[u];
+                }
+            }
+        }
+        if (first != match->limit[nacm_op_idx(op)]) {
+            return nacm->rules[first].permit;
+        }
+    }
+
+    return (match->permit & op) ? 1 : 0;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_nacm_check(const struct lyd_nacm *nacm, const struct lyd_node *node, uint32_t access)
+{
+    LY_ERR rc;
+    struct ly_ht *members = NULL;
+    struct lyd_nacm_snode rec, *match;
+    ly_bool permit;
+
+    LY_CHECK_ARG_RET(NULL, nacm, node, access && !(access & (access - 1)) && !(access & ~LYD_NACM_ALL), LY_EINVAL);
+
+    /* evaluate the data paths only if needed */
+    rec.snode = node->schema;
+    if (nacm->enabled && node->schema && !lyht_find(nacm->snodes, &rec, nacm_ptr_hash(node->schema), (void **)&match) &&
+            (match->cond & access)) {
+        LY_CHECK_RET(rc = nacm_members_new(nacm, node, &members));
+    }
+
+    permit = nacm_node_permit(nacm, members, node, access);
+    lyht_free(members, nacm_idx_free);
+    return permit ? LY_SUCCESS : LY_ENOT;
+}
+
+/**
+ * @brief Remove the unreadable nodes from siblings, recursively.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] members Evaluated rules with a data path, if any.
+ * @param[in] first First sibling to filter.
+ * @param[in,out] tree Top-level tree to update, if filtering the top-level siblings.
+ */
+static void
+nacm_filter_r(const struct lyd_nacm *nacm, const struct ly_ht *members, struct lyd_node *first, struct lyd_node **tree)
+{
+    struct lyd_node *node, *next;
+
+    LY_LIST_FOR_SAFE(first, next, node) {
+        if (node->schema && lysc_is_key(node->schema)) {
+            /* kept with its list instance */
+            continue;
+        }
+
+        if (!nacm_node_permit(nacm, members, node, LYD_NACM_READ)) {
+            if (tree && (*tree == node)) {
+                *tree = next;
+            }
+            lyd_free_tree(node);
+            continue;
+        }
+
+        nacm_filter_r(nacm, members, lyd_child(node), NULL);
+    }
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_nacm_filter(const struct lyd_nacm *nacm, struct lyd_node **tree)
+{
+    struct ly_ht *members;
+
+    LY_CHECK_ARG_RET(NULL, nacm, tree, LY_EINVAL);
+
+    if (!*tree || !nacm->enabled) {
+        return LY_SUCCESS;
+    }
+
+    *tree = lyd_first_sibling(*tree);
+
+    /* the data paths are evaluated before anything is removed */
+    LY_CHECK_RET(nacm_members_new(nacm, *tree, &members));
+
+    nacm_filter_r(nacm, members, *tree, tree);
+
+    lyht_free(members, nacm_idx_free);
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Get the access operation required by a diff node.
+ *
+ * @param[in] node Diff node.
+ * @return Access operation, 0 if none.
+ */
+static uint8_t
+nacm_diff_op(const struct lyd_node *node)
+{
+    const struct lyd_meta *meta = NULL;
+    const char *op;
+
+    /* the operation may be inherited */
+    for ( ; node && !meta; node = lyd_parent(node)) {
+        meta = lyd_find_meta(node->meta, NULL, "yang:operation");
+    }
+    if (!meta) {
+        return 0;
+    }
+
+    op = lyd_get_meta_value(meta);
+    if (!strcmp(op, "create")) {
+        return LYD_NACM_CREATE;
+    } else if (!strcmp(op, "delete")) {
+        return LYD_NACM_DELETE;
+    } else if (!strcmp(op, "replace")) {
+        return LYD_NACM_UPDATE;
+    }
+    return 0;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_nacm_check_diff(const struct lyd_nacm *nacm, const struct lyd_node *diff, const struct lyd_node **denied)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_ht *members = NULL;
+    const struct lyd_node *root, *elem;
+    uint8_t op;
+
+    LY_CHECK_ARG_RET(NULL, nacm, LY_EINVAL);
+
+    if (denied) {
+        *denied = NULL;
+    }
+    if (!diff || !nacm->enabled) {
+        return LY_SUCCESS;
+    }
+
+    LY_CHECK_RET(nacm_members_new(nacm, diff, &members));
+
+    LY_LIST_FOR(lyd_first_sibling(diff), root) {
+        LYD_TREE_DFS_BEGIN(root, elem) {
+            op = nacm_diff_op(elem);
+            if (op && !nacm_node_permit(nacm, members, elem, op)) {
+                if (denied) {
+                    *denied = elem;
+                }
+                rc = LY_ENOT;
+                goto cleanup;
+            }
+
+            LYD_TREE_DFS_END(root, elem);
+        }
+    }
+
+cleanup:
+    lyht_free(members, nacm_idx_free);
+    return rc;
+}
+
 /**
  * @brief Plugin descriptions for the NACM's default-deny-write and default-deny-all extensions
  *
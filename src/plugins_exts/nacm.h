@@ -0,0 +1,146 @@
+/**
+ * @file nacm.h
+ * @brief ietf-netconf-acm (NACM) access control API
+ *
+ * Copyright (c) 2024 CESNET, z.s.p.o.
+ *
+ * This source code is licensed under BSD 3-Clause License (the "License").
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://opensource.org/licenses/BSD-3-Clause
+ */
+
+#ifndef LY_PLUGINS_EXTS_NACM_H_
+#define LY_PLUGINS_EXTS_NACM_H_
+
+#include <stdint.h>
+
+#include "log.h"
+#include "tree_data.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @page howtoNACM NACM Access Control
+ *
+ * The ietf-netconf-acm rules ([RFC 8341](https://tools.ietf.org/html/rfc8341)) applicable to a user can be compiled
+ * by ::lyd_nacm_compile() for all the schema nodes of a context. The result holds the decision of every access
+ * operation for every schema node so that checking a data node is a single hash table lookup. Only the rules with
+ * a data path including predicates are evaluated on the data tree, once for the whole tree being filtered or checked.
+ *
+ * A rule with a data path not matching any schema node of the context matches no data. A warning is logged for such
+ * rules and the deny ones are reported by ::lyd_nacm_unresolved_rule() so that the caller can refuse the configuration.
+ *
+ * The NACM extensions default-deny-write and default-deny-all are respected for the nodes without any matching rule.
+ * Note that the recovery session and the operations always allowed by the RFC (such as close-session) are not
+ * handled, the caller is expected to do so.
+ *
+ * Functions List
+ * --------------
+ * - ::lyd_nacm_compile()
+ * - ::lyd_nacm_unresolved_rule()
+ * - ::lyd_nacm_free()
+ * - ::lyd_nacm_check()
+ * - ::lyd_nacm_filter()
+ * - ::lyd_nacm_check_diff()
+ */
+
+/**
+ * @defgroup nacmaccess NACM access operations
+ *
+ * Access operations of the NACM rules, to be used in ::lyd_nacm_check().
+ *
+ * @{
+ */
+#define LYD_NACM_CREATE 0x01    /**< create access */
+#define LYD_NACM_READ 0x02      /**< read access */
+#define LYD_NACM_UPDATE 0x04    /**< update access */
+#define LYD_NACM_DELETE 0x08    /**< delete access */
+#define LYD_NACM_EXEC 0x10      /**< exec access */
+/** @} nacmaccess */
+
+/**
+ * @brief Compiled NACM rules of a user.
+ */
+struct lyd_nacm;
+
+/**
+ * @brief Compile the NACM rules applicable to a user.
+ *
+ * @param[in] ctx Context with the schema nodes of the data to be checked.
+ * @param[in] nacm_data Validated data tree with the ietf-netconf-acm:nacm container, NULL if there is none and only
+ * the default values are used.
+ * @param[in] user Name of the user to compile the rules for.
+ * @param[in] groups Optional NULL-terminated array of the external groups of @p user.
+ * @param[out] nacm Compiled NACM rules.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_nacm_compile(const struct ly_ctx *ctx, const struct lyd_node *nacm_data, const char *user,
+        const char **groups, struct lyd_nacm **nacm);
+
+/**
+ * @brief Get a deny rule whose data path does not match any schema node so it matches no data.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] idx Index of the rule, starting from 0.
+ * @return Name of the @p idx -th such rule, NULL if there are no more.
+ */
+LIBYANG_API_DECL const char *lyd_nacm_unresolved_rule(const struct lyd_nacm *nacm, uint32_t idx);
+
+/**
+ * @brief Free compiled NACM rules.
+ *
+ * @param[in] nacm Compiled NACM rules to free.
+ */
+LIBYANG_API_DECL void lyd_nacm_free(struct lyd_nacm *nacm);
+
+/**
+ * @brief Check access to a single data node.
+ *
+ * If there are any rules with a data path including predicates relevant for @p node, they are evaluated on
+ * the whole data tree of @p node so use ::lyd_nacm_filter() or ::lyd_nacm_check_diff() for checking many nodes.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] node Data node to check.
+ * @param[in] access Access operation to check, one of @ref nacmaccess.
+ * @return LY_SUCCESS if the access is permitted.
+ * @return LY_ENOT if the access is denied.
+ * @return LY_ERR on error.
+ */
+LIBYANG_API_DECL LY_ERR lyd_nacm_check(const struct lyd_nacm *nacm, const struct lyd_node *node, uint32_t access);
+
+/**
+ * @brief Remove all the data nodes the user is not permitted to read from a data tree.
+ *
+ * The subtrees of the unreadable nodes are removed, too. List keys are always kept with their list instance.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in,out] tree Data tree to filter, may be changed if a top-level node is removed.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_nacm_filter(const struct lyd_nacm *nacm, struct lyd_node **tree);
+
+/**
+ * @brief Check that the user is permitted to perform all the changes of a diff.
+ *
+ * Every node with a (possibly inherited) create, delete, or replace operation requires create, delete, or update
+ * access, respectively.
+ *
+ * @param[in] nacm Compiled NACM rules.
+ * @param[in] diff Diff as generated by ::lyd_diff_tree() or ::lyd_diff_siblings().
+ * @param[out] denied Optional first data node of @p diff the access was denied to.
+ * @return LY_SUCCESS if all the changes are permitted.
+ * @return LY_ENOT if some change is denied.
+ * @return LY_ERR on error.
+ */
+LIBYANG_API_DECL LY_ERR lyd_nacm_check_diff(const struct lyd_nacm *nacm, const struct lyd_node *diff,
+        const struct lyd_node **denied);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LY_PLUGINS_EXTS_NACM_H_ */
@@ -50,13 +50,24 @@ struct lyplg_ext_sm {
     } *shared;                          /**< shared schema mount points */
 
     struct lyplg_ext_sm_inln {
+        pthread_rwlock_t lock;          /**< lock for accessing the inline schemas, readers only search the cache */
         struct {
             struct ly_ctx *ctx;         /**< context created for inline schema data, may be reused if possible */
         } *schemas;                     /**< array of inline schemas */
         uint32_t schema_count;          /**< length of schemas array */
+        struct ly_ht *ctx_ht;           /**< cache of the inline schemas with ::lyplg_ext_sm_inln_rec records hashed by
+                                             the fingerprint of the ietf-yang-library data they were used for */
     } inln;                             /**< inline mount points */
 };
 
+/**
+ * @brief Record of the inline schema cache.
+ */
+struct lyplg_ext_sm_inln_rec {
+    uint32_t fp;                        /**< ietf-yang-library data fingerprint, also the hash of the record */
+    struct ly_ctx *ctx;                 /**< matching inline schema */
+};
+
 struct sprinter_tree_priv {
     struct ly_ctx *ext_ctx;
     struct ly_set *refs;
@@ -190,6 +201,23 @@ schema_mount_compile_find_shared(const struct lys_module *mod, const struct lysc
     return cb_data.sm_shared;
 }
 
+/**
+ * @brief Inline schema cache record equal callback.
+ *
+ * Implementation of ::lyht_value_equal_cb. Records with the same fingerprint are all candidates when searching,
+ * a specific record is identified by its schema as well.
+ */
+static ly_bool
+schema_mount_inln_equal_cb(void *val1_p, void *val2_p, ly_bool mod, void *UNUSED(cb_data))
+{
+    struct lyplg_ext_sm_inln_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    if (rec1->fp != rec2->fp) {
+        return 0;
+    }
+    return mod ? (rec1->ctx == rec2->ctx) : 1;
+}
+
 /**
  * @brief Schema mount compile.
  * Checks if it can be a valid extension instance for yang schema mount.
@@ -207,7 +235,13 @@ schema_mount_compile(struct lysc_ctx *cctx, const struct lysp_ext_instance *UNUS
     if (!sm_data) {
         EXT_LOGERR_MEM_RET(cctx, ext);
     }
+    sm_data->inln.ctx_ht = lyht_new(1, sizeof(struct lyplg_ext_sm_inln_rec), schema_mount_inln_equal_cb, NULL, 1);
+    if (!sm_data->inln.ctx_ht) {
+        free(sm_data);
+        EXT_LOGERR_MEM_RET(cctx, ext);
+    }
     pthread_mutex_init(&sm_data->lock, NULL);
+    pthread_rwlock_init(&sm_data->inln.lock, NULL);
     ext->compiled = sm_data;
 
     /* find the owner module */
@@ -223,7 +257,11 @@ schema_mount_compile(struct lysc_ctx *cctx, const struct lysp_ext_instance *UNUS
     } else {
         sm_data->shared = calloc(1, sizeof *sm_data->shared);
         if (!sm_data->shared) {
+            lyht_free(sm_data->inln.ctx_ht, NULL);
+            pthread_rwlock_destroy(&sm_data->inln.lock);
+            pthread_mutex_destroy(&sm_data->lock);
             free(sm_data);
+            ext->compiled = NULL;
             EXT_LOGERR_MEM_RET(cctx, ext);
         }
         sm_data->shared->ref_count = 1;
@@ -286,18 +324,146 @@ schema_mount_get_smount(const struct lysc_ext_instance *ext, const struct lyd_no
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Free module data returned by ::schema_mount_imp_clb().
+ *
+ * Implementation of ::ly_module_imp_data_free_clb.
+ */
+static void
+schema_mount_imp_data_free(void *module_data, void *UNUSED(user_data))
+{
+    free(module_data);
+}
+
+/**
+ * @brief Find a parsed (sub)module in a context that is the same one as would be found in the searchdirs.
+ *
+ * @param[in] ctx Context to search in.
+ * @param[in] mod_name Module name.
+ * @param[in] mod_rev Optional module revision, latest if not set.
+ * @param[in] submod_name Optional submodule name, module is searched if not set.
+ * @param[in] submod_rev Optional submodule revision, latest if not set.
+ * @param[out] pmod Found parsed module.
+ * @param[out] submod Found parsed submodule, if @p submod_name set.
+ * @return Whether the (sub)module was found.
+ */
+static ly_bool
+schema_mount_imp_find(const struct ly_ctx *ctx, const char *mod_name, const char *mod_rev, const char *submod_name,
+        const char *submod_rev, const struct lysp_module **pmod, const struct lysp_submodule **submod)
+{
+    const struct lys_module *mod;
+    const struct lysp_submodule *sub;
+    uint32_t idx = 0;
+    LY_ARRAY_COUNT_TYPE u;
+
+    *pmod = NULL;
+    *submod = NULL;
+
+    if (!submod_name) {
+        if (mod_rev) {
+            mod = ly_ctx_get_module(ctx, mod_name, mod_rev);
+        } else {
+            /* only the latest revision that was actually looked up */
+            mod = ly_ctx_get_module_latest(ctx, mod_name);
+            if (mod && !(mod->latest_revision & (LYS_MOD_LATEST_SEARCHDIRS | LYS_MOD_LATEST_IMPCLB))) {
+                mod = NULL;
+            }
+        }
+        if (!mod || !mod->parsed) {
+            return 0;
+        }
+
+        *pmod = mod->parsed;
+        return 1;
+    }
+
+    /* the submodule may be included by any revision of the module */
+    while ((mod = ly_ctx_get_module_iter(ctx, &idx))) {
+        if (strcmp(mod->name, mod_name) || !mod->parsed) {
+            continue;
+        }
+
+        LY_ARRAY_FOR(mod->parsed->includes, u) {
+            sub = mod->parsed->includes[u].submodule;
+            if (!sub || strcmp(sub->name, submod_name)) {
+                continue;
+            }
+
+            if (submod_rev ? (sub->revs && !strcmp(sub->revs[0].date, submod_rev)) : (sub->latest_revision == 2)) {
+                *pmod = mod->parsed;
+                *submod = sub;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Import callback of a new inline schema providing the modules already parsed in the context of the mount point
+ * or in the other inline schemas instead of searching for them and reading them from the disk.
+ *
+ * Implementation of ::ly_module_imp_clb, @p user_data is the compiled extension instance.
+ */
+static LY_ERR
+schema_mount_imp_clb(const char *mod_name, const char *mod_rev, const char *submod_name, const char *submod_rev,
+        void *user_data, LYS_INFORMAT *format, const char **module_data, ly_module_imp_data_free_clb *free_module_data)
+{
+    const struct lysc_ext_instance *ext = user_data;
+    struct lyplg_ext_sm *sm_data = ext->compiled;
+    const struct ly_ctx *ctx;
+    const struct lysp_module *pmod;
+    const struct lysp_submodule *submod;
+    struct ly_out *out;
+    char *data = NULL;
+    uint32_t i;
+    LY_ERR r;
+
+    for (i = 0; i <= sm_data->inln.schema_count; ++i) {
+        ctx = i ? sm_data->inln.schemas[i - 1].ctx : ext->module->ctx;
+        if (!schema_mount_imp_find(ctx, mod_name, mod_rev, submod_name, submod_rev, &pmod, &submod)) {
+            continue;
+        }
+
+        /* print it back, reading it is not needed */
+        if (submod) {
+            if (ly_out_new_memory(&data, 0, &out)) {
+                return LY_EMEM;
+            }
+            r = lys_print_submodule(out, submod, LYS_OUT_YANG, 0, 0);
+            ly_out_free(out, NULL, 0);
+        } else {
+            r = lys_print_mem(&data, pmod->mod, LYS_OUT_YANG, 0);
+        }
+        if (r) {
+            free(data);
+            return r;
+        }
+
+        *format = LYS_IN_YANG;
+        *module_data = data;
+        *free_module_data = schema_mount_imp_data_free;
+        return LY_SUCCESS;
+    }
+
+    return LY_ENOTFOUND;
+}
+
 /**
  * @brief Create schema (context) based on retrieved extension data.
  *
  * @param[in] ext Compiled extension instance.
  * @param[in] ext_data Extension data retrieved by the callback.
  * @param[in] config Whether the whole schema should keep its config or be set to false.
+ * @param[in] reuse_mods Whether to reuse the modules parsed in the context of @p ext and its inline schemas,
+ * the caller must hold the inline schemas write lock.
  * @param[out] ext_ctx Schema to use for parsing the data.
  * @return LY_ERR value.
  */
 static LY_ERR
 schema_mount_create_ctx(const struct lysc_ext_instance *ext, const struct lyd_node *ext_data, ly_bool config,
-        struct ly_ctx **ext_ctx)
+        ly_bool reuse_mods, struct ly_ctx **ext_ctx)
 {
     LY_ERR rc = LY_SUCCESS;
     const char * const *searchdirs;
@@ -318,8 +484,29 @@ schema_mount_create_ctx(const struct lysc_ext_instance *ext, const struct lyd_no
         }
     }
 
+    if (reuse_mods) {
+        /* create an empty context getting the modules from the others first */
+        if ((rc = ly_ctx_new(sdirs, ly_ctx_get_options(ext->module->ctx), ext_ctx))) {
+            lyplg_ext_compile_log(NULL, ext, LY_LLERR, rc, "Failed to create context for the schema-mount data (%s).",
+                    ly_last_logmsg());
+            goto cleanup;
+        }
+        ly_ctx_set_module_imp_clb(*ext_ctx, schema_mount_imp_clb, (void *)ext);
+    } else {
+        *ext_ctx = NULL;
+    }
+
     /* create the context based on the data */
-    if ((rc = ly_ctx_new_yldata(sdirs, ext_data, ly_ctx_get_options(ext->module->ctx), ext_ctx))) {
+    rc = ly_ctx_new_yldata(sdirs, ext_data, ly_ctx_get_options(ext->module->ctx), ext_ctx);
+    if (reuse_mods) {
+        /* the other schemas can be accessed only while holding the lock */
+        ly_ctx_set_module_imp_clb(*ext_ctx, NULL, NULL);
+        if (rc) {
+            ly_ctx_destroy(*ext_ctx);
+            *ext_ctx = NULL;
+        }
+    }
+    if (rc) {
         lyplg_ext_compile_log(NULL, ext, LY_LLERR, rc, "Failed to create context for the schema-mount data (%s).",
                 ly_last_logmsg());
         goto cleanup;
@@ -433,7 +620,7 @@ schema_mount_get_ctx_shared(struct lysc_ext_instance *ext, const struct lyd_node
         }
     } else {
         /* no schema found, create it */
-        if ((r = schema_mount_create_ctx(ext, ext_data, config, &new_ctx))) {
+        if ((r = schema_mount_create_ctx(ext, ext_data, config, 0, &new_ctx))) {
             rc = r;
             goto cleanup;
         }
@@ -556,9 +743,112 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Learn the fingerprint of ietf-yang-library data, the modules relevant for ::schema_mount_ctx_match().
+ *
+ * The fingerprint does not depend on the order of the modules.
+ *
+ * @param[in] ext_data Extension data retrieved by the callback with the yang-library data.
+ * @return Fingerprint of @p ext_data.
+ */
+static uint32_t
+schema_mount_yldata_fp(const struct lyd_node *ext_data)
+{
+    const struct lyd_node *yl = NULL, *ms = NULL, *iter, *module, *node;
+    const char *kind, *value;
+    uint32_t fp = 0, hash;
+
+    LY_LIST_FOR(ext_data, iter) {
+        if (!iter->schema || strcmp(iter->schema->module->name, "ietf-yang-library")) {
+            continue;
+        }
+        if (!strcmp(iter->schema->name, "yang-library")) {
+            yl = iter;
+        } else if (!strcmp(iter->schema->name, "modules-state")) {
+            ms = iter;
+        }
+    }
+
+    if (yl && !lyd_find_path(yl, "content-id", 0, NULL)) {
+        /* the first module set */
+        LY_LIST_FOR(lyd_child(yl), iter) {
+            if (!strcmp(iter->schema->name, "module-set")) {
+                break;
+            }
+        }
+        yl = iter;
+    } else {
+        /* legacy data */
+        yl = ms;
+    }
+
+    LY_LIST_FOR(lyd_child(yl), module) {
+        kind = module->schema->name;
+        if (!strcmp(kind, "module") || !strcmp(kind, "import-only-module")) {
+            hash = 0;
+            LY_LIST_FOR(lyd_child(module), node) {
+                if (!strcmp(node->schema->name, "conformance-type")) {
+                    /* legacy implemented or imported module */
+                    kind = lyd_get_value(node);
+                } else if (!strcmp(node->schema->name, "name") || !strcmp(node->schema->name, "revision")) {
+                    value = lyd_get_value(node);
+                    hash = lyht_hash_multi(hash, value, strlen(value));
+                }
+            }
+            hash = lyht_hash_multi(hash, kind, strlen(kind));
+            fp += lyht_hash_multi(hash, NULL, 0);
+        }
+    }
+
+    return fp;
+}
+
+/**
+ * @brief Find a cached inline schema for ietf-yang-library data.
+ *
+ * @param[in] ext Compiled extension instance.
+ * @param[in] ext_data Extension data retrieved by the callback.
+ * @param[in] fp Fingerprint of @p ext_data.
+ * @param[out] ext_ctx Found schema.
+ * @return LY_SUCCESS if found.
+ * @return LY_ENOT if not found.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+schema_mount_inln_find(struct lysc_ext_instance *ext, const struct lyd_node *ext_data, uint32_t fp,
+        const struct ly_ctx **ext_ctx)
+{
+    struct lyplg_ext_sm *sm_data = ext->compiled;
+    struct lyplg_ext_sm_inln_rec rec = {.fp = fp}, *match;
+    void *val_p;
+    LY_ERR r;
+
+    if (lyht_find(sm_data->inln.ctx_ht, &rec, fp, &val_p)) {
+        return LY_ENOT;
+    }
+
+    do {
+        /* the fingerprints may collide */
+        match = val_p;
+        r = schema_mount_ctx_match(ext, ext_data, match->ctx);
+        if (!r) {
+            *ext_ctx = match->ctx;
+            return LY_SUCCESS;
+        } else if (r != LY_ENOT) {
+            return r;
+        }
+    } while (!lyht_find_next(sm_data->inln.ctx_ht, match, fp, &val_p));
+
+    return LY_ENOT;
+}
+
 /**
  * @brief Get schema (context) for an inline mount point.
  *
+ * The schemas are cached by the fingerprint of the ietf-yang-library data so that finding an existing schema
+ * requires only a read lock. Otherwise, any suitable schema is reused or a new one is created, reusing the modules
+ * parsed in the existing schemas.
+ *
  * @param[in] ext Compiled extension instance.
  * @param[in] ext_data Extension data retrieved by the callback.
  * @param[in] config Whether the whole schema should keep its config or be set to false.
@@ -570,6 +860,7 @@ schema_mount_get_ctx_inline(struct lysc_ext_instance *ext, const struct lyd_node
         const struct ly_ctx **ext_ctx)
 {
     struct lyplg_ext_sm *sm_data = ext->compiled;
+    struct lyplg_ext_sm_inln_rec rec;
     struct ly_ctx *new_ctx = NULL;
     uint32_t i;
     void *mem;
@@ -577,18 +868,48 @@ schema_mount_get_ctx_inline(struct lysc_ext_instance *ext, const struct lyd_node
 
     assert(sm_data && sm_data->shared);
 
-    /* LOCK */
-    if ((r = pthread_mutex_lock(&sm_data->lock))) {
-        lyplg_ext_compile_log(NULL, ext, LY_LLERR, LY_ESYS, "Mutex lock failed (%s).", strerror(r));
+    rec.fp = schema_mount_yldata_fp(ext_data);
+
+    /* READ LOCK */
+    if ((r = pthread_rwlock_rdlock(&sm_data->inln.lock))) {
+        lyplg_ext_compile_log(NULL, ext, LY_LLERR, LY_ESYS, "Lock failed (%s).", strerror(r));
+        return LY_ESYS;
+    }
+
+    /* try to find a cached context */
+    rc = schema_mount_inln_find(ext, ext_data, rec.fp, ext_ctx);
+
+    /* UNLOCK */
+    pthread_rwlock_unlock(&sm_data->inln.lock);
+
+    if (rc != LY_ENOT) {
+        return rc;
+    }
+    rc = LY_SUCCESS;
+
+    /* WRITE LOCK */
+    if ((r = pthread_rwlock_wrlock(&sm_data->inln.lock))) {
+        lyplg_ext_compile_log(NULL, ext, LY_LLERR, LY_ESYS, "Lock failed (%s).", strerror(r));
         return LY_ESYS;
     }
 
+    /* may have been added meanwhile */
+    r = schema_mount_inln_find(ext, ext_data, rec.fp, ext_ctx);
+    if (r != LY_ENOT) {
+        rc = r;
+        goto cleanup;
+    }
+
     /* try to find a context we can reuse */
     for (i = 0; i < sm_data->inln.schema_count; ++i) {
         r = schema_mount_ctx_match(ext, ext_data, sm_data->inln.schemas[i].ctx);
         if (!r) {
-            /* match */
-            *ext_ctx = sm_data->inln.schemas[i].ctx;
+            /* match, cache it for this fingerprint as well */
+            rec.ctx = sm_data->inln.schemas[i].ctx;
+            if (lyht_insert(sm_data->inln.ctx_ht, &rec, rec.fp, NULL)) {
+                EXT_LOGERR_MEM_GOTO(NULL, ext, rc, cleanup);
+            }
+            *ext_ctx = rec.ctx;
             goto cleanup;
         } else if (r != LY_ENOT) {
             /* error */
@@ -598,7 +919,7 @@ schema_mount_get_ctx_inline(struct lysc_ext_instance *ext, const struct lyd_node
     }
 
     /* new schema required, create context */
-    if ((r = schema_mount_create_ctx(ext, ext_data, config, &new_ctx))) {
+    if ((r = schema_mount_create_ctx(ext, ext_data, config, 1, &new_ctx))) {
         rc = r;
         goto cleanup;
     }
@@ -615,12 +936,18 @@ schema_mount_get_ctx_inline(struct lysc_ext_instance *ext, const struct lyd_node
     /* fill entry */
     sm_data->inln.schemas[i].ctx = new_ctx;
 
+    /* cache it */
+    rec.ctx = new_ctx;
+    if (lyht_insert(sm_data->inln.ctx_ht, &rec, rec.fp, NULL)) {
+        EXT_LOGERR_MEM_GOTO(NULL, ext, rc, cleanup);
+    }
+
     /* use the context */
     *ext_ctx = sm_data->inln.schemas[i].ctx;
 
 cleanup:
     /* UNLOCK */
-    pthread_mutex_unlock(&sm_data->lock);
+    pthread_rwlock_unlock(&sm_data->inln.lock);
 
     return rc;
 }
@@ -1054,7 +1381,9 @@ schema_mount_cfree(const struct ly_ctx *ctx, struct lysc_ext_instance *ext)
         ly_ctx_destroy(sm_data->inln.schemas[i].ctx);
     }
     free(sm_data->inln.schemas);
+    lyht_free(sm_data->inln.ctx_ht, NULL);
 
+    pthread_rwlock_destroy(&sm_data->inln.lock);
     pthread_mutex_destroy(&sm_data->lock);
     free(sm_data);
 }
@@ -1085,7 +1414,7 @@ lyplg_ext_schema_mount_create_context(const struct lysc_ext_instance *ext, struc
     }
 
     /* create the context */
-    rc = schema_mount_create_ctx(ext, ext_data, config, ctx);
+    rc = schema_mount_create_ctx(ext, ext_data, config, 0, ctx);
 
 cleanup:
     if (ext_data_free) {
@@ -340,13 +340,16 @@ LIBYANG_API_DEF const void *
 lyplg_type_print_simple(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT UNUSED(format),
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
+    const char *canon;
+
     if (dynamic) {
         *dynamic = 0;
     }
+    canon = LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical);
     if (value_len) {
-        *value_len = ly_strlen(value->_canonical);
+        *value_len = ly_strlen(canon);
     }
-    return value->_canonical;
+    return canon;
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -354,7 +357,7 @@ lyplg_type_dup_simple(const struct ly_ctx *ctx, const struct lyd_value *original
 {
     LY_ERR r;
 
-    if ((r = lydict_dup(ctx, original->_canonical, &dup->_canonical))) {
+    if ((r = lydict_dup(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), &dup->_canonical))) {
         /* in case of error NULL the values so that freeing does not fail */
         memset(dup, 0, sizeof *dup);
         return r;
@@ -1093,7 +1096,8 @@ lyplg_type_resolve_leafref(const struct lysc_type_leafref *lref, const struct ly
     if (targets) {
         LY_CHECK_GOTO(rc = ly_set_new(targets), cleanup);
         for (i = 0; i < set.used; ++i) {
-            if (set.val.nodes[i].type != LYXP_NODE_ELEM) {
+            if ((set.val.nodes[i].type != LYXP_NODE_ELEM) || (set.val.nodes[i].node->flags & LYD_VIRTUAL)) {
+                /* virtual default nodes are freed with the XPath set */
                 continue;
             }
             if (((struct lyd_node_term *)set.val.nodes[i].node)->value.realtype != value->realtype) {
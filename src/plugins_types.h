@@ -476,6 +476,8 @@ LIBYANG_API_DECL LY_ERR lyplg_type_print_xpath10_value(const struct lyd_value_xp
                                              the value, make the module implemented. */
 #define LYPLG_TYPE_STORE_IS_UTF8   0x04 /**< The value is guaranteed to be a valid UTF-8 string, if applicable for the type. */
 #define LYPLG_TYPE_STORE_ONLY      0x08 /**< The value is stored only, type-specific validation is skipped (performed before) */
+#define LYPLG_TYPE_STORE_LAZY_CANON 0x10 /**< The canonical value does not need to be stored, it can be generated later
+                                             on-demand by ::lyplg_type_print_clb (always for ::LY_VALUE_CANON format). */
 /**
  * @} plugintypestoreopts
  */
@@ -1283,7 +1285,8 @@ LIBYANG_API_DECL LY_ERR lyplg_type_validate_patterns(struct lysc_pattern **patte
  * @param[in] node Context node.
  * @param[in] value Target value.
  * @param[in] tree Full data tree to search in.
- * @param[out] targets Pointer to set of target nodes, optional.
+ * @param[out] targets Pointer to set of target nodes, optional. Virtual default nodes (::LY_CTX_VIRTUAL_DEFAULTS) are
+ * not included.
  * @param[out] errmsg Error message in case of error.
  * @return LY_ERR value.
  */
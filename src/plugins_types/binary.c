@@ -308,7 +308,9 @@ lyplg_type_store_binary(const struct ly_ctx *ctx, const struct lysc_type *type,
     LY_CHECK_GOTO(ret, cleanup);
 
     /* store canonical value */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
+    if (options & LYPLG_TYPE_STORE_LAZY_CANON) {
+        /* canonical value generated on-demand */
+    } else if (options & LYPLG_TYPE_STORE_DYNAMIC) {
         ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
         options &= ~LYPLG_TYPE_STORE_DYNAMIC;
         LY_CHECK_GOTO(ret, cleanup);
@@ -344,21 +346,30 @@ static LY_ERR
 lyplg_type_validate_binary(const struct ly_ctx *ctx, const struct lysc_type *type, const struct lyd_node *UNUSED(ctx_node),
         const struct lyd_node *UNUSED(tree), struct lyd_value *storage, struct ly_err_item **err)
 {
+    LY_ERR ret;
     struct lysc_type_bin *type_bin = (struct lysc_type_bin *)type;
     struct lyd_value_binary *val;
-    const void *value;
-    size_t value_len;
+    char *canon = NULL;
+    size_t canon_len;
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
 
     val = LYPLG_TYPE_VAL_IS_DYN(val) ? (struct lyd_value_binary *)(storage->dyn_mem) : (struct lyd_value_binary *)(storage->fixed_mem);
-    value = lyd_value_get_canonical(ctx, storage);
-    value_len = strlen(value);
     *err = NULL;
 
     /* length restriction of the binary value */
     if (type_bin->length) {
-        LY_CHECK_RET(lyplg_type_validate_range(LY_TYPE_BINARY, type_bin->length, val->size, value, value_len, err));
+        /* canonical value is needed only for the error message and may not have been generated yet */
+        if (storage->_canonical) {
+            canon_len = strlen(storage->_canonical);
+        } else {
+            LY_CHECK_RET(binary_base64_encode(ctx, val->data, val->size, &canon, &canon_len));
+        }
+
+        ret = lyplg_type_validate_range(LY_TYPE_BINARY, type_bin->length, val->size,
+                canon ? canon : storage->_canonical, canon_len, err);
+        free(canon);
+        LY_CHECK_RET(ret);
     }
 
     return LY_SUCCESS;
@@ -417,14 +428,14 @@ lyplg_type_print_binary(const struct ly_ctx *ctx, const struct lyd_value *value,
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         /* get the base64 string value */
         if (binary_base64_encode(ctx, val->data, val->size, &ret, &ret_len)) {
             return NULL;
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -448,7 +459,7 @@ lyplg_type_dup_binary(const struct ly_ctx *ctx, const struct lyd_value *original
 
     memset(dup, 0, sizeof *dup);
 
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, error);
 
     LYPLG_TYPE_VAL_INLINE_PREPARE(dup, dup_val);
@@ -416,14 +416,14 @@ lyplg_type_print_bits(const struct ly_ctx *ctx, const struct lyd_value *value, L
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         /* get the canonical value */
         if (bits_items2canon(val->items, &ret)) {
             return NULL;
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -450,7 +450,7 @@ lyplg_type_dup_bits(const struct ly_ctx *ctx, const struct lyd_value *original,
     memset(dup, 0, sizeof *dup);
 
     /* optional canonical value */
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, error);
 
     /* allocate value */
@@ -124,7 +124,7 @@ lyplg_type_store_date_and_time(const struct ly_ctx *ctx, const struct lysc_type
         val->unknown_tz = 1;
     }
 
-    if (format == LY_VALUE_CANON) {
+    if ((format == LY_VALUE_CANON) && !(options & LYPLG_TYPE_STORE_LAZY_CANON)) {
         /* store canonical value */
         if (options & LYPLG_TYPE_STORE_DYNAMIC) {
             ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
@@ -295,7 +295,7 @@ lyplg_type_print_date_and_time(const struct ly_ctx *ctx, const struct lyd_value
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         if (val->unknown_tz) {
             /* ly_time_time2str but always using GMT */
             if (!gmtime_r(&val->time, &tm)) {
@@ -313,7 +313,7 @@ lyplg_type_print_date_and_time(const struct ly_ctx *ctx, const struct lyd_value
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -341,7 +341,7 @@ lyplg_type_dup_date_and_time(const struct ly_ctx *ctx, const struct lyd_value *o
     memset(dup, 0, sizeof *dup);
 
     /* optional canonical value */
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, error);
 
     /* allocate value */
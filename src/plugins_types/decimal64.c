@@ -121,8 +121,9 @@ lyplg_type_store_decimal64(const struct ly_ctx *ctx, const struct lysc_type *typ
     /* store value */
     storage->dec64 = num;
 
-    /* we need canonical value for the range check */
-    if (format == LY_VALUE_CANON) {
+    if (options & LYPLG_TYPE_STORE_LAZY_CANON) {
+        /* canonical value generated on-demand */
+    } else if (format == LY_VALUE_CANON) {
         /* store canonical value */
         if (options & LYPLG_TYPE_STORE_DYNAMIC) {
             ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
@@ -169,15 +170,22 @@ lyplg_type_validate_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lys
     LY_ERR ret;
     struct lysc_type_dec *type_dec = (struct lysc_type_dec *)type;
     int64_t num;
+    char *canon = NULL;
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
     num = storage->dec64;
 
     if (type_dec->range) {
+        /* canonical value is needed only for the error message and may not have been generated yet */
+        if (!storage->_canonical) {
+            LY_CHECK_RET(decimal64_num2str(num, type_dec, &canon));
+        }
+
         /* check range of the number */
-        ret = lyplg_type_validate_range(type->basetype, type_dec->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        ret = lyplg_type_validate_range(type->basetype, type_dec->range, num, canon ? canon : storage->_canonical,
+                strlen(canon ? canon : storage->_canonical), err);
+        free(canon);
         LY_CHECK_RET(ret);
     }
 
@@ -208,11 +216,12 @@ lyplg_type_sort_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_val
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_decimal64(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     int64_t num = 0;
     void *buf;
+    char *canon;
 
     if (format == LY_VALUE_LYB) {
         num = htole64(value->dec64);
@@ -237,6 +246,20 @@ lyplg_type_print_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_va
         }
     }
 
+    /* generate canonical value if not already */
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
+        if (decimal64_num2str(value->dec64, (struct lysc_type_dec *)value->realtype, &canon)) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+
+        /* store it */
+        if (lydict_insert_zc_once(ctx, canon, (const char **)&value->_canonical)) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
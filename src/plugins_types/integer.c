@@ -122,7 +122,9 @@ lyplg_type_store_int(const struct ly_ctx *ctx, const struct lysc_type *type, con
         break;
     }
 
-    if (format == LY_VALUE_CANON) {
+    if (options & LYPLG_TYPE_STORE_LAZY_CANON) {
+        /* canonical value generated on-demand */
+    } else if (format == LY_VALUE_CANON) {
         /* store canonical value */
         if (options & LYPLG_TYPE_STORE_DYNAMIC) {
             ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
@@ -183,6 +185,8 @@ lyplg_type_validate_int(const struct ly_ctx *UNUSED(ctx), const struct lysc_type
     LY_ERR ret;
     struct lysc_type_num *type_num = (struct lysc_type_num *)type;
     int64_t num;
+    char buf[LY_NUMBER_MAXLEN];
+    const char *canon;
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
@@ -207,8 +211,14 @@ lyplg_type_validate_int(const struct ly_ctx *UNUSED(ctx), const struct lysc_type
 
     /* validate range of the number */
     if (type_num->range) {
-        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        /* canonical value is needed only for the error message and may not have been generated yet */
+        if (storage->_canonical) {
+            canon = storage->_canonical;
+        } else {
+            sprintf(buf, "%" PRId64, num);
+            canon = buf;
+        }
+        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, canon, strlen(canon), err);
         LY_CHECK_RET(ret);
     }
 
@@ -296,29 +306,31 @@ lyplg_type_sort_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *va
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_int(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     int64_t prev_num = 0, num = 0;
     void *buf;
+    char *canon;
+
+    switch (value->realtype->basetype) {
+    case LY_TYPE_INT8:
+        prev_num = num = value->int8;
+        break;
+    case LY_TYPE_INT16:
+        prev_num = num = value->int16;
+        break;
+    case LY_TYPE_INT32:
+        prev_num = num = value->int32;
+        break;
+    case LY_TYPE_INT64:
+        prev_num = num = value->int64;
+        break;
+    default:
+        break;
+    }
 
     if (format == LY_VALUE_LYB) {
-        switch (value->realtype->basetype) {
-        case LY_TYPE_INT8:
-            prev_num = num = value->int8;
-            break;
-        case LY_TYPE_INT16:
-            prev_num = num = value->int16;
-            break;
-        case LY_TYPE_INT32:
-            prev_num = num = value->int32;
-            break;
-        case LY_TYPE_INT64:
-            prev_num = num = value->int64;
-            break;
-        default:
-            break;
-        }
         num = htole64(num);
         if (num == prev_num) {
             /* values are equal, little-endian or int8 */
@@ -341,6 +353,20 @@ lyplg_type_print_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *v
         }
     }
 
+    /* generate canonical value if not already */
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
+        if (asprintf(&canon, "%" PRId64, num) == -1) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+
+        /* store it */
+        if (lydict_insert_zc_once(ctx, canon, (const char **)&value->_canonical)) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
@@ -421,7 +447,9 @@ lyplg_type_store_uint(const struct ly_ctx *ctx, const struct lysc_type *type, co
         break;
     }
 
-    if (format == LY_VALUE_CANON) {
+    if (options & LYPLG_TYPE_STORE_LAZY_CANON) {
+        /* canonical value generated on-demand */
+    } else if (format == LY_VALUE_CANON) {
         /* store canonical value */
         if (options & LYPLG_TYPE_STORE_DYNAMIC) {
             ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
@@ -467,6 +495,8 @@ lyplg_type_validate_uint(const struct ly_ctx *UNUSED(ctx), const struct lysc_typ
     LY_ERR ret;
     struct lysc_type_num *type_num = (struct lysc_type_num *)type;
     uint64_t num;
+    char buf[LY_NUMBER_MAXLEN];
+    const char *canon;
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
@@ -491,8 +521,14 @@ lyplg_type_validate_uint(const struct ly_ctx *UNUSED(ctx), const struct lysc_typ
 
     /* validate range of the number */
     if (type_num->range) {
-        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        /* canonical value is needed only for the error message and may not have been generated yet */
+        if (storage->_canonical) {
+            canon = storage->_canonical;
+        } else {
+            sprintf(buf, "%" PRIu64, num);
+            canon = buf;
+        }
+        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, canon, strlen(canon), err);
         LY_CHECK_RET(ret);
     }
 
@@ -576,29 +612,31 @@ lyplg_type_sort_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *v
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_uint(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     uint64_t num = 0;
     void *buf;
+    char *canon;
+
+    switch (value->realtype->basetype) {
+    case LY_TYPE_UINT8:
+        num = value->uint8;
+        break;
+    case LY_TYPE_UINT16:
+        num = value->uint16;
+        break;
+    case LY_TYPE_UINT32:
+        num = value->uint32;
+        break;
+    case LY_TYPE_UINT64:
+        num = value->uint64;
+        break;
+    default:
+        break;
+    }
 
     if (format == LY_VALUE_LYB) {
-        switch (value->realtype->basetype) {
-        case LY_TYPE_UINT8:
-            num = value->uint8;
-            break;
-        case LY_TYPE_UINT16:
-            num = value->uint16;
-            break;
-        case LY_TYPE_UINT32:
-            num = value->uint32;
-            break;
-        case LY_TYPE_UINT64:
-            num = value->uint64;
-            break;
-        default:
-            break;
-        }
         num = htole64(num);
         if (num == value->uint64) {
             /* values are equal, little-endian or uint8 */
@@ -621,6 +659,20 @@ lyplg_type_print_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *
         }
     }
 
+    /* generate canonical value if not already */
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
+        if (asprintf(&canon, "%" PRIu64, num) == -1) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+
+        /* store it */
+        if (lydict_insert_zc_once(ctx, canon, (const char **)&value->_canonical)) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
@@ -187,7 +187,9 @@ lyplg_type_store_ipv4_address(const struct ly_ctx *ctx, const struct lysc_type *
     LY_CHECK_GOTO(ret, cleanup);
 
     /* store canonical value */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
+    if (options & LYPLG_TYPE_STORE_LAZY_CANON) {
+        /* canonical value generated on-demand */
+    } else if (options & LYPLG_TYPE_STORE_DYNAMIC) {
         ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
         options &= ~LYPLG_TYPE_STORE_DYNAMIC;
         LY_CHECK_GOTO(ret, cleanup);
@@ -294,7 +296,7 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         /* '%' + zone */
         zone_len = val->zone ? strlen(val->zone) + 1 : 0;
         ret = malloc(INET_ADDRSTRLEN + zone_len);
@@ -313,7 +315,7 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -340,7 +342,7 @@ lyplg_type_dup_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *or
 
     memset(dup, 0, sizeof *dup);
 
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, error);
 
     LYPLG_TYPE_VAL_INLINE_PREPARE(dup, dup_val);
@@ -180,7 +180,7 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
     }
 
     /* generate canonical value if not already (loaded from LYB) */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         ret = malloc(INET_ADDRSTRLEN);
         LY_CHECK_RET(!ret, NULL);
 
@@ -192,7 +192,7 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -251,7 +251,7 @@ lyplg_type_print_ipv4_prefix(const struct ly_ctx *ctx, const struct lyd_value *v
     }
 
     /* generate canonical value if not already */
-    if (!value->_canonical) {
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical)) {
         /* IPv4 mask + '/' + prefix */
         ret = malloc(INET_ADDRSTRLEN + 3);
         LY_CHECK_RET(!ret, NULL);
@@ -266,7 +266,7 @@ lyplg_type_print_ipv4_prefix(const struct ly_ctx *ctx, const struct lyd_value *v
         sprintf(ret + strlen(ret), "/%" PRIu8, val->prefix);
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
+        if (lydict_insert_zc_once(ctx, ret, (const char **)&value->_canonical)) {
             LOGMEM(ctx);
             return NULL;
         }
@@ -293,7 +293,7 @@ lyplg_type_dup_ipv4_prefix(const struct ly_ctx *ctx, const struct lyd_value *ori
 
     memset(dup, 0, sizeof *dup);
 
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, error);
 
     LYPLG_TYPE_VAL_INLINE_PREPARE(dup, dup_val);
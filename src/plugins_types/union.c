@@ -286,6 +286,9 @@ union_store_type(const struct ly_ctx *ctx, struct lysc_type_union *type_u, uint3
         }
     }
 
+    /* remember the type for printing */
+    subvalue->type_idx = type_idx;
+
 cleanup:
     if (dynamic) {
         free((void *)value);
@@ -598,8 +601,6 @@ lyplg_type_sort_union(const struct ly_ctx *ctx, const struct lyd_value *val1, co
 /**
  * @brief Create LYB data for printing.
  *
- * @param[in] ctx libyang context.
- * @param[in] type_u Compiled type of union.
  * @param[in] subvalue Union value.
  * @param[in] prefix_data Format-specific data for resolving any
  * prefixes (see ly_resolve_prefix()).
@@ -608,31 +609,14 @@ lyplg_type_sort_union(const struct ly_ctx *ctx, const struct lyd_value *val1, co
  * @return NULL in case of error.
  */
 static const void *
-lyb_union_print(const struct ly_ctx *ctx, struct lysc_type_union *type_u, struct lyd_value_union *subvalue,
-        void *prefix_data, size_t *value_len)
+lyb_union_print(struct lyd_value_union *subvalue, void *prefix_data, size_t *value_len)
 {
     void *ret = NULL;
-    LY_ERR r;
-    struct ly_err_item *err;
     uint64_t num = 0;
-    uint32_t type_idx = 0;
     ly_bool dynamic;
     size_t pval_len;
     void *pval;
 
-    /* Find out the index number (type_idx). The call should succeed
-     * because the union_find_type() has already been called in the
-     * lyplg_type_store_union().
-     */
-    if (!ctx) {
-        assert(subvalue->ctx_node);
-        ctx = subvalue->ctx_node->module->ctx;
-    }
-    subvalue->value.realtype->plugin->free(ctx, &subvalue->value);
-    r = union_find_type(ctx, type_u, subvalue, 0, 0, NULL, NULL, &type_idx, NULL, &err);
-    ly_err_free(err);
-    LY_CHECK_RET((r != LY_SUCCESS) && (r != LY_EINCOMPLETE), NULL);
-
     /* Print subvalue in LYB format. */
     pval = (void *)subvalue->value.realtype->plugin->print(NULL, &subvalue->value, LY_VALUE_LYB, prefix_data, &dynamic,
             &pval_len);
@@ -643,7 +627,7 @@ lyb_union_print(const struct ly_ctx *ctx, struct lysc_type_union *type_u, struct
     ret = malloc(*value_len);
     LY_CHECK_RET(!ret, NULL);
 
-    num = type_idx;
+    num = subvalue->type_idx;
     num = htole64(num);
     memcpy(ret, &num, TYPE_IDX_SIZE);
     memcpy((char *)ret + TYPE_IDX_SIZE, pval, pval_len);
@@ -661,8 +645,8 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
 {
     const void *ret;
     struct lyd_value_union *subvalue = value->subvalue;
-    struct lysc_type_union *type_u = (struct lysc_type_union *)value->realtype;
     size_t lyb_data_len = 0;
+    char *canon;
 
     if ((format == LY_VALUE_LYB) && (subvalue->format == LY_VALUE_LYB)) {
         /* The return value is already ready. */
@@ -674,7 +658,7 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
     } else if ((format == LY_VALUE_LYB) && (subvalue->format != LY_VALUE_LYB)) {
         /* The return LYB data must be created. */
         *dynamic = 1;
-        ret = lyb_union_print(ctx, type_u, subvalue, prefix_data, &lyb_data_len);
+        ret = lyb_union_print(subvalue, prefix_data, &lyb_data_len);
         if (value_len) {
             *value_len = lyb_data_len;
         }
@@ -683,9 +667,13 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
 
     assert(format != LY_VALUE_LYB);
     ret = (void *)subvalue->value.realtype->plugin->print(ctx, &subvalue->value, format, prefix_data, dynamic, value_len);
-    if (!value->_canonical && (format == LY_VALUE_CANON)) {
-        /* the canonical value is supposed to be stored now */
-        lydict_insert(ctx, subvalue->value._canonical, 0, (const char **)&value->_canonical);
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical) && (format == LY_VALUE_CANON) &&
+            LY_ATOMIC_LOAD_ACQUIRE_PTR(subvalue->value._canonical)) {
+        /* the canonical value is supposed to be stored now, store it only once if printed concurrently */
+        canon = strdup(subvalue->value._canonical);
+        if (!canon || lydict_insert_zc_once(ctx, canon, (const char **)&value->_canonical)) {
+            LOGMEM(ctx);
+        }
     }
 
     return ret;
@@ -701,7 +689,7 @@ lyplg_type_dup_union(const struct ly_ctx *ctx, const struct lyd_value *original,
     memset(dup, 0, sizeof *dup);
     dup->realtype = original->realtype;
 
-    ret = lydict_insert(ctx, original->_canonical, 0, &dup->_canonical);
+    ret = lydict_insert(ctx, LY_ATOMIC_LOAD_ACQUIRE_PTR(original->_canonical), 0, &dup->_canonical);
     LY_CHECK_GOTO(ret, cleanup);
 
     dup_val = calloc(1, sizeof *dup_val);
@@ -724,6 +712,7 @@ lyplg_type_dup_union(const struct ly_ctx *ctx, const struct lyd_value *original,
     dup_val->format = orig_val->format;
     dup_val->ctx_node = orig_val->ctx_node;
     dup_val->hints = orig_val->hints;
+    dup_val->type_idx = orig_val->type_idx;
     ret = lyplg_type_prefix_data_dup(ctx, orig_val->format, orig_val->prefix_data, &dup_val->prefix_data);
     LY_CHECK_GOTO(ret, cleanup);
 
@@ -15,6 +15,7 @@
 #include "printer_data.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include "log.h"
 #include "ly_common.h"
@@ -22,6 +23,50 @@
 #include "out_internal.h"
 #include "printer_internal.h"
 #include "tree_data.h"
+#include "tree_data_internal.h"
+
+LY_ERR
+lyd_print_dflts_init(const struct lyd_node *parent, uint32_t options, struct lyd_print_dflts *pdflts)
+{
+    memset(pdflts, 0, sizeof *pdflts);
+
+    if (options & LYD_PRINT_WD_TRIM) {
+        /* default nodes not printed */
+        return LY_SUCCESS;
+    }
+
+    /* only the state default nodes are printed in the explicit mode */
+    LY_CHECK_RET(lyd_dflt_virtual_new(parent, NULL, NULL, (options & LYD_PRINT_WD_MASK) ? 0 : 1, &pdflts->dflts));
+    pdflts->next = pdflts->dflts;
+    if (pdflts->next) {
+        pdflts->anchor = lyd_insert_get_next_anchor(lyd_child(parent), pdflts->next);
+    }
+    return LY_SUCCESS;
+}
+
+const struct lyd_node *
+lyd_print_dflts_next(struct lyd_print_dflts *pdflts, const struct lyd_node *child)
+{
+    const struct lyd_node *dflt;
+
+    if (!pdflts->next || (child && (pdflts->anchor != child))) {
+        return NULL;
+    }
+
+    dflt = pdflts->next;
+    pdflts->next = pdflts->next->next;
+    if (pdflts->next) {
+        pdflts->anchor = lyd_insert_get_next_anchor(lyd_child(lyd_parent(dflt)), pdflts->next);
+    }
+    return dflt;
+}
+
+void
+lyd_print_dflts_erase(struct lyd_print_dflts *pdflts)
+{
+    lyd_dflt_virtual_free(pdflts->dflts);
+    memset(pdflts, 0, sizeof *pdflts);
+}
 
 static LY_ERR
 lyd_print_(struct ly_out *out, const struct lyd_node *root, LYD_FORMAT format, uint32_t options)
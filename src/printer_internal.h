@@ -87,6 +87,42 @@ LY_ERR yang_print_parsed_module(struct ly_out *out, const struct lysp_module *mo
 
 #define XML_NS_INDENT 8
 
+/**
+ * @brief Virtual default children of a data node being printed, see ::LY_CTX_VIRTUAL_DEFAULTS.
+ */
+struct lyd_print_dflts {
+    struct lyd_node *dflts;         /**< all the virtual default children in the schema order */
+    struct lyd_node *next;          /**< next virtual default child to print */
+    const struct lyd_node *anchor;  /**< child to print lyd_print_dflts.next before, NULL for after all the children */
+};
+
+/**
+ * @brief Create the virtual default children of a data node to print, if the printer options require them.
+ *
+ * @param[in] parent Data node whose children are being printed.
+ * @param[in] options [Data printer flags](@ref dataprinterflags).
+ * @param[out] pdflts Virtual default children to print.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_print_dflts_init(const struct lyd_node *parent, uint32_t options, struct lyd_print_dflts *pdflts);
+
+/**
+ * @brief Get the next virtual default child to print before a child, the function should be called until
+ * it returns NULL.
+ *
+ * @param[in,out] pdflts Virtual default children to print.
+ * @param[in] child Child to be printed next, NULL if all the children were printed.
+ * @return Virtual default child to print, NULL if there is none before @p child.
+ */
+const struct lyd_node *lyd_print_dflts_next(struct lyd_print_dflts *pdflts, const struct lyd_node *child);
+
+/**
+ * @brief Free the virtual default children to print.
+ *
+ * @param[in] pdflts Virtual default children to free.
+ */
+void lyd_print_dflts_erase(struct lyd_print_dflts *pdflts);
+
 /**
  * @brief YANG printer of the parsed submodule. Full YANG printer.
  *
@@ -673,17 +673,22 @@ json_print_any_content(struct jsonpr_ctx *pctx, struct lyd_node_any *any)
 static LY_ERR
 json_print_inner(struct jsonpr_ctx *pctx, const struct lyd_node *node)
 {
+    LY_ERR ret = LY_SUCCESS;
     struct lyd_node *child;
-    const struct lyd_node *prev_parent;
+    const struct lyd_node *prev_parent, *dflt;
     struct lyd_node_opaq *opaq = NULL;
+    struct lyd_print_dflts pdflts;
     ly_bool has_content = 0;
 
+    /* virtual default children */
+    LY_CHECK_RET(lyd_print_dflts_init(node, pctx->options, &pdflts));
+
     LY_LIST_FOR(lyd_child(node), child) {
         if (lyd_node_should_print(child, pctx->options)) {
             break;
         }
     }
-    if (node->meta || child) {
+    if (node->meta || child || pdflts.dflts) {
         has_content = 1;
     }
     if (!node->schema) {
@@ -706,7 +711,13 @@ json_print_inner(struct jsonpr_ctx *pctx, const struct lyd_node *node)
     prev_parent = pctx->parent;
     pctx->parent = node;
     LY_LIST_FOR(lyd_child(node), child) {
-        LY_CHECK_RET(json_print_node(pctx, child));
+        while ((dflt = lyd_print_dflts_next(&pdflts, child))) {
+            LY_CHECK_GOTO(ret = json_print_node(pctx, dflt), cleanup);
+        }
+        LY_CHECK_GOTO(ret = json_print_node(pctx, child), cleanup);
+    }
+    while ((dflt = lyd_print_dflts_next(&pdflts, NULL))) {
+        LY_CHECK_GOTO(ret = json_print_node(pctx, dflt), cleanup);
     }
     pctx->parent = prev_parent;
 
@@ -718,7 +729,9 @@ json_print_inner(struct jsonpr_ctx *pctx, const struct lyd_node *node)
     }
     LEVEL_PRINTED;
 
-    return LY_SUCCESS;
+cleanup:
+    lyd_print_dflts_erase(&pdflts);
+    return ret;
 }
 
 /**
@@ -397,17 +397,22 @@ cleanup:
 static LY_ERR
 xml_print_inner(struct xmlpr_ctx *pctx, const struct lyd_node_inner *node)
 {
-    LY_ERR ret;
+    LY_ERR ret = LY_SUCCESS;
     struct lyd_node *child;
+    const struct lyd_node *dflt;
+    struct lyd_print_dflts pdflts;
 
     xml_print_node_open(pctx, &node->node);
 
+    /* virtual default children */
+    LY_CHECK_RET(lyd_print_dflts_init(&node->node, pctx->options, &pdflts));
+
     LY_LIST_FOR(node->child, child) {
         if (lyd_node_should_print(child, pctx->options)) {
             break;
         }
     }
-    if (!child) {
+    if (!child && !pdflts.dflts) {
         /* there are no children that will be printed */
         ly_print_(pctx->out, "/>%s", DO_FORMAT ? "\n" : "");
         return LY_SUCCESS;
@@ -418,14 +423,24 @@ xml_print_inner(struct xmlpr_ctx *pctx, const struct lyd_node_inner *node)
 
     LEVEL_INC;
     LY_LIST_FOR(node->child, child) {
-        ret = xml_print_node(pctx, child);
-        LY_CHECK_ERR_RET(ret, LEVEL_DEC, ret);
+        while ((dflt = lyd_print_dflts_next(&pdflts, child))) {
+            LY_CHECK_GOTO(ret = xml_print_node(pctx, dflt), cleanup);
+        }
+        LY_CHECK_GOTO(ret = xml_print_node(pctx, child), cleanup);
+    }
+    while ((dflt = lyd_print_dflts_next(&pdflts, NULL))) {
+        LY_CHECK_GOTO(ret = xml_print_node(pctx, dflt), cleanup);
     }
     LEVEL_DEC;
 
     ly_print_(pctx->out, "%*s</%s>%s", INDENT, node->schema->name, DO_FORMAT ? "\n" : "");
 
-    return LY_SUCCESS;
+cleanup:
+    if (ret) {
+        LEVEL_DEC;
+    }
+    lyd_print_dflts_erase(&pdflts);
+    return ret;
 }
 
 static LY_ERR
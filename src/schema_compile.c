@@ -627,9 +627,10 @@ lys_compile_unres_when(struct lysc_ctx *ctx, const struct lysc_when *when, const
     struct lyxp_set tmp_set = {0};
     uint32_t i, opts;
     struct lysc_node *schema;
+    const struct lysc_node **atom;
     LY_ERR ret = LY_SUCCESS;
 
-    opts = LYXP_SCNODE_SCHEMA | ((node->flags & LYS_IS_OUTPUT) ? LYXP_SCNODE_OUTPUT : 0);
+    opts = LYXP_SCNODE_SCHEMA | LYXP_SCNODE_CACHE | ((node->flags & LYS_IS_OUTPUT) ? LYXP_SCNODE_OUTPUT : 0);
 
     /* check "when" */
     ret = lyxp_atomize(ctx->ctx, when->cond, node->module, LY_VALUE_SCHEMA_RESOLVED, when->prefixes, when->context,
@@ -639,6 +640,9 @@ lys_compile_unres_when(struct lysc_ctx *ctx, const struct lysc_when *when, const
         goto cleanup;
     }
 
+    /* specialize simple conditions */
+    LY_CHECK_GOTO(ret = lyxp_expr_specialize(ctx->ctx, when->cond, node->module, when->prefixes, when->context), cleanup);
+
     ctx->path[0] = '\0';
     lysc_path(node, LYSC_PATH_LOG, ctx->path, LYSC_CTX_BUFSIZE);
     for (i = 0; i < tmp_set.used; ++i) {
@@ -671,6 +675,19 @@ lys_compile_unres_when(struct lysc_ctx *ctx, const struct lysc_when *when, const
         }
     }
 
+    /* remember the nodes the condition depends on so that its results can be memoized during validation */
+    LY_ARRAY_FREE(when->cond->atoms);
+    when->cond->atoms = NULL;
+    for (i = 0; i < tmp_set.used; ++i) {
+        if ((tmp_set.val.scnodes[i].type != LYXP_NODE_ELEM) ||
+                (tmp_set.val.scnodes[i].in_ctx == LYXP_SET_SCNODE_START_USED)) {
+            continue;
+        }
+
+        LY_ARRAY_NEW_GOTO(ctx->ctx, when->cond->atoms, atom, ret, cleanup);
+        *atom = tmp_set.val.scnodes[i].scnode;
+    }
+
     if (when->context != node) {
         /* node actually depends on this "when", not the context node */
         assert(tmp_set.val.scnodes[0].scnode == when->context);
@@ -714,7 +731,7 @@ lys_compile_unres_must(struct lysc_ctx *ctx, const struct lysc_node *node, const
     LOG_LOCSET(node, NULL);
 
     memset(&tmp_set, 0, sizeof tmp_set);
-    opts = LYXP_SCNODE_SCHEMA | ((node->flags & LYS_IS_OUTPUT) ? LYXP_SCNODE_OUTPUT : 0);
+    opts = LYXP_SCNODE_SCHEMA | LYXP_SCNODE_CACHE | ((node->flags & LYS_IS_OUTPUT) ? LYXP_SCNODE_OUTPUT : 0);
 
     musts = lysc_node_musts(node);
     LY_ARRAY_FOR(musts, u) {
@@ -726,6 +743,10 @@ lys_compile_unres_must(struct lysc_ctx *ctx, const struct lysc_node *node, const
             goto cleanup;
         }
 
+        /* specialize simple conditions */
+        ret = lyxp_expr_specialize(ctx->ctx, musts[u].cond, node->module, musts[u].prefixes, node);
+        LY_CHECK_GOTO(ret, cleanup);
+
         ctx->path[0] = '\0';
         lysc_path(node, LYSC_PATH_LOG, ctx->path, LYSC_CTX_BUFSIZE);
         for (i = 0; i < tmp_set.used; ++i) {
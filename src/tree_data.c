@@ -82,6 +82,51 @@ lyd_parse_get_format(const struct ly_in *in, LYD_FORMAT format)
     return format;
 }
 
+/**
+ * @brief Drop the cached getnext schema nodes of a pooled data parser context.
+ *
+ * @param[in] lydctx Pooled data parser context.
+ */
+static void
+lyd_parser_getnext_clear(struct lyd_ctx *lydctx)
+{
+    lyd_val_getnext_ht_free(lydctx->val_getnext_ht);
+    lydctx->val_getnext_ht = NULL;
+    lydctx->val_getnext_ht_mod = NULL;
+}
+
+/**
+ * @brief Get the pooled data parser context of a parser handle for a format.
+ *
+ * @param[in] parser Parser handle, may be NULL.
+ * @param[in] format Format of the data to parse.
+ * @return Pooled data parser context to reuse, NULL if none.
+ */
+static struct lyd_ctx *
+lyd_parser_pooled(struct lyd_parser *parser, LYD_FORMAT format)
+{
+    if (!parser) {
+        return NULL;
+    }
+
+    if (parser->change_count != ly_ctx_get_change_count(parser->ctx)) {
+        /* the cached schema nodes may have been freed */
+        lyd_parser_getnext_clear(parser->xml);
+        lyd_parser_getnext_clear(parser->json);
+        parser->change_count = ly_ctx_get_change_count(parser->ctx);
+    }
+
+    switch (format) {
+    case LYD_XML:
+        return parser->xml;
+    case LYD_JSON:
+        return parser->json;
+    default:
+        /* not pooled */
+        return NULL;
+    }
+}
+
 /**
  * @brief Parse YANG data into a data tree.
  *
@@ -93,12 +138,14 @@ lyd_parse_get_format(const struct ly_in *in, LYD_FORMAT format)
  * @param[in] format Expected format of the data in @p in.
  * @param[in] parse_opts Options for parser.
  * @param[in] val_opts Options for validation.
+ * @param[in] parser Optional parser handle with pooled parser contexts to use.
  * @param[out] op Optional pointer to the parsed operation, if any.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_parse(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent, struct lyd_node **first_p,
-        struct ly_in *in, LYD_FORMAT format, uint32_t parse_opts, uint32_t val_opts, struct lyd_node **op)
+        struct ly_in *in, LYD_FORMAT format, uint32_t parse_opts, uint32_t val_opts, struct lyd_parser *parser,
+        struct lyd_node **op)
 {
     LY_ERR r = LY_SUCCESS, rc = LY_SUCCESS;
     struct lyd_ctx *lydctx = NULL;
@@ -122,6 +169,9 @@ lyd_parse(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct
         int_opts = LYD_INTOPT_WITH_SIBLINGS;
     }
 
+    /* reuse a pooled parser context, if any */
+    lydctx = lyd_parser_pooled(parser, format);
+
     /* parse the data */
     switch (format) {
     case LYD_XML:
@@ -141,6 +191,11 @@ lyd_parse(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct
         r = LY_EINVAL;
         break;
     }
+    if (LYD_PARSER_INSERT_ORDER(parse_opts) == LYD_INSERT_NODE_BULK) {
+        /* sort and hash the parsed top-level nodes, the parsers did so for the children of all the inner nodes */
+        rc = lyd_insert_bulk_finish(parent, parent ? NULL : first_p);
+        LY_CHECK_GOTO(rc, cleanup);
+    }
     if (r) {
         rc = r;
         if ((r != LY_EVALID) || !lydctx || !(lydctx->val_opts & LYD_VALIDATE_MULTI_ERROR)) {
@@ -215,7 +270,7 @@ lyd_parse_ext_data(const struct lysc_ext_instance *ext, struct lyd_node *parent,
     LY_CHECK_ARG_RET(ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), LY_EINVAL);
     LY_CHECK_ARG_RET(ctx, !(validate_options & ~LYD_VALIDATE_OPTS_MASK), LY_EINVAL);
 
-    return lyd_parse(ctx, ext, parent, tree, in, format, parse_options, validate_options, NULL);
+    return lyd_parse(ctx, ext, parent, tree, in, format, parse_options, validate_options, NULL, NULL);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -230,7 +285,7 @@ lyd_parse_data(const struct ly_ctx *ctx, struct lyd_node *parent, struct ly_in *
         ctx = LYD_CTX(parent);
     }
 
-    return lyd_parse(ctx, NULL, parent, tree, in, format, parse_options, validate_options, NULL);
+    return lyd_parse(ctx, NULL, parent, tree, in, format, parse_options, validate_options, NULL, NULL);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -289,6 +344,7 @@ lyd_parse_data_path(const struct ly_ctx *ctx, const char *path, LYD_FORMAT forma
  * @param[in] in Input handle to read the input from.
  * @param[in] format Expected format of the data in @p in.
  * @param[in] data_type Expected operation to parse (@ref datatype).
+ * @param[in] parser Optional parser handle with pooled parser contexts to use.
  * @param[out] tree Optional full parsed data tree. If @p parent is set, set to NULL.
  * @param[out] op Optional parsed operation node.
  * @return LY_ERR value.
@@ -296,7 +352,8 @@ lyd_parse_data_path(const struct ly_ctx *ctx, const char *path, LYD_FORMAT forma
  */
 static LY_ERR
 lyd_parse_op_(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
-        struct ly_in *in, LYD_FORMAT format, enum lyd_type data_type, struct lyd_node **tree, struct lyd_node **op)
+        struct ly_in *in, LYD_FORMAT format, enum lyd_type data_type, struct lyd_parser *parser, struct lyd_node **tree,
+        struct lyd_node **op)
 {
     LY_ERR rc = LY_SUCCESS;
     struct lyd_ctx *lydctx = NULL;
@@ -320,6 +377,9 @@ lyd_parse_op_(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, str
     /* remember input position */
     in->func_start = in->current;
 
+    /* reuse a pooled parser context, if any */
+    lydctx = lyd_parser_pooled(parser, format);
+
     /* set parse and validation opts */
     parse_opts = LYD_PARSE_ONLY | LYD_PARSE_STRICT;
     val_opts = 0;
@@ -447,7 +507,7 @@ lyd_parse_op(const struct ly_ctx *ctx, struct lyd_node *parent, struct ly_in *in
 {
     LY_CHECK_ARG_RET(ctx, ctx || parent, in, data_type, parent || tree || op, LY_EINVAL);
 
-    return lyd_parse_op_(ctx, NULL, parent, in, format, data_type, tree, op);
+    return lyd_parse_op_(ctx, NULL, parent, in, format, data_type, NULL, tree, op);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -458,7 +518,64 @@ lyd_parse_ext_op(const struct lysc_ext_instance *ext, struct lyd_node *parent, s
 
     LY_CHECK_ARG_RET(ctx, ext, in, data_type, parent || tree || op, LY_EINVAL);
 
-    return lyd_parse_op_(ctx, ext, parent, in, format, data_type, tree, op);
+    return lyd_parse_op_(ctx, ext, parent, in, format, data_type, NULL, tree, op);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_parser_new(const struct ly_ctx *ctx, struct lyd_parser **parser)
+{
+    LY_ERR rc = LY_SUCCESS;
+
+    LY_CHECK_ARG_RET(ctx, ctx, parser, LY_EINVAL);
+
+    *parser = calloc(1, sizeof **parser);
+    LY_CHECK_ERR_RET(!*parser, LOGMEM(ctx), LY_EMEM);
+    (*parser)->ctx = ctx;
+    (*parser)->change_count = ly_ctx_get_change_count(ctx);
+
+    LY_CHECK_GOTO(rc = lyd_xml_ctx_new_pooled(ctx, &(*parser)->xml), cleanup);
+    LY_CHECK_GOTO(rc = lyd_json_ctx_new_pooled(ctx, &(*parser)->json), cleanup);
+
+cleanup:
+    if (rc) {
+        lyd_parser_free(*parser);
+        *parser = NULL;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_parser_parse_data(struct lyd_parser *parser, struct lyd_node *parent, struct ly_in *in, LYD_FORMAT format,
+        uint32_t parse_options, uint32_t validate_options, struct lyd_node **tree)
+{
+    LY_CHECK_ARG_RET(NULL, parser, in, parent || tree, LY_EINVAL);
+    LY_CHECK_ARG_RET(parser->ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), LY_EINVAL);
+    LY_CHECK_ARG_RET(parser->ctx, !(validate_options & ~LYD_VALIDATE_OPTS_MASK), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parser->ctx, parent ? LYD_CTX(parent) : NULL, LY_EINVAL);
+
+    return lyd_parse(parser->ctx, NULL, parent, tree, in, format, parse_options, validate_options, parser, NULL);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_parser_parse_op(struct lyd_parser *parser, struct lyd_node *parent, struct ly_in *in, LYD_FORMAT format,
+        enum lyd_type data_type, struct lyd_node **tree, struct lyd_node **op)
+{
+    LY_CHECK_ARG_RET(NULL, parser, in, data_type, parent || tree || op, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parser->ctx, parent ? LYD_CTX(parent) : NULL, LY_EINVAL);
+
+    return lyd_parse_op_(parser->ctx, NULL, parent, in, format, data_type, parser, tree, op);
+}
+
+LIBYANG_API_DEF void
+lyd_parser_free(struct lyd_parser *parser)
+{
+    if (!parser) {
+        return;
+    }
+
+    lyd_xml_ctx_free(parser->xml);
+    lyd_json_ctx_free(parser->json);
+    free(parser);
 }
 
 struct lyd_node *
@@ -741,6 +858,134 @@ lyd_insert_node_ordby_schema(struct lyd_node *parent, struct lyd_node **first_si
     }
 }
 
+/**
+ * @brief Insert @p node as the last instance according to the schema, quickly if it can be appended.
+ *
+ * @param[in] parent Parent to insert into, NULL for top-level sibling.
+ * @param[in,out] first_sibling First sibling, NULL if no top-level sibling exist yet.
+ * Can be also NULL if @p parent is set.
+ * @param[in] node Individual node (without siblings) to insert.
+ */
+static void
+lyd_insert_node_bulk(struct lyd_node *parent, struct lyd_node **first_sibling, struct lyd_node *node)
+{
+    const struct lysc_node *schema, *sparent;
+    const struct lys_module *mod;
+    struct lyd_node *last;
+    uint32_t getnext_opts;
+
+    last = *first_sibling ? (*first_sibling)->prev : NULL;
+    if (!last || !last->schema || (LYD_CTX(last) != LYD_CTX(node))) {
+        goto ordby_schema;
+    }
+
+    /* the node can be appended if the last sibling is an instance of the same or a preceding schema node */
+    sparent = lysc_data_parent(node->schema);
+    mod = lyd_owner_module(node);
+    if (!sparent && (lyd_owner_module(last) != mod)) {
+        if (strcmp(lyd_owner_module(last)->name, mod->name) < 0) {
+            goto append;
+        }
+        goto ordby_schema;
+    }
+
+    getnext_opts = (node->schema->flags & LYS_IS_OUTPUT) ? LYS_GETNEXT_OUTPUT : 0;
+    for (schema = last->schema; schema && (schema != node->schema);
+            schema = lys_getnext(schema, sparent, sparent ? NULL : mod->compiled, getnext_opts)) {}
+    if (schema) {
+        goto append;
+    }
+
+ordby_schema:
+    lyd_insert_node_ordby_schema(parent, first_sibling, node);
+    return;
+
+append:
+    lyd_insert_node_last(parent, first_sibling, node);
+}
+
+/**
+ * @brief Sort the (leaf-)lists with appended instances of a parent with a children hash table.
+ *
+ * The inserted nodes were added into the hash table so the (leaf-)lists are found by their schema nodes and
+ * none of the other children are visited.
+ *
+ * @param[in] parent Parent of the inserted nodes.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_insert_bulk_finish_hashed(struct lyd_node *parent)
+{
+    const struct lysc_node *snode = NULL;
+    struct lyd_node *first, *iter, *leader, *prev_leader, *last;
+    uint32_t getnext_opts = 0;
+
+    first = lyd_child(parent);
+    for (iter = first; iter && !iter->schema; iter = iter->next) {}
+    if (iter && (iter->schema->flags & LYS_IS_OUTPUT)) {
+        getnext_opts = LYS_GETNEXT_OUTPUT;
+    }
+
+    while ((snode = lys_getnext(snode, parent->schema, NULL, getnext_opts))) {
+        if (!(snode->nodetype & (LYS_LIST | LYS_LEAFLIST)) || lyd_find_sibling_schema(first, snode, &leader) ||
+                !lyds_is_supported(leader)) {
+            continue;
+        }
+
+        prev_leader = leader;
+        LY_CHECK_RET(lyds_build_appended(&first, &leader, &last));
+
+        /* the first instance may have been moved without updating the hash table */
+        LY_CHECK_RET(lyd_find_sibling_schema(first, snode, &prev_leader));
+        LY_CHECK_RET(lyd_insert_hash_first_inst(prev_leader, leader));
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyd_insert_bulk_finish(struct lyd_node *parent, struct lyd_node **first_sibling)
+{
+    struct lyd_node *first, *iter, *leader;
+
+    assert(parent || first_sibling);
+
+    first = parent ? lyd_child(parent) : *first_sibling;
+    if (!first) {
+        return LY_SUCCESS;
+    }
+
+    if (parent && parent->schema && ((struct lyd_node_inner *)parent)->children_ht) {
+        /* the nodes were hashed when inserted, only the (leaf-)lists with appended instances are sorted */
+        if (!(first->flags & LYD_EXT)) {
+            LY_CHECK_RET(lyd_insert_bulk_finish_hashed(parent));
+        }
+        return LY_SUCCESS;
+    }
+
+    if (!(first->flags & LYD_EXT)) {
+        /* sort the (leaf-)lists, the instances of those with a BST and no appended instances are skipped */
+        for (iter = first; iter; iter = iter->next) {
+            if (!LYDS_NODE_IS_LEADER(iter)) {
+                continue;
+            }
+
+            leader = iter;
+            LY_CHECK_RET(lyds_build_appended(&first, &leader, &iter));
+        }
+    }
+
+    if (parent && parent->schema) {
+        /* create the hash table with its final size */
+        LY_CHECK_RET(lyd_insert_hash_all(parent));
+    }
+    if (!parent) {
+        *first_sibling = first;
+    }
+
+    return LY_SUCCESS;
+}
+
 void
 lyd_insert_node(struct lyd_node *parent, struct lyd_node **first_sibling_p, struct lyd_node *node, uint32_t order)
 {
@@ -761,6 +1006,8 @@ lyd_insert_node(struct lyd_node *parent, struct lyd_node **first_sibling_p, stru
         lyd_insert_node_last(parent, &first_sibling, node);
     } else if (order == LYD_INSERT_NODE_LAST_BY_SCHEMA) {
         lyd_insert_node_ordby_schema(parent, &first_sibling, node);
+    } else if (order == LYD_INSERT_NODE_BULK) {
+        lyd_insert_node_bulk(parent, &first_sibling, node);
     } else if (lyds_is_supported(node) &&
             (lyd_find_sibling_schema(first_sibling, node->schema, &leader) == LY_SUCCESS)) {
         ret = lyds_insert(&first_sibling, &leader, node);
@@ -776,7 +1023,13 @@ lyd_insert_node(struct lyd_node *parent, struct lyd_node **first_sibling_p, stru
     }
 
     /* insert into parent HT */
-    lyd_insert_hash(node);
+    if ((order != LYD_INSERT_NODE_BULK) ||
+            (parent && parent->schema && ((struct lyd_node_inner *)parent)->children_ht)) {
+        lyd_insert_hash(node);
+    } else {
+        /* the HT is created once all the siblings are inserted */
+        lyd_uniq_idx_update(node, 0);
+    }
 
     /* finish hashes for our parent, if needed and possible */
     if (node->schema && (node->schema->flags & LYS_KEY) && parent && parent->schema && lyd_insert_has_keys(parent)) {
@@ -1101,6 +1354,86 @@ lyd_insert_sibling(struct lyd_node *sibling, struct lyd_node *node, struct lyd_n
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Insert several nodes into parent/siblings at once.
+ *
+ * @param[in] parent Parent to insert into, NULL for top-level siblings.
+ * @param[in] sibling Sibling to insert next to, used only if @p parent is not set, may be NULL.
+ * @param[in] nodes Nodes to insert, are unlinked first.
+ * @param[in] count Count of @p nodes.
+ * @param[out] first Optional first sibling after insertion.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_insert_bulk(struct lyd_node *parent, struct lyd_node *sibling, struct lyd_node **nodes, uint32_t count,
+        struct lyd_node **first)
+{
+    LY_ERR rc;
+    struct lyd_node *first_sibling;
+    uint32_t i;
+
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_RET(lyd_unlink_check(nodes[i]));
+    }
+
+    /* unlink all the nodes first, they may be siblings of each other */
+    for (i = 0; i < count; ++i) {
+        lyd_unlink(nodes[i]);
+    }
+
+    /* append all the nodes */
+    if (!parent && sibling) {
+        parent = lyd_parent(sibling);
+    }
+    first_sibling = parent ? NULL : lyd_first_sibling(sibling);
+    for (i = 0; i < count; ++i) {
+        lyd_insert_node(parent, &first_sibling, nodes[i], LYD_INSERT_NODE_BULK);
+    }
+
+    /* sort them and create the hash table */
+    rc = lyd_insert_bulk_finish(parent, &first_sibling);
+
+    if (first) {
+        *first = parent ? lyd_child(parent) : first_sibling;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_insert_child_bulk(struct lyd_node *parent, struct lyd_node **nodes, uint32_t count)
+{
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(NULL, parent, nodes || !count, !parent->schema || (parent->schema->nodetype & LYD_NODE_INNER),
+            LY_EINVAL);
+
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_ARG_RET(NULL, nodes[i], nodes[i] != parent, LY_EINVAL);
+        LY_CHECK_CTX_EQUAL_RET(__func__, LYD_CTX(parent), LYD_CTX(nodes[i]), LY_EINVAL);
+        LY_CHECK_RET(lyd_insert_check_schema(parent->schema, NULL, nodes[i]->schema));
+    }
+
+    return lyd_insert_bulk(parent, NULL, nodes, count, NULL);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_insert_sibling_bulk(struct lyd_node *sibling, struct lyd_node **nodes, uint32_t count, struct lyd_node **first)
+{
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(NULL, nodes || !count, LY_EINVAL);
+
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_ARG_RET(NULL, nodes[i], nodes[i] != sibling, LY_EINVAL);
+        if (sibling) {
+            LY_CHECK_CTX_EQUAL_RET(__func__, LYD_CTX(sibling), LYD_CTX(nodes[i]), LY_EINVAL);
+            LY_CHECK_RET(lyd_insert_check_schema(NULL, sibling->schema, nodes[i]->schema));
+        }
+    }
+
+    return lyd_insert_bulk(NULL, sibling, nodes, count, first);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_insert_before(struct lyd_node *sibling, struct lyd_node *node)
 {
@@ -2270,8 +2603,10 @@ lyd_dup_r(const struct lyd_node *node, const struct ly_ctx *trg_ctx, struct lyd_
         if (options & LYD_DUP_RECURSIVE) {
             /* create a hash table with the size of the previous hash table (duplicate) */
             if (orig->children_ht) {
-                ((struct lyd_node_inner *)dup)->children_ht = lyht_new(orig->children_ht->size,
+                ((struct lyd_node_inner *)dup)->children_ht = lyht_new_open(orig->children_ht->size,
                         sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
+                LY_CHECK_ERR_GOTO(!((struct lyd_node_inner *)dup)->children_ht, LOGMEM(trg_ctx); rc = LY_EMEM, cleanup);
+                lyht_set_resize_step(((struct lyd_node_inner *)dup)->children_ht, LYHT_RESIZE_STEP);
             }
 
             /* duplicate all the children */
@@ -3410,6 +3745,20 @@ lyd_find_sibling_opaq_next(const struct lyd_node *first, const char *name, struc
     return first ? LY_SUCCESS : LY_ENOTFOUND;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_find_child_dflt(struct lyd_node *parent, const struct lysc_node *schema, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, parent, schema, schema->nodetype & LYD_NODE_TERM, LY_EINVAL);
+
+    if (!lyd_find_sibling_val(lyd_child(parent), schema, NULL, 0, match)) {
+        return LY_SUCCESS;
+    }
+
+    /* create the virtual default node(s) and find the first */
+    LY_CHECK_RET(lyd_dflt_materialize(parent, schema->module, schema->name));
+    return lyd_find_sibling_val(lyd_child(parent), schema, NULL, 0, match);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_find_xpath(const struct lyd_node *ctx_node, const char *xpath, struct ly_set **set)
 {
@@ -3489,7 +3838,8 @@ lyd_eval_xpath4(const struct lyd_node *ctx_node, const struct lyd_node *tree, co
             LY_CHECK_ERR_GOTO(!(*node_set)->objs, LOGMEM(LYD_CTX(tree)); ret = LY_EMEM, cleanup);
             (*node_set)->size = xp_set.used;
             for (i = 0; i < xp_set.used; ++i) {
-                if (xp_set.val.nodes[i].type == LYXP_NODE_ELEM) {
+                if ((xp_set.val.nodes[i].type == LYXP_NODE_ELEM) && !(xp_set.val.nodes[i].node->flags & LYD_VIRTUAL)) {
+                    /* virtual default nodes are freed with the XPath set */
                     ret = ly_set_add(*node_set, xp_set.val.nodes[i].node, 1, NULL);
                     LY_CHECK_GOTO(ret, cleanup);
                 }
@@ -3736,6 +4086,137 @@ lyd_find_target(const struct ly_path *path, const struct lyd_node *tree, struct
     return LY_SUCCESS;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_path_compile(const struct ly_ctx *ctx, const struct lysc_node *ctx_node, const char *path, ly_bool output,
+        struct lyd_path_handle **handle)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyxp_expr *expr = NULL;
+    struct lyd_path_handle *h = NULL;
+    const char **vars;
+    LY_ARRAY_COUNT_TYPE u, v;
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(ctx, ctx, path, (path[0] == '/') || ctx_node, handle, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, ctx, ctx_node ? ctx_node->module->ctx : NULL, LY_EINVAL);
+
+    h = calloc(1, sizeof *h);
+    LY_CHECK_ERR_GOTO(!h, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+    h->ctx = ctx;
+    h->ctx_node = (path[0] == '/') ? NULL : ctx_node;
+    h->output = output;
+    h->str_path = strdup(path);
+    LY_CHECK_ERR_GOTO(!h->str_path, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+
+    /* parse the path */
+    ret = ly_path_parse(ctx, ctx_node, path, 0, 0, LY_PATH_BEGIN_EITHER, LY_PATH_PREFIX_FIRST, LY_PATH_PRED_SIMPLE, &expr);
+    LY_CHECK_GOTO(ret, cleanup);
+
+    /* compile the path */
+    ret = ly_path_compile(ctx, NULL, h->ctx_node, NULL, expr, output ? LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT,
+            LY_PATH_TARGET_MANY, 0, LY_VALUE_JSON, NULL, &h->path);
+    LY_CHECK_GOTO(ret, cleanup);
+
+    /* collect all the variables */
+    LY_ARRAY_FOR(h->path, u) {
+        LY_ARRAY_FOR(h->path[u].predicates, v) {
+            if (h->path[u].predicates[v].type != LY_PATH_PREDTYPE_LIST_VAR) {
+                continue;
+            }
+
+            for (i = 0; i < h->var_count; ++i) {
+                if (!strcmp(h->vars[i], h->path[u].predicates[v].variable)) {
+                    break;
+                }
+            }
+            if (i < h->var_count) {
+                /* already used */
+                continue;
+            }
+
+            vars = realloc(h->vars, (h->var_count + 1) * sizeof *h->vars);
+            LY_CHECK_ERR_GOTO(!vars, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+            h->vars = vars;
+            h->vars[h->var_count++] = h->path[u].predicates[v].variable;
+        }
+    }
+
+cleanup:
+    lyxp_expr_free(ctx, expr);
+    if (ret) {
+        lyd_path_handle_free(h);
+    } else {
+        *handle = h;
+    }
+    return ret;
+}
+
+LIBYANG_API_DEF uint32_t
+lyd_path_handle_var_count(const struct lyd_path_handle *handle)
+{
+    LY_CHECK_ARG_RET(NULL, handle, 0);
+
+    return handle->var_count;
+}
+
+LIBYANG_API_DEF void
+lyd_path_handle_free(struct lyd_path_handle *handle)
+{
+    if (!handle) {
+        return;
+    }
+
+    free(handle->str_path);
+    ly_path_free(handle->path);
+    free(handle->vars);
+    free(handle);
+}
+
+LY_ERR
+lyd_path_handle_vars(const struct lyd_path_handle *handle, const char **args, struct lyxp_var **vars)
+{
+    uint32_t i;
+
+    *vars = NULL;
+    if (!handle->var_count) {
+        return LY_SUCCESS;
+    }
+
+    LY_CHECK_ARG_RET(handle->ctx, args, LY_EINVAL);
+    for (i = 0; i < handle->var_count; ++i) {
+        LY_CHECK_ARG_RET(handle->ctx, args[i], LY_EINVAL);
+    }
+
+    LY_ARRAY_CREATE_RET(handle->ctx, *vars, handle->var_count, LY_EMEM);
+    for (i = 0; i < handle->var_count; ++i) {
+        LY_ARRAY_INCREMENT(*vars);
+        (*vars)[i].name = (char *)handle->vars[i];
+        (*vars)[i].value = (char *)args[i];
+    }
+
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_find_path_handle(const struct lyd_node *ctx_node, const struct lyd_path_handle *handle, const char **args,
+        struct lyd_node **match)
+{
+    LY_ERR ret;
+    struct lyxp_var *vars = NULL;
+
+    LY_CHECK_ARG_RET(NULL, ctx_node, handle, !handle->ctx_node || (ctx_node->schema == handle->ctx_node), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, LYD_CTX(ctx_node), handle->ctx, LY_EINVAL);
+
+    /* bind the variables */
+    LY_CHECK_RET(lyd_path_handle_vars(handle, args, &vars));
+
+    /* evaluate the path */
+    ret = ly_path_eval_partial(handle->path, ctx_node, vars, 0, NULL, match);
+
+    LY_ARRAY_FREE(vars);
+    return ret;
+}
+
 LY_ERR
 lyd_get_or_create_leafref_links_record(const struct lyd_node_term *node, struct lyd_leafref_links_rec **record, ly_bool create)
 {
@@ -39,6 +39,7 @@ struct ly_path;
 struct ly_set;
 struct lyd_node;
 struct lyd_node_opaq;
+struct lyd_path_handle;
 struct lyd_node_term;
 struct timespec;
 struct lyxp_var;
@@ -91,6 +92,7 @@ struct rb_node;
  * - @subpage howtoDataManipulation
  * - @subpage howtoDataPrinters
  * - @subpage howtoDataLYB
+ * - @subpage howtoNACM
  *
  * \note API for this group of functions is described in the [Data Instances module](@ref datatree).
  *
@@ -108,6 +110,7 @@ struct rb_node;
  * - ::lyd_find_sibling_val()
  * - ::lyd_find_sibling_first()
  * - ::lyd_find_sibling_opaq_next()
+ * - ::lyd_find_child_dflt()
  * - ::lyd_find_meta()
  *
  * - ::lyd_path()
@@ -115,6 +118,8 @@ struct rb_node;
  *
  * - ::lyd_lyb_data_length()
  *
+ * - ::lyd_freeze()
+ *
  *
  * @section howtoDataMetadata Metadata Support
  *
@@ -234,7 +239,7 @@ struct rb_node;
  * Creating data is generally possible in two ways, they can be combined. You can add nodes one-by-one based on
  * the node name and/or its parent (::lyd_new_inner(), ::lyd_new_term(), ::lyd_new_any(), ::lyd_new_list(), ::lyd_new_list2()
  * and ::lyd_new_opaq()) or address the nodes using a [simple XPath addressing](@ref howtoXPath) (::lyd_new_path() and
- * ::lyd_new_path2()). The latter enables to create a whole path of nodes, requires less information
+ * ::lyd_new_path2(), or ::lyd_new_paths() for many paths at once). The latter enables to create a whole path of nodes, requires less information
  * about the modified data, and is generally simpler to use. Actually the third way is duplicating the existing data using
  * ::lyd_dup_single(), ::lyd_dup_siblings() and ::lyd_dup_meta_single().
  *
@@ -301,6 +306,8 @@ struct rb_node;
  *
  * - ::lyd_insert_child()
  * - ::lyd_insert_sibling()
+ * - ::lyd_insert_child_bulk()
+ * - ::lyd_insert_sibling_bulk()
  * - ::lyd_insert_after()
  * - ::lyd_insert_before()
  *
@@ -630,6 +637,7 @@ struct lyd_value_union {
                                       (instance-identifier in XML looks different than in JSON). */
     void *prefix_data;           /**< Format-specific data for prefix resolution (see ly_resolve_prefix()) */
     const struct lysc_node *ctx_node;   /**< Context schema node. */
+    uint32_t type_idx;           /**< Index of the union's subtype the value is stored as (in ::lysc_type_union.types). */
 };
 
 /**
@@ -778,6 +786,8 @@ struct lyd_attr {
  *       3 LYD_NEW          |x|x|x|x|x|x|x|
  *                          +-+-+-+-+-+-+-+
  *       4 LYD_EXT          |x|x|x|x|x|x|x|
+ *                          +-+-+-+-+-+-+-+
+ *       5 LYD_VIRTUAL      | | |x|x| | | |
  *     ---------------------+-+-+-+-+-+-+-+
  *
  */
@@ -786,6 +796,7 @@ struct lyd_attr {
 #define LYD_WHEN_TRUE   0x02        /**< all when conditions of this node were evaluated to true */
 #define LYD_NEW         0x04        /**< node was created after the last validation, is needed for the next validation */
 #define LYD_EXT         0x08        /**< node is the first sibling parsed as extension instance data */
+#define LYD_VIRTUAL     0x10        /**< virtual default node (::LY_CTX_VIRTUAL_DEFAULTS), not a child of its parent */
 
 /** @} */
 
@@ -1176,7 +1187,9 @@ lyd_get_value(const struct lyd_node *node)
     } else if (node->schema->nodetype & LYD_NODE_TERM) {
         const struct lyd_value *value = &((const struct lyd_node_term *)node)->value;
 
-        return value->_canonical ? value->_canonical : lyd_value_get_canonical(LYD_CTX(node), value);
+        const char *canon = LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical);
+
+        return canon ? canon : lyd_value_get_canonical(LYD_CTX(node), value);
     }
 
     return NULL;
@@ -1219,6 +1232,19 @@ LIBYANG_API_DECL const struct lysc_node *lyd_node_schema(const struct lyd_node *
  */
 LIBYANG_API_DECL ly_bool lyd_meta_is_internal(const struct lyd_meta *meta);
 
+/**
+ * @brief Freeze a data tree for concurrent read-only access.
+ *
+ * Some information of a data tree, such as canonical values of some types or schema node hashes used by the LYB
+ * format, is generated only when it is first needed. Freezing generates all of it so that no function reading
+ * the tree writes into it anymore and any number of threads can search, print, and compare the tree at the same
+ * time without any synchronization. Once the tree is modified, it needs to be frozen again, see @ref howtoThreads.
+ *
+ * @param[in] tree Any node of the data tree, all its siblings and their descendants are frozen. Can be NULL.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_freeze(struct lyd_node *tree);
+
 /**
  * @brief Create a new inner node in the data tree.
  *
@@ -1621,6 +1647,59 @@ LIBYANG_API_DECL LY_ERR lyd_new_path2(struct lyd_node *parent, const struct ly_c
 LIBYANG_API_DECL LY_ERR lyd_new_ext_path(struct lyd_node *parent, const struct lysc_ext_instance *ext, const char *path,
         const void *value, uint32_t options, struct lyd_node **node);
 
+/**
+ * @brief Create several new nodes in a data tree at once, each of them using a path. Semantically equal to calling
+ * ::lyd_new_path() for each of the @p paths in order.
+ *
+ * All the @p paths are parsed and compiled first so no nodes are created if any of them is invalid. The nodes created
+ * for the leading path segments shared with the previous path are remembered and the rest of the path is created
+ * relative to them so the common prefix is not searched for repeatedly. It is therefore most efficient when
+ * the @p paths are sorted so that paths to siblings follow each other. The nodes are inserted in bulk, the instances
+ * of the (leaf-)lists ordered by the system are sorted only once all the paths are created
+ * (see ::lyd_insert_child_bulk()). Errors are always reported for the whole path as passed in @p paths.
+ *
+ * Details are mentioned in ::lyd_new_path().
+ *
+ * @param[in] parent Data parent to add to/modify, can be NULL.
+ * @param[in] ctx libyang context, must be set if @p parent is NULL.
+ * @param[in] paths Array of [paths](@ref howtoXPath) to create, must all be absolute if @p parent is NULL.
+ * @param[in] values Optional array of values of the new leaves/leaf-lists, indexed the same as @p paths.
+ * Set the particular item to NULL for other node types.
+ * @param[in] count Number of items in @p paths (and @p values).
+ * @param[in] options Bitmask of options, see @ref pathoptions. ::LYD_NEW_VAL_BIN is not supported.
+ * @param[out] tree First top-level sibling of the created tree, must be set if @p parent is NULL. On error,
+ * all the nodes created are freed if @p parent is NULL, otherwise the nodes created so far are kept.
+ * @return LY_SUCCESS on success.
+ * @return LY_EEXIST if a final node to create exists (unless ::LYD_NEW_PATH_UPDATE is used).
+ * @return LY_EINVAL on invalid arguments including invalid path.
+ * @return LY_EVALID on invalid value.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_new_paths(struct lyd_node *parent, const struct ly_ctx *ctx, const char **paths,
+        const char **values, uint32_t count, uint32_t options, struct lyd_node **tree);
+
+/**
+ * @brief Create a new node in the data tree based on a compiled path handle.
+ *
+ * Works the same as ::lyd_new_path() but without any path parsing. ::LYD_NEW_VAL_OUTPUT is ignored, the flag
+ * used when compiling @p handle applies.
+ *
+ * @param[in] parent Data parent to add to/modify, can be NULL. Must be an instance of the context node of @p handle,
+ * if it was compiled with one.
+ * @param[in] handle Compiled path handle, see ::lyd_path_compile().
+ * @param[in] args Values of the @p handle variables (in JSON format), ::lyd_path_handle_var_count() items.
+ * @param[in] value Value of the new leaf/leaf-list. For other node types, it should be NULL.
+ * @param[in] options Bitmask of options, see @ref pathoptions.
+ * @param[out] node Optional first created node.
+ * @return LY_SUCCESS on success.
+ * @return LY_EEXIST if the final node to create exists (unless ::LYD_NEW_PATH_UPDATE is used).
+ * @return LY_EINVAL on invalid arguments including invalid variable values.
+ * @return LY_EVALID on invalid @p value.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_new_path_handle(struct lyd_node *parent, const struct lyd_path_handle *handle,
+        const char **args, const char *value, uint32_t options, struct lyd_node **node);
+
 /**
  * @ingroup datatree
  * @defgroup implicitoptions Implicit node creation options
@@ -1765,6 +1844,40 @@ LIBYANG_API_DECL LY_ERR lyd_insert_child(struct lyd_node *parent, struct lyd_nod
  */
 LIBYANG_API_DECL LY_ERR lyd_insert_sibling(struct lyd_node *sibling, struct lyd_node *node, struct lyd_node **first);
 
+/**
+ * @brief Insert many children into a parent at once.
+ *
+ * The result is the same as inserting the nodes one by one using ::lyd_insert_child() but instead of keeping
+ * the children sorted and hashed after every insertion, all the nodes are appended and only then the instances of
+ * the (leaf-)lists ordered by the system are sorted and the hash table of the children is created with its final size.
+ *
+ * - if a node is part of some other tree, it is automatically unlinked.
+ * - the siblings of the nodes are not inserted.
+ *
+ * @param[in] parent Parent node to insert into.
+ * @param[in] nodes Array of the nodes to insert.
+ * @param[in] count Count of @p nodes.
+ * @return LY_SUCCESS on success.
+ * @return LY_ERR error on error.
+ */
+LIBYANG_API_DECL LY_ERR lyd_insert_child_bulk(struct lyd_node *parent, struct lyd_node **nodes, uint32_t count);
+
+/**
+ * @brief Insert many nodes into siblings at once.
+ *
+ * The result is the same as inserting the nodes one by one using ::lyd_insert_sibling(), see
+ * ::lyd_insert_child_bulk() for details.
+ *
+ * @param[in] sibling Siblings to insert into, can even be NULL.
+ * @param[in] nodes Array of the nodes to insert.
+ * @param[in] count Count of @p nodes.
+ * @param[out] first Optionally return the first sibling after insertion. Can be the address of @p sibling.
+ * @return LY_SUCCESS on success.
+ * @return LY_ERR error on error.
+ */
+LIBYANG_API_DECL LY_ERR lyd_insert_sibling_bulk(struct lyd_node *sibling, struct lyd_node **nodes, uint32_t count,
+        struct lyd_node **first);
+
 /**
  * @brief Insert a node before another node, can be used only for user-ordered nodes.
  * If inserting several siblings, each of them must be inserted individually.
@@ -2166,6 +2279,10 @@ LIBYANG_API_DECL LY_ERR lyd_merge_module(struct lyd_node **target, const struct
 #define LYD_DIFF_META       0x02 /**< All metadata are compared and the full difference reported in the diff always in
                                       the form of 'yang:meta-\<operation\>' metadata. Also, equal nodes with only changes
                                       in their metadata will be present in the diff with the 'none' operation. */
+#define LYD_DIFF_PARALLEL   0x04 /**< Subtrees on the first sibling level with several subtrees to compare are compared
+                                      concurrently, by a thread per online CPU. The created diff is the same as without
+                                      this option. The extension data callback (::ly_ctx_set_ext_data_clb()) must be
+                                      thread-safe and the option is ignored for contexts with ::LY_CTX_LEAFREF_LINKING. */
 
 /** @} diffoptions */
 
@@ -2444,6 +2561,23 @@ LIBYANG_API_DECL LY_ERR lyd_find_sibling_dup_inst_set(const struct lyd_node *sib
  */
 LIBYANG_API_DECL LY_ERR lyd_find_sibling_opaq_next(const struct lyd_node *first, const char *name, struct lyd_node **match);
 
+/**
+ * @brief Search the children of a node for the instances of a leaf or a leaf-list and if there are none, create
+ * its virtual default node(s) in a context with ::LY_CTX_VIRTUAL_DEFAULTS.
+ *
+ * The created default nodes are standard implicit nodes with ::LYD_DEFAULT flag. In other contexts, the function
+ * only searches for the instance.
+ *
+ * @param[in] parent Parent of the node to find.
+ * @param[in] schema Schema node of the leaf or leaf-list child of @p parent to find.
+ * @param[out] match Can be NULL, otherwise the found or created (first) data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found and there is no default, @p match set to NULL.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_child_dflt(struct lyd_node *parent, const struct lysc_node *schema,
+        struct lyd_node **match);
+
 /**
  * @brief Set a new XPath variable to @p vars.
  *
@@ -2474,6 +2608,9 @@ LIBYANG_API_DECL void lyxp_vars_free(struct lyxp_var *vars);
  *
  * Opaque nodes are part of the evaluation but only those with a matching schema node.
  *
+ * Virtual default nodes (::LY_CTX_VIRTUAL_DEFAULTS) are part of the evaluation but they are not returned,
+ * use ::lyd_find_child_dflt() to create them.
+ *
  * @param[in] ctx_node XPath context node.
  * @param[in] xpath [XPath](@ref howtoXPath) to select in JSON format. It must evaluate into a node set.
  * @param[out] set Set of found data nodes. In case the result is a number, a string, or a boolean,
@@ -2645,6 +2782,58 @@ LIBYANG_API_DECL LY_ERR lyd_find_path(const struct lyd_node *ctx_node, const cha
  */
 LIBYANG_API_DECL LY_ERR lyd_find_target(const struct ly_path *path, const struct lyd_node *tree, struct lyd_node **match);
 
+/**
+ * @brief Compile a path into a reusable handle for repeated ::lyd_find_path_handle() and ::lyd_new_path_handle() calls.
+ *
+ * The path is parsed and resolved on the schema only once. Any list key values that change between the uses
+ * can be written as XPath variables instead of literals, for example `/a:cont/list[name=$name]/leaf`. The values
+ * for them are then provided in every use of the handle, in the order of the first occurrence of each variable
+ * in the path.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] ctx_node Optional schema context node for a relative @p path. The handle can then be used only with data
+ * nodes of this schema node as the context/parent.
+ * @param[in] path [Path](@ref howtoXPath) to compile.
+ * @param[in] output Whether to use RPC/action output nodes or input nodes.
+ * @param[out] handle Compiled path handle, free with ::lyd_path_handle_free().
+ * @return LY_SUCCESS on success.
+ * @return LY_ERR on error.
+ */
+LIBYANG_API_DECL LY_ERR lyd_path_compile(const struct ly_ctx *ctx, const struct lysc_node *ctx_node, const char *path,
+        ly_bool output, struct lyd_path_handle **handle);
+
+/**
+ * @brief Get the number of distinct variables used in a compiled path handle.
+ *
+ * @param[in] handle Compiled path handle.
+ * @return Number of values expected in every use of @p handle.
+ */
+LIBYANG_API_DECL uint32_t lyd_path_handle_var_count(const struct lyd_path_handle *handle);
+
+/**
+ * @brief Free a compiled path handle.
+ *
+ * @param[in] handle Compiled path handle to free.
+ */
+LIBYANG_API_DECL void lyd_path_handle_free(struct lyd_path_handle *handle);
+
+/**
+ * @brief Search in given data for a node uniquely identified by a compiled path handle.
+ *
+ * Works the same as ::lyd_find_path() but without any path parsing.
+ *
+ * @param[in] ctx_node Path context node.
+ * @param[in] handle Compiled path handle.
+ * @param[in] args Values of the @p handle variables (in JSON format), ::lyd_path_handle_var_count() items.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match is set to the found node.
+ * @return LY_EINCOMPLETE if only a parent of the node was found, @p match is set to this parent node.
+ * @return LY_ENOTFOUND if no nodes in the path were found.
+ * @return LY_ERR on other errors.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_path_handle(const struct lyd_node *ctx_node, const struct lyd_path_handle *handle,
+        const char **args, struct lyd_node **match);
+
 /**
  * @brief Get current timezone (including DST setting) UTC (GMT) time offset in seconds.
  *
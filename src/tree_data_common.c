@@ -512,6 +512,7 @@ lyd_value_store(const struct ly_ctx *ctx, struct lyd_value *val, const struct ly
 {
     LY_ERR ret;
     struct ly_err_item *err = NULL;
+    struct timespec start;
     uint32_t options = 0;
 
     if (!value) {
@@ -531,8 +532,16 @@ lyd_value_store(const struct ly_ctx *ctx, struct lyd_value *val, const struct ly
     if (store_only) {
         options |= LYPLG_TYPE_STORE_ONLY;
     }
+    if (ctx->flags & LY_CTX_LAZY_CANONICAL) {
+        options |= LYPLG_TYPE_STORE_LAZY_CANON;
+    }
 
+    lyd_val_prof_start(ctx, &start);
     ret = type->plugin->store(ctx, type, value, value_len, options, format, prefix_data, hints, ctx_node, val, NULL, &err);
+    if (ctx_node && (ctx_node->nodetype & LYD_NODE_TERM) && (((struct lysc_node_leaf *)ctx_node)->type == type)) {
+        /* the value of the node itself, not of metadata or a union member */
+        lyd_val_prof_stop(ctx, LYD_VAL_PROF_STORE, type->plugin, ctx_node, &start);
+    }
     if (dynamic) {
         *dynamic = 0;
     }
@@ -977,10 +986,13 @@ cleanup:
 LIBYANG_API_DEF const char *
 lyd_value_get_canonical(const struct ly_ctx *ctx, const struct lyd_value *value)
 {
+    const char *canon;
+
     LY_CHECK_ARG_RET(ctx, ctx, value, NULL);
 
-    return value->_canonical ? value->_canonical :
-           (const char *)value->realtype->plugin->print(ctx, value, LY_VALUE_CANON, NULL, NULL, NULL);
+    /* the canonical value may be generated and published concurrently */
+    canon = LY_ATOMIC_LOAD_ACQUIRE_PTR(value->_canonical);
+    return canon ? canon : (const char *)value->realtype->plugin->print(ctx, value, LY_VALUE_CANON, NULL, NULL, NULL);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1159,6 +1171,51 @@ lyd_meta_is_internal(const struct lyd_meta *meta)
     return 0;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_freeze(struct lyd_node *tree)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyd_node *root, *node;
+    struct lyd_meta *meta;
+    struct ly_set mods = {0};
+    uint32_t i;
+
+    if (!tree) {
+        return LY_SUCCESS;
+    }
+
+    LY_LIST_FOR(lyd_first_sibling(tree), root) {
+        LYD_TREE_DFS_BEGIN(root, node) {
+            if (node->schema) {
+                /* generate all the canonical values */
+                if ((node->schema->nodetype & LYD_NODE_TERM) && !lyd_get_value(node)) {
+                    rc = LY_EMEM;
+                    goto cleanup;
+                }
+                LY_LIST_FOR(node->meta, meta) {
+                    if (!lyd_meta_is_internal(meta) && !lyd_get_meta_value(meta)) {
+                        rc = LY_EMEM;
+                        goto cleanup;
+                    }
+                }
+
+                /* remember the module for its LYB hashes */
+                LY_CHECK_GOTO(rc = ly_set_add(&mods, node->schema->module, 0, NULL), cleanup);
+            }
+            LYD_TREE_DFS_END(root, node);
+        }
+    }
+
+    /* cache the schema node hashes used by the LYB printer */
+    for (i = 0; i < mods.count; ++i) {
+        lyb_cache_module_hash(mods.objs[i]);
+    }
+
+cleanup:
+    ly_set_erase(&mods, NULL);
+    return rc;
+}
+
 /**
  * @brief Comparison callback to match schema node with a schema of a data node.
  *
@@ -224,6 +224,7 @@ lyd_free_subtree(struct lyd_node *node)
     } else if (node->schema->nodetype & LYD_NODE_INNER) {
         /* remove children hash table in case of inner data node */
         lyht_free(((struct lyd_node_inner *)node)->children_ht, NULL);
+        lyd_uniq_idx_free(node);
 
         /* free the children */
         LY_LIST_FOR_SAFE(lyd_child(node), next, iter) {
@@ -19,11 +19,14 @@
 
 #include "compat.h"
 #include "hash_table.h"
+#include "hash_table_internal.h"
 #include "log.h"
 #include "ly_common.h"
 #include "plugins_types.h"
+#include "set.h"
 #include "tree.h"
 #include "tree_data.h"
+#include "tree_data_internal.h"
 #include "tree_schema.h"
 
 LY_ERR
@@ -159,12 +162,52 @@ lyd_insert_hash_add(struct ly_ht *ht, struct lyd_node *node, ly_bool empty_ht)
     return LY_SUCCESS;
 }
 
-LY_ERR
-lyd_insert_hash(struct lyd_node *node)
+/**
+ * @brief Create the children hash table of a parent with all its children, if there are enough of them.
+ *
+ * @param[in] parent Parent with no children hash table.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_insert_hash_create(struct lyd_node_inner *parent)
 {
     struct lyd_node *iter;
     uint32_t u;
 
+    assert(!parent->children_ht);
+
+    /* the hash table is created only when the number of children in a node exceeds the
+     * defined minimal limit LYD_HT_MIN_ITEMS
+     */
+    u = 0;
+    LY_LIST_FOR(parent->child, iter) {
+        if (iter->schema) {
+            ++u;
+        }
+    }
+    if (u < LYD_HT_MIN_ITEMS) {
+        return LY_SUCCESS;
+    }
+
+    parent->children_ht = lyht_new_open(lyht_get_fixed_size(u), sizeof(struct lyd_node *), lyd_hash_table_val_equal,
+            NULL, 1);
+    LY_CHECK_ERR_RET(!parent->children_ht, LOGMEM(LYD_CTX(parent)), LY_EMEM);
+    lyht_set_resize_step(parent->children_ht, LYHT_RESIZE_STEP);
+    LY_LIST_FOR(parent->child, iter) {
+        if (iter->schema) {
+            LY_CHECK_RET(lyd_insert_hash_add(parent->children_ht, iter, 1));
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyd_insert_hash(struct lyd_node *node)
+{
+    /* the node and its list ancestors need to be validated for unique again */
+    lyd_uniq_idx_update(node, 0);
+
     if (!node->parent || !node->schema || !node->parent->schema) {
         /* nothing to do */
         return LY_SUCCESS;
@@ -172,23 +215,7 @@ lyd_insert_hash(struct lyd_node *node)
 
     /* create parent hash table if required, otherwise just add the new child */
     if (!node->parent->children_ht) {
-        /* the hash table is created only when the number of children in a node exceeds the
-         * defined minimal limit LYD_HT_MIN_ITEMS
-         */
-        u = 0;
-        LY_LIST_FOR(node->parent->child, iter) {
-            if (iter->schema) {
-                ++u;
-            }
-        }
-        if (u >= LYD_HT_MIN_ITEMS) {
-            node->parent->children_ht = lyht_new(lyht_get_fixed_size(u), sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
-            LY_LIST_FOR(node->parent->child, iter) {
-                if (iter->schema) {
-                    LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, iter, 1));
-                }
-            }
-        }
+        LY_CHECK_RET(lyd_insert_hash_create(node->parent));
     } else {
         LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, node, 0));
     }
@@ -196,11 +223,55 @@ lyd_insert_hash(struct lyd_node *node)
     return LY_SUCCESS;
 }
 
+LY_ERR
+lyd_insert_hash_all(struct lyd_node *parent)
+{
+    struct lyd_node_inner *inner = (struct lyd_node_inner *)parent;
+
+    if (!parent->schema || !(parent->schema->nodetype & LYD_NODE_INNER)) {
+        /* no hash table */
+        return LY_SUCCESS;
+    }
+
+    lyht_free(inner->children_ht, NULL);
+    inner->children_ht = NULL;
+    return lyd_insert_hash_create(inner);
+}
+
+LY_ERR
+lyd_insert_hash_first_inst(struct lyd_node *prev_first, struct lyd_node *first)
+{
+    struct ly_ht *ht;
+    uint32_t hash;
+
+    assert(prev_first && first && (prev_first->schema == first->schema));
+
+    if ((prev_first == first) || !first->parent || !first->parent->schema || !first->parent->children_ht) {
+        return LY_SUCCESS;
+    }
+    ht = first->parent->children_ht;
+
+    /* get the simple hash */
+    hash = lyht_hash_multi(0, first->schema->module->name, strlen(first->schema->module->name));
+    hash = lyht_hash_multi(hash, first->schema->name, strlen(first->schema->name));
+    hash = lyht_hash_multi(hash, NULL, 0);
+
+    /* replace the stored first instance */
+    if (lyht_remove(ht, &prev_first, hash) || lyht_insert(ht, &first, hash, NULL)) {
+        LOGINT_RET(LYD_CTX(first));
+    }
+
+    return LY_SUCCESS;
+}
+
 void
 lyd_unlink_hash(struct lyd_node *node)
 {
     uint32_t hash;
 
+    /* remove the node from its unique index and mark its list ancestors */
+    lyd_uniq_idx_update(node, 1);
+
     if (!node->parent || !node->schema || !node->parent->schema || !node->parent->children_ht) {
         /* not in any HT */
         return;
@@ -234,3 +305,459 @@ lyd_unlink_hash(struct lyd_node *node)
         }
     }
 }
+
+/**
+ * @brief Compare callback for data nodes in unique index hash tables, compares pointers.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_uniq_idx_ptr_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return *((struct lyd_node **)val1_p) == *((struct lyd_node **)val2_p);
+}
+
+/**
+ * @brief Get the hash of a list instance pointer.
+ *
+ * @param[in] inst List instance.
+ * @return Pointer hash.
+ */
+static uint32_t
+lyd_uniq_idx_ptr_hash(const struct lyd_node *inst)
+{
+    return lyht_hash((const char *)&inst, sizeof inst);
+}
+
+/**
+ * @brief Get the size of a member record of a unique index.
+ *
+ * @param[in] schema List schema node.
+ * @return Member record size.
+ */
+static uint16_t
+lyd_uniq_idx_rec_size(const struct lysc_node *schema)
+{
+    return sizeof(struct lyd_uniq_member) +
+           LY_ARRAY_COUNT(((struct lysc_node_list *)schema)->uniques) * sizeof(struct lyd_uniq_hash);
+}
+
+/**
+ * @brief Get the hash table of unique indexes, create it if needed.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held.
+ *
+ * @param[in] ctx Context with the hash table.
+ * @param[in,out] ht Hash table of the context.
+ * @return Hash table, NULL on memory allocation failure.
+ */
+static struct ly_ht *
+lyd_uniq_owner_ht(const struct ly_ctx *ctx, struct ly_ht **ht)
+{
+    struct ly_ht *new;
+
+    if (!*ht) {
+        new = lyht_new(1, sizeof(struct lyd_uniq_owner), lyd_uniq_idx_ptr_equal, NULL, 1);
+        LY_CHECK_ERR_RET(!new, LOGMEM(ctx), NULL);
+
+        /* the table is read without the lock to learn whether there can be any indexes */
+        LY_ATOMIC_CAS_PTR(*ht, NULL, new);
+    }
+
+    return *ht;
+}
+
+/**
+ * @brief Find the record of unique indexes of a data node.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held.
+ *
+ * @param[in] ht Hash table of the context, may be NULL.
+ * @param[in] node Data parent of the instances or a top-level instance.
+ * @return Found record, NULL if there is none.
+ */
+static struct lyd_uniq_owner *
+lyd_uniq_owner_find(const struct ly_ht *ht, const struct lyd_node *node)
+{
+    struct lyd_uniq_owner *owner;
+
+    if (!ht || lyht_find(ht, &node, lyd_uniq_idx_ptr_hash(node), (void **)&owner)) {
+        return NULL;
+    }
+    return owner;
+}
+
+/**
+ * @brief Remove a top-level instance from ::ly_ctx.uniq_top_ht, callback for freeing the members of an index.
+ *
+ * @param[in] val_p Member record of the instance.
+ */
+static void
+lyd_uniq_idx_top_unmap(void *val_p)
+{
+    struct lyd_uniq_member *rec = val_p;
+
+    lyht_remove(LYD_CTX(rec->inst)->uniq_top_ht, &rec->inst, lyd_uniq_idx_ptr_hash(rec->inst));
+}
+
+/**
+ * @brief Free a single unique index.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held if the index is stored in the context.
+ *
+ * @param[in] idx Index to free.
+ */
+static void
+lyd_uniq_idx_free_single(struct lyd_uniq_idx *idx)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (idx->tables) {
+        LY_ARRAY_FOR(((struct lysc_node_list *)idx->schema)->uniques, u) {
+            lyht_free(idx->tables[u], NULL);
+        }
+        free(idx->tables);
+    }
+    lyht_free(idx->members, idx->top ? lyd_uniq_idx_top_unmap : NULL);
+    ly_set_free(idx->dirty, NULL);
+    free(idx->rec);
+    free(idx);
+}
+
+/**
+ * @brief Remove a unique index from the context and free it.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held.
+ *
+ * @param[in] parent Data parent with the index, NULL for top-level instances.
+ * @param[in] idx Index to drop.
+ */
+static void
+lyd_uniq_idx_drop(const struct lyd_node *parent, struct lyd_uniq_idx *idx)
+{
+    struct ly_ht *ht = idx->schema->module->ctx->uniq_idx_ht;
+    struct lyd_uniq_owner *owner;
+    struct lyd_uniq_idx **iter;
+
+    if (!idx->top) {
+        owner = lyd_uniq_owner_find(ht, parent);
+        assert(owner);
+
+        for (iter = &owner->idx; *iter != idx; iter = &(*iter)->next) {}
+        *iter = idx->next;
+        if (!owner->idx) {
+            /* no more indexes of the parent */
+            lyht_remove(ht, &parent, lyd_uniq_idx_ptr_hash(parent));
+        }
+    }
+
+    lyd_uniq_idx_free_single(idx);
+}
+
+/**
+ * @brief Mark a list instance dirty, it is removed from the unique hash tables and will be validated again.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held.
+ *
+ * @param[in] idx Unique index.
+ * @param[in] inst List instance.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_uniq_idx_mark(struct lyd_uniq_idx *idx, struct lyd_node *inst)
+{
+    struct lyd_uniq_member *rec;
+    struct lyd_uniq_owner owner;
+    struct ly_ht *ht = NULL;
+    uint32_t hash;
+
+    rec = lyd_uniq_idx_member(idx, inst);
+    if (rec) {
+        if (rec->dirty) {
+            /* already marked */
+            return LY_SUCCESS;
+        }
+
+        lyd_uniq_idx_remove_tables(idx, rec);
+        rec->dirty = 1;
+    } else {
+        hash = lyd_uniq_idx_ptr_hash(inst);
+        if (idx->top) {
+            /* the index is found by each of its top-level instances */
+            ht = lyd_uniq_owner_ht(LYD_CTX(inst), &((struct ly_ctx *)LYD_CTX(inst))->uniq_top_ht);
+            LY_CHECK_RET(!ht, LY_EMEM);
+            owner.node = inst;
+            owner.idx = idx;
+            LY_CHECK_RET(lyht_insert(ht, &owner, hash, NULL));
+        }
+
+        /* new member */
+        memset(idx->rec, 0, lyd_uniq_idx_rec_size(idx->schema));
+        idx->rec->inst = inst;
+        idx->rec->dirty = 1;
+        if (lyht_insert(idx->members, idx->rec, hash, NULL)) {
+            if (idx->top) {
+                lyht_remove(ht, &inst, hash);
+            }
+            return LY_EMEM;
+        }
+    }
+
+    return ly_set_add(idx->dirty, inst, 1, NULL);
+}
+
+/**
+ * @brief Remove a list instance from a unique index, a top-level index is freed when its last instance is removed.
+ *
+ * Is expected to be called with ::ly_ctx.uniq_idx_lock held.
+ *
+ * @param[in] idx Unique index.
+ * @param[in] inst List instance.
+ */
+static void
+lyd_uniq_idx_unlink(struct lyd_uniq_idx *idx, const struct lyd_node *inst)
+{
+    struct lyd_uniq_member *rec;
+    uint32_t hash;
+
+    rec = lyd_uniq_idx_member(idx, inst);
+    if (!rec) {
+        return;
+    }
+
+    /* the instance may stay in the dirty set, it is skipped because it is no longer a member */
+    hash = lyd_uniq_idx_ptr_hash(inst);
+    lyd_uniq_idx_remove_tables(idx, rec);
+    lyht_remove(idx->members, &inst, hash);
+
+    if (idx->top) {
+        lyht_remove(LYD_CTX(inst)->uniq_top_ht, &inst, hash);
+        if (!idx->members->used) {
+            /* no instances left to find the index by */
+            lyd_uniq_idx_free_single(idx);
+        }
+    }
+}
+
+/**
+ * @brief Get a top-level sibling instance of the same list as a newly inserted instance.
+ *
+ * @param[in] node Inserted top-level list instance.
+ * @return Sibling instance, NULL if there is none.
+ */
+static const struct lyd_node *
+lyd_uniq_idx_top_sibling(const struct lyd_node *node)
+{
+    if (node->prev->next && (node->prev->schema == node->schema)) {
+        return node->prev;
+    } else if (node->next && (node->next->schema == node->schema)) {
+        return node->next;
+    }
+
+    return NULL;
+}
+
+LY_ERR
+lyd_uniq_idx_new(const struct lyd_node *parent, const struct lyd_node *first, const struct lysc_node *schema,
+        struct lyd_uniq_idx **idx)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_ctx *ctx = schema->module->ctx;
+    struct lyd_uniq_idx *new = NULL;
+    struct lyd_uniq_owner owner, *match;
+    const struct lyd_node *iter;
+    struct ly_ht *ht;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t count = 0;
+
+    assert((schema->nodetype == LYS_LIST) && ((struct lysc_node_list *)schema)->uniques);
+
+    LY_LIST_FOR(first, iter) {
+        if (iter->schema == schema) {
+            ++count;
+        }
+    }
+
+    pthread_mutex_lock(&ctx->uniq_idx_lock);
+
+    new = calloc(1, sizeof *new);
+    LY_CHECK_ERR_GOTO(!new, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    new->schema = schema;
+    new->top = parent ? 0 : 1;
+
+    /* create the hash tables */
+    new->tables = calloc(LY_ARRAY_COUNT(((struct lysc_node_list *)schema)->uniques), sizeof *new->tables);
+    LY_CHECK_ERR_GOTO(!new->tables, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    LY_ARRAY_FOR(((struct lysc_node_list *)schema)->uniques, u) {
+        new->tables[u] = lyht_new(lyht_get_fixed_size(count), sizeof(struct lyd_node *), lyd_uniq_idx_ptr_equal,
+                NULL, 1);
+        LY_CHECK_ERR_GOTO(!new->tables[u], LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    }
+    new->members = lyht_new(lyht_get_fixed_size(count), lyd_uniq_idx_rec_size(schema), lyd_uniq_idx_ptr_equal, NULL, 1);
+    LY_CHECK_ERR_GOTO(!new->members, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    new->rec = calloc(1, lyd_uniq_idx_rec_size(schema));
+    LY_CHECK_ERR_GOTO(!new->rec, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    LY_CHECK_GOTO(rc = ly_set_new(&new->dirty), cleanup);
+
+    /* all the instances need to be validated */
+    LY_LIST_FOR(first, iter) {
+        if (iter->schema == schema) {
+            LY_CHECK_GOTO(rc = lyd_uniq_idx_mark(new, (struct lyd_node *)iter), cleanup);
+        }
+    }
+
+    if (parent) {
+        /* store the index by the parent */
+        if ((match = lyd_uniq_owner_find(ctx->uniq_idx_ht, parent))) {
+            new->next = match->idx;
+            match->idx = new;
+        } else {
+            ht = lyd_uniq_owner_ht(ctx, &ctx->uniq_idx_ht);
+            LY_CHECK_ERR_GOTO(!ht, rc = LY_EMEM, cleanup);
+            owner.node = parent;
+            owner.idx = new;
+            LY_CHECK_GOTO(rc = lyht_insert(ht, &owner, lyd_uniq_idx_ptr_hash(parent), NULL), cleanup);
+        }
+    }
+    *idx = new;
+
+cleanup:
+    if (rc && new) {
+        lyd_uniq_idx_free_single(new);
+    }
+    pthread_mutex_unlock(&ctx->uniq_idx_lock);
+    return rc;
+}
+
+struct lyd_uniq_idx *
+lyd_uniq_idx_find(const struct lyd_node *parent, const struct lyd_node *inst, const struct lysc_node *schema)
+{
+    struct ly_ctx *ctx = schema->module->ctx;
+    struct lyd_uniq_owner *owner;
+    struct lyd_uniq_idx *idx = NULL;
+
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_idx_ht) && !LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_top_ht)) {
+        /* no indexes were ever created */
+        return NULL;
+    }
+
+    pthread_mutex_lock(&ctx->uniq_idx_lock);
+
+    if (parent) {
+        if ((owner = lyd_uniq_owner_find(ctx->uniq_idx_ht, parent))) {
+            for (idx = owner->idx; idx && (idx->schema != schema); idx = idx->next) {}
+        }
+    } else if ((owner = lyd_uniq_owner_find(ctx->uniq_top_ht, inst))) {
+        idx = owner->idx;
+        assert(idx->schema == schema);
+    }
+
+    pthread_mutex_unlock(&ctx->uniq_idx_lock);
+    return idx;
+}
+
+struct lyd_uniq_member *
+lyd_uniq_idx_member(const struct lyd_uniq_idx *idx, const struct lyd_node *inst)
+{
+    struct lyd_uniq_member *rec;
+
+    if (lyht_find(idx->members, &inst, lyd_uniq_idx_ptr_hash(inst), (void **)&rec)) {
+        return NULL;
+    }
+    return rec;
+}
+
+void
+lyd_uniq_idx_remove_tables(struct lyd_uniq_idx *idx, struct lyd_uniq_member *rec)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(((struct lysc_node_list *)idx->schema)->uniques, u) {
+        if (rec->uniq[u].indexed) {
+            lyht_remove(idx->tables[u], &rec->inst, rec->uniq[u].hash);
+            rec->uniq[u].indexed = 0;
+        }
+    }
+}
+
+void
+lyd_uniq_idx_update(struct lyd_node *node, ly_bool unlink)
+{
+    struct ly_ctx *ctx = (struct ly_ctx *)LYD_CTX(node);
+    struct lyd_node *iter;
+    const struct lyd_node *sibling;
+    struct lyd_uniq_owner *owner;
+    struct lyd_uniq_idx *idx;
+
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_idx_ht) && !LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_top_ht)) {
+        /* no indexes were ever created */
+        return;
+    }
+
+    pthread_mutex_lock(&ctx->uniq_idx_lock);
+
+    for (iter = node; iter; iter = lyd_parent(iter)) {
+        if (!iter->schema || (iter->schema->nodetype != LYS_LIST)) {
+            continue;
+        }
+
+        idx = NULL;
+        if (iter->parent) {
+            if (iter->parent->schema && (owner = lyd_uniq_owner_find(ctx->uniq_idx_ht, lyd_parent(iter)))) {
+                for (idx = owner->idx; idx && (idx->schema != iter->schema); idx = idx->next) {}
+            }
+        } else if ((owner = lyd_uniq_owner_find(ctx->uniq_top_ht, iter))) {
+            idx = owner->idx;
+        } else if ((iter == node) && !unlink && (sibling = lyd_uniq_idx_top_sibling(iter)) &&
+                (owner = lyd_uniq_owner_find(ctx->uniq_top_ht, sibling))) {
+            /* new top-level instance */
+            idx = owner->idx;
+        }
+        if (!idx) {
+            continue;
+        }
+
+        if (unlink && (iter == node)) {
+            /* the instance itself is being unlinked */
+            lyd_uniq_idx_unlink(idx, iter);
+        } else if (lyd_uniq_idx_mark(idx, iter)) {
+            /* the index cannot be maintained, it will be created again when needed */
+            lyd_uniq_idx_drop(lyd_parent(iter), idx);
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->uniq_idx_lock);
+}
+
+void
+lyd_uniq_idx_free(const struct lyd_node *node)
+{
+    struct ly_ctx *ctx = (struct ly_ctx *)LYD_CTX(node);
+    struct lyd_uniq_owner *owner;
+    struct lyd_uniq_idx *idx, *next;
+
+    if (!LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_idx_ht) && !LY_ATOMIC_LOAD_ACQUIRE_PTR(ctx->uniq_top_ht)) {
+        /* no indexes were ever created */
+        return;
+    }
+
+    pthread_mutex_lock(&ctx->uniq_idx_lock);
+
+    if ((owner = lyd_uniq_owner_find(ctx->uniq_idx_ht, node))) {
+        /* indexes of the children */
+        idx = owner->idx;
+        lyht_remove(ctx->uniq_idx_ht, &node, lyd_uniq_idx_ptr_hash(node));
+        while (idx) {
+            next = idx->next;
+            lyd_uniq_idx_free_single(idx);
+            idx = next;
+        }
+    }
+
+    if (!node->parent && (owner = lyd_uniq_owner_find(ctx->uniq_top_ht, node))) {
+        /* top-level instance freed without being unlinked */
+        lyd_uniq_idx_unlink(owner->idx, node);
+    }
+
+    pthread_mutex_unlock(&ctx->uniq_idx_lock);
+}
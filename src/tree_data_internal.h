@@ -23,6 +23,7 @@
 
 #include <stddef.h>
 
+struct ly_path;
 struct ly_path_predicate;
 struct lyd_ctx;
 struct lysc_module;
@@ -42,6 +43,73 @@ struct lyd_dup_inst {
     uint32_t used;
 };
 
+/**
+ * @brief Hash of the values of a single unique statement of an indexed list instance.
+ */
+struct lyd_uniq_hash {
+    uint32_t hash;                  /**< hash of the unique values */
+    ly_bool indexed;                /**< whether the instance is in the unique hash table, unset for incomplete values */
+};
+
+/**
+ * @brief Record of an indexed list instance in ::lyd_uniq_idx.members.
+ */
+struct lyd_uniq_member {
+    struct lyd_node *inst;          /**< list instance */
+    ly_bool dirty;                  /**< instance was inserted or changed and is not in ::lyd_uniq_idx.tables */
+    struct lyd_uniq_hash uniq[];    /**< hashes of all the unique statements of the list */
+};
+
+/**
+ * @brief Index of list instances by their unique values.
+ *
+ * Stored in the context, in ::ly_ctx.uniq_idx_ht by the data parent of the instances or in ::ly_ctx.uniq_top_ht by
+ * each top-level instance. Updated on every insertion, unlink, and value change of the instances so that only
+ * the new and changed instances need to be validated.
+ */
+struct lyd_uniq_idx {
+    const struct lysc_node *schema; /**< list schema node with unique statements */
+    ly_bool top;                    /**< whether the instances are top-level, stored in ::ly_ctx.uniq_top_ht */
+    struct ly_ht **tables;          /**< hash tables of the instances, one for each unique statement */
+    struct ly_ht *members;          /**< hash table of all the indexed instances (struct lyd_uniq_member) */
+    struct ly_set *dirty;           /**< instances to validate, may include unlinked (dangling) instances */
+    struct lyd_uniq_member *rec;    /**< buffer for a member record */
+    struct lyd_uniq_idx *next;      /**< next index of another list in the same parent */
+};
+
+/**
+ * @brief Record of ::ly_ctx.uniq_idx_ht and ::ly_ctx.uniq_top_ht.
+ */
+struct lyd_uniq_owner {
+    const struct lyd_node *node;    /**< data parent of the instances or a top-level instance */
+    struct lyd_uniq_idx *idx;       /**< first index of the parent or the index of the top-level instance */
+};
+
+/**
+ * @brief Compiled path handle.
+ */
+struct lyd_path_handle {
+    const struct ly_ctx *ctx;       /**< libyang context */
+    const struct lysc_node *ctx_node;   /**< context node of a relative path, NULL for an absolute path */
+    char *str_path;                 /**< original string path, used for logging */
+    struct ly_path *path;           /**< compiled path */
+    ly_bool output;                 /**< whether the path was compiled for RPC/action output */
+    const char **vars;              /**< names of all the variables in the order of the first occurrence, point
+                                         to the predicates in @p path */
+    uint32_t var_count;             /**< count of @p vars */
+};
+
+/**
+ * @brief Create a variable array for a use of a compiled path handle.
+ *
+ * @param[in] handle Compiled path handle.
+ * @param[in] args Values of the variables.
+ * @param[out] vars [Sized array](@ref sizedarrays) of variables, free with ::LY_ARRAY_FREE(), the names and values
+ * are not owned.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_path_handle_vars(const struct lyd_path_handle *handle, const char **args, struct lyxp_var **vars);
+
 /**
  * @brief Update a found inst using a duplicate instance cache hash table. Needs to be called for every "used"
  * (that should not be considered next time) instance.
@@ -406,6 +474,58 @@ LY_ERR lyd_new_implicit_r(struct lyd_node *parent, struct lyd_node **first, cons
         const struct lys_module *mod, struct ly_set *node_when, struct ly_set *node_types, struct ly_set *ext_node,
         uint32_t impl_opts, struct ly_ht *getnext_ht, struct lyd_node **diff);
 
+/**
+ * @brief Internal implicit option (@ref implicitoptions) to not create default leaves and leaf-lists of nested nodes
+ * in a context with ::LY_CTX_VIRTUAL_DEFAULTS.
+ */
+#define LYD_IMPLICIT_VIRTUAL 0x80
+
+/**
+ * @brief Create the virtual default nodes of a node in a context with ::LY_CTX_VIRTUAL_DEFAULTS.
+ *
+ * Default leaves and leaf-lists are created for all the schema children of @p parent without any instance. They are
+ * not inserted into @p parent, only their parent pointer is set so that they can be printed and used for evaluation,
+ * and they have ::LYD_VIRTUAL flag.
+ *
+ * @param[in] parent Parent to create the virtual default nodes of.
+ * @param[in] mod Module of the nodes to create, NULL for any.
+ * @param[in] name Name of the nodes to create in the dictionary, NULL for any.
+ * @param[in] state_only Whether to create only the state (config false) default nodes.
+ * @param[out] dflts Created virtual default siblings in the schema order, NULL if there are none. Free them using
+ * ::lyd_dflt_virtual_free().
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_dflt_virtual_new(const struct lyd_node *parent, const struct lys_module *mod, const char *name,
+        ly_bool state_only, struct lyd_node **dflts);
+
+/**
+ * @brief Check whether a node has any virtual default nodes in a context with ::LY_CTX_VIRTUAL_DEFAULTS.
+ *
+ * Decided from the schema, a node is created only to evaluate the when conditions of a default node.
+ *
+ * @param[in] parent Parent to check.
+ * @param[in] state_only Whether to consider only the state (config false) default nodes.
+ * @return Whether @p parent has any virtual default nodes.
+ */
+ly_bool lyd_dflt_virtual_exists(const struct lyd_node *parent, ly_bool state_only);
+
+/**
+ * @brief Free virtual default nodes.
+ *
+ * @param[in] dflts Virtual default siblings to free.
+ */
+void lyd_dflt_virtual_free(struct lyd_node *dflts);
+
+/**
+ * @brief Create the virtual default nodes of a node in a context with ::LY_CTX_VIRTUAL_DEFAULTS in the tree.
+ *
+ * @param[in] parent Parent to create the default nodes in.
+ * @param[in] mod Module of the nodes to create, NULL for any.
+ * @param[in] name Name of the nodes to create in the dictionary, NULL for any.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_dflt_materialize(struct lyd_node *parent, const struct lys_module *mod, const char *name);
+
 /**
  * @brief Find the next node, before which to insert the new node.
  *
@@ -455,6 +575,10 @@ void lyd_insert_before_node(struct lyd_node *sibling, struct lyd_node *node);
                                                   in Debug build, to detect misuse of the LYD_PARSE_ORDERED flag. */
 #define LYD_INSERT_NODE_LAST_BY_SCHEMA  0x02 /**< The node is inserted according to the schema as a last instance.
                                                   Node order not checked. */
+#define LYD_INSERT_NODE_BULK            0x04 /**< The node is inserted according to the schema as a last instance but
+                                                  neither the parent hash table (unless it exists) nor the (leaf-)list
+                                                  BST is updated, ::lyd_insert_bulk_finish() must be called once all
+                                                  the siblings are inserted. */
 
 /** @} insertorder */
 
@@ -469,6 +593,20 @@ void lyd_insert_before_node(struct lyd_node *sibling, struct lyd_node *node);
 void lyd_insert_node(struct lyd_node *parent, struct lyd_node **first_sibling, struct lyd_node *node,
         uint32_t order);
 
+/**
+ * @brief Finish inserting nodes with ::LYD_INSERT_NODE_BULK.
+ *
+ * Sorts the appended (leaf-)list instances. Those of a (leaf-)list with a BST are inserted into it, otherwise all
+ * the instances are sorted and their BST built at once. If the parent has no hash table, it is created with its final
+ * size. If it has one, the inserted nodes are already in it and the (leaf-)lists are found using it so the cost
+ * does not depend on the number of the other children.
+ *
+ * @param[in] parent Parent of the inserted siblings, NULL for top-level siblings.
+ * @param[in,out] first_sibling First top-level sibling, used only if @p parent is not set.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_insert_bulk_finish(struct lyd_node *parent, struct lyd_node **first_sibling);
+
 /**
  * @brief Insert a node into parent/siblings, either before the 'anchor' or as the last sibling.
  *
@@ -660,6 +798,26 @@ ly_bool lyd_hash_table_val_equal(void *val1_p, void *val2_p, ly_bool mod, void *
  */
 LY_ERR lyd_insert_hash(struct lyd_node *node);
 
+/**
+ * @brief Create the ::lyd_node_inner.children_ht hash table of a node with all its children at once.
+ *
+ * Any previous hash table is discarded.
+ *
+ * @param[in] parent Data node whose children hash table is created.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_insert_hash_all(struct lyd_node *parent);
+
+/**
+ * @brief Replace the first instance of a (leaf-)list stored in the ::lyd_node_inner.children_ht hash table
+ * of its parent after the instances were reordered without updating their hashes.
+ *
+ * @param[in] prev_first Instance stored as the first one.
+ * @param[in] first Actual first instance.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_insert_hash_first_inst(struct lyd_node *prev_first, struct lyd_node *first);
+
 /**
  * @brief Maintain node's parent's children hash table when unlinking the node.
  *
@@ -669,6 +827,63 @@ LY_ERR lyd_insert_hash(struct lyd_node *node);
  */
 void lyd_unlink_hash(struct lyd_node *node);
 
+/**
+ * @brief Create a new unique index of list instances, all the current instances are marked dirty.
+ *
+ * @param[in] parent Data parent of the list instances, NULL for top-level instances.
+ * @param[in] first First sibling to search for the instances in.
+ * @param[in] schema List schema node with unique statements.
+ * @param[out] idx Created index.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_uniq_idx_new(const struct lyd_node *parent, const struct lyd_node *first, const struct lysc_node *schema,
+        struct lyd_uniq_idx **idx);
+
+/**
+ * @brief Find a unique index of list instances.
+ *
+ * @param[in] parent Data parent of the list instances, NULL for top-level instances.
+ * @param[in] inst Any top-level list instance, used only if @p parent is NULL.
+ * @param[in] schema List schema node.
+ * @return Found index, NULL if there is none.
+ */
+struct lyd_uniq_idx *lyd_uniq_idx_find(const struct lyd_node *parent, const struct lyd_node *inst,
+        const struct lysc_node *schema);
+
+/**
+ * @brief Get the member record of a list instance in a unique index.
+ *
+ * @param[in] idx Unique index.
+ * @param[in] inst List instance.
+ * @return Member record, NULL if @p inst is not a member.
+ */
+struct lyd_uniq_member *lyd_uniq_idx_member(const struct lyd_uniq_idx *idx, const struct lyd_node *inst);
+
+/**
+ * @brief Remove an indexed list instance from the unique hash tables.
+ *
+ * @param[in] idx Unique index.
+ * @param[in] rec Member record of the instance.
+ */
+void lyd_uniq_idx_remove_tables(struct lyd_uniq_idx *idx, struct lyd_uniq_member *rec);
+
+/**
+ * @brief Update unique indexes after a node was inserted, unlinked, or its value changed.
+ *
+ * The node itself is added to or removed from its index and all its list instance ancestors are marked dirty.
+ *
+ * @param[in] node Changed data node, still linked to its parent when being unlinked.
+ * @param[in] unlink Whether the node is being unlinked.
+ */
+void lyd_uniq_idx_update(struct lyd_node *node, ly_bool unlink);
+
+/**
+ * @brief Free all the unique indexes of a data node being freed and remove it from the index of top-level instances.
+ *
+ * @param[in] node Inner data node being freed.
+ */
+void lyd_uniq_idx_free(const struct lyd_node *node);
+
 /** @} datahash */
 
 /**
@@ -1267,6 +1267,9 @@ lyd_change_node_value(struct lyd_node_term *term, struct lyd_value *val, ly_bool
             rc = ((struct lysc_node_leaf *)term->schema)->type->plugin->duplicate(LYD_CTX(term), val, &term->value);
         }
 
+        /* the value may be unique in a list instance */
+        lyd_uniq_idx_update(&term->node, 0);
+
         /* leaf that is not a key, its value is not used for its hash so it does not change */
         return rc;
     }
@@ -1632,41 +1635,30 @@ lyd_new_path_check_find_lypath(struct ly_path *path, const char *str_path, const
 }
 
 /**
- * @brief Create a new node in the data tree based on a path. All node types can be created.
+ * @brief Create a new node in the data tree based on a compiled path. All node types can be created.
  *
- * If @p path points to a list key, the key value from the predicate is used and @p value is ignored.
- * Also, if a leaf-list is being created and both a predicate is defined in @p path
- * and @p value is set, the predicate is preferred.
+ * Details are mentioned in ::lyd_new_path_().
  *
- * For key-less lists and state leaf-lists, positional predicates can be used. If no preciate is used for these
- * nodes, they are always created.
- *
- * @param[in] parent Data parent to add to/modify, can be NULL. Note that in case a first top-level sibling is used,
- * it may no longer be first if @p path is absolute and starts with a non-existing top-level node inserted
- * before @p parent. Use ::lyd_first_sibling() to adjust @p parent in these cases.
- * @param[in] ctx libyang context, must be set if @p parent is NULL.
- * @param[in] ext Extension instance where the node being created is defined. This argument takes effect only for absolute
- * path or when the relative paths touches document root (top-level). In such cases the present extension instance replaces
- * searching for the appropriate module.
- * @param[in] path [Path](@ref howtoXPath) to create.
- * @param[in] value Value of the new leaf/leaf-list (const char *) in ::LY_VALUE_JSON format. If creating an
- * anyxml/anydata node, the expected type depends on @p value_type. For other node types, it should be NULL.
- * @param[in] value_len Length of @p value in bytes. May be 0 if @p value is a zero-terminated string. Ignored when
- * creating anyxml/anydata nodes.
+ * @param[in] parent Data parent to add to/modify, can be NULL.
+ * @param[in] ctx libyang context.
+ * @param[in] p Compiled path to create, may be modified (its predicates).
+ * @param[in] path String path @p p was compiled from, used for logging.
+ * @param[in] value Value of the new leaf/leaf-list or anyxml/anydata node.
+ * @param[in] value_len Length of @p value in bytes. May be 0 if @p value is a zero-terminated string.
  * @param[in] value_type Anyxml/anydata node @p value type.
  * @param[in] options Bitmask of options, see @ref pathoptions.
+ * @param[in] order Insert order of the created nodes, see @ref insertorder. With ::LYD_INSERT_NODE_BULK,
+ * ::lyd_insert_bulk_finish() must be called for the parents of the created nodes.
  * @param[out] new_parent Optional first parent node created. If only one node was created, equals to @p new_node.
  * @param[out] new_node Optional last node created.
  * @return LY_ERR value.
  */
 static LY_ERR
-lyd_new_path_(struct lyd_node *parent, const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, const char *path,
-        const void *value, size_t value_len, LYD_ANYDATA_VALUETYPE value_type, uint32_t options,
+lyd_new_path_create(struct lyd_node *parent, const struct ly_ctx *ctx, struct ly_path *p, const char *path,
+        const void *value, size_t value_len, LYD_ANYDATA_VALUETYPE value_type, uint32_t options, uint32_t order,
         struct lyd_node **new_parent, struct lyd_node **new_node)
 {
     LY_ERR ret = LY_SUCCESS, r;
-    struct lyxp_expr *exp = NULL;
-    struct ly_path *p = NULL;
     struct lyd_node *nparent = NULL, *nnode = NULL, *node = NULL, *cur_parent, *iter;
     const struct lysc_node *schema;
     const struct lyd_value *val = NULL;
@@ -1676,25 +1668,11 @@ lyd_new_path_(struct lyd_node *parent, const struct ly_ctx *ctx, const struct ly
     LY_VALUE_FORMAT format;
     uint32_t hints, count;
 
-    assert(parent || ctx);
-    assert(path && ((path[0] == '/') || parent));
-
-    if (!ctx) {
-        ctx = LYD_CTX(parent);
-    }
     if (value && !value_len) {
         value_len = strlen(value);
     }
     LY_CHECK_GOTO(ret = lyd_new_val_get_format(options, &format), cleanup);
 
-    /* parse path */
-    LY_CHECK_GOTO(ret = ly_path_parse(ctx, NULL, path, 0, 0, LY_PATH_BEGIN_EITHER, LY_PATH_PREFIX_FIRST,
-            LY_PATH_PRED_SIMPLE, &exp), cleanup);
-
-    /* compile path */
-    LY_CHECK_GOTO(ret = ly_path_compile(ctx, NULL, lyd_node_schema(parent), ext, exp, options & LYD_NEW_VAL_OUTPUT ?
-            LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT, LY_PATH_TARGET_MANY, 0, LY_VALUE_JSON, NULL, &p), cleanup);
-
     /* check the compiled path before searching existing nodes, it may be shortened */
     orig_count = LY_ARRAY_COUNT(p);
     LY_CHECK_GOTO(ret = lyd_new_path_check_find_lypath(p, path, value, value_len, format, options), cleanup);
@@ -1872,10 +1850,18 @@ lyd_new_path_(struct lyd_node *parent, const struct ly_ctx *ctx, const struct ly
         }
         if (cur_parent) {
             /* connect to the parent */
-            lyd_insert_node(cur_parent, NULL, node, LYD_INSERT_NODE_DEFAULT);
+            lyd_insert_node(cur_parent, NULL, node, order);
+            if ((order == LYD_INSERT_NODE_BULK) && cur_parent->schema &&
+                    !((struct lyd_node_inner *)cur_parent)->children_ht) {
+                /* create the hash table once there are enough children so that the following nodes are found quickly */
+                lyd_insert_hash(node);
+            }
         } else if (parent) {
-            /* connect to top-level siblings */
-            lyd_insert_node(NULL, &parent, node, LYD_INSERT_NODE_DEFAULT);
+            /* connect to top-level siblings, appended after the last one in bulk */
+            if (order == LYD_INSERT_NODE_BULK) {
+                parent = lyd_first_sibling(parent);
+            }
+            lyd_insert_node(NULL, &parent, node, order);
         }
 
 next_iter:
@@ -1887,13 +1873,9 @@ next_iter:
     }
 
 cleanup:
-    lyxp_expr_free(ctx, exp);
-    if (p) {
-        while (orig_count > LY_ARRAY_COUNT(p)) {
-            LY_ARRAY_INCREMENT(p);
-        }
+    while (orig_count > LY_ARRAY_COUNT(p)) {
+        LY_ARRAY_INCREMENT(p);
     }
-    ly_path_free(p);
     if (!ret) {
         /* set out params only on success */
         if (new_parent) {
@@ -1908,6 +1890,68 @@ cleanup:
     return ret;
 }
 
+/**
+ * @brief Create a new node in the data tree based on a path. All node types can be created.
+ *
+ * If @p path points to a list key, the key value from the predicate is used and @p value is ignored.
+ * Also, if a leaf-list is being created and both a predicate is defined in @p path
+ * and @p value is set, the predicate is preferred.
+ *
+ * For key-less lists and state leaf-lists, positional predicates can be used. If no preciate is used for these
+ * nodes, they are always created.
+ *
+ * @param[in] parent Data parent to add to/modify, can be NULL. Note that in case a first top-level sibling is used,
+ * it may no longer be first if @p path is absolute and starts with a non-existing top-level node inserted
+ * before @p parent. Use ::lyd_first_sibling() to adjust @p parent in these cases.
+ * @param[in] ctx libyang context, must be set if @p parent is NULL.
+ * @param[in] ext Extension instance where the node being created is defined. This argument takes effect only for absolute
+ * path or when the relative paths touches document root (top-level). In such cases the present extension instance replaces
+ * searching for the appropriate module.
+ * @param[in] path [Path](@ref howtoXPath) to create.
+ * @param[in] value Value of the new leaf/leaf-list (const char *) in ::LY_VALUE_JSON format. If creating an
+ * anyxml/anydata node, the expected type depends on @p value_type. For other node types, it should be NULL.
+ * @param[in] value_len Length of @p value in bytes. May be 0 if @p value is a zero-terminated string. Ignored when
+ * creating anyxml/anydata nodes.
+ * @param[in] value_type Anyxml/anydata node @p value type.
+ * @param[in] options Bitmask of options, see @ref pathoptions.
+ * @param[out] new_parent Optional first parent node created. If only one node was created, equals to @p new_node.
+ * @param[out] new_node Optional last node created.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_new_path_(struct lyd_node *parent, const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, const char *path,
+        const void *value, size_t value_len, LYD_ANYDATA_VALUETYPE value_type, uint32_t options,
+        struct lyd_node **new_parent, struct lyd_node **new_node)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyxp_expr *exp = NULL;
+    struct ly_path *p = NULL;
+
+    assert(parent || ctx);
+    assert(path && ((path[0] == '/') || parent));
+
+    if (!ctx) {
+        ctx = LYD_CTX(parent);
+    }
+
+    /* parse path */
+    LY_CHECK_GOTO(ret = ly_path_parse(ctx, NULL, path, 0, 0, LY_PATH_BEGIN_EITHER, LY_PATH_PREFIX_FIRST,
+            LY_PATH_PRED_SIMPLE, &exp), cleanup);
+
+    /* compile path */
+    LY_CHECK_GOTO(ret = ly_path_compile(ctx, NULL, lyd_node_schema(parent), ext, exp, options & LYD_NEW_VAL_OUTPUT ?
+            LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT, LY_PATH_TARGET_MANY, 0, LY_VALUE_JSON, NULL, &p), cleanup);
+
+    /* create the nodes */
+    ret = lyd_new_path_create(parent, ctx, p, path, value, value_len, value_type, options, LYD_INSERT_NODE_DEFAULT,
+            new_parent, new_node);
+
+cleanup:
+    lyxp_expr_free(ctx, exp);
+    ly_path_free(p);
+    return ret;
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_new_path(struct lyd_node *parent, const struct ly_ctx *ctx, const char *path, const char *value, uint32_t options,
         struct lyd_node **node)
@@ -1944,6 +1988,562 @@ lyd_new_ext_path(struct lyd_node *parent, const struct lysc_ext_instance *ext, c
     return lyd_new_path_(parent, ctx, ext, path, value, 0, LYD_ANYDATA_STRING, options, node, NULL);
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_new_path_handle(struct lyd_node *parent, const struct lyd_path_handle *handle, const char **args, const char *value,
+        uint32_t options, struct lyd_node **node)
+{
+    LY_ERR ret;
+    struct lyxp_var *vars = NULL;
+    struct ly_path *p = NULL;
+
+    LY_CHECK_ARG_RET(NULL, handle, !handle->ctx_node || (parent && (parent->schema == handle->ctx_node)),
+            !(options & LYD_NEW_VAL_BIN) || !(options & LYD_NEW_VAL_CANON), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, handle->ctx, LY_EINVAL);
+
+    /* bind the variables */
+    LY_CHECK_RET(lyd_path_handle_vars(handle, args, &vars));
+    ret = ly_path_dup_bind(handle->ctx, handle->path, vars, &p);
+    LY_ARRAY_FREE(vars);
+    LY_CHECK_RET(ret);
+
+    /* create the nodes */
+    options &= ~LYD_NEW_VAL_OUTPUT;
+    if (handle->output) {
+        options |= LYD_NEW_VAL_OUTPUT;
+    }
+    ret = lyd_new_path_create(parent, handle->ctx, p, handle->str_path, value, 0, LYD_ANYDATA_STRING, options,
+            LYD_INSERT_NODE_DEFAULT, node, NULL);
+
+    ly_path_free(p);
+    return ret;
+}
+
+/**
+ * @brief Check whether two compiled path segments identify the same data node.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] seg1 First compiled path segment.
+ * @param[in] seg2 Second compiled path segment.
+ * @return Whether the segments are equal and an existing instance is identified by them.
+ */
+static ly_bool
+lyd_new_paths_segment_equal(const struct ly_ctx *ctx, const struct ly_path *seg1, const struct ly_path *seg2)
+{
+    const struct ly_path_predicate *pred1, *pred2;
+    LY_ARRAY_COUNT_TYPE u;
+
+    if ((seg1->node != seg2->node) || (seg1->ext != seg2->ext) ||
+            (LY_ARRAY_COUNT(seg1->predicates) != LY_ARRAY_COUNT(seg2->predicates))) {
+        return 0;
+    }
+    if (lysc_is_dup_inst_list(seg1->node) && !seg1->predicates) {
+        /* a new instance is created for every such segment */
+        return 0;
+    }
+
+    LY_ARRAY_FOR(seg1->predicates, u) {
+        pred1 = &seg1->predicates[u];
+        pred2 = &seg2->predicates[u];
+        if (pred1->type != pred2->type) {
+            return 0;
+        }
+
+        switch (pred1->type) {
+        case LY_PATH_PREDTYPE_POSITION:
+            if (pred1->position != pred2->position) {
+                return 0;
+            }
+            break;
+        case LY_PATH_PREDTYPE_LIST:
+        case LY_PATH_PREDTYPE_LEAFLIST:
+            if ((pred1->key != pred2->key) || (pred1->value.realtype != pred2->value.realtype) ||
+                    pred1->value.realtype->plugin->compare(ctx, &pred1->value, &pred2->value)) {
+                return 0;
+            }
+            break;
+        case LY_PATH_PREDTYPE_LIST_VAR:
+            /* no variables are bound */
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Hash table equal callback for the parents of nodes inserted in bulk.
+ */
+static ly_bool
+lyd_new_paths_parent_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return *(struct lyd_node **)val1_p == *(struct lyd_node **)val2_p;
+}
+
+/**
+ * @brief Remember a parent of nodes inserted in bulk to finish the insertion into it later.
+ *
+ * @param[in] parent_ht Hash table of the remembered parents.
+ * @param[in,out] parents Set of the remembered parents.
+ * @param[in] parent Parent to remember, NULL for top-level.
+ * @param[in,out] top_level Set if @p parent is NULL.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_new_paths_bulk_parent(struct ly_ht *parent_ht, struct ly_set *parents, struct lyd_node *parent, ly_bool *top_level)
+{
+    LY_ERR r;
+
+    if (!parent) {
+        *top_level = 1;
+        return LY_SUCCESS;
+    }
+
+    r = lyht_insert(parent_ht, &parent, parent->hash, NULL);
+    if (r == LY_EEXIST) {
+        /* already remembered */
+        return LY_SUCCESS;
+    }
+    LY_CHECK_RET(r);
+
+    return ly_set_add(parents, parent, 1, NULL);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_new_paths(struct lyd_node *parent, const struct ly_ctx *ctx, const char **paths, const char **values, uint32_t count,
+        uint32_t options, struct lyd_node **tree)
+{
+    LY_ERR ret = LY_SUCCESS, r;
+    struct lyxp_expr *exp = NULL;
+    struct ly_path **lypaths = NULL, *p, *rest = NULL;
+    struct lyd_node *first = NULL, *base, *top, *nparent, *nnode, *node, **seg_nodes = NULL;
+    struct ly_ht *parent_ht = NULL;
+    struct ly_set parents = {0};
+    LY_ARRAY_COUNT_TYPE u, seg_count, shared, seg_size = 0, prev_seg_count = 0;
+    uint32_t i;
+    ly_bool top_level = 0;
+
+    LY_CHECK_ARG_RET(ctx, parent || ctx, parent || tree, !count || paths, !(options & LYD_NEW_VAL_BIN), LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(__func__, parent ? LYD_CTX(parent) : NULL, ctx, LY_EINVAL);
+
+    if (!ctx) {
+        ctx = LYD_CTX(parent);
+    }
+
+    /* parse and compile all the paths first */
+    if (count) {
+        lypaths = calloc(count, sizeof *lypaths);
+        LY_CHECK_ERR_GOTO(!lypaths, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+    }
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_ERR_GOTO(!paths[i] || ((paths[i][0] != '/') && !parent), LOGARG(ctx, paths); ret = LY_EINVAL, cleanup);
+
+        LY_CHECK_GOTO(ret = ly_path_parse(ctx, NULL, paths[i], 0, 0, LY_PATH_BEGIN_EITHER, LY_PATH_PREFIX_FIRST,
+                LY_PATH_PRED_SIMPLE, &exp), cleanup);
+        ret = ly_path_compile(ctx, NULL, lyd_node_schema(parent), NULL, exp, (options & LYD_NEW_VAL_OUTPUT) ?
+                LY_PATH_OPER_OUTPUT : LY_PATH_OPER_INPUT, LY_PATH_TARGET_MANY, 0, LY_VALUE_JSON, NULL, &lypaths[i]);
+        lyxp_expr_free(ctx, exp);
+        exp = NULL;
+        LY_CHECK_GOTO(ret, cleanup);
+    }
+
+    /* parents the nodes were inserted into in bulk */
+    parent_ht = lyht_new(LYHT_MIN_SIZE, sizeof node, lyd_new_paths_parent_equal_cb, NULL, 1);
+    LY_CHECK_ERR_GOTO(!parent_ht, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+
+    for (i = 0; i < count; ++i) {
+        p = lypaths[i];
+        seg_count = LY_ARRAY_COUNT(p);
+        if (seg_count > seg_size) {
+            seg_size = seg_count;
+            seg_nodes = ly_realloc(seg_nodes, seg_size * sizeof *seg_nodes);
+            LY_CHECK_ERR_GOTO(!seg_nodes, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+        }
+
+        /* learn how many leading segments are shared with the previous path, at least the last one is created */
+        for (shared = 0; (shared < prev_seg_count) && (shared + 1 < seg_count); ++shared) {
+            if (!lyd_new_paths_segment_equal(ctx, &lypaths[i - 1][shared], &p[shared])) {
+                break;
+            }
+        }
+        if (shared && !lysc_data_parent(p[shared].node)) {
+            /* the rest of the path would not be relative */
+            shared = 0;
+        }
+
+        /* create the rest of the path from the last shared node, errors are reported for the whole path */
+        if (shared) {
+            base = seg_nodes[shared - 1];
+            LY_ARRAY_CREATE_GOTO(ctx, rest, seg_count - shared, ret, cleanup);
+            for (u = shared; u < seg_count; ++u) {
+                LY_ARRAY_INCREMENT(rest);
+                rest[u - shared] = p[u];
+            }
+        } else {
+            base = parent ? parent : first;
+        }
+        nparent = NULL;
+        nnode = NULL;
+        ret = lyd_new_path_create(base, ctx, shared ? rest : p, paths[i], values ? values[i] : NULL, 0,
+                LYD_ANYDATA_STRING, options, LYD_INSERT_NODE_BULK, &nparent, &nnode);
+        if (rest) {
+            /* the predicates of the segments may have been changed */
+            memcpy(p + shared, rest, (seg_count - shared) * sizeof *p);
+            LY_ARRAY_FREE(rest);
+            rest = NULL;
+        }
+        LY_CHECK_GOTO(ret, cleanup);
+        if (!parent && nparent && !lyd_parent(nparent) && !nparent->prev->next) {
+            /* new first top-level sibling */
+            first = nparent;
+        }
+
+        /* remember the parents of all the created nodes */
+        for (node = nnode; node; node = (node == nparent) ? NULL : lyd_parent(node)) {
+            LY_CHECK_GOTO(ret = lyd_new_paths_bulk_parent(parent_ht, &parents, lyd_parent(node), &top_level), cleanup);
+        }
+
+        /* remember the nodes of all the segments, the target node is of the last one */
+        prev_seg_count = shared;
+        if (nnode) {
+            node = nnode;
+            for (u = seg_count; (u > shared) && node; --u) {
+                seg_nodes[u - 1] = node;
+                node = lyd_parent(node);
+            }
+            if ((u == shared) && (!shared || (node == seg_nodes[shared - 1]))) {
+                prev_seg_count = seg_count;
+            }
+        }
+    }
+
+cleanup:
+    if (!ret || parent) {
+        /* sort the (leaf-)list instances and hash the children of all the parents once */
+        for (i = 0; i < parents.count; ++i) {
+            r = lyd_insert_bulk_finish(parents.dnodes[i], NULL);
+            ret = ret ? ret : r;
+        }
+        if (top_level) {
+            for (top = parent ? parent : first; lyd_parent(top); top = lyd_parent(top)) {}
+            top = lyd_first_sibling(top);
+            r = lyd_insert_bulk_finish(NULL, &top);
+            ret = ret ? ret : r;
+            if (!parent) {
+                first = top;
+            }
+        }
+    }
+    lyxp_expr_free(ctx, exp);
+    for (i = 0; lypaths && (i < count); ++i) {
+        ly_path_free(lypaths[i]);
+    }
+    free(lypaths);
+    free(seg_nodes);
+    lyht_free(parent_ht, NULL);
+    ly_set_erase(&parents, NULL);
+    if (ret) {
+        if (!parent) {
+            lyd_free_siblings(first);
+        }
+    } else if (tree) {
+        *tree = first;
+    }
+    return ret;
+}
+
+/**
+ * @brief Check whether the default leaves and leaf-lists of a node are virtual.
+ *
+ * @param[in] parent Data parent, NULL for top-level.
+ * @return Whether its default nodes are not created but resolved virtually.
+ */
+static ly_bool
+lyd_dflt_is_virtual(const struct lyd_node *parent)
+{
+    if (!parent || !parent->schema || !(parent->schema->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_NOTIF))) {
+        /* top-level and operation defaults are always created */
+        return 0;
+    }
+
+    return (LYD_CTX(parent)->flags & LY_CTX_VIRTUAL_DEFAULTS) ? 1 : 0;
+}
+
+/**
+ * @brief Get the number of default values of a schema node.
+ *
+ * @param[in] snode Schema node.
+ * @return Number of its default values, 0 if it is not a leaf or a leaf-list.
+ */
+static LY_ARRAY_COUNT_TYPE
+lyd_dflt_count(const struct lysc_node *snode)
+{
+    if ((snode->nodetype == LYS_LEAF) && ((struct lysc_node_leaf *)snode)->dflt) {
+        return 1;
+    } else if (snode->nodetype == LYS_LEAFLIST) {
+        return LY_ARRAY_COUNT(((struct lysc_node_leaflist *)snode)->dflts);
+    }
+    return 0;
+}
+
+/**
+ * @brief Check whether values of a type need to be validated in the data tree.
+ *
+ * @param[in] type Type to check.
+ * @return Whether it requires an instance in the data tree.
+ */
+static ly_bool
+lyd_dflt_type_needs_tree(const struct lysc_type *type)
+{
+    const struct lysc_type_union *type_u;
+    LY_ARRAY_COUNT_TYPE u;
+
+    switch (type->basetype) {
+    case LY_TYPE_LEAFREF:
+        return ((struct lysc_type_leafref *)type)->require_instance;
+    case LY_TYPE_INST:
+        return ((struct lysc_type_instanceid *)type)->require_instance;
+    case LY_TYPE_UNION:
+        type_u = (const struct lysc_type_union *)type;
+        LY_ARRAY_FOR(type_u->types, u) {
+            if (lyd_dflt_type_needs_tree(type_u->types[u])) {
+                return 1;
+            }
+        }
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Check whether the default values of a schema node need to be validated in the data tree.
+ *
+ * Such defaults (leafref, instance-identifier with require-instance) are always created so that they are validated
+ * with the tree.
+ *
+ * @param[in] snode Leaf or leaf-list schema node.
+ * @return Whether its type needs to be resolved in the data tree.
+ */
+static ly_bool
+lyd_dflt_needs_tree(const struct lysc_node *snode)
+{
+    return lyd_dflt_type_needs_tree(((struct lysc_node_leaf *)snode)->type);
+}
+
+/**
+ * @brief Get the schema parent of the case of a choice whose default nodes a data parent may have.
+ *
+ * @param[in] parent Data parent.
+ * @param[in] choice Choice schema node.
+ * @return Case of the existing data or the default case, NULL if there is none.
+ */
+static const struct lysc_node *
+lyd_dflt_choice_case(const struct lyd_node *parent, const struct lysc_node_choice *choice)
+{
+    const struct lyd_node *node;
+
+    node = lys_getnext_data(NULL, lyd_child(parent), NULL, &choice->node, NULL);
+    if (node) {
+        return node->schema->parent;
+    }
+    return choice->dflt ? &choice->dflt->node : NULL;
+}
+
+/**
+ * @brief Create the default nodes of the schema children of a data parent, recursively for choices.
+ *
+ * @param[in] parent Data parent.
+ * @param[in] sparent Schema parent, schema node of @p parent or a case.
+ * @param[in] mod Module of the nodes to create, NULL for any.
+ * @param[in] name Name of the nodes to create in the dictionary, NULL for any.
+ * @param[in] state_only Whether to create only the state (config false) default nodes.
+ * @param[in] materialize Whether to insert the nodes into @p parent or into @p dflts.
+ * @param[in,out] dflts Created virtual default siblings, not connected to @p parent yet.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_dflt_virtual_r(struct lyd_node *parent, const struct lysc_node *sparent, const struct lys_module *mod,
+        const char *name, ly_bool state_only, ly_bool materialize, struct lyd_node **dflts)
+{
+    LY_ERR r;
+    const struct lysc_node *snode = NULL, *scase;
+    struct lyd_node *node;
+    struct lyd_value *dflt;
+    LY_ARRAY_COUNT_TYPE u, count;
+    ly_bool enabled;
+
+    while ((snode = lys_getnext(snode, sparent, NULL, LYS_GETNEXT_WITHCHOICE))) {
+        if (snode->flags & LYS_STATUS_OBSLT) {
+            continue;
+        }
+
+        if (snode->nodetype == LYS_CHOICE) {
+            /* the existing case or the default one */
+            scase = lyd_dflt_choice_case(parent, (const struct lysc_node_choice *)snode);
+            if (scase) {
+                LY_CHECK_RET(lyd_dflt_virtual_r(parent, scase, mod, name, state_only, materialize, dflts));
+            }
+            continue;
+        } else if ((name && (snode->name != name)) || (mod && (snode->module != mod))) {
+            continue;
+        } else if (state_only && !(snode->flags & LYS_CONFIG_R)) {
+            continue;
+        }
+
+        count = lyd_dflt_count(snode);
+        if (!count || !lyd_find_sibling_val(lyd_child(parent), snode, NULL, 0, NULL)) {
+            /* no default or an existing instance */
+            continue;
+        }
+
+        for (u = 0; u < count; ++u) {
+            if (snode->nodetype == LYS_LEAF) {
+                dflt = ((struct lysc_node_leaf *)snode)->dflt;
+            } else {
+                dflt = ((struct lysc_node_leaflist *)snode)->dflts[u];
+            }
+
+            /* the value was validated when the schema was compiled, defaults requiring an instance are never virtual
+             * in a validated tree because they are created and validated with it, see lyd_new_implicit() */
+            LY_CHECK_RET(lyd_create_term2(snode, dflt, &node));
+            node->flags = LYD_DEFAULT | LYD_VIRTUAL | (lysc_has_when(snode) ? LYD_WHEN_TRUE : 0);
+
+            if (!u && lysc_has_when(snode)) {
+                /* evaluate the when conditions shared by all the instances */
+                node->parent = (struct lyd_node_inner *)parent;
+                r = lyd_validate_dflt_when(node, &enabled);
+                node->parent = NULL;
+                if (r || !enabled) {
+                    lyd_free_tree(node);
+                    LY_CHECK_RET(r);
+                    break;
+                }
+            }
+
+            if (materialize) {
+                node->flags &= ~LYD_VIRTUAL;
+                lyd_insert_node(parent, NULL, node, LYD_INSERT_NODE_DEFAULT);
+            } else {
+                lyd_insert_node(NULL, dflts, node, LYD_INSERT_NODE_DEFAULT);
+            }
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyd_dflt_virtual_new(const struct lyd_node *parent, const struct lys_module *mod, const char *name,
+        ly_bool state_only, struct lyd_node **dflts)
+{
+    LY_ERR rc;
+    struct lyd_node *iter;
+
+    *dflts = NULL;
+
+    if (!lyd_dflt_is_virtual(parent)) {
+        return LY_SUCCESS;
+    }
+
+    rc = lyd_dflt_virtual_r((struct lyd_node *)parent, parent->schema, mod, name, state_only, 0, dflts);
+    if (rc) {
+        lyd_free_siblings(*dflts);
+        *dflts = NULL;
+        return rc;
+    }
+
+    /* only now, they were not inserted into the parent */
+    LY_LIST_FOR(*dflts, iter) {
+        iter->parent = (struct lyd_node_inner *)parent;
+    }
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Check whether the schema children of a data parent have any virtual default nodes, recursively for choices.
+ *
+ * @param[in] parent Data parent.
+ * @param[in] sparent Schema parent, schema node of @p parent or a case.
+ * @param[in] state_only Whether to consider only the state (config false) default nodes.
+ * @return Whether there is a virtual default node.
+ */
+static ly_bool
+lyd_dflt_virtual_exists_r(const struct lyd_node *parent, const struct lysc_node *sparent, ly_bool state_only)
+{
+    const struct lysc_node *snode = NULL, *scase;
+    struct lyd_node *dflts;
+    ly_bool exists;
+
+    while ((snode = lys_getnext(snode, sparent, NULL, LYS_GETNEXT_WITHCHOICE))) {
+        if (snode->flags & LYS_STATUS_OBSLT) {
+            continue;
+        }
+
+        if (snode->nodetype == LYS_CHOICE) {
+            scase = lyd_dflt_choice_case(parent, (const struct lysc_node_choice *)snode);
+            if (scase && lyd_dflt_virtual_exists_r(parent, scase, state_only)) {
+                return 1;
+            }
+            continue;
+        } else if (state_only && !(snode->flags & LYS_CONFIG_R)) {
+            continue;
+        }
+
+        if (!lyd_dflt_count(snode) || !lyd_find_sibling_val(lyd_child(parent), snode, NULL, 0, NULL)) {
+            /* no default or an existing instance */
+            continue;
+        }
+
+        if (!lysc_has_when(snode)) {
+            return 1;
+        }
+
+        /* only the when conditions need to be evaluated on a created node */
+        if (lyd_dflt_virtual_new(parent, snode->module, snode->name, state_only, &dflts)) {
+            continue;
+        }
+        exists = dflts ? 1 : 0;
+        lyd_dflt_virtual_free(dflts);
+        if (exists) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+ly_bool
+lyd_dflt_virtual_exists(const struct lyd_node *parent, ly_bool state_only)
+{
+    if (!lyd_dflt_is_virtual(parent)) {
+        return 0;
+    }
+
+    return lyd_dflt_virtual_exists_r(parent, parent->schema, state_only);
+}
+
+void
+lyd_dflt_virtual_free(struct lyd_node *dflts)
+{
+    struct lyd_node *iter;
+
+    /* they are not in the parent children */
+    LY_LIST_FOR(dflts, iter) {
+        iter->parent = NULL;
+    }
+    lyd_free_siblings(dflts);
+}
+
+LY_ERR
+lyd_dflt_materialize(struct lyd_node *parent, const struct lys_module *mod, const char *name)
+{
+    if (!lyd_dflt_is_virtual(parent)) {
+        return LY_SUCCESS;
+    }
+
+    return lyd_dflt_virtual_r(parent, parent->schema, mod, name, 0, 1, NULL);
+}
+
 LY_ERR
 lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct lysc_node *sparent,
         const struct lys_module *mod, struct ly_set *node_when, struct ly_set *node_types, struct ly_set *ext_node,
@@ -1955,6 +2555,7 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
     struct lyd_value **dflts;
     LY_ARRAY_COUNT_TYPE u;
     uint32_t i;
+    ly_bool virt_dflts;
 
     assert(first && (parent || sparent || mod));
 
@@ -1962,6 +2563,9 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
         sparent = parent->schema;
     }
 
+    /* default leaves and leaf-lists are resolved only when needed, except those validated in the data tree */
+    virt_dflts = ((impl_opts & LYD_IMPLICIT_VIRTUAL) && lyd_dflt_is_virtual(parent)) ? 1 : 0;
+
     /* get cached getnext schema nodes */
     LY_CHECK_RET(lyd_val_getnext_get(sparent, mod, NULL, impl_opts & LYD_IMPLICIT_OUTPUT, getnext_ht, &choices, &snodes));
 
@@ -2026,12 +2630,12 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
             break;
         case LYS_LEAF:
             if (!(impl_opts & LYD_IMPLICIT_NO_DEFAULTS) && ((struct lysc_node_leaf *)snode)->dflt &&
-                    lyd_find_sibling_val(*first, snode, NULL, 0, NULL)) {
+                    (!virt_dflts || lyd_dflt_needs_tree(snode)) && lyd_find_sibling_val(*first, snode, NULL, 0, NULL)) {
                 /* create default leaf */
                 ret = lyd_create_term2(snode, ((struct lysc_node_leaf *)snode)->dflt, &node);
-                if (ret == LY_EINCOMPLETE) {
+                if ((ret == LY_EINCOMPLETE) || (!ret && virt_dflts)) {
                     if (node_types) {
-                        /* remember to resolve type */
+                        /* remember to resolve type, the only reason to create an otherwise virtual default */
                         LY_CHECK_RET(ly_set_add(node_types, node, 1, NULL));
                     }
                 } else if (ret) {
@@ -2056,14 +2660,14 @@ lyd_new_implicit(struct lyd_node *parent, struct lyd_node **first, const struct
             break;
         case LYS_LEAFLIST:
             if (!(impl_opts & LYD_IMPLICIT_NO_DEFAULTS) && ((struct lysc_node_leaflist *)snode)->dflts &&
-                    lyd_find_sibling_val(*first, snode, NULL, 0, NULL)) {
+                    (!virt_dflts || lyd_dflt_needs_tree(snode)) && lyd_find_sibling_val(*first, snode, NULL, 0, NULL)) {
                 /* create all default leaf-lists */
                 dflts = ((struct lysc_node_leaflist *)snode)->dflts;
                 LY_ARRAY_FOR(dflts, u) {
                     ret = lyd_create_term2(snode, dflts[u], &node);
-                    if (ret == LY_EINCOMPLETE) {
+                    if ((ret == LY_EINCOMPLETE) || (!ret && virt_dflts)) {
                         if (node_types) {
-                            /* remember to resolve type */
+                            /* remember to resolve type, the only reason to create an otherwise virtual default */
                             LY_CHECK_RET(ly_set_add(node_types, node, 1, NULL));
                         }
                     } else if (ret) {
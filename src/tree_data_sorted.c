@@ -1328,6 +1328,200 @@ cleanup:
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Instance of a (leaf-)list being sorted by ::lyds_build().
+ */
+struct lyds_build_item {
+    struct lyd_node *node;  /**< (leaf-)list instance */
+    uint32_t idx;           /**< original position of the instance, for a stable sort */
+};
+
+/**
+ * @brief Compare callback for sorting (leaf-)list instances, equal instances keep their original order.
+ *
+ * Implementation of the qsort(3) callback.
+ */
+static int
+lyds_build_compare(const void *ptr1, const void *ptr2)
+{
+    const struct lyds_build_item *item1 = ptr1, *item2 = ptr2;
+    int comp;
+
+    comp = lyds_compare_single(item1->node, item2->node);
+    if (!comp) {
+        comp = (item1->idx < item2->idx) ? -1 : 1;
+    }
+    return comp;
+}
+
+/**
+ * @brief Build a balanced Red-black tree from sorted red-black nodes.
+ *
+ * All the levels except the deepest one are full so the nodes in the deepest level are red and all the others black.
+ *
+ * @param[in] rbns Sorted red-black nodes.
+ * @param[in] count Count of @p rbns.
+ * @param[in] parent Parent of the built subtree.
+ * @param[in] depth Depth of the built subtree.
+ * @param[in] red_depth Depth of the red nodes.
+ * @return Root of the built subtree.
+ */
+static struct rb_node *
+rb_build(struct rb_node **rbns, uint32_t count, struct rb_node *parent, uint32_t depth, uint32_t red_depth)
+{
+    struct rb_node *rbn;
+    uint32_t mid;
+
+    if (!count) {
+        return NULL;
+    }
+
+    mid = count / 2;
+    rbn = rbns[mid];
+    RBN_PARENT(rbn) = parent;
+    RBN_COLOR(rbn) = (depth == red_depth) ? RB_RED : RB_BLACK;
+    RBN_LEFT(rbn) = rb_build(rbns, mid, rbn, depth + 1, red_depth);
+    RBN_RIGHT(rbn) = rb_build(rbns + mid + 1, count - mid - 1, rbn, depth + 1, red_depth);
+
+    return rbn;
+}
+
+LY_ERR
+lyds_build(struct lyd_node **first_sibling, struct lyd_node **leader)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyds_build_item *items = NULL;
+    struct rb_node **rbns = NULL, *rbt;
+    struct lyd_meta *root_meta;
+    struct lyd_node *iter, *before, *after, *last;
+    uint32_t i, count, red_depth;
+    ly_bool sorted = 1;
+
+    assert(first_sibling && leader && LYDS_NODE_IS_LEADER((*leader)));
+
+    /* count the instances and learn whether they are sorted */
+    count = 1;
+    for (iter = (*leader)->next; iter && (iter->schema == (*leader)->schema); iter = iter->next) {
+        if (sorted && (lyds_compare_single(iter->prev, iter) > 0)) {
+            sorted = 0;
+        }
+        ++count;
+    }
+    after = iter;
+
+    rbt = lyds_get_rb_tree(*leader, &root_meta);
+    if ((count == 1) && !root_meta) {
+        /* single instance, no tree needed */
+        return LY_SUCCESS;
+    }
+
+    items = malloc(count * sizeof *items);
+    rbns = calloc(count, sizeof *rbns);
+    LY_CHECK_ERR_GOTO(!items || !rbns, LOGMEM(LYD_CTX(*leader)); rc = LY_EMEM, cleanup);
+    for (i = 0, iter = *leader; i < count; ++i, iter = iter->next) {
+        items[i].node = iter;
+        items[i].idx = i;
+    }
+
+    /* sort the instances */
+    if (!sorted) {
+        qsort(items, count, sizeof *items, lyds_build_compare);
+    }
+
+    /* create all the red-black nodes */
+    for (i = 0; i < count; ++i) {
+        LY_CHECK_GOTO(rc = lyds_create_node(items[i].node, &rbns[i]), cleanup);
+    }
+
+    if (!sorted) {
+        /* relink the data nodes in the sorted order */
+        before = (*leader)->prev->next ? (*leader)->prev : NULL;
+        last = (*first_sibling)->prev;
+        for (i = 0; i < count; ++i) {
+            items[i].node->prev = i ? items[i - 1].node : before;
+            items[i].node->next = (i + 1 < count) ? items[i + 1].node : after;
+        }
+        if (before) {
+            before->next = items[0].node;
+        } else {
+            /* new first sibling */
+            items[0].node->prev = after ? last : items[count - 1].node;
+            *first_sibling = items[0].node;
+            if (items[0].node->parent) {
+                items[0].node->parent->child = items[0].node;
+            }
+        }
+        if (after) {
+            after->prev = items[count - 1].node;
+        } else {
+            (*first_sibling)->prev = items[count - 1].node;
+        }
+    }
+
+    /* the metadata with the tree belong to the first instance */
+    if (root_meta) {
+        lyds_free_tree(rbt);
+        RBT_SET(root_meta, NULL);
+        if (items[0].node != *leader) {
+            lyds_move_meta(items[0].node, root_meta);
+        }
+    } else {
+        LY_CHECK_GOTO(rc = lyds_create_metadata(items[0].node, &root_meta), cleanup);
+    }
+    for (i = 1; i < count; ++i) {
+        /* metadata of other instances are not needed */
+        lyds_free_metadata(items[i].node);
+    }
+    *leader = items[0].node;
+
+    /* build the tree, the deepest level of red nodes is the only one that need not be full */
+    for (red_depth = 0; (count >> red_depth) > 1; ++red_depth) {}
+    rbt = rb_build(rbns, count, NULL, 0, red_depth ? red_depth : UINT32_MAX);
+    RBT_SET(root_meta, rbt);
+
+cleanup:
+    if (rc && rbns) {
+        for (i = 0; i < count; ++i) {
+            rb_free_node(&rbns[i]);
+        }
+    }
+    free(items);
+    free(rbns);
+    return rc;
+}
+
+LY_ERR
+lyds_build_appended(struct lyd_node **first_sibling, struct lyd_node **leader, struct lyd_node **last)
+{
+    LY_ERR rc;
+    struct rb_node *rbt, *rbn;
+    struct lyd_meta *root_meta;
+    struct lyd_node *iter;
+
+    assert(first_sibling && leader && last && LYDS_NODE_IS_LEADER((*leader)));
+
+    rbt = lyds_get_rb_tree(*leader, &root_meta);
+    if (!rbt) {
+        /* no BST, sort all the instances */
+        LY_CHECK_RET(lyds_build(first_sibling, leader));
+        for (*last = *leader; (*last)->next && ((*last)->next->schema == (*leader)->schema); *last = (*last)->next) {}
+        return LY_SUCCESS;
+    }
+
+    /* the instances following the greatest one in the BST were appended */
+    for (rbn = rbt; RBN_RIGHT(rbn); rbn = RBN_RIGHT(rbn)) {}
+    iter = RBN_DNODE(rbn)->next;
+    if (iter && (iter->schema == (*leader)->schema)) {
+        rc = lyds_additionally_create_rb_nodes(first_sibling, leader, root_meta, &rbt, iter);
+        RBT_SET(root_meta, rbt);
+        LY_CHECK_RET(rc);
+        for (rbn = rbt; RBN_RIGHT(rbn); rbn = RBN_RIGHT(rbn)) {}
+    }
+    *last = RBN_DNODE(rbn);
+
+    return LY_SUCCESS;
+}
+
 void
 lyds_unlink(struct lyd_node **leader, struct lyd_node *node)
 {
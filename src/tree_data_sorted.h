@@ -114,6 +114,32 @@ LY_ERR lyds_insert(struct lyd_node **first_sibling, struct lyd_node **leader, st
 LY_ERR lyds_insert2(struct lyd_node *parent, struct lyd_node **first_sibling, struct lyd_node **leader,
         struct lyd_node *node, struct lyds_pool *pool);
 
+/**
+ * @brief Sort all the instances of a (leaf-)list and build their BST at once.
+ *
+ * Used after the instances were inserted without sorting. The instances are sorted stably so equal
+ * instances keep their order, and the BST is constructed from the sorted instances in linear time. Any previous
+ * BST is discarded. Hash for data nodes is not updated.
+ *
+ * @param[in,out] first_sibling First sibling node, updated if the first instance is moved.
+ * @param[in,out] leader First instance of the (leaf-)list, set to the first instance after sorting.
+ * @return LY_ERR value.
+ */
+LY_ERR lyds_build(struct lyd_node **first_sibling, struct lyd_node **leader);
+
+/**
+ * @brief Sort the instances of a (leaf-)list appended after its sorted instances.
+ *
+ * If the (leaf-)list has a BST, only the instances following its greatest instance are inserted into it and their
+ * hashes are updated, the other instances are not visited. Otherwise, all the instances are sorted by ::lyds_build().
+ *
+ * @param[in,out] first_sibling First sibling node, updated if the first instance is moved.
+ * @param[in,out] leader First instance of the (leaf-)list, set to the first instance after sorting.
+ * @param[out] last Last instance of the (leaf-)list after sorting.
+ * @return LY_ERR value.
+ */
+LY_ERR lyds_build_appended(struct lyd_node **first_sibling, struct lyd_node **leader, struct lyd_node **last);
+
 /**
  * @brief Unlink (remove) the specified data node from BST.
  *
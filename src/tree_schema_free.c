@@ -22,6 +22,7 @@
 #include "dict.h"
 #include "log.h"
 #include "ly_common.h"
+#include "parser_data.h"
 #include "plugins_exts.h"
 #include "plugins_types.h"
 #include "tree.h"
@@ -1280,6 +1281,9 @@ lysc_module_free(struct lysf_ctx *ctx, struct lysc_module *module)
         return;
     }
 
+    /* validation profiler records reference the compiled constraints and nodes */
+    lyd_validate_profile_clear(ctx->ctx);
+
     LY_LIST_FOR_SAFE(module->data, node_next, node) {
         lysc_node_free_(ctx, node);
     }
@@ -16,17 +16,22 @@
 #include "validation.h"
 
 #include <assert.h>
+#include <inttypes.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "compat.h"
 #include "diff.h"
 #include "hash_table.h"
+#include "hash_table_internal.h"
 #include "log.h"
 #include "ly_common.h"
+#include "out_internal.h"
 #include "parser_data.h"
 #include "parser_internal.h"
 #include "plugins_exts.h"
@@ -159,6 +164,240 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Validation profiler record.
+ */
+struct lyd_val_prof_rec {
+    enum lyd_val_prof_kind kind;    /**< kind of the constraint */
+    const void *cons;               /**< measured constraint */
+    const struct lysc_node *node;   /**< schema node of the constraint */
+    uint64_t count;                 /**< number of evaluations */
+    uint64_t total;                 /**< total duration of all the evaluations in ns */
+    uint64_t max;                   /**< maximal duration of an evaluation in ns */
+};
+
+/**
+ * @brief Callback for checking validation profiler record equality.
+ */
+static ly_bool
+lyd_val_prof_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_val_prof_rec *val1 = val1_p;
+    struct lyd_val_prof_rec *val2 = val2_p;
+
+    return (val1->kind == val2->kind) && (val1->cons == val2->cons) && (val1->node == val2->node);
+}
+
+void
+lyd_val_prof_start(const struct ly_ctx *ctx, struct timespec *start)
+{
+    if (!(ctx->flags & LY_CTX_VAL_PROFILE)) {
+        start->tv_sec = 0;
+        start->tv_nsec = 0;
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, start);
+}
+
+void
+lyd_val_prof_stop(const struct ly_ctx *ctx, enum lyd_val_prof_kind kind, const void *cons, const struct lysc_node *node,
+        const struct timespec *start)
+{
+    struct ly_ctx *pctx = (struct ly_ctx *)ctx;
+    struct lyd_val_prof_rec rec = {0}, *match;
+    struct timespec end;
+    uint64_t duration;
+    uint32_t hash;
+
+    if (!start->tv_sec && !start->tv_nsec) {
+        /* not measured */
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    duration = (uint64_t)(end.tv_sec - start->tv_sec) * 1000000000 + end.tv_nsec - start->tv_nsec;
+
+    rec.kind = kind;
+    rec.cons = cons;
+    rec.node = node;
+    hash = lyht_hash_multi(0, (const char *)&kind, sizeof kind);
+    hash = lyht_hash_multi(hash, (const char *)&cons, sizeof cons);
+    hash = lyht_hash_multi(hash, (const char *)&node, sizeof node);
+    hash = lyht_hash_multi(hash, NULL, 0);
+
+    pthread_mutex_lock(&pctx->val_prof_lock);
+
+    if (!pctx->val_prof_ht) {
+        pctx->val_prof_ht = lyht_new(LYHT_MIN_SIZE, sizeof rec, lyd_val_prof_equal_cb, NULL, 1);
+        LY_CHECK_ERR_GOTO(!pctx->val_prof_ht, LOGMEM(ctx), cleanup);
+    }
+
+    if (!lyht_find(pctx->val_prof_ht, &rec, hash, (void **)&match)) {
+        /* update the record */
+        ++match->count;
+        match->total += duration;
+        if (duration > match->max) {
+            match->max = duration;
+        }
+    } else {
+        /* new record */
+        rec.count = 1;
+        rec.total = duration;
+        rec.max = duration;
+        lyht_insert(pctx->val_prof_ht, &rec, hash, NULL);
+    }
+
+cleanup:
+    pthread_mutex_unlock(&pctx->val_prof_lock);
+}
+
+/**
+ * @brief Compare validation profiler records by their total duration, descending.
+ */
+static int
+lyd_val_prof_cmp(const void *ptr1, const void *ptr2)
+{
+    const struct lyd_val_prof_rec *rec1 = ptr1, *rec2 = ptr2;
+
+    if (rec1->total > rec2->total) {
+        return -1;
+    } else if (rec1->total < rec2->total) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Print a JSON string.
+ *
+ * @param[in] out Output handler.
+ * @param[in] str String to print.
+ */
+static void
+lyd_val_prof_print_str(struct ly_out *out, const char *str)
+{
+    ly_print_(out, "\"");
+    for ( ; *str; ++str) {
+        if ((*str == '"') || (*str == '\\')) {
+            ly_print_(out, "\\%c", *str);
+        } else if ((unsigned char)*str < 0x20) {
+            ly_print_(out, "\\u%04x", (unsigned char)*str);
+        } else {
+            ly_write_(out, str, 1);
+        }
+    }
+    ly_print_(out, "\"");
+}
+
+/**
+ * @brief Print the constraint of a validation profiler record.
+ *
+ * @param[in] out Output handler.
+ * @param[in] rec Record to print.
+ */
+static void
+lyd_val_prof_print_cons(struct ly_out *out, const struct lyd_val_prof_rec *rec)
+{
+    const struct lysc_node_leaf ***uniques;
+    LY_ARRAY_COUNT_TYPE u, v;
+
+    switch (rec->kind) {
+    case LYD_VAL_PROF_WHEN:
+        ly_print_(out, "      \"kind\": \"when\",\n      \"expression\": ");
+        lyd_val_prof_print_str(out, ((const struct lysc_when *)rec->cons)->cond->expr);
+        break;
+    case LYD_VAL_PROF_MUST:
+        ly_print_(out, "      \"kind\": \"must\",\n      \"expression\": ");
+        lyd_val_prof_print_str(out, ((const struct lysc_must *)rec->cons)->cond->expr);
+        break;
+    case LYD_VAL_PROF_UNIQUE:
+        ly_print_(out, "      \"kind\": \"unique\",\n      \"unique\": [");
+        uniques = (const struct lysc_node_leaf ***)rec->cons;
+        LY_ARRAY_FOR(uniques, u) {
+            ly_print_(out, "%s\"", u ? ", " : "");
+            LY_ARRAY_FOR(uniques[u], v) {
+                ly_print_(out, "%s%s", v ? " " : "", uniques[u][v]->name);
+            }
+            ly_print_(out, "\"");
+        }
+        ly_print_(out, "]");
+        break;
+    case LYD_VAL_PROF_STORE:
+        ly_print_(out, "      \"kind\": \"type-store\",\n      \"plugin\": ");
+        lyd_val_prof_print_str(out, ((const struct lyplg_type *)rec->cons)->id);
+        break;
+    case LYD_VAL_PROF_VALIDATE:
+        ly_print_(out, "      \"kind\": \"type-validate\",\n      \"plugin\": ");
+        lyd_val_prof_print_str(out, ((const struct lyplg_type *)rec->cons)->id);
+        break;
+    }
+    ly_print_(out, ",\n");
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_validate_profile_print(struct ly_out *out, const struct ly_ctx *ctx)
+{
+    struct ly_ctx *pctx = (struct ly_ctx *)ctx;
+    struct lyd_val_prof_rec *recs = NULL;
+    struct ly_ht_rec *rec;
+    uint32_t hlist_idx, rec_idx, count = 0, i;
+    char *path;
+
+    LY_CHECK_ARG_RET(ctx, out, ctx, LY_EINVAL);
+
+    /* copy the records */
+    pthread_mutex_lock(&pctx->val_prof_lock);
+    if (pctx->val_prof_ht && pctx->val_prof_ht->used) {
+        recs = malloc(pctx->val_prof_ht->used * sizeof *recs);
+        if (!recs) {
+            pthread_mutex_unlock(&pctx->val_prof_lock);
+            LOGMEM_RET(ctx);
+        }
+        LYHT_ITER_ALL_RECS(pctx->val_prof_ht, hlist_idx, rec_idx, rec) {
+            memcpy(&recs[count++], &rec->val, sizeof *recs);
+        }
+    }
+    pthread_mutex_unlock(&pctx->val_prof_lock);
+
+    /* the most expensive first */
+    qsort(recs, count, sizeof *recs, lyd_val_prof_cmp);
+
+    ly_print_(out, "{\n  \"records\": [");
+    for (i = 0; i < count; ++i) {
+        ly_print_(out, "%s\n    {\n      \"module\": ", i ? "," : "");
+        lyd_val_prof_print_str(out, recs[i].node->module->name);
+        ly_print_(out, ",\n      \"path\": ");
+        path = lysc_path(recs[i].node, LYSC_PATH_DATA, NULL, 0);
+        lyd_val_prof_print_str(out, path ? path : "");
+        free(path);
+        ly_print_(out, ",\n");
+        lyd_val_prof_print_cons(out, &recs[i]);
+        ly_print_(out, "      \"count\": %" PRIu64 ",\n      \"total-ns\": %" PRIu64 ",\n      \"max-ns\": %" PRIu64 "\n    }",
+                recs[i].count, recs[i].total, recs[i].max);
+    }
+    ly_print_(out, "%s]\n}\n", count ? "\n  " : "");
+    ly_print_flush(out);
+
+    free(recs);
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF void
+lyd_validate_profile_clear(const struct ly_ctx *ctx)
+{
+    struct ly_ctx *pctx = (struct ly_ctx *)ctx;
+
+    if (!ctx) {
+        return;
+    }
+
+    pthread_mutex_lock(&pctx->val_prof_lock);
+    lyht_free(pctx->val_prof_ht, NULL);
+    pctx->val_prof_ht = NULL;
+    pthread_mutex_unlock(&pctx->val_prof_lock);
+}
+
 LY_ERR
 lyd_val_diff_add(const struct lyd_node *node, enum lyd_diff_op op, struct lyd_node **diff)
 {
@@ -229,6 +468,116 @@ cleanup:
     return ret;
 }
 
+/**
+ * @brief Memoized result of a when condition evaluated for a specific context node.
+ */
+struct lyd_when_memo {
+    const struct lysc_when *when;       /**< evaluated when */
+    const struct lyd_node *ctx_node;    /**< context node of the evaluation */
+    ly_bool valid;                      /**< whether the result is valid, the tree may have changed since */
+    ly_bool result;                     /**< result of the evaluation */
+};
+
+/**
+ * @brief Hash table equal callback for ::lyd_when_memo.
+ */
+static ly_bool
+lyd_when_memo_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_when_memo *val1 = val1_p, *val2 = val2_p;
+
+    return (val1->when == val2->when) && (val1->ctx_node == val2->ctx_node);
+}
+
+/**
+ * @brief Get hash of a when memo record.
+ *
+ * @param[in] when Evaluated when.
+ * @param[in] ctx_node Context node of the evaluation.
+ * @return Hash of the record.
+ */
+static uint32_t
+lyd_when_memo_hash(const struct lysc_when *when, const struct lyd_node *ctx_node)
+{
+    uint32_t hash;
+
+    hash = lyht_hash_multi(0, (const char *)&when, sizeof when);
+    hash = lyht_hash_multi(hash, (const char *)&ctx_node, sizeof ctx_node);
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
+/**
+ * @brief Invalidate memoized when results that may be affected by deleting a subtree.
+ *
+ * A result is affected if its context node is being deleted or if any node in the deleted subtree is an instance
+ * of a schema node the when condition depends on.
+ *
+ * @param[in] when_memo Hash table with memoized when results.
+ * @param[in] del Subtree to be deleted, must still be valid.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_when_memo_invalidate(struct ly_ht *when_memo, const struct lyd_node *del)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_set del_schemas = {0};
+    const struct lyd_node *iter;
+    struct ly_ht_rec *rec;
+    struct lyd_when_memo *memo;
+    const struct lysc_node **atoms;
+    uint32_t hlist_idx, rec_idx, i;
+    LY_ARRAY_COUNT_TYPE u;
+    ly_bool affected;
+
+    if (!when_memo->used) {
+        return LY_SUCCESS;
+    }
+
+    /* collect all the schema nodes of the deleted instances */
+    LYD_TREE_DFS_BEGIN(del, iter) {
+        if (iter->schema) {
+            LY_CHECK_GOTO(rc = ly_set_add(&del_schemas, iter->schema, 0, NULL), cleanup);
+        }
+        LYD_TREE_DFS_END(del, iter);
+    }
+
+    LYHT_ITER_ALL_RECS(when_memo, hlist_idx, rec_idx, rec) {
+        memo = (struct lyd_when_memo *)&rec->val;
+        if (!memo->valid) {
+            continue;
+        }
+
+        /* context node deleted */
+        for (iter = memo->ctx_node; iter && (iter != del); iter = lyd_parent(iter)) {}
+        affected = iter ? 1 : 0;
+
+        /* dependency deleted */
+        atoms = memo->when->cond->atoms;
+        if (!atoms) {
+            affected = 1;
+        }
+        LY_ARRAY_FOR(atoms, u) {
+            if (affected) {
+                break;
+            }
+            for (i = 0; i < del_schemas.count; ++i) {
+                if (atoms[u] == del_schemas.snodes[i]) {
+                    affected = 1;
+                    break;
+                }
+            }
+        }
+
+        if (affected) {
+            memo->valid = 0;
+        }
+    }
+
+cleanup:
+    ly_set_erase(&del_schemas, NULL);
+    return rc;
+}
+
 /**
  * @brief Evaluate all relevant "when" conditions of a node.
  *
@@ -236,6 +585,8 @@ cleanup:
  * @param[in] node Node whose relevant when conditions will be evaluated.
  * @param[in] schema Schema node of @p node. It may not be possible to use directly if @p node is opaque.
  * @param[in] xpath_options Additional XPath options to use.
+ * @param[in] when_memo Optional hash table with memoized results of conditions with a context node other
+ * than @p node, is updated.
  * @param[out] disabled First when that evaluated false, if any.
  * @return LY_SUCCESS on success.
  * @return LY_EINCOMPLETE if a referenced node does not have its when evaluated.
@@ -243,12 +594,16 @@ cleanup:
  */
 static LY_ERR
 lyd_validate_node_when(const struct lyd_node *tree, const struct lyd_node *node, const struct lysc_node *schema,
-        uint32_t xpath_options, const struct lysc_when **disabled)
+        uint32_t xpath_options, struct ly_ht *when_memo, const struct lysc_when **disabled)
 {
     LY_ERR r;
     const struct lyd_node *ctx_node;
     struct lyxp_set xp_set;
+    struct lyd_when_memo memo_rec, *memo;
+    struct timespec start;
+    uint32_t hash = 0;
     LY_ARRAY_COUNT_TYPE u;
+    ly_bool result;
 
     assert(!node->schema || (node->schema == schema));
 
@@ -269,16 +624,43 @@ lyd_validate_node_when(const struct lyd_node *tree, const struct lyd_node *node,
                 ctx_node = lyd_parent(node);
             }
 
-            /* evaluate when */
-            memset(&xp_set, 0, sizeof xp_set);
-            r = lyxp_eval(LYD_CTX(node), when->cond, schema->module, LY_VALUE_SCHEMA_RESOLVED, when->prefixes,
-                    ctx_node, ctx_node, tree, NULL, &xp_set, LYXP_SCHEMA | xpath_options);
-            lyxp_set_cast(&xp_set, LYXP_SET_BOOLEAN);
+            memo = NULL;
+            if (when_memo && (ctx_node != node)) {
+                /* the same condition may have already been evaluated for a sibling */
+                memo_rec.when = when;
+                memo_rec.ctx_node = ctx_node;
+                hash = lyd_when_memo_hash(when, ctx_node);
+                lyht_find(when_memo, &memo_rec, hash, (void **)&memo);
+            }
 
-            /* return error or LY_EINCOMPLETE for dependant unresolved when */
-            LY_CHECK_RET(r);
+            if (memo && memo->valid) {
+                result = memo->result;
+            } else {
+                /* evaluate when */
+                memset(&xp_set, 0, sizeof xp_set);
+                lyd_val_prof_start(LYD_CTX(node), &start);
+                r = lyxp_eval(LYD_CTX(node), when->cond, schema->module, LY_VALUE_SCHEMA_RESOLVED, when->prefixes,
+                        ctx_node, ctx_node, tree, NULL, &xp_set, LYXP_SCHEMA | xpath_options);
+                lyxp_set_cast(&xp_set, LYXP_SET_BOOLEAN);
+                lyd_val_prof_stop(LYD_CTX(node), LYD_VAL_PROF_WHEN, when, schema, &start);
+
+                /* return error or LY_EINCOMPLETE for dependant unresolved when */
+                LY_CHECK_RET(r);
+                result = xp_set.val.bln;
+
+                if (memo) {
+                    /* refresh an invalidated result */
+                    memo->valid = 1;
+                    memo->result = result;
+                } else if (when_memo && (ctx_node != node)) {
+                    /* remember the result */
+                    memo_rec.valid = 1;
+                    memo_rec.result = result;
+                    LY_CHECK_RET(lyht_insert(when_memo, &memo_rec, hash, NULL));
+                }
+            }
 
-            if (!xp_set.val.bln) {
+            if (!result) {
                 /* false when */
                 *disabled = when;
                 return LY_SUCCESS;
@@ -371,6 +753,7 @@ lyd_validate_autodel_node_del(struct lyd_node **first, struct lyd_node *del, con
  * @param[in] node_when Set with nodes with "when" conditions.
  * @param[in] val_opts Validation options.
  * @param[in] xpath_options Additional XPath options to use.
+ * @param[in,out] when_memo Hash table with memoized when results, is updated.
  * @param[in,out] node_types Set with nodes with unresolved types, remove any with false "when" parents.
  * @param[in,out] diff Validation diff.
  * @return LY_SUCCESS on success.
@@ -378,7 +761,7 @@ lyd_validate_autodel_node_del(struct lyd_node **first, struct lyd_node *del, con
  */
 static LY_ERR
 lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, struct ly_set *node_when, uint32_t val_opts,
-        uint32_t xpath_options, struct ly_set *node_types, struct lyd_node **diff)
+        uint32_t xpath_options, struct ly_ht *when_memo, struct ly_set *node_types, struct lyd_node **diff)
 {
     LY_ERR rc = LY_SUCCESS, r;
     uint32_t i, count;
@@ -396,12 +779,14 @@ lyd_validate_unres_when(struct lyd_node **tree, const struct lys_module *mod, st
         LOG_LOCSET(node->schema, node);
 
         /* evaluate all when expressions that affect this node's existence */
-        r = lyd_validate_node_when(*tree, node, node->schema, xpath_options, &disabled);
+        r = lyd_validate_node_when(*tree, node, node->schema, xpath_options, when_memo, &disabled);
         if (!r) {
             if (disabled) {
                 /* when false */
                 if (node->flags & LYD_WHEN_TRUE) {
-                    /* autodelete */
+                    /* autodelete, any memoized results depending on the node are no longer valid */
+                    r = lyd_when_memo_invalidate(when_memo, node);
+                    LY_CHECK_ERR_GOTO(r, rc = r, error);
                     count = node_when->count;
                     lyd_validate_autodel_node_del(tree, node, mod, 1, NULL, node_when, node_types, diff);
                     if (count > node_when->count) {
@@ -445,6 +830,8 @@ lyd_validate_unres(struct lyd_node **tree, const struct lys_module *mod, enum ly
         struct ly_set *ext_val, uint32_t val_opts, struct lyd_node **diff)
 {
     LY_ERR r, rc = LY_SUCCESS;
+    struct ly_ht *when_memo = NULL;
+    struct timespec start;
     uint32_t i;
 
     if (ext_val && ext_val->count) {
@@ -481,13 +868,16 @@ lyd_validate_unres(struct lyd_node **tree, const struct lys_module *mod, enum ly
         } while (i);
     }
 
-    if (node_when) {
-        /* evaluate all when conditions */
+    if (node_when && node_when->count) {
+        /* evaluate all when conditions, results are shared by all the nodes with the same condition and context node */
         uint32_t prev_count;
 
+        when_memo = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyd_when_memo), lyd_when_memo_equal_cb, NULL, 1);
+        LY_CHECK_ERR_GOTO(!when_memo, LOGMEM(LYD_CTX(node_when->dnodes[0])); rc = LY_EMEM, cleanup);
+
         do {
             prev_count = node_when->count;
-            r = lyd_validate_unres_when(tree, mod, node_when, val_opts, when_xp_opts, node_types, diff);
+            r = lyd_validate_unres_when(tree, mod, node_when, val_opts, when_xp_opts, when_memo, node_types, diff);
             LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
 
             /* there must have been some when conditions resolved */
@@ -514,7 +904,9 @@ lyd_validate_unres(struct lyd_node **tree, const struct lys_module *mod, enum ly
 
             /* resolve the value of the node */
             LOG_LOCSET(NULL, &node->node);
+            lyd_val_prof_start(LYD_CTX(node), &start);
             r = lyd_value_validate_incomplete(LYD_CTX(node), type, &node->value, &node->node, *tree);
+            lyd_val_prof_stop(LYD_CTX(node), LYD_VAL_PROF_VALIDATE, type->plugin, node->schema, &start);
             LOG_LOCBACK(0, 1);
             LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
 
@@ -543,6 +935,7 @@ lyd_validate_unres(struct lyd_node **tree, const struct lys_module *mod, enum ly
     }
 
 cleanup:
+    lyht_free(when_memo, NULL);
     return rc;
 }
 
@@ -1057,7 +1450,7 @@ lyd_validate_dummy_when(const struct lyd_node *first, const struct lyd_node *par
     }
 
     /* evaluate all when */
-    rc = lyd_validate_node_when(tree, dummy, snode, xp_opts, disabled);
+    rc = lyd_validate_node_when(tree, dummy, snode, xp_opts, NULL, disabled);
     if (rc == LY_EINCOMPLETE) {
         /* all other when must be resolved by now */
         LOGINT(snode->module->ctx);
@@ -1073,6 +1466,33 @@ cleanup:
     return rc;
 }
 
+LY_ERR
+lyd_validate_dflt_when(const struct lyd_node *node, ly_bool *enabled)
+{
+    const struct lyd_node *tree;
+    const struct lysc_when *disabled;
+    uint32_t xp_opts;
+
+    assert(node->parent);
+
+    /* find root */
+    for (tree = lyd_parent(node); tree->parent; tree = lyd_parent(tree)) {}
+    tree = lyd_first_sibling(tree);
+
+    /* explicitly specified accesible tree */
+    if (node->schema->flags & LYS_CONFIG_W) {
+        xp_opts = LYXP_ACCESS_TREE_CONFIG;
+    } else {
+        xp_opts = LYXP_ACCESS_TREE_ALL;
+    }
+
+    /* evaluate all when, the referenced nodes are not being validated */
+    LY_CHECK_RET(lyd_validate_node_when(tree, node, node->schema, xp_opts | LYXP_IGNORE_WHEN, NULL, &disabled));
+
+    *enabled = disabled ? 0 : 1;
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Validate mandatory node existence.
  *
@@ -1270,7 +1690,7 @@ lyd_val_uniq_find_leaf(const struct lysc_node_leaf *uniq_leaf, const struct lyd_
             --i;
         }
 
-        /* find iter instance in children */
+        /* find iter instance in children, a virtual default leaf is not found and its default value is used */
         assert(iter->nodetype & (LYS_CONTAINER | LYS_LEAF));
         lyd_find_sibling_val(lyd_child(node), iter, NULL, 0, &node);
         --depth;
@@ -1399,9 +1819,126 @@ uniquecheck:
     return 0;
 }
 
+/**
+ * @brief Get the hash of the values of a single unique statement of a list instance.
+ *
+ * @param[in] unique Unique leaves.
+ * @param[in] inst List instance.
+ * @param[out] hash Hash of the unique values.
+ * @return 0 on success;
+ * @return 1 if the unique values are incomplete.
+ */
+static ly_bool
+lyd_val_uniq_hash(const struct lysc_node_leaf **unique, const struct lyd_node *inst, uint32_t *hash)
+{
+    const struct lyd_node *diter;
+    struct lyd_value *val;
+    LY_ARRAY_COUNT_TYPE v;
+    const void *hash_key;
+    size_t key_len;
+    ly_bool dyn;
+
+    for (v = *hash = 0; v < LY_ARRAY_COUNT(unique); v++) {
+        diter = lyd_val_uniq_find_leaf(unique[v], inst);
+        if (diter) {
+            val = &((struct lyd_node_term *)diter)->value;
+        } else {
+            /* use default value */
+            val = unique[v]->dflt;
+        }
+        if (!val) {
+            /* unique item not present nor has default value */
+            return 1;
+        }
+
+        /* get hash key */
+        hash_key = val->realtype->plugin->print(NULL, val, LY_VALUE_LYB, NULL, &dyn, &key_len);
+        *hash = lyht_hash_multi(*hash, hash_key, key_len);
+        if (dyn) {
+            free((void *)hash_key);
+        }
+    }
+
+    /* finish the hash value */
+    *hash = lyht_hash_multi(*hash, NULL, 0);
+    return 0;
+}
+
+/**
+ * @brief Validate list unique leaves of all the dirty instances in a unique index.
+ *
+ * The valid instances are inserted into the unique hash tables so the following validations check only instances
+ * inserted or changed in the meantime.
+ *
+ * @param[in] idx Unique index.
+ * @param[in] val_opts Validation options.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_validate_unique_idx(struct lyd_uniq_idx *idx, uint32_t val_opts)
+{
+    const struct lysc_node_list *slist = (const struct lysc_node_list *)idx->schema;
+    struct lyd_uniq_member *rec;
+    struct lyd_val_uniq_arg arg;
+    struct lyd_node *inst;
+    LY_ARRAY_COUNT_TYPE u;
+    LY_ERR ret = LY_SUCCESS;
+    uint32_t i, hash;
+
+    for (i = 0; i < idx->dirty->count; i++) {
+        inst = idx->dirty->objs[i];
+        rec = lyd_uniq_idx_member(idx, inst);
+        if (!rec || !rec->dirty) {
+            /* unlinked or already validated instance */
+            continue;
+        }
+
+        LY_ARRAY_FOR(slist->uniques, u) {
+            if (lyd_val_uniq_hash((const struct lysc_node_leaf **)slist->uniques[u], inst, &hash)) {
+                /* skip this unique since its set is incomplete */
+                continue;
+            }
+
+            /* look for an instance with the same unique values */
+            arg.action = u + 1;
+            arg.val_opts = val_opts;
+            lyht_set_cb_data(idx->tables[u], &arg);
+            if (!lyht_find_with_val_cb(idx->tables[u], &inst, hash, lyd_val_uniq_list_equal, NULL)) {
+                /* instance duplication */
+                ret = LY_EVALID;
+            } else {
+                ret = lyht_insert(idx->tables[u], &inst, hash, NULL);
+            }
+            lyht_set_cb_data(idx->tables[u], NULL);
+            if (ret) {
+                break;
+            }
+
+            rec->uniq[u].hash = hash;
+            rec->uniq[u].indexed = 1;
+        }
+        if (ret) {
+            /* the instance stays dirty */
+            lyd_uniq_idx_remove_tables(idx, rec);
+            break;
+        }
+
+        rec->dirty = 0;
+    }
+
+    /* keep only the instances that were not validated */
+    memmove(idx->dirty->objs, idx->dirty->objs + i, (idx->dirty->count - i) * sizeof *idx->dirty->objs);
+    idx->dirty->count -= i;
+
+    return ret;
+}
+
 /**
  * @brief Validate list unique leaves.
  *
+ * Lists with more than 2 instances in a data parent or at the top level get a unique index created, which is then
+ * used by all the following validations.
+ *
  * @param[in] first First sibling to search in.
  * @param[in] snode Schema node to validate.
  * @param[in] uniques List unique arrays to validate.
@@ -1412,21 +1949,35 @@ static LY_ERR
 lyd_validate_unique(const struct lyd_node *first, const struct lysc_node *snode, const struct lysc_node_leaf ***uniques,
         uint32_t val_opts)
 {
-    const struct lyd_node *diter;
+    const struct lyd_node *diter, *parent;
+    struct lyd_uniq_idx *idx;
+    ly_bool indexed;
     struct ly_set *set;
     LY_ARRAY_COUNT_TYPE u, v, x = 0;
     LY_ERR ret = LY_SUCCESS;
     uint32_t hash, i;
-    size_t key_len;
-    ly_bool dyn;
-    const void *hash_key;
     struct lyd_val_uniq_arg arg, *args = NULL;
     struct ly_ht **uniqtables = NULL;
-    struct lyd_value *val;
     struct ly_ctx *ctx = snode->module->ctx;
 
     assert(uniques);
 
+    if (first && first->parent) {
+        parent = first->parent->schema ? lyd_parent(first) : NULL;
+        indexed = parent ? 1 : 0;
+        idx = parent ? lyd_uniq_idx_find(parent, NULL, snode) : NULL;
+    } else {
+        /* top-level instances, the index is found by any of them */
+        parent = NULL;
+        indexed = 1;
+        for (diter = first; diter && (diter->schema != snode); diter = diter->next) {}
+        idx = diter ? lyd_uniq_idx_find(NULL, diter, snode) : NULL;
+    }
+    if (idx) {
+        /* validate only the new and changed instances */
+        return lyd_validate_unique_idx(idx, val_opts);
+    }
+
     /* get all list instances */
     LY_CHECK_RET(ly_set_new(&set));
     LY_LIST_FOR(first, diter) {
@@ -1445,6 +1996,10 @@ lyd_validate_unique(const struct lyd_node *first, const struct lysc_node *snode,
             ret = LY_EVALID;
             goto cleanup;
         }
+    } else if ((set->count > 2) && indexed) {
+        /* create the index and use it */
+        LY_CHECK_GOTO(ret = lyd_uniq_idx_new(parent, first, snode, &idx), cleanup);
+        ret = lyd_validate_unique_idx(idx, val_opts);
     } else if (set->count > 2) {
         /* use hashes for comparison */
         uniqtables = malloc(LY_ARRAY_COUNT(uniques) * sizeof *uniqtables);
@@ -1462,35 +2017,11 @@ lyd_validate_unique(const struct lyd_node *first, const struct lysc_node *snode,
         for (i = 0; i < set->count; i++) {
             /* loop for unique - get the hash for the instances */
             for (u = 0; u < x; u++) {
-                val = NULL;
-                for (v = hash = 0; v < LY_ARRAY_COUNT(uniques[u]); v++) {
-                    diter = lyd_val_uniq_find_leaf(uniques[u][v], set->objs[i]);
-                    if (diter) {
-                        val = &((struct lyd_node_term *)diter)->value;
-                    } else {
-                        /* use default value */
-                        val = uniques[u][v]->dflt;
-                    }
-                    if (!val) {
-                        /* unique item not present nor has default value */
-                        break;
-                    }
-
-                    /* get hash key */
-                    hash_key = val->realtype->plugin->print(NULL, val, LY_VALUE_LYB, NULL, &dyn, &key_len);
-                    hash = lyht_hash_multi(hash, hash_key, key_len);
-                    if (dyn) {
-                        free((void *)hash_key);
-                    }
-                }
-                if (!val) {
+                if (lyd_val_uniq_hash(uniques[u], set->objs[i], &hash)) {
                     /* skip this list instance since its unique set is incomplete */
                     continue;
                 }
 
-                /* finish the hash value */
-                hash = lyht_hash_multi(hash, NULL, 0);
-
                 /* insert into the hashtable */
                 ret = lyht_insert(uniqtables[u], &set->objs[i], hash, NULL);
                 if (ret == LY_EEXIST) {
@@ -1539,6 +2070,7 @@ lyd_validate_siblings_schema_r(const struct lyd_node *first, const struct lyd_no
     const struct lysc_node *snode, *scase, **choices, **snodes;
     struct lysc_node_list *slist;
     struct lysc_node_leaflist *sllist;
+    struct timespec start;
     uint32_t i;
 
     /* get cached getnext schema nodes */
@@ -1588,7 +2120,9 @@ lyd_validate_siblings_schema_r(const struct lyd_node *first, const struct lyd_no
 
             /* check unique */
             if (slist->uniques) {
+                lyd_val_prof_start(snode->module->ctx, &start);
                 r = lyd_validate_unique(first, snode, (const struct lysc_node_leaf ***)slist->uniques, val_opts);
+                lyd_val_prof_stop(snode->module->ctx, LYD_VAL_PROF_UNIQUE, slist->uniques, snode, &start);
                 LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
             }
         } else if (snode->nodetype == LYS_LEAFLIST) {
@@ -1651,6 +2185,7 @@ lyd_validate_must(const struct lyd_node *node, uint32_t val_opts, uint32_t int_o
     const struct lyd_node *tree;
     const struct lysc_node *schema;
     const char *emsg, *eapptag;
+    struct timespec start;
     LY_ARRAY_COUNT_TYPE u;
 
     assert((int_opts & (LYD_INTOPT_RPC | LYD_INTOPT_REPLY)) != (LYD_INTOPT_RPC | LYD_INTOPT_REPLY));
@@ -1681,8 +2216,10 @@ lyd_validate_must(const struct lyd_node *node, uint32_t val_opts, uint32_t int_o
         memset(&xp_set, 0, sizeof xp_set);
 
         /* evaluate must */
+        lyd_val_prof_start(LYD_CTX(node), &start);
         r = lyxp_eval(LYD_CTX(node), musts[u].cond, node->schema->module, LY_VALUE_SCHEMA_RESOLVED,
                 musts[u].prefixes, node, node, tree, NULL, &xp_set, LYXP_SCHEMA | xpath_options);
+        lyd_val_prof_stop(LYD_CTX(node), LYD_VAL_PROF_MUST, &musts[u], schema, &start);
         if (r == LY_EINCOMPLETE) {
             LOGERR(LYD_CTX(node), LY_EINCOMPLETE,
                     "Must \"%s\" depends on a node with a when condition, which has not been evaluated.", musts[u].cond->expr);
@@ -1954,7 +2491,7 @@ lyd_validate_subtree(struct lyd_node *root, struct ly_set *node_when, struct ly_
             LY_VAL_ERR_GOTO(r, rc = r, val_opts, cleanup);
 
             /* add nested defaults */
-            impl_opts = 0;
+            impl_opts = LYD_IMPLICIT_VIRTUAL;
             if (val_opts & LYD_VALIDATE_NO_STATE) {
                 impl_opts |= LYD_IMPLICIT_NO_STATE;
             }
@@ -2035,7 +2572,7 @@ lyd_validate(struct lyd_node **tree, const struct lys_module *module, const stru
 
         /* add all top-level defaults for this module, if going to validate subtree, do not add into unres sets
          * (lyd_validate_subtree() adds all the nodes in that case) */
-        impl_opts = 0;
+        impl_opts = LYD_IMPLICIT_VIRTUAL;
         if (val_opts & LYD_VALIDATE_NO_STATE) {
             impl_opts |= LYD_IMPLICIT_NO_STATE;
         }
@@ -2335,7 +2872,7 @@ _lyd_validate_op(struct lyd_node *op_tree, struct lyd_node *op_node, const struc
         if (validate_subtree) {
             /* add output children defaults */
             rc = lyd_new_implicit(op_node, lyd_node_child_p(op_node), NULL, NULL, node_when_p, node_types_p,
-                    ext_node_p, LYD_IMPLICIT_OUTPUT, getnext_ht, diff);
+                    ext_node_p, LYD_IMPLICIT_OUTPUT | LYD_IMPLICIT_VIRTUAL, getnext_ht, diff);
             LY_CHECK_GOTO(rc, cleanup);
 
             /* skip validating the operation itself, go to children directly */
@@ -2347,7 +2884,7 @@ _lyd_validate_op(struct lyd_node *op_tree, struct lyd_node *op_node, const struc
         } else {
             /* add output children defaults and their descendants */
             rc = lyd_new_implicit_r(op_node, lyd_node_child_p(op_node), NULL, NULL, node_when_p, node_types_p,
-                    ext_node_p, LYD_IMPLICIT_OUTPUT, getnext_ht, diff);
+                    ext_node_p, LYD_IMPLICIT_OUTPUT | LYD_IMPLICIT_VIRTUAL, getnext_ht, diff);
             LY_CHECK_GOTO(rc, cleanup);
         }
     } else {
@@ -16,6 +16,7 @@
 #define LY_VALIDATION_H_
 
 #include <stdint.h>
+#include <time.h>
 
 #include "diff.h"
 #include "log.h"
@@ -27,6 +28,37 @@ struct lyd_node;
 struct lys_module;
 struct lysc_node;
 
+/**
+ * @brief Kinds of constraints measured by the validation profiler, see ::LY_CTX_VAL_PROFILE.
+ */
+enum lyd_val_prof_kind {
+    LYD_VAL_PROF_WHEN,      /**< when condition, the constraint is struct lysc_when */
+    LYD_VAL_PROF_MUST,      /**< must condition, the constraint is struct lysc_must */
+    LYD_VAL_PROF_UNIQUE,    /**< all the unique statements of a list, the constraint is ::lysc_node_list.uniques */
+    LYD_VAL_PROF_STORE,     /**< type plugin store callback, the constraint is struct lyplg_type */
+    LYD_VAL_PROF_VALIDATE   /**< type plugin validate callback, the constraint is struct lyplg_type */
+};
+
+/**
+ * @brief Start measuring a constraint evaluation, if the validation profiler is enabled.
+ *
+ * @param[in] ctx Context of the data.
+ * @param[out] start Start time, zeroed if the profiler is disabled.
+ */
+void lyd_val_prof_start(const struct ly_ctx *ctx, struct timespec *start);
+
+/**
+ * @brief Finish measuring a constraint evaluation and record its duration.
+ *
+ * @param[in] ctx Context of the data.
+ * @param[in] kind Kind of the constraint.
+ * @param[in] cons Evaluated constraint.
+ * @param[in] node Schema node of the constraint.
+ * @param[in] start Start time set by ::lyd_val_prof_start(), nothing is recorded if zeroed.
+ */
+void lyd_val_prof_stop(const struct ly_ctx *ctx, enum lyd_val_prof_kind kind, const void *cons,
+        const struct lysc_node *node, const struct timespec *start);
+
 /**
  * @brief Cached getnext schema nodes stored in a validation HT.
  */
@@ -131,6 +163,15 @@ LY_ERR lyd_validate_new(struct lyd_node **first, const struct lysc_node *sparent
  */
 LY_ERR lyd_validate_node_ext(struct lyd_node *node, struct ly_set *ext_node);
 
+/**
+ * @brief Evaluate all relevant "when" conditions of a virtual default node.
+ *
+ * @param[in] node Virtual default node with its parent set.
+ * @param[out] enabled Whether all the conditions evaluated to true.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_validate_dflt_when(const struct lyd_node *node, ly_bool *enabled);
+
 /**
  * @brief Validate a data tree.
  *
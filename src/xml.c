@@ -909,41 +909,58 @@ lyxml_next_element(struct lyxml_ctx *xmlctx, const char **prefix, size_t *prefix
     return LY_SUCCESS;
 }
 
-LY_ERR
-lyxml_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyxml_ctx **xmlctx_p)
+/**
+ * @brief Start parsing an input with a new or reset XML context.
+ *
+ * @param[in] xmlctx XML context with no input.
+ * @param[in] ctx libyang context.
+ * @param[in] in Input structure.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyxml_ctx_start(struct lyxml_ctx *xmlctx, const struct ly_ctx *ctx, struct ly_in *in)
 {
-    LY_ERR ret = LY_SUCCESS;
-    struct lyxml_ctx *xmlctx;
     ly_bool closing;
 
-    /* new context */
-    xmlctx = calloc(1, sizeof *xmlctx);
-    LY_CHECK_ERR_RET(!xmlctx, LOGMEM(ctx), LY_EMEM);
+    assert(!xmlctx->in);
+
     xmlctx->ctx = ctx;
     xmlctx->in = in;
 
     ly_log_location(NULL, NULL, NULL, in);
 
     /* parse next element, if any */
-    LY_CHECK_GOTO(ret = lyxml_next_element(xmlctx, &xmlctx->prefix, &xmlctx->prefix_len, &xmlctx->name,
-            &xmlctx->name_len, &closing), cleanup);
+    LY_CHECK_RET(lyxml_next_element(xmlctx, &xmlctx->prefix, &xmlctx->prefix_len, &xmlctx->name,
+            &xmlctx->name_len, &closing));
 
     if (xmlctx->in->current[0] == '\0') {
         /* update status */
         xmlctx->status = LYXML_END;
     } else if (closing) {
         LOGVAL(ctx, LYVE_SYNTAX, "Stray closing element tag (\"%.*s\").", (int)xmlctx->name_len, xmlctx->name);
-        ret = LY_EVALID;
-        goto cleanup;
+        return LY_EVALID;
     } else {
         /* open an element, also parses all enclosed namespaces */
-        LY_CHECK_GOTO(ret = lyxml_open_element(xmlctx, xmlctx->prefix, xmlctx->prefix_len, xmlctx->name, xmlctx->name_len), cleanup);
+        LY_CHECK_RET(lyxml_open_element(xmlctx, xmlctx->prefix, xmlctx->prefix_len, xmlctx->name, xmlctx->name_len));
 
         /* update status */
         xmlctx->status = LYXML_ELEMENT;
     }
 
-cleanup:
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyxml_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyxml_ctx **xmlctx_p)
+{
+    LY_ERR ret;
+    struct lyxml_ctx *xmlctx;
+
+    /* new context */
+    xmlctx = calloc(1, sizeof *xmlctx);
+    LY_CHECK_ERR_RET(!xmlctx, LOGMEM(ctx), LY_EMEM);
+
+    ret = lyxml_ctx_start(xmlctx, ctx, in);
     if (ret) {
         lyxml_ctx_free(xmlctx);
     } else {
@@ -952,6 +969,18 @@ cleanup:
     return ret;
 }
 
+LY_ERR
+lyxml_ctx_renew(struct lyxml_ctx *xmlctx, const struct ly_ctx *ctx, struct ly_in *in)
+{
+    LY_ERR ret;
+
+    ret = lyxml_ctx_start(xmlctx, ctx, in);
+    if (ret) {
+        lyxml_ctx_reset(xmlctx);
+    }
+    return ret;
+}
+
 LY_ERR
 lyxml_ctx_next(struct lyxml_ctx *xmlctx)
 {
@@ -1142,7 +1171,7 @@ cleanup:
 }
 
 /**
- * @brief Free all namespaces in XML context.
+ * @brief Free all namespaces in XML context, the memory of the set is kept.
  *
  * @param[in] xmlctx XML context to use.
  */
@@ -1159,23 +1188,42 @@ lyxml_ns_rm_all(struct lyxml_ctx *xmlctx)
         free(ns->uri);
         free(ns);
     }
-    ly_set_erase(&xmlctx->ns, NULL);
+    xmlctx->ns.count = 0;
 }
 
 void
-lyxml_ctx_free(struct lyxml_ctx *xmlctx)
+lyxml_ctx_reset(struct lyxml_ctx *xmlctx)
 {
-    if (!xmlctx) {
-        return;
-    }
+    struct ly_set elements, ns;
 
-    ly_log_location_revert(0, 0, 0, 1);
+    if (xmlctx->in) {
+        ly_log_location_revert(0, 0, 0, 1);
+    }
 
     if (((xmlctx->status == LYXML_ELEM_CONTENT) || (xmlctx->status == LYXML_ATTR_CONTENT)) && xmlctx->dynamic) {
         free((char *)xmlctx->value);
     }
-    ly_set_erase(&xmlctx->elements, free);
+    ly_set_clean(&xmlctx->elements, free);
     lyxml_ns_rm_all(xmlctx);
+
+    /* keep only the sets */
+    elements = xmlctx->elements;
+    ns = xmlctx->ns;
+    memset(xmlctx, 0, sizeof *xmlctx);
+    xmlctx->elements = elements;
+    xmlctx->ns = ns;
+}
+
+void
+lyxml_ctx_free(struct lyxml_ctx *xmlctx)
+{
+    if (!xmlctx) {
+        return;
+    }
+
+    lyxml_ctx_reset(xmlctx);
+    ly_set_erase(&xmlctx->elements, NULL);
+    ly_set_erase(&xmlctx->ns, NULL);
     free(xmlctx);
 }
 
@@ -1276,6 +1324,7 @@ lyxml_ctx_restore(struct lyxml_ctx *xmlctx, struct lyxml_ctx *backup)
 
     /* free ns */
     lyxml_ns_rm_all(xmlctx);
+    ly_set_erase(&xmlctx->ns, NULL);
 
     /* restore in */
     xmlctx->in->current = backup->b_current;
@@ -118,6 +118,16 @@ struct lyxml_ctx {
  */
 LY_ERR lyxml_ctx_new(const struct ly_ctx *ctx, struct ly_in *in, struct lyxml_ctx **xmlctx);
 
+/**
+ * @brief Start parsing another input with an XML parser context reset by ::lyxml_ctx_reset().
+ *
+ * @param[in] xmlctx XML context to reuse, is reset again on error.
+ * @param[in] ctx libyang context.
+ * @param[in] in Input structure.
+ * @return LY_ERR value.
+ */
+LY_ERR lyxml_ctx_renew(struct lyxml_ctx *xmlctx, const struct ly_ctx *ctx, struct ly_in *in);
+
 /**
  * @brief Move to the next XML artefact and update parser status.
  *
@@ -172,6 +182,13 @@ LY_ERR lyxml_dump_text(struct ly_out *out, const char *text, ly_bool attribute);
  */
 void lyxml_ctx_free(struct lyxml_ctx *xmlctx);
 
+/**
+ * @brief Remove all the parsing state of the context but keep its allocated working memory for reuse.
+ *
+ * @param[in] xmlctx XML context to reset.
+ */
+void lyxml_ctx_reset(struct lyxml_ctx *xmlctx);
+
 /**
  * @brief Create a backup of XML context.
  *
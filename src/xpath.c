@@ -739,7 +739,7 @@ set_insert_node_hash(struct lyxp_set *set, struct lyd_node *node, enum lyxp_node
 
     if (!set->ht && (set->used >= LYD_HT_MIN_ITEMS)) {
         /* create hash table and add all the nodes */
-        set->ht = lyht_new(1, sizeof(struct lyxp_set_hash_node), set_values_equal_cb, NULL, 1);
+        set->ht = lyht_new_open(1, sizeof(struct lyxp_set_hash_node), set_values_equal_cb, NULL, 1);
         for (i = 0; i < set->used; ++i) {
             hnode.node = set->val.nodes[i].node;
             hnode.type = set->val.nodes[i].type;
@@ -846,6 +846,87 @@ set_dup_node_hash_check(const struct lyxp_set *set, struct lyd_node *node, enum
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Virtual default nodes of a data parent resolved by an evaluation.
+ */
+struct lyxp_set_dflt {
+    const struct lyd_node *parent;  /**< data parent */
+    const struct lysc_node *schema; /**< schema node of the default nodes */
+    struct lyd_node *dflts;         /**< virtual default siblings, NULL if there are none */
+};
+
+/**
+ * @brief Callback for checking value equality.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ *
+ * @param[in] val1_p First value.
+ * @param[in] val2_p Second value.
+ * @param[in] mod Whether hash table is being modified.
+ * @param[in] cb_data Callback data.
+ * @return Boolean value whether values are equal or not.
+ */
+static ly_bool
+set_dflt_values_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyxp_set_dflt *val1, *val2;
+
+    val1 = (struct lyxp_set_dflt *)val1_p;
+    val2 = (struct lyxp_set_dflt *)val2_p;
+
+    return (val1->parent == val2->parent) && (val1->schema == val2->schema);
+}
+
+/**
+ * @brief Free the virtual default nodes of a hash table record.
+ *
+ * @param[in] val_p Record to free.
+ */
+static void
+set_dflt_free_cb(void *val_p)
+{
+    lyd_dflt_virtual_free(((struct lyxp_set_dflt *)val_p)->dflts);
+}
+
+/**
+ * @brief Get the virtual default nodes of a data parent, they are created only once for an evaluation.
+ *
+ * @param[in] set Set of the evaluation.
+ * @param[in] parent Data parent.
+ * @param[in] schema Leaf or leaf-list schema child of @p parent.
+ * @param[out] dflts Virtual default siblings, NULL if there are none.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+set_dflt_get(struct lyxp_set *set, const struct lyd_node *parent, const struct lysc_node *schema,
+        struct lyd_node **dflts)
+{
+    struct lyxp_set_dflt rec, *match;
+    uint32_t hash;
+
+    *dflts = NULL;
+
+    rec.parent = parent;
+    rec.schema = schema;
+    hash = lyht_hash_multi(0, (const char *)&rec.parent, sizeof rec.parent);
+    hash = lyht_hash_multi(hash, (const char *)&rec.schema, sizeof rec.schema);
+    hash = lyht_hash_multi(hash, NULL, 0);
+    if (!lyht_find(set->dflts, &rec, hash, (void **)&match)) {
+        *dflts = match->dflts;
+        return LY_SUCCESS;
+    }
+
+    /* remember even no nodes */
+    LY_CHECK_RET(lyd_dflt_virtual_new(parent, schema->module, schema->name, 0, &rec.dflts));
+    if (lyht_insert(set->dflts, &rec, hash, NULL)) {
+        lyd_dflt_virtual_free(rec.dflts);
+        LOGMEM_RET(set->ctx);
+    }
+
+    *dflts = rec.dflts;
+    return LY_SUCCESS;
+}
+
 void
 lyxp_set_free_content(struct lyxp_set *set)
 {
@@ -853,6 +934,13 @@ lyxp_set_free_content(struct lyxp_set *set)
         return;
     }
 
+    if (set->dflts_owner) {
+        /* no node of the evaluation can be used anymore */
+        lyht_free(set->dflts, set_dflt_free_cb);
+        set->dflts = NULL;
+        set->dflts_owner = 0;
+    }
+
     if (set->type == LYXP_SET_NODE_SET) {
         free(set->val.nodes);
         lyht_free(set->ht, NULL);
@@ -915,6 +1003,7 @@ set_init(struct lyxp_set *new, const struct lyxp_set *set)
     new->format = set->format;
     new->prefix_data = set->prefix_data;
     new->vars = set->vars;
+    new->dflts = set->dflts;
 }
 
 /**
@@ -973,6 +1062,7 @@ set_copy(struct lyxp_set *set)
         }
     } else {
         memcpy(ret, set, sizeof *ret);
+        ret->dflts_owner = 0;
         if (set->type == LYXP_SET_STRING) {
             ret->val.str = strdup(set->val.str);
             LY_CHECK_ERR_RET(!ret->val.str, LOGMEM(set->ctx); free(ret), NULL);
@@ -1528,9 +1618,149 @@ dfs_search:
     return pos;
 }
 
+/**
+ * @brief Item of the hash table of nodes waiting for their position.
+ */
+struct lyxp_set_pos_node {
+    const struct lyd_node *node;    /**< data node */
+    uint32_t pos;                   /**< its position, 0 if not yet known */
+};
+
+/**
+ * @brief Callback for checking value equality.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ *
+ * @param[in] val1_p First value.
+ * @param[in] val2_p Second value.
+ * @param[in] mod Whether hash table is being modified.
+ * @param[in] cb_data Callback data.
+ * @return Boolean value whether values are equal or not.
+ */
+static ly_bool
+set_pos_values_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyxp_set_pos_node *val1, *val2;
+
+    val1 = (struct lyxp_set_pos_node *)val1_p;
+    val2 = (struct lyxp_set_pos_node *)val2_p;
+
+    return val1->node == val2->node;
+}
+
+/**
+ * @brief Get the data node whose position is the position of a set item.
+ *
+ * @param[in] set Set with the item.
+ * @param[in] idx Index of the item.
+ * @return Data node, NULL for the root nodes.
+ */
+static const struct lyd_node *
+set_pos_node(const struct lyxp_set *set, uint32_t idx)
+{
+    switch (set->val.nodes[idx].type) {
+    case LYXP_NODE_META:
+        return set->val.meta[idx].meta->parent;
+    case LYXP_NODE_ELEM:
+    case LYXP_NODE_TEXT:
+        if (set->val.nodes[idx].node->flags & LYD_VIRTUAL) {
+            /* not in the tree, virtual default nodes have the position of their parent */
+            return lyd_parent(set->val.nodes[idx].node);
+        }
+        return set->val.nodes[idx].node;
+    default:
+        /* all roots have position 0 */
+        return NULL;
+    }
+}
+
+/**
+ * @brief Assign (fill) missing node positions using a single DFS of the whole data tree.
+ *
+ * @param[in] set Set to fill positions in.
+ * @param[in] start Index of the first node in @p set to fill.
+ * @param[in] root Context root node.
+ * @param[in] root_type Context root type.
+ * @return LY_ERR
+ */
+static LY_ERR
+set_assign_pos_bulk(struct lyxp_set *set, uint32_t start, const struct lyd_node *root, enum lyxp_node_type root_type)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_ht *ht;
+    struct lyxp_set_pos_node pnode, *match;
+    const struct lyd_node *top_sibling, *elem;
+    uint32_t i, hash, pos = 1, remaining = 0;
+
+    ht = lyht_new(1, sizeof pnode, set_pos_values_equal_cb, NULL, 1);
+    LY_CHECK_ERR_RET(!ht, LOGMEM(set->ctx), LY_EMEM);
+
+    /* collect all the nodes without a position */
+    pnode.pos = 0;
+    for (i = start; i < set->used; ++i) {
+        if (set->val.nodes[i].pos || !(pnode.node = set_pos_node(set, i))) {
+            continue;
+        }
+
+        hash = lyht_hash_multi(0, (const char *)&pnode.node, sizeof pnode.node);
+        hash = lyht_hash_multi(hash, NULL, 0);
+        if (!lyht_insert(ht, &pnode, hash, NULL)) {
+            ++remaining;
+        }
+    }
+
+    /* number the nodes in the same order as get_node_pos() */
+    LY_LIST_FOR(root, top_sibling) {
+        LYD_TREE_DFS_BEGIN(top_sibling, elem) {
+            if ((root_type == LYXP_NODE_ROOT_CONFIG) && elem->schema && (elem->schema->flags & LYS_CONFIG_R)) {
+                /* skip */
+                LYD_TREE_DFS_continue = 1;
+            } else {
+                pnode.node = elem;
+                hash = lyht_hash_multi(0, (const char *)&pnode.node, sizeof pnode.node);
+                hash = lyht_hash_multi(hash, NULL, 0);
+                if (!lyht_find(ht, &pnode, hash, (void **)&match)) {
+                    match->pos = pos;
+                    if (!--remaining) {
+                        goto numbered;
+                    }
+                }
+                ++pos;
+            }
+
+            LYD_TREE_DFS_END(top_sibling, elem);
+        }
+    }
+
+numbered:
+    /* fill the positions */
+    for (i = start; i < set->used; ++i) {
+        if (set->val.nodes[i].pos || !(pnode.node = set_pos_node(set, i))) {
+            continue;
+        }
+
+        hash = lyht_hash_multi(0, (const char *)&pnode.node, sizeof pnode.node);
+        hash = lyht_hash_multi(hash, NULL, 0);
+        if (lyht_find(ht, &pnode, hash, (void **)&match) || !match->pos) {
+            /* not found in the tree, cannot be */
+            LOGINT(set->ctx);
+            rc = LY_EINT;
+            break;
+        }
+        set->val.nodes[i].pos = match->pos;
+    }
+
+    lyht_free(ht, NULL);
+    return rc;
+}
+
 /**
  * @brief Assign (fill) missing node positions.
  *
+ * Positions are learned by continuing the DFS from the previous node, which is efficient for nodes mostly
+ * in the document order. Once the nodes turn out not to be, all the remaining positions are assigned
+ * by a single DFS of the whole tree.
+ *
  * @param[in] set Set to fill positions in.
  * @param[in] root Context root node.
  * @param[in] root_type Context root type.
@@ -1540,30 +1770,32 @@ static LY_ERR
 set_assign_pos(struct lyxp_set *set, const struct lyd_node *root, enum lyxp_node_type root_type)
 {
     const struct lyd_node *prev = NULL, *tmp_node;
-    uint32_t i, tmp_pos = 0;
+    uint32_t i, tmp_pos = 0, last_pos = 0, restarts = 0;
 
     for (i = 0; i < set->used; ++i) {
-        if (!set->val.nodes[i].pos) {
-            tmp_node = NULL;
-            switch (set->val.nodes[i].type) {
-            case LYXP_NODE_META:
-                tmp_node = set->val.meta[i].meta->parent;
-                if (!tmp_node) {
-                    LOGINT_RET(root->schema->module->ctx);
-                }
-            /* fall through */
-            case LYXP_NODE_ELEM:
-            case LYXP_NODE_TEXT:
-                if (!tmp_node) {
-                    tmp_node = set->val.nodes[i].node;
-                }
-                set->val.nodes[i].pos = get_node_pos(tmp_node, set->val.nodes[i].type, root, root_type, &prev, &tmp_pos);
-                break;
-            default:
-                /* all roots have position 0 */
-                break;
+        if (set->val.nodes[i].pos) {
+            continue;
+        }
+
+        tmp_node = set_pos_node(set, i);
+        if (!tmp_node) {
+            if (set->val.nodes[i].type == LYXP_NODE_META) {
+                LOGINT_RET(root->schema->module->ctx);
             }
+            continue;
+        }
+
+        if ((restarts == LYXP_SORT_DFS_RESTARTS) && (set->used - i >= LYXP_SORT_DFS_RESTARTS)) {
+            /* the nodes are not in document order, do not search for each of them from the root */
+            return set_assign_pos_bulk(set, i, root, root_type);
         }
+
+        set->val.nodes[i].pos = get_node_pos(tmp_node, set->val.nodes[i].type, root, root_type, &prev, &tmp_pos);
+        if (set->val.nodes[i].pos < last_pos) {
+            /* the DFS had to be restarted from the root */
+            ++restarts;
+        }
+        last_pos = set->val.nodes[i].pos;
     }
 
     return LY_SUCCESS;
@@ -1589,6 +1821,65 @@ get_meta_pos(struct lyd_meta *meta)
     return pos;
 }
 
+/**
+ * @brief Check whether a set item is a virtual default node or its text.
+ *
+ * @param[in] item Set item.
+ * @return Whether it is virtual.
+ */
+static ly_bool
+set_item_is_virtual(const struct lyxp_set_node *item)
+{
+    return ((item->type == LYXP_NODE_ELEM) || (item->type == LYXP_NODE_TEXT)) && (item->node->flags & LYD_VIRTUAL);
+}
+
+/**
+ * @brief Compare 2 different nodes with the same position in respect to XPath document order, at least one of them
+ * virtual.
+ *
+ * Virtual default nodes follow their parent and its metadata and precede its children in the tree, in the schema
+ * order.
+ *
+ * @param[in] item1 1st node.
+ * @param[in] item2 2nd node.
+ * @return If 1st > 2nd returns 1 and 1st < 2nd returns -1.
+ */
+static int
+set_sort_compare_virtual(struct lyxp_set_node *item1, struct lyxp_set_node *item2)
+{
+    const struct lyd_node *node1 = item1->node, *node2 = item2->node, *iter;
+    const struct lysc_node *siter = NULL;
+
+    /* the parent (or its metadata) is first */
+    if (!set_item_is_virtual(item1)) {
+        return -1;
+    } else if (!set_item_is_virtual(item2)) {
+        return 1;
+    }
+
+    if (node1->schema == node2->schema) {
+        /* instances of a leaf-list, in the order of the values */
+        for (iter = node1->next; iter; iter = iter->next) {
+            if (iter == node2) {
+                return -1;
+            }
+        }
+        return 1;
+    }
+
+    /* siblings in the schema order */
+    while ((siter = lys_getnext(siter, lyd_parent(node1)->schema, NULL, 0))) {
+        if (siter == node1->schema) {
+            return -1;
+        } else if (siter == node2->schema) {
+            return 1;
+        }
+    }
+
+    LOGINT(LYD_CTX(node1));
+    return 0;
+}
+
 /**
  * @brief Compare 2 nodes in respect to XPath document order.
  *
@@ -1623,6 +1914,11 @@ set_sort_compare(struct lyxp_set_node *item1, struct lyxp_set_node *item2)
         }
     }
 
+    /* virtual default nodes have the position of their parent */
+    if ((item1->node != item2->node) && (set_item_is_virtual(item1) || set_item_is_virtual(item2))) {
+        return set_sort_compare_virtual(item1, item2);
+    }
+
     /* we need meta positions now */
     if (item1->type == LYXP_NODE_META) {
         meta_pos1 = get_meta_pos((struct lyd_meta *)item1->node);
@@ -1660,6 +1956,19 @@ set_sort_compare(struct lyxp_set_node *item1, struct lyxp_set_node *item2)
     return -1;
 }
 
+/**
+ * @brief Compare 2 nodes in respect to XPath document order, qsort() callback.
+ *
+ * @param[in] item1 1st node.
+ * @param[in] item2 2nd node.
+ * @return If 1st > 2nd returns 1, 1st == 2nd returns 0, and 1st < 2nd returns -1.
+ */
+static int
+set_sort_compare_cb(const void *item1, const void *item2)
+{
+    return set_sort_compare((struct lyxp_set_node *)item1, (struct lyxp_set_node *)item2);
+}
+
 /**
  * @brief Set cast for comparisons.
  *
@@ -1747,20 +2056,17 @@ set_comp_canonize(struct lyxp_set *set, const struct lyxp_set_node *xp_node)
 }
 
 /**
- * @brief Bubble sort @p set into XPath document order.
- *        Context position aware.
+ * @brief Sort @p set into XPath document order.
  *
  * @param[in] set Set to sort.
- * @return How many times the whole set was traversed - 1 (if set was sorted, returns 0).
+ * @return 0 if the set was already sorted, non-zero otherwise.
  */
 static int
 set_sort(struct lyxp_set *set)
 {
-    uint32_t i, j;
-    int ret = 0, cmp;
-    ly_bool inverted, change;
+    uint32_t i;
+    int ret = 0;
     const struct lyd_node *root;
-    struct lyxp_set_node item;
     struct lyxp_set_hash_node hnode;
     uint64_t hash;
 
@@ -1782,38 +2088,18 @@ set_sort(struct lyxp_set *set)
     print_set_debug(set);
 #endif
 
-    for (i = 0; i < set->used; ++i) {
-        inverted = 0;
-        change = 0;
-
-        for (j = 1; j < set->used - i; ++j) {
-            /* compare node positions */
-            if (inverted) {
-                cmp = set_sort_compare(&set->val.nodes[j], &set->val.nodes[j - 1]);
-            } else {
-                cmp = set_sort_compare(&set->val.nodes[j - 1], &set->val.nodes[j]);
-            }
-
-            /* swap if needed */
-            if ((inverted && (cmp < 0)) || (!inverted && (cmp > 0))) {
-                change = 1;
-
-                item = set->val.nodes[j - 1];
-                set->val.nodes[j - 1] = set->val.nodes[j];
-                set->val.nodes[j] = item;
-            } else {
-                /* whether node_pos1 should be smaller than node_pos2 or the other way around */
-                inverted = !inverted;
-            }
-        }
-
-        ++ret;
-
-        if (!change) {
+    /* the set is often sorted already */
+    for (i = 1; i < set->used; ++i) {
+        if (set_sort_compare(&set->val.nodes[i - 1], &set->val.nodes[i]) > 0) {
             break;
         }
     }
 
+    if (i < set->used) {
+        qsort(set->val.nodes, set->used, sizeof *set->val.nodes, set_sort_compare_cb);
+        ret = 1;
+    }
+
 #ifndef NDEBUG
     LOGDBG(LY_LDGXPATH, "SORT END %d", ret);
     print_set_debug(set);
@@ -1834,7 +2120,7 @@ set_sort(struct lyxp_set *set)
         }
     }
 
-    return ret - 1;
+    return ret;
 }
 
 /**
@@ -2810,6 +3096,12 @@ lyxp_expr_free(const struct ly_ctx *ctx, struct lyxp_expr *expr)
         }
     }
     free(expr->repeat);
+    free(expr->scnode_cache);
+    LY_ARRAY_FREE(expr->atoms);
+    if (expr->spec) {
+        free(expr->spec->path);
+        free(expr->spec);
+    }
     free(expr);
 }
 
@@ -6109,6 +6401,58 @@ moveto_axis_node_next(const struct lyd_node **iter, enum lyxp_node_type *iter_ty
     return next_type ? LY_SUCCESS : LY_ENOTFOUND;
 }
 
+/**
+ * @brief Add the matching virtual default children of a node into a result set.
+ *
+ * @param[in] set Set to read general context from.
+ * @param[in] parent Data parent of the virtual default nodes.
+ * @param[in] moveto_mod Matching node module, NULL for no prefix.
+ * @param[in] ncname Matching node name in the dictionary, NULL for any.
+ * @param[in] options XPath options.
+ * @param[in] dup_check Whether to skip nodes already in @p result.
+ * @param[in,out] result Set to add the nodes into.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+moveto_node_dflts(struct lyxp_set *set, const struct lyd_node *parent, const struct lys_module *moveto_mod,
+        const char *ncname, uint32_t options, ly_bool dup_check, struct lyxp_set *result)
+{
+    const struct lysc_node *siter = NULL;
+    struct lyd_node *dflts, *iter;
+
+    if (!set->dflts || !parent->schema || !(parent->schema->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_NOTIF))) {
+        /* no virtual default nodes */
+        return LY_SUCCESS;
+    }
+
+    while ((siter = lys_getnext(siter, parent->schema, NULL, 0))) {
+        if ((siter->nodetype == LYS_LEAF) && !((struct lysc_node_leaf *)siter)->dflt) {
+            continue;
+        } else if ((siter->nodetype == LYS_LEAFLIST) && !((struct lysc_node_leaflist *)siter)->dflts) {
+            continue;
+        } else if (!(siter->nodetype & LYD_NODE_TERM)) {
+            continue;
+        } else if (ncname && (set->ctx == LYD_CTX(parent)) && (siter->name != ncname)) {
+            continue;
+        } else if (ncname && (set->ctx != LYD_CTX(parent)) && strcmp(siter->name, ncname)) {
+            continue;
+        }
+
+        LY_CHECK_RET(set_dflt_get(set, parent, siter, &dflts));
+        LY_LIST_FOR(dflts, iter) {
+            if (moveto_node_check(iter, LYXP_NODE_ELEM, set, ncname, moveto_mod, options)) {
+                continue;
+            } else if (dup_check && set_dup_node_check(result, iter, LYXP_NODE_ELEM, -1)) {
+                continue;
+            }
+
+            set_insert_node(result, iter, 0, LYXP_NODE_ELEM, result->used);
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Move context @p set to a node. Result is LYXP_SET_NODE_SET. Context position aware.
  *
@@ -6128,6 +6472,7 @@ moveto_node(struct lyxp_set *set, const struct lys_module *moveto_mod, const cha
     enum lyxp_node_type iter_type;
     struct lyxp_set result;
     uint32_t i;
+    ly_bool desc;
 
     if (options & LYXP_SKIP_EXPR) {
         return LY_SUCCESS;
@@ -6140,12 +6485,29 @@ moveto_node(struct lyxp_set *set, const struct lys_module *moveto_mod, const cha
 
     /* init result set */
     set_init(&result, set);
+    desc = ((axis == LYXP_AXIS_DESCENDANT) || (axis == LYXP_AXIS_DESCENDANT_OR_SELF)) ? 1 : 0;
+    if (desc) {
+        /* virtual default nodes are added out of the document order */
+        result.non_child_axis = 1;
+    }
 
     for (i = 0; i < set->used; ++i) {
+        if (((axis == LYXP_AXIS_CHILD) || desc) && (set->val.nodes[i].type == LYXP_NODE_ELEM)) {
+            /* matching virtual default children, they precede the children in the tree */
+            r = moveto_node_dflts(set, set->val.nodes[i].node, moveto_mod, ncname, options, desc, &result);
+            LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+        }
+
         /* iterate over all the nodes on the axis of the node */
         iter = NULL;
         iter_type = 0;
         while (!moveto_axis_node_next(&iter, &iter_type, set->val.nodes[i].node, set->val.nodes[i].type, axis, set)) {
+            if (desc && (iter_type == LYXP_NODE_ELEM) && (iter != set->val.nodes[i].node)) {
+                /* matching virtual default children of the descendant, the set is sorted afterwards */
+                r = moveto_node_dflts(set, iter, moveto_mod, ncname, options, 1, &result);
+                LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+            }
+
             r = moveto_node_check(iter, iter_type, set, ncname, moveto_mod, options);
             if (r == LY_EINCOMPLETE) {
                 rc = r;
@@ -6219,7 +6581,7 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
     uint32_t i;
     const struct lyd_node *siblings;
     struct lyxp_set result;
-    struct lyd_node *sub, *inst = NULL;
+    struct lyd_node *sub, *inst = NULL, *dflts;
 
     assert(scnode && (!(scnode->nodetype & (LYS_LIST | LYS_LEAFLIST)) || predicates));
 
@@ -6278,6 +6640,12 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
         }
         LY_CHECK_ERR_GOTO(r && (r != LY_ENOTFOUND), ret = r, cleanup);
 
+        if (!sub && set->dflts && (scnode->nodetype & LYD_NODE_TERM) && (set->val.nodes[i].type == LYXP_NODE_ELEM)) {
+            /* may be a virtual default node */
+            LY_CHECK_GOTO(ret = set_dflt_get(set, set->val.nodes[i].node, scnode, &dflts), cleanup);
+            for (sub = dflts; sub && inst && lyd_compare_single(sub, inst, 0); sub = sub->next) {}
+        }
+
         /* when check */
         if (!(options & LYXP_IGNORE_WHEN) && sub && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
             ret = LY_EINCOMPLETE;
@@ -6852,6 +7220,7 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
     uint32_t i;
     const struct lyd_node *next, *elem, *start;
     struct lyxp_set ret_set;
+    ly_bool sort;
     LY_ERR rc;
 
     if (options & LYXP_SKIP_EXPR) {
@@ -6863,12 +7232,21 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
         return LY_EVALID;
     }
 
+    /* the virtual default children of the original nodes are not among their children */
+    set_init(&ret_set, set);
+    for (i = 0; i < set->used; ++i) {
+        if (set->val.nodes[i].type == LYXP_NODE_ELEM) {
+            rc = moveto_node_dflts(set, set->val.nodes[i].node, moveto_mod, ncname, options, 1, &ret_set);
+            LY_CHECK_GOTO(rc, cleanup);
+        }
+    }
+    sort = ret_set.used ? 1 : 0;
+
     /* replace the original nodes (and throws away all text and meta nodes, root is replaced by a child) */
     rc = xpath_pi_node(set, LYXP_AXIS_CHILD, options);
-    LY_CHECK_RET(rc);
+    LY_CHECK_GOTO(rc, cleanup);
 
     /* this loop traverses all the nodes in the set and adds/keeps only those that match qname */
-    set_init(&ret_set, set);
     for (i = 0; i < set->used; ++i) {
 
         /* TREE DFS */
@@ -6883,11 +7261,15 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
                     goto skip_children;
                 }
             } else if (rc == LY_EINCOMPLETE) {
-                return rc;
+                goto cleanup;
             } else if (rc == LY_EINVAL) {
                 goto skip_children;
             }
 
+            /* matching virtual default children, they precede the children in the tree */
+            rc = moveto_node_dflts(set, elem, moveto_mod, ncname, options, 1, &ret_set);
+            LY_CHECK_GOTO(rc, cleanup);
+
             /* TREE DFS NEXT ELEM */
             /* select element for the next run - children first */
             next = lyd_child(elem);
@@ -6919,9 +7301,17 @@ skip_children:
     ret_set.ctx_size = set->ctx_size;
     lyxp_set_free_content(set);
     memcpy(set, &ret_set, sizeof *set);
-    assert(!set_sort(set));
+    if (sort) {
+        set_sort(set);
+    } else {
+        assert(!set_sort(set));
+    }
 
     return LY_SUCCESS;
+
+cleanup:
+    lyxp_set_free_content(&ret_set);
+    return rc;
 }
 
 /**
@@ -7990,6 +8380,7 @@ cleanup:
  * @param[in] moveto_mod Expected node module, can be NULL for JSON format with no prefix.
  * @param[in] root_type XPath root type.
  * @param[in] format Prefix format.
+ * @param[in] cached Cached schema node lookup of the NameTest, if any.
  * @param[in,out] found Previously found node, is updated.
  * @return LY_SUCCESS on success,
  * @return LY_ENOT if the whole check failed and hashes cannot be used.
@@ -7997,7 +8388,7 @@ cleanup:
 static LY_ERR
 eval_name_test_with_predicate_get_scnode(const struct ly_ctx *ctx, const struct lyd_node *node, const char *name,
         uint32_t name_len, const struct lys_module *moveto_mod, enum lyxp_node_type root_type, LY_VALUE_FORMAT format,
-        const struct lysc_node **found)
+        const struct lyxp_scnode_cache *cached, const struct lysc_node **found)
 {
     const struct lysc_node *scnode, *scnode2;
     const struct lys_module *mod;
@@ -8037,7 +8428,10 @@ continue_search:
         }
 
         /* search in children, do not repeat the same search */
-        if (node->schema->nodetype & (LYS_RPC | LYS_ACTION)) {
+        if (cached && (cached->parent == node->schema) && (cached->mod == moveto_mod)) {
+            /* cached lookup */
+            scnode = cached->scnode;
+        } else if (node->schema->nodetype & (LYS_RPC | LYS_ACTION)) {
             /* make sure the node is unique, whether in input or output */
             scnode = lys_find_child(node->schema, moveto_mod, name, name_len, 0, 0);
             scnode2 = lys_find_child(node->schema, moveto_mod, name, name_len, 0, LYS_GETNEXT_OUTPUT);
@@ -8076,6 +8470,65 @@ continue_search:
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Cache the schema node lookup of a NameTest in the expression to be reused for data evaluation.
+ *
+ * Only a NameTest with a single context schema node is cached.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Index of the NameTest token.
+ * @param[in] set Atomized context set.
+ * @param[in] moveto_mod Module of the NameTest.
+ * @param[in] name Node name.
+ * @param[in] name_len Length of @p name.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+eval_name_test_cache_scnode(const struct lyxp_expr *exp, uint32_t tok_idx, const struct lyxp_set *set,
+        const struct lys_module *moveto_mod, const char *name, uint32_t name_len)
+{
+    struct lyxp_expr *e = (struct lyxp_expr *)exp;
+    const struct lysc_node *parent = NULL, *scnode;
+    uint32_t i;
+
+    /* get the only context node */
+    for (i = 0; i < set->used; ++i) {
+        if ((set->val.scnodes[i].in_ctx == LYXP_SET_SCNODE_START) ||
+                (set->val.scnodes[i].in_ctx == LYXP_SET_SCNODE_ATOM_CTX)) {
+            if (parent || (set->val.scnodes[i].type != LYXP_NODE_ELEM)) {
+                /* several context nodes or a root */
+                return LY_SUCCESS;
+            }
+            parent = set->val.scnodes[i].scnode;
+        }
+    }
+
+    if (!parent || (parent->nodetype & (LYS_RPC | LYS_ACTION))) {
+        /* no context node, or input and output children are searched differently */
+        return LY_SUCCESS;
+    }
+
+    if (e->scnode_cache && e->scnode_cache[tok_idx].parent) {
+        /* already cached, possibly for another context node of a shared expression */
+        return LY_SUCCESS;
+    }
+
+    scnode = lys_find_child(parent, moveto_mod, name, name_len, 0, 0);
+    if (!scnode) {
+        return LY_SUCCESS;
+    }
+
+    if (!e->scnode_cache) {
+        e->scnode_cache = calloc(e->used, sizeof *e->scnode_cache);
+        LY_CHECK_ERR_RET(!e->scnode_cache, LOGMEM(moveto_mod->ctx), LY_EMEM);
+    }
+    e->scnode_cache[tok_idx].parent = parent;
+    e->scnode_cache[tok_idx].mod = moveto_mod;
+    e->scnode_cache[tok_idx].scnode = scnode;
+
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Generate message when no matching schema nodes were found for a path segment.
  *
@@ -8187,7 +8640,7 @@ eval_name_test_with_predicate(const struct lyxp_expr *exp, uint32_t *tok_idx, en
                 moveto_m = moveto_mod;
             }
             if (eval_name_test_with_predicate_get_scnode(set->ctx, set->val.nodes[i].node, ncname, ncname_len,
-                    moveto_m, set->root_type, set->format, &scnode)) {
+                    moveto_m, set->root_type, set->format, exp->scnode_cache ? &exp->scnode_cache[*tok_idx - 1] : NULL, &scnode)) {
                 /* check failed */
                 scnode = NULL;
                 break;
@@ -8241,6 +8694,12 @@ moveto:
                 }
             }
 
+            if ((options & LYXP_SCNODE_CACHE) && moveto_mod && (axis == LYXP_AXIS_CHILD) && !all_desc) {
+                /* cache the schema node lookup for data evaluation */
+                rc = eval_name_test_cache_scnode(exp, *tok_idx - 1, set, moveto_mod, ncname, ncname_len);
+                LY_CHECK_GOTO(rc, cleanup);
+            }
+
             if (all_desc && (axis == LYXP_AXIS_CHILD)) {
                 /* efficient evaluation that does not add all the descendants into the set */
                 rc = moveto_scnode_alldesc_child(set, moveto_mod, ncname_dict, options);
@@ -9724,12 +10183,86 @@ lyxp_get_root_type(const struct lyd_node *ctx_node, const struct lysc_node *ctx_
     return LYXP_NODE_ROOT;
 }
 
+/**
+ * @brief Evaluate a specialized expression.
+ *
+ * @param[in] spec Specialized expression.
+ * @param[in] ctx_node Context node.
+ * @param[in,out] set Prepared context set, result is a boolean.
+ * @return LY_SUCCESS on success;
+ * @return LY_ENOT if the specialized expression cannot be used and the expression must be evaluated.
+ */
+static LY_ERR
+eval_expr_spec(const struct lyxp_expr_spec *spec, const struct lyd_node *ctx_node, struct lyxp_set *set)
+{
+    const struct lyd_node *node = ctx_node;
+    struct lyd_node *match = NULL;
+    const struct lyd_value *val;
+    uint32_t i;
+    ly_bool result = 0;
+
+    if (!node || (node->schema != spec->ctx_scnode)) {
+        /* different context */
+        return LY_ENOT;
+    }
+
+    /* parent steps */
+    for (i = 0; i < spec->up; ++i) {
+        node = lyd_parent(node);
+        if (!node) {
+            return LY_ENOT;
+        }
+    }
+    if (node->schema != spec->base) {
+        return LY_ENOT;
+    }
+
+    /* child steps */
+    for (i = 0; i < spec->path_len; ++i) {
+        if (lyd_find_sibling_schema(lyd_child(node), spec->path[i], &match)) {
+            if (set->dflts) {
+                /* may be a virtual default node */
+                return LY_ENOT;
+            }
+
+            /* empty node-set */
+            goto cleanup;
+        }
+        node = match;
+    }
+
+    /* compare the value */
+    val = &((struct lyd_node_term *)node)->value;
+    switch (spec->type) {
+    case LYXP_SPEC_ENUM_EQUAL:
+        result = (val->enum_item == spec->enum_item) ? 1 : 0;
+        break;
+    case LYXP_SPEC_ENUM_NEQUAL:
+        result = (val->enum_item != spec->enum_item) ? 1 : 0;
+        break;
+    case LYXP_SPEC_DERIVED_FROM_OR_SELF:
+        if (val->ident == spec->ident) {
+            result = 1;
+            break;
+        }
+    /* fallthrough */
+    case LYXP_SPEC_DERIVED_FROM:
+        result = lyplg_type_identity_isderived(spec->ident, val->ident) ? 0 : 1;
+        break;
+    }
+
+cleanup:
+    set_fill_boolean(set, result);
+    return LY_SUCCESS;
+}
+
 LY_ERR
 lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct lys_module *cur_mod,
         LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node,
         const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_set *set, uint32_t options)
 {
     uint32_t tok_idx = 0;
+    struct ly_ht *dflts;
     LY_ERR rc;
 
     LY_CHECK_ARG_RET(ctx, ctx, exp, set, LY_EINVAL);
@@ -9769,16 +10302,34 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
     set->format = format;
     set->prefix_data = prefix_data;
     set->vars = vars;
+    if (ctx->flags & LY_CTX_VIRTUAL_DEFAULTS) {
+        set->dflts = lyht_new(1, sizeof(struct lyxp_set_dflt), set_dflt_values_equal_cb, NULL, 1);
+        LY_CHECK_ERR_RET(!set->dflts, LOGMEM(ctx); lyxp_set_free_content(set), LY_EMEM);
+    }
+    dflts = set->dflts;
 
     if (set->cur_node) {
         LOG_LOCSET(NULL, set->cur_node);
     }
 
     /* evaluate */
-    rc = eval_expr_select(exp, &tok_idx, 0, set, options);
+    if (!exp->spec || eval_expr_spec(exp->spec, ctx_node, set)) {
+        rc = eval_expr_select(exp, &tok_idx, 0, set, options);
+    } else {
+        rc = LY_SUCCESS;
+    }
     if (!rc && set->not_found) {
         rc = LY_ENOTFOUND;
     }
+
+    if (!rc && (set->type == LYXP_SET_NODE_SET)) {
+        /* the result may reference virtual default nodes, they are freed with it */
+        set->dflts = dflts;
+        set->dflts_owner = dflts ? 1 : 0;
+    } else {
+        lyht_free(dflts, set_dflt_free_cb);
+        set->dflts = NULL;
+    }
     if (rc) {
         lyxp_set_free_content(set);
     }
@@ -10015,6 +10566,247 @@ lyxp_set_cast(struct lyxp_set *set, enum lyxp_set_type target)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Resolve a simple relative path of a specialized expression.
+ *
+ * [1] Path ::= '..' ('/' '..')* ('/' NameTest)+ | NameTest ('/' NameTest)*
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in,out] tok_idx Position in the expression @p exp, moved after the path.
+ * @param[in] cur_mod Current module for the expression.
+ * @param[in] prefixes Resolved prefixes of the expression.
+ * @param[in,out] spec Specialized expression to fill.
+ * @return LY_SUCCESS on success;
+ * @return LY_ENOT if the path is not supported;
+ * @return LY_EMEM on memory allocation failure.
+ */
+static LY_ERR
+spec_resolve_path(const struct lyxp_expr *exp, uint32_t *tok_idx, const struct lys_module *cur_mod,
+        const void *prefixes, struct lyxp_expr_spec *spec)
+{
+    const struct lysc_node *scnode = spec->ctx_scnode, *child;
+    const struct lys_module *mod;
+    const struct lysc_node **path;
+    const char *name, *ptr;
+    uint32_t name_len;
+
+    do {
+        if (exp->tokens[*tok_idx] == LYXP_TOKEN_DDOT) {
+            if (spec->path_len) {
+                /* parent step after a child step */
+                return LY_ENOT;
+            }
+
+            scnode = lysc_data_parent(scnode);
+            if (!scnode) {
+                /* root */
+                return LY_ENOT;
+            }
+            ++spec->up;
+            spec->base = scnode;
+        } else if (exp->tokens[*tok_idx] == LYXP_TOKEN_NAMETEST) {
+            name = &exp->expr[exp->tok_pos[*tok_idx]];
+            name_len = exp->tok_len[*tok_idx];
+
+            /* get the module */
+            if ((ptr = ly_strnchr(name, ':', name_len))) {
+                mod = ly_resolve_prefix(cur_mod->ctx, name, ptr - name, LY_VALUE_SCHEMA_RESOLVED, prefixes);
+                name_len -= (ptr - name) + 1;
+                name = ptr + 1;
+            } else {
+                mod = cur_mod;
+            }
+            if (!mod || !mod->implemented || ((name_len == 1) && (name[0] == '*'))) {
+                return LY_ENOT;
+            }
+
+            /* find the child */
+            if (scnode->nodetype & (LYS_RPC | LYS_ACTION)) {
+                /* input or output */
+                return LY_ENOT;
+            }
+            child = lys_find_child(scnode, mod, name, name_len, 0, 0);
+            if (!child || !(child->nodetype & (LYS_CONTAINER | LYS_LEAF)) || lysc_has_when(child)) {
+                /* not found, multiple instances, or possibly unresolved when */
+                return LY_ENOT;
+            }
+            if ((spec->ctx_scnode->flags & LYS_CONFIG_W) && (child->flags & LYS_CONFIG_R)) {
+                /* not accessible */
+                return LY_ENOT;
+            }
+            scnode = child;
+
+            /* add into path */
+            path = realloc(spec->path, (spec->path_len + 1) * sizeof *spec->path);
+            LY_CHECK_ERR_RET(!path, LOGMEM(cur_mod->ctx), LY_EMEM);
+            spec->path = path;
+            spec->path[spec->path_len++] = scnode;
+        } else {
+            return LY_ENOT;
+        }
+        ++(*tok_idx);
+    } while ((*tok_idx < exp->used) && (exp->tokens[*tok_idx] == LYXP_TOKEN_OPER_PATH) && (++(*tok_idx) < exp->used));
+
+    if (!spec->path_len || (scnode->nodetype != LYS_LEAF)) {
+        /* no leaf */
+        return LY_ENOT;
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Resolve the literal of a specialized expression.
+ *
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Index of the literal token.
+ * @param[in] cur_mod Current module for the expression.
+ * @param[in] prefixes Resolved prefixes of the expression.
+ * @param[in,out] spec Specialized expression to fill.
+ * @return LY_SUCCESS on success;
+ * @return LY_ENOT if the literal is not supported.
+ */
+static LY_ERR
+spec_resolve_literal(const struct lyxp_expr *exp, uint32_t tok_idx, const struct lys_module *cur_mod,
+        const void *prefixes, struct lyxp_expr_spec *spec)
+{
+    const struct lysc_node_leaf *sleaf = (const struct lysc_node_leaf *)spec->path[spec->path_len - 1];
+    const struct lysc_type_enum *type_enum;
+    const struct lys_module *mod;
+    const char *str, *ptr;
+    uint32_t str_len;
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (exp->tokens[tok_idx] != LYXP_TOKEN_LITERAL) {
+        return LY_ENOT;
+    }
+    str = &exp->expr[exp->tok_pos[tok_idx] + 1];
+    str_len = exp->tok_len[tok_idx] - 2;
+
+    if ((spec->type == LYXP_SPEC_ENUM_EQUAL) || (spec->type == LYXP_SPEC_ENUM_NEQUAL)) {
+        if (sleaf->type->basetype != LY_TYPE_ENUM) {
+            return LY_ENOT;
+        }
+
+        /* find the enum, its string value is its name */
+        type_enum = (const struct lysc_type_enum *)sleaf->type;
+        LY_ARRAY_FOR(type_enum->enums, u) {
+            if (!ly_strncmp(type_enum->enums[u].name, str, str_len)) {
+                spec->enum_item = &type_enum->enums[u];
+                break;
+            }
+        }
+    } else {
+        if (sleaf->type->basetype != LY_TYPE_IDENT) {
+            return LY_ENOT;
+        }
+
+        /* find the identity the same way as derived-from() */
+        if ((ptr = ly_strnchr(str, ':', str_len))) {
+            mod = ly_resolve_prefix(cur_mod->ctx, str, ptr - str, LY_VALUE_SCHEMA_RESOLVED, prefixes);
+            str_len -= (ptr - str) + 1;
+            str = ptr + 1;
+        } else {
+            mod = cur_mod;
+        }
+        if (!mod || !mod->implemented) {
+            return LY_ENOT;
+        }
+        LY_ARRAY_FOR(mod->identities, u) {
+            if (!ly_strncmp(mod->identities[u].name, str, str_len)) {
+                spec->ident = &mod->identities[u];
+                break;
+            }
+        }
+        if (!spec->ident) {
+            /* evaluation error */
+            return LY_ENOT;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyxp_expr_specialize(const struct ly_ctx *ctx, struct lyxp_expr *exp, const struct lys_module *cur_mod,
+        const void *prefixes, const struct lysc_node *ctx_scnode)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyxp_expr_spec *spec = NULL;
+    uint32_t tok_idx = 0, lit_idx;
+    const char *func;
+
+    if (exp->spec || !ctx_scnode || (exp->used < 3)) {
+        /* already specialized or no context node */
+        return LY_SUCCESS;
+    }
+
+    spec = calloc(1, sizeof *spec);
+    LY_CHECK_ERR_RET(!spec, LOGMEM(ctx), LY_EMEM);
+    spec->ctx_scnode = ctx_scnode;
+    spec->base = ctx_scnode;
+
+    if (exp->tokens[0] == LYXP_TOKEN_FUNCNAME) {
+        /* derived-from(-or-self)(path, 'identity') */
+        func = &exp->expr[exp->tok_pos[0]];
+        if ((exp->tok_len[0] == 12) && !strncmp(func, "derived-from", 12)) {
+            spec->type = LYXP_SPEC_DERIVED_FROM;
+        } else if ((exp->tok_len[0] == 20) && !strncmp(func, "derived-from-or-self", 20)) {
+            spec->type = LYXP_SPEC_DERIVED_FROM_OR_SELF;
+        } else {
+            rc = LY_ENOT;
+            goto cleanup;
+        }
+        tok_idx = 2;
+        LY_CHECK_GOTO(rc = spec_resolve_path(exp, &tok_idx, cur_mod, prefixes, spec), cleanup);
+        if ((tok_idx + 3 != exp->used) || (exp->tokens[tok_idx] != LYXP_TOKEN_COMMA) ||
+                (exp->tokens[tok_idx + 2] != LYXP_TOKEN_PAR2)) {
+            rc = LY_ENOT;
+            goto cleanup;
+        }
+        lit_idx = tok_idx + 1;
+    } else {
+        /* path = 'enum' or 'enum' = path */
+        if (exp->tokens[0] == LYXP_TOKEN_LITERAL) {
+            lit_idx = 0;
+            tok_idx = 2;
+            LY_CHECK_GOTO(rc = spec_resolve_path(exp, &tok_idx, cur_mod, prefixes, spec), cleanup);
+            if (tok_idx != exp->used) {
+                rc = LY_ENOT;
+                goto cleanup;
+            }
+            tok_idx = 1;
+        } else {
+            LY_CHECK_GOTO(rc = spec_resolve_path(exp, &tok_idx, cur_mod, prefixes, spec), cleanup);
+            if (tok_idx + 2 != exp->used) {
+                rc = LY_ENOT;
+                goto cleanup;
+            }
+            lit_idx = tok_idx + 1;
+        }
+
+        if (exp->tokens[tok_idx] == LYXP_TOKEN_OPER_EQUAL) {
+            spec->type = LYXP_SPEC_ENUM_EQUAL;
+        } else if (exp->tokens[tok_idx] == LYXP_TOKEN_OPER_NEQUAL) {
+            spec->type = LYXP_SPEC_ENUM_NEQUAL;
+        } else {
+            rc = LY_ENOT;
+            goto cleanup;
+        }
+    }
+    LY_CHECK_GOTO(rc = spec_resolve_literal(exp, lit_idx, cur_mod, prefixes, spec), cleanup);
+
+    exp->spec = spec;
+    spec = NULL;
+
+cleanup:
+    if (spec) {
+        free(spec->path);
+        free(spec);
+    }
+    return (rc == LY_ENOT) ? LY_SUCCESS : rc;
+}
+
 LY_ERR
 lyxp_atomize(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct lys_module *cur_mod,
         LY_VALUE_FORMAT format, void *prefix_data, const struct lysc_node *cur_scnode,
@@ -93,6 +93,9 @@ struct lyd_node;
 /* Maximum number of nested expressions. */
 #define LYXP_MAX_BLOCK_DEPTH 100
 
+/* number of DFS restarts when learning node positions before all of them are learned in a single DFS */
+#define LYXP_SORT_DFS_RESTARTS 4
+
 /**
  * @brief Tokens that can be in an XPath expression.
  */
@@ -187,6 +190,51 @@ struct lyxp_expr {
     uint32_t size;           /**< Allocated array items. */
 
     const char *expr;        /**< The original XPath expression. */
+    struct lyxp_scnode_cache *scnode_cache; /**< Cache of schema node lookups of NameTest tokens filled during schema
+                                         compilation, indexed by token, NULL if empty. */
+    struct lyxp_expr_spec *spec;    /**< Specialized evaluation of the expression, if it was recognized. */
+    const struct lysc_node **atoms; /**< Sized array of schema nodes the expression depends on, collected during schema
+                                         compilation of when conditions, NULL if not known. */
+};
+
+/**
+ * @brief Types of specialized expressions.
+ */
+enum lyxp_expr_spec_type {
+    LYXP_SPEC_ENUM_EQUAL,           /**< path = 'enum' */
+    LYXP_SPEC_ENUM_NEQUAL,          /**< path != 'enum' */
+    LYXP_SPEC_DERIVED_FROM,         /**< derived-from(path, 'identity') */
+    LYXP_SPEC_DERIVED_FROM_OR_SELF  /**< derived-from-or-self(path, 'identity') */
+};
+
+/**
+ * @brief Specialized expression comparing a single leaf value with a constant, created during schema compilation
+ * for simple when and must conditions.
+ *
+ * The leaf is reached from the context node by @p up parent steps followed by child steps to @p path nodes.
+ */
+struct lyxp_expr_spec {
+    enum lyxp_expr_spec_type type;      /**< expression type */
+    const struct lysc_node *ctx_scnode; /**< context schema node the expression is specialized for */
+    uint32_t up;                        /**< number of parent steps */
+    const struct lysc_node *base;       /**< schema node reached by the parent steps */
+    const struct lysc_node **path;      /**< child schema nodes to move to, the last one is the leaf */
+    uint32_t path_len;                  /**< number of nodes in @p path */
+
+    union {
+        const struct lysc_type_bitenum_item *enum_item; /**< compared enumeration value, NULL if not valid */
+        const struct lysc_ident *ident;                 /**< compared identity */
+    };
+};
+
+/**
+ * @brief Cached ::lys_find_child() result of a NameTest token, remembered during schema compilation and reused
+ * when evaluating the expression on data with the same context schema node and module.
+ */
+struct lyxp_scnode_cache {
+    const struct lysc_node *parent;     /**< context schema node of the NameTest */
+    const struct lys_module *mod;       /**< module of the NameTest */
+    const struct lysc_node *scnode;     /**< resolved schema node, NULL if not resolved */
 };
 
 /*
@@ -315,6 +363,9 @@ struct lyxp_set {
     void *prefix_data;                      /**< Format-specific prefix data (see ::ly_resolve_prefix). */
     const struct lyxp_var *vars;            /**< XPath variables. [Sized array](@ref sizedarrays).
                                                  Set of variable bindings. */
+    struct ly_ht *dflts;                    /**< Virtual default nodes (::LY_CTX_VIRTUAL_DEFAULTS) resolved by the
+                                                 evaluation, shared by all its sets. */
+    ly_bool dflts_owner;                    /**< Whether the set frees @p dflts, only the result of ::lyxp_eval(). */
 };
 
 /**
@@ -343,7 +394,7 @@ const char *lyxp_token2str(enum lyxp_token tok);
  * @param[in] tree Data tree on which to perform the evaluation, it must include all the available data (including
  * the tree of @p ctx_node). Can be any node of the tree, it is adjusted.
  * @param[in] vars [Sized array](@ref sizedarrays) of XPath variables.
- * @param[out] set Result set.
+ * @param[out] set Result set. Any virtual default nodes (::LY_CTX_VIRTUAL_DEFAULTS) in it are freed with its content.
  * @param[in] options Whether to apply some evaluation restrictions.
  * @return LY_EVALID for invalid argument types/count,
  * @return LY_EINCOMPLETE for unresolved when,
@@ -353,6 +404,21 @@ LY_ERR lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const st
         LY_VALUE_FORMAT format, void *prefix_data, const struct lyd_node *cur_node, const struct lyd_node *ctx_node,
         const struct lyd_node *tree, const struct lyxp_var *vars, struct lyxp_set *set, uint32_t options);
 
+/**
+ * @brief Try to create a specialized evaluation of a when or must expression, which is then used by ::lyxp_eval().
+ *
+ * Simple comparisons of a leaf with an enumeration value or identity are recognized.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in,out] exp Parsed XPath expression, ::lyxp_expr.spec is set if recognized.
+ * @param[in] cur_mod Current module for the expression.
+ * @param[in] prefixes Resolved prefixes of the expression (::LY_VALUE_SCHEMA_RESOLVED).
+ * @param[in] ctx_scnode Context schema node of the expression.
+ * @return LY_ERR value, not recognized expression is not an error.
+ */
+LY_ERR lyxp_expr_specialize(const struct ly_ctx *ctx, struct lyxp_expr *exp, const struct lys_module *cur_mod,
+        const void *prefixes, const struct lysc_node *ctx_scnode);
+
 /**
  * @brief Get all the partial XPath nodes (atoms) that are required for @p exp to be evaluated.
  *
@@ -386,6 +452,8 @@ LY_ERR lyxp_atomize(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const
 #define LYXP_ACCESS_TREE_ALL 0x80   /**< Explicit accessible tree of all the nodes. */
 #define LYXP_ACCESS_TREE_CONFIG 0x0100  /**< Explicit accessible tree of only configuration data. */
 #define LYXP_SCNODE_SCHEMAMOUNT LYS_FIND_SCHEMAMOUNT    /**< Nodes from mounted modules are also accessible. */
+#define LYXP_SCNODE_CACHE  0x0400  /**< Cache NameTest schema node lookups in the expression (::lyxp_expr.scnode_cache),
+                                         should be used only during schema compilation. */
 
 /**
  * @brief Cast XPath set to another type.
@@ -20,7 +20,9 @@
 #include <sys/time.h>
 #include <time.h>
 
+#include "hash_table.h"
 #include "libyang.h"
+#include "nacm.h"
 #include "tests_config.h"
 
 #ifdef HAVE_CALLGRIND
@@ -313,6 +315,34 @@ setup_data_offset_tree(const struct lys_module *mod, uint32_t count, struct test
     return LY_SUCCESS;
 }
 
+static LY_ERR
+setup_data_nacm(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+    const char *nacm = "<nacm xmlns=\"urn:ietf:params:xml:ns:yang:ietf-netconf-acm\">"
+            "<rule-list><name>rl</name><group>*</group>"
+            "<rule><name>r1</name><module-name>perf</module-name>"
+            "<path xmlns:perf=\"urn:sysrepo:tests:perf\">/perf:cont/perf:lst[perf:k1='0'][perf:k2='str0']</path>"
+            "<access-operations>read</access-operations><action>deny</action></rule>"
+            "<rule><name>r2</name><module-name>perf</module-name>"
+            "<path xmlns:perf=\"urn:sysrepo:tests:perf\">/perf:cont/perf:lst/perf:lfl</path>"
+            "<access-operations>read</access-operations><action>deny</action></rule>"
+            "</rule-list></nacm>";
+
+    state->mod = mod;
+    state->count = count;
+
+    if ((ret = create_list_inst(mod, 0, count, &state->data1))) {
+        return ret;
+    }
+    if ((ret = lyd_parse_data_mem(mod->ctx, nacm, LYD_XML, 0, LYD_VALIDATE_PRESENT | LYD_VALIDATE_NO_STATE,
+            &state->data2))) {
+        return ret;
+    }
+
+    return LY_SUCCESS;
+}
+
 /* TEST CB */
 static LY_ERR
 test_create_new_text(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
@@ -453,12 +483,74 @@ cleanup:
     return ret;
 }
 
+static LY_ERR
+_test_parse_small(struct test_state *state, ly_bool reuse, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_node *data = NULL;
+    struct lyd_parser *parser = NULL;
+    struct ly_in *in = NULL;
+    const char *xml = "<cont xmlns=\"urn:sysrepo:tests:perf\"><lst><k1>1</k1><k2>str1</k2><l>l1</l></lst></cont>";
+    uint32_t i;
+
+    if ((ret = ly_in_new_memory(xml, &in))) {
+        goto cleanup;
+    }
+    if (reuse && (ret = lyd_parser_new(state->mod->ctx, &parser))) {
+        goto cleanup;
+    }
+
+    TEST_START(ts_start);
+
+    /* many small inputs */
+    for (i = 0; i < state->count; ++i) {
+        ly_in_reset(in);
+        if (reuse) {
+            ret = lyd_parser_parse_data(parser, NULL, in, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &data);
+        } else {
+            ret = lyd_parse_data(state->mod->ctx, NULL, in, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &data);
+        }
+        if (ret) {
+            goto cleanup;
+        }
+        lyd_free_siblings(data);
+        data = NULL;
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    lyd_parser_free(parser);
+    ly_in_free(in, 0);
+    lyd_free_siblings(data);
+    return ret;
+}
+
+static LY_ERR
+test_parse_xml_small_validate(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse_small(state, 0, ts_start, ts_end);
+}
+
+static LY_ERR
+test_parse_xml_small_validate_reuse(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse_small(state, 1, ts_start, ts_end);
+}
+
 static LY_ERR
 test_parse_xml_mem_validate(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
     return _test_parse(state, LYD_XML, 0, LYD_PRINT_SHRINK, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, ts_start, ts_end);
 }
 
+static LY_ERR
+test_parse_xml_mem_validate_bulk(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse(state, LYD_XML, 0, LYD_PRINT_SHRINK, LYD_PARSE_STRICT | LYD_PARSE_BULK, LYD_VALIDATE_PRESENT,
+            ts_start, ts_end);
+}
+
 static LY_ERR
 test_parse_xml_mem_no_validate(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -478,6 +570,13 @@ test_parse_json_mem_validate(struct test_state *state, struct timespec *ts_start
     return _test_parse(state, LYD_JSON, 0, LYD_PRINT_SHRINK, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, ts_start, ts_end);
 }
 
+static LY_ERR
+test_parse_json_mem_validate_bulk(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse(state, LYD_JSON, 0, LYD_PRINT_SHRINK, LYD_PARSE_STRICT | LYD_PARSE_BULK, LYD_VALIDATE_PRESENT,
+            ts_start, ts_end);
+}
+
 static LY_ERR
 test_parse_json_mem_no_validate(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -768,20 +867,319 @@ test_merge_no_same_destruct(struct test_state *state, struct timespec *ts_start,
     return LY_SUCCESS;
 }
 
+static LY_ERR
+test_nacm_filter(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct lyd_nacm *nacm;
+    struct lyd_node *data;
+
+    if ((r = lyd_dup_single(state->data1, NULL, LYD_DUP_RECURSIVE, &data))) {
+        return r;
+    }
+    if ((r = lyd_nacm_compile(state->mod->ctx, state->data2, "user", NULL, &nacm))) {
+        return r;
+    }
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_nacm_filter(nacm, &data))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    lyd_nacm_free(nacm);
+    lyd_free_siblings(data);
+
+    return LY_SUCCESS;
+}
+
+static ly_bool
+ht_uint64_equal_cb(void *val1_p, void *val2_p, ly_bool mod, void *cb_data)
+{
+    (void)mod;
+    (void)cb_data;
+
+    return *(uint64_t *)val1_p == *(uint64_t *)val2_p;
+}
+
+/**
+ * @brief Hash table operation to measure.
+ */
+enum ht_op {
+    HT_INSERT,  /**< insert into a table large enough */
+    HT_RESIZE,  /**< insert into a table enlarged on the way */
+    HT_FIND,    /**< find all the values */
+    HT_REMOVE   /**< remove all the values, the table is shrunk on the way */
+};
+
+static LY_ERR
+_test_ht(struct test_state *state, ly_bool open_addr, enum ht_op op, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct ly_ht *ht;
+    uint64_t val;
+    uint32_t i, size;
+
+    /* spread values, with their hashes computed the same way as pointers are hashed */
+    size = (op == HT_RESIZE) ? 1 : lyht_get_fixed_size(state->count * 2);
+    ht = open_addr ? lyht_new_open(size, sizeof val, ht_uint64_equal_cb, NULL, 1) :
+            lyht_new(size, sizeof val, ht_uint64_equal_cb, NULL, 1);
+    if (!ht) {
+        return LY_EMEM;
+    }
+    if ((op == HT_FIND) || (op == HT_REMOVE)) {
+        for (i = 0; i < state->count; ++i) {
+            val = i * 2654435761ULL;
+            if ((ret = lyht_insert(ht, &val, lyht_hash((const char *)&val, sizeof val), NULL))) {
+                goto cleanup;
+            }
+        }
+    }
+
+    TEST_START(ts_start);
+
+    for (i = 0; i < state->count; ++i) {
+        val = i * 2654435761ULL;
+        switch (op) {
+        case HT_INSERT:
+        case HT_RESIZE:
+            ret = lyht_insert(ht, &val, lyht_hash((const char *)&val, sizeof val), NULL);
+            break;
+        case HT_FIND:
+            ret = lyht_find(ht, &val, lyht_hash((const char *)&val, sizeof val), NULL);
+            break;
+        case HT_REMOVE:
+            ret = lyht_remove(ht, &val, lyht_hash((const char *)&val, sizeof val));
+            break;
+        }
+        if (ret) {
+            goto cleanup;
+        }
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    lyht_free(ht, NULL);
+    return ret;
+}
+
+static LY_ERR
+test_ht_insert(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 0, HT_INSERT, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_insert_open(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 1, HT_INSERT, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_resize(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 0, HT_RESIZE, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_resize_open(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 1, HT_RESIZE, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_find(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 0, HT_FIND, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_find_open(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 1, HT_FIND, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_remove(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 0, HT_REMOVE, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_remove_open(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht(state, 1, HT_REMOVE, ts_start, ts_end);
+}
+
+/**
+ * @brief Measure the slowest single insert into an open addressing hash table enlarged on the way.
+ */
+static LY_ERR
+_test_ht_insert_worst(struct test_state *state, uint32_t resize_step, struct timespec *ts_start,
+        struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct ly_ht *ht;
+    struct timespec start, end;
+    uint64_t val, nsec, worst = 0;
+    uint32_t i;
+
+    ht = lyht_new_open(1, sizeof val, ht_uint64_equal_cb, NULL, 1);
+    if (!ht) {
+        return LY_EMEM;
+    }
+    lyht_set_resize_step(ht, resize_step);
+
+    for (i = 0; i < state->count; ++i) {
+        val = i * 2654435761ULL;
+
+        time_get(&start);
+        ret = lyht_insert(ht, &val, lyht_hash((const char *)&val, sizeof val), NULL);
+        time_get(&end);
+        if (ret) {
+            goto cleanup;
+        }
+
+        /* remember the slowest insert */
+        nsec = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+        if (nsec >= worst) {
+            worst = nsec;
+            *ts_start = start;
+            *ts_end = end;
+        }
+    }
+
+cleanup:
+    lyht_free(ht, NULL);
+    return ret;
+}
+
+static LY_ERR
+test_ht_insert_worst(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht_insert_worst(state, 0, ts_start, ts_end);
+}
+
+static LY_ERR
+test_ht_insert_worst_incr(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_ht_insert_worst(state, 8, ts_start, ts_end);
+}
+
+/**
+ * @brief Operation on (leaf-)list instances ordered by system to measure.
+ */
+enum sorted_op {
+    SORTED_INSERT,          /**< insert leaf-list instances in random order */
+    SORTED_INSERT_ORDERED,  /**< insert leaf-list instances in sorted order */
+    SORTED_REMOVE,          /**< remove leaf-list instances in random order */
+    SORTED_INSERT_LIST      /**< insert list instances in random order */
+};
+
+static LY_ERR
+_test_sorted(struct test_state *state, enum sorted_op op, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_node *data = NULL, *list, **nodes = NULL;
+    uint32_t i, val, k2_len;
+    char k2_val[32];
+
+    if ((ret = lyd_new_inner(NULL, state->mod, "cont", 0, &data))) {
+        return ret;
+    }
+    if ((ret = lyd_new_list(data, NULL, "lst", 0, &list, "0", "str0"))) {
+        goto cleanup;
+    }
+    if (op == SORTED_REMOVE) {
+        nodes = malloc(state->count * sizeof *nodes);
+        if (!nodes) {
+            ret = LY_EMEM;
+            goto cleanup;
+        }
+        for (i = 0; i < state->count; ++i) {
+            val = i * 2654435761U;
+            if ((ret = lyd_new_term_bin(list, NULL, "lfl", &val, sizeof val, 0, &nodes[i]))) {
+                goto cleanup;
+            }
+        }
+    }
+
+    TEST_START(ts_start);
+
+    for (i = 0; i < state->count; ++i) {
+        /* distinct values in random order */
+        val = (op == SORTED_INSERT_ORDERED) ? i : i * 2654435761U;
+        switch (op) {
+        case SORTED_INSERT:
+        case SORTED_INSERT_ORDERED:
+            ret = lyd_new_term_bin(list, NULL, "lfl", &val, sizeof val, 0, NULL);
+            break;
+        case SORTED_REMOVE:
+            lyd_free_tree(nodes[i]);
+            break;
+        case SORTED_INSERT_LIST:
+            k2_len = sprintf(k2_val, "str%" PRIu32, i);
+            ret = lyd_new_list(data, NULL, "lst", LYD_NEW_VAL_BIN, NULL, &val, sizeof val, k2_val, k2_len);
+            break;
+        }
+        if (ret) {
+            goto cleanup;
+        }
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    free(nodes);
+    lyd_free_siblings(data);
+    return ret;
+}
+
+static LY_ERR
+test_sorted_insert(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_sorted(state, SORTED_INSERT, ts_start, ts_end);
+}
+
+static LY_ERR
+test_sorted_insert_ordered(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_sorted(state, SORTED_INSERT_ORDERED, ts_start, ts_end);
+}
+
+static LY_ERR
+test_sorted_remove(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_sorted(state, SORTED_REMOVE, ts_start, ts_end);
+}
+
+static LY_ERR
+test_sorted_insert_list(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_sorted(state, SORTED_INSERT_LIST, ts_start, ts_end);
+}
+
 struct test tests[] = {
     {"create new text", setup_basic, test_create_new_text},
     {"create new bin", setup_basic, test_create_new_bin},
     {"create path", setup_basic, test_create_path},
     {"validate", setup_data_single_tree, test_validate},
     {"parse xml mem validate", setup_data_single_tree, test_parse_xml_mem_validate},
+    {"parse xml mem validate bulk", setup_data_single_tree, test_parse_xml_mem_validate_bulk},
     {"parse xml mem no validate", setup_data_single_tree, test_parse_xml_mem_no_validate},
     {"parse xml file no validate format", setup_data_single_tree, test_parse_xml_file_no_validate_format},
     {"parse json mem validate", setup_data_single_tree, test_parse_json_mem_validate},
+    {"parse json mem validate bulk", setup_data_single_tree, test_parse_json_mem_validate_bulk},
     {"parse json mem no validate", setup_data_single_tree, test_parse_json_mem_no_validate},
     {"parse json file no validate format", setup_data_single_tree, test_parse_json_file_no_validate_format},
     {"parse lyb mem validate", setup_data_single_tree, test_parse_lyb_mem_validate},
     {"parse lyb mem no validate", setup_data_single_tree, test_parse_lyb_mem_no_validate},
     {"parse lyb file no validate", setup_data_single_tree, test_parse_lyb_file_no_validate},
+    {"parse xml small validate", setup_basic, test_parse_xml_small_validate},
+    {"parse xml small validate reuse", setup_basic, test_parse_xml_small_validate_reuse},
     {"print xml", setup_data_single_tree, test_print_xml},
     {"print json", setup_data_single_tree, test_print_json},
     {"print lyb", setup_data_single_tree, test_print_lyb},
@@ -796,6 +1194,21 @@ struct test tests[] = {
     {"merge same", setup_data_same_trees, test_merge_same},
     {"merge no same", setup_data_offset_tree, test_merge_no_same},
     {"merge no same destruct", setup_basic, test_merge_no_same_destruct},
+    {"nacm filter", setup_data_nacm, test_nacm_filter},
+    {"hash table insert", setup_basic, test_ht_insert},
+    {"hash table insert open", setup_basic, test_ht_insert_open},
+    {"hash table resize", setup_basic, test_ht_resize},
+    {"hash table resize open", setup_basic, test_ht_resize_open},
+    {"hash table find", setup_basic, test_ht_find},
+    {"hash table find open", setup_basic, test_ht_find_open},
+    {"hash table remove", setup_basic, test_ht_remove},
+    {"hash table remove open", setup_basic, test_ht_remove_open},
+    {"hash table insert worst", setup_basic, test_ht_insert_worst},
+    {"hash table insert worst incr", setup_basic, test_ht_insert_worst_incr},
+    {"sorted leaf-list insert", setup_basic, test_sorted_insert},
+    {"sorted leaf-list insert ordered", setup_basic, test_sorted_insert_ordered},
+    {"sorted leaf-list remove", setup_basic, test_sorted_remove},
+    {"sorted list insert", setup_basic, test_sorted_insert_list},
 };
 
 int
@@ -832,6 +1245,13 @@ main(int argc, char **argv)
     }
 
     /* load modules */
+    if ((ret = ly_ctx_set_searchdir(ctx, TESTS_DIR_MODULES_YANG))) {
+        goto cleanup;
+    }
+    if (!ly_ctx_load_module(ctx, "ietf-netconf-acm", "2018-02-14", NULL)) {
+        ret = LY_ENOTFOUND;
+        goto cleanup;
+    }
     if (!(mod = ly_ctx_load_module(ctx, "perf", NULL, NULL))) {
         ret = LY_ENOTFOUND;
         goto cleanup;
@@ -14,6 +14,8 @@
 #define _UTEST_MAIN_
 #include "utests.h"
 
+#include <pthread.h>
+
 #include "context.h"
 #include "in.h"
 #include "ly_common.h"
@@ -1106,6 +1108,83 @@ test_explicit_compile(void **state)
     assert_non_null(mod);
 }
 
+struct thread_err_arg {
+    struct ly_ctx *ctx;
+    uint32_t id;
+    int ok;
+};
+
+static void *
+thread_err_logger(void *arg)
+{
+    struct thread_err_arg *targ = arg;
+    const struct ly_err_item *e;
+    uint32_t i, j, count, temp_lo = LY_LOSTORE, *prev_lo;
+    char msg[32];
+
+    prev_lo = ly_temp_log_options(&temp_lo);
+    targ->ok = 1;
+    for (i = 0; i < 200; ++i) {
+        for (j = 0; j < 3; ++j) {
+            LOGERR(targ->ctx, LY_EINVAL, "thread %" PRIu32 " error %" PRIu32, targ->id, j);
+        }
+
+        /* only the errors of this thread are visible */
+        count = 0;
+        for (e = ly_err_first(targ->ctx); e; e = e->next) {
+            sprintf(msg, "thread %" PRIu32 " error %" PRIu32, targ->id, count);
+            if (strcmp(e->msg, msg)) {
+                targ->ok = 0;
+            }
+            ++count;
+        }
+        if (count != 3) {
+            targ->ok = 0;
+        }
+
+        ly_err_clean(targ->ctx, NULL);
+        if (ly_err_last(targ->ctx)) {
+            targ->ok = 0;
+        }
+    }
+    ly_temp_log_options(prev_lo);
+
+    return NULL;
+}
+
+static void
+test_thread_errors(void **state)
+{
+    struct thread_err_arg args[4];
+    pthread_t threads[4];
+    struct ly_ctx *ctx;
+    uint32_t i, temp_lo = LY_LOSTORE, *prev_lo;
+
+    for (i = 0; i < 4; ++i) {
+        args[i].ctx = UTEST_LYCTX;
+        args[i].id = i;
+        assert_int_equal(0, pthread_create(&threads[i], NULL, thread_err_logger, &args[i]));
+    }
+    for (i = 0; i < 4; ++i) {
+        assert_int_equal(0, pthread_join(threads[i], NULL));
+        assert_true(args[i].ok);
+    }
+
+    /* the errors of other threads are not visible here */
+    assert_null(ly_err_first(UTEST_LYCTX));
+
+    /* errors of a destroyed context do not leak into a new one, even if it reuses the same address */
+    prev_lo = ly_temp_log_options(&temp_lo);
+    for (i = 0; i < 10; ++i) {
+        assert_int_equal(LY_SUCCESS, ly_ctx_new(NULL, LY_CTX_NO_YANGLIBRARY, &ctx));
+        assert_null(ly_err_last(ctx));
+        LOGERR(ctx, LY_EINVAL, "error %" PRIu32, i);
+        assert_non_null(ly_err_last(ctx));
+        ly_ctx_destroy(ctx);
+    }
+    ly_temp_log_options(prev_lo);
+}
+
 int
 main(void)
 {
@@ -1118,6 +1197,7 @@ main(void)
         UTEST(test_ylmem),
         UTEST(test_set_priv_parsed),
         UTEST(test_explicit_compile),
+        UTEST(test_thread_errors),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -247,6 +247,175 @@ test_ht_collisions(void **UNUSED(state))
     lyht_free(ht, NULL);
 }
 
+static uint8_t
+ht_group_equal_clb(void *val1, void *val2, uint8_t mod, void *cb_data)
+{
+    int *v1, *v2;
+
+    (void)cb_data;
+
+    v1 = (int *)val1;
+    v2 = (int *)val2;
+
+    /* find matches any value of the same hundred */
+    return mod ? (*v1 == *v2) : (*v1 / 100 == *v2 / 100);
+}
+
+static void
+test_ht_open(void **UNUSED(state))
+{
+    uint32_t i, hlist_idx, rec_idx, count;
+    int val, *match;
+    struct ly_ht_rec *rec;
+    struct ly_ht *ht, *dup;
+
+    assert_non_null(ht = lyht_new_open(8, sizeof(int), ht_group_equal_clb, NULL, 1));
+
+    /* values with equal hashes wrapping around the end of the table */
+    for (val = 100; val < 104; ++val) {
+        assert_int_equal(LY_SUCCESS, lyht_insert(ht, &val, 7, NULL));
+    }
+    assert_int_equal(8, ht->size);
+
+    /* many colliding values, the table is enlarged */
+    for (val = 1000; val < 3000; ++val) {
+        assert_int_equal(LY_SUCCESS, lyht_insert(ht, &val, val % 61, NULL));
+    }
+    assert_int_equal(2004, ht->used);
+    assert_int_equal(4096, ht->size);
+    val = 1500;
+    assert_int_equal(LY_EEXIST, lyht_insert(ht, &val, val % 61, NULL));
+    for (val = 1000; val < 3000; ++val) {
+        assert_int_equal(LY_SUCCESS, lyht_find(ht, &val, val % 61, (void **)&match));
+        assert_int_equal(*match / 100, val / 100);
+    }
+    val = 3000;
+    assert_int_equal(LY_ENOTFOUND, lyht_find(ht, &val, val % 61, NULL));
+
+    /* values with equal hashes are found in the order of insertion */
+    val = 100;
+    assert_int_equal(LY_SUCCESS, lyht_find(ht, &val, 7, (void **)&match));
+    for (i = 0; i < 3; ++i) {
+        assert_int_equal(100 + i, *match);
+        val = *match;
+        assert_int_equal(LY_SUCCESS, lyht_find_next(ht, &val, 7, (void **)&match));
+    }
+    assert_int_equal(103, *match);
+    val = 103;
+    assert_int_equal(LY_ENOTFOUND, lyht_find_next(ht, &val, 7, NULL));
+
+    /* iterate all the records */
+    count = 0;
+    LYHT_ITER_ALL_RECS(ht, hlist_idx, rec_idx, rec) {
+        ++count;
+    }
+    assert_int_equal(2004, count);
+
+    /* duplicate */
+    assert_non_null(dup = lyht_dup(ht));
+    for (val = 1000; val < 3000; val += 7) {
+        assert_int_equal(LY_SUCCESS, lyht_find(dup, &val, val % 61, NULL));
+    }
+    lyht_free(dup, NULL);
+
+    /* remove most of the values, the table is shrunk */
+    for (val = 1000; val < 2990; ++val) {
+        assert_int_equal(LY_SUCCESS, lyht_remove(ht, &val, val % 61));
+    }
+    val = 101;
+    assert_int_equal(LY_SUCCESS, lyht_remove(ht, &val, 7));
+    assert_int_equal(13, ht->used);
+    assert_int_equal(32, ht->size);
+    for (val = 1000; val < 3000; ++val) {
+        assert_int_equal((val < 2990) ? LY_ENOTFOUND : LY_SUCCESS, lyht_find_with_val_cb(ht, &val, val % 61, ht_equal_clb,
+                NULL));
+    }
+
+    /* the order of the remaining values with equal hashes is kept */
+    val = 100;
+    assert_int_equal(LY_SUCCESS, lyht_find(ht, &val, 7, (void **)&match));
+    assert_int_equal(100, *match);
+    assert_int_equal(LY_SUCCESS, lyht_find_next(ht, match, 7, (void **)&match));
+    assert_int_equal(102, *match);
+    assert_int_equal(LY_SUCCESS, lyht_find_next(ht, match, 7, (void **)&match));
+    assert_int_equal(103, *match);
+
+    lyht_free(ht, NULL);
+}
+
+static void
+test_ht_incremental(void **UNUSED(state))
+{
+    uint32_t i;
+    int val, num, *match, open_addr, migrated;
+    struct ly_ht *ht, *dup;
+
+    for (open_addr = 0; open_addr < 2; ++open_addr) {
+        dup = NULL;
+        assert_non_null(ht = open_addr ? lyht_new_open(8, sizeof(int), ht_group_equal_clb, NULL, 1) :
+                lyht_new(8, sizeof(int), ht_group_equal_clb, NULL, 1));
+        assert_int_equal(0, lyht_set_resize_step(ht, 1));
+
+        /* values with equal hashes */
+        for (val = 100; val < 104; ++val) {
+            assert_int_equal(LY_SUCCESS, lyht_insert(ht, &val, 7, NULL));
+        }
+
+        /* all the values are always found while the table is being enlarged */
+        migrated = 0;
+        for (val = 1000; val < 1200; ++val) {
+            assert_int_equal(LY_SUCCESS, lyht_insert(ht, &val, val % 61, NULL));
+            if (ht->old) {
+                ++migrated;
+            }
+            for (num = 1000; num <= val; ++num) {
+                assert_int_equal(LY_SUCCESS, lyht_find_with_val_cb(ht, &num, num % 61, ht_equal_clb, NULL));
+            }
+            assert_int_equal(LY_EEXIST, lyht_insert(ht, &val, val % 61, NULL));
+
+            /* values with equal hashes are found in the order of insertion */
+            num = 100;
+            assert_int_equal(LY_SUCCESS, lyht_find(ht, &num, 7, (void **)&match));
+            for (i = 0; i < 3; ++i) {
+                assert_int_equal(100 + i, *match);
+                assert_int_equal(LY_SUCCESS, lyht_find_next(ht, match, 7, (void **)&match));
+            }
+            assert_int_equal(103, *match);
+            assert_int_equal(LY_ENOTFOUND, lyht_find_next(ht, match, 7, NULL));
+
+            if (ht->old && !dup) {
+                /* duplicate */
+                assert_non_null(dup = lyht_dup(ht));
+                assert_null(dup->old);
+                assert_int_equal(ht->used, dup->used);
+                for (num = 1000; num <= val; ++num) {
+                    assert_int_equal(LY_SUCCESS, lyht_find_with_val_cb(dup, &num, num % 61, ht_equal_clb, NULL));
+                }
+                lyht_free(dup, NULL);
+            }
+        }
+        assert_int_not_equal(0, migrated);
+        assert_int_equal(204, ht->used);
+
+        /* remove the values while the table is being shrunk */
+        for (val = 1000; val < 1200; ++val) {
+            assert_int_equal(LY_SUCCESS, lyht_remove(ht, &val, val % 61));
+            for (num = 1000; num < 1200; ++num) {
+                assert_int_equal((num <= val) ? LY_ENOTFOUND : LY_SUCCESS,
+                        lyht_find_with_val_cb(ht, &num, num % 61, ht_equal_clb, NULL));
+            }
+        }
+        assert_int_equal(4, ht->used);
+        assert_true(ht->size < 256);
+
+        /* free while being enlarged */
+        for (val = 1000; !ht->old; ++val) {
+            assert_int_equal(LY_SUCCESS, lyht_insert(ht, &val, val % 61, NULL));
+        }
+        lyht_free(ht, NULL);
+    }
+}
+
 int
 main(void)
 {
@@ -256,6 +425,8 @@ main(void)
         UTEST(test_ht_basic),
         UTEST(test_ht_resize),
         UTEST(test_ht_collisions),
+        UTEST(test_ht_open),
+        UTEST(test_ht_incremental),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
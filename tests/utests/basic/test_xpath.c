@@ -22,6 +22,7 @@
 #include "tests_config.h"
 #include "tree_data.h"
 #include "tree_schema.h"
+#include "xpath.h"
 
 const char *schema_a =
         "module a {\n"
@@ -1099,6 +1100,199 @@ test_axes(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_sort(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    char buf[16];
+    uint32_t i;
+
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, ly_ctx_get_module_implemented(UTEST_LYCTX, "a"), "c", 0, &tree));
+    for (i = 0; i < 40; ++i) {
+        sprintf(buf, "val%02" PRIu32, i);
+        assert_int_equal(LY_SUCCESS, lyd_new_term(tree, NULL, "ll2", buf, 0, NULL));
+    }
+
+    /* reverse axis, the nodes need to be sorted */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "ll2[last()]/preceding-sibling::ll2", &set));
+    assert_int_equal(39, set->count);
+    for (i = 0; i < set->count; ++i) {
+        sprintf(buf, "val%02" PRIu32, i);
+        assert_string_equal(buf, lyd_get_value(set->dnodes[i]));
+    }
+    ly_set_free(set, NULL);
+
+    /* unions of unsorted sets */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "ll2[.='val30']/preceding-sibling::ll2[position() < 20] | "
+            "ll2[.='val39']/preceding-sibling::ll2[position() < 10] | ll2[1]/following-sibling::ll2[position() < 5]", &set));
+    assert_int_equal(4 + 19 + 9, set->count);
+    node = NULL;
+    for (i = 0; i < set->count; ++i) {
+        if (node) {
+            assert_int_equal(-1, strcmp(lyd_get_value(node), lyd_get_value(set->dnodes[i])));
+        }
+        node = set->dnodes[i];
+    }
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_scnode_cache(void **state)
+{
+    const char *schema =
+            "module rs {\n"
+            "    namespace urn:tests:rs;\n"
+            "    prefix rs;\n"
+            "    container c {\n"
+            "        leaf a {\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf b {\n"
+            "            when \"../a = 'x'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf d {\n"
+            "            must \"../a != 'y'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+    const struct lysc_node *cont, *a, *b, *d;
+    const struct lyxp_expr *cond;
+    struct lyd_node *tree;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    cont = lys_find_path(UTEST_LYCTX, NULL, "/rs:c", 0);
+    a = lys_find_path(UTEST_LYCTX, NULL, "/rs:c/a", 0);
+    b = lys_find_path(UTEST_LYCTX, NULL, "/rs:c/b", 0);
+    d = lys_find_path(UTEST_LYCTX, NULL, "/rs:c/d", 0);
+
+    /* "a" resolved during compilation */
+    cond = lysc_node_when(b)[0]->cond;
+    assert_non_null(cond->scnode_cache);
+    assert_int_equal(LYXP_TOKEN_NAMETEST, cond->tokens[2]);
+    assert_ptr_equal(cont, cond->scnode_cache[2].parent);
+    assert_ptr_equal(a, cond->scnode_cache[2].scnode);
+    cond = lysc_node_musts(d)[0].cond;
+    assert_non_null(cond->scnode_cache);
+    assert_ptr_equal(a, cond->scnode_cache[2].scnode);
+
+    /* evaluated using the resolved nodes */
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:rs\"><a>x</a><b>val</b><d>val</d></c>", LYD_XML, 0,
+            LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:rs\"><a>z</a><b>val</b></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT,
+            LY_EVALID, tree);
+    CHECK_LOG_CTX("When condition \"../a = 'x'\" not satisfied.", "/rs:c/b", 0);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:rs\"><a>y</a><d>val</d></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT,
+            LY_EVALID, tree);
+    CHECK_LOG_CTX("Must condition \"../a != 'y'\" not satisfied.", "/rs:c/d", 0);
+}
+
+static void
+test_specialized(void **state)
+{
+    const char *schema =
+            "module sp {\n"
+            "    namespace urn:tests:sp;\n"
+            "    prefix sp;\n"
+            "    identity base;\n"
+            "    identity eth {\n"
+            "        base base;\n"
+            "    }\n"
+            "    identity fast-eth {\n"
+            "        base eth;\n"
+            "    }\n"
+            "    identity other {\n"
+            "        base base;\n"
+            "    }\n"
+            "    container c {\n"
+            "        leaf mode {\n"
+            "            type enumeration {\n"
+            "                enum auto;\n"
+            "                enum manual;\n"
+            "            }\n"
+            "        }\n"
+            "        container sub {\n"
+            "            leaf type {\n"
+            "                type identityref {\n"
+            "                    base base;\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "        leaf a {\n"
+            "            when \"../mode = 'auto'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf b {\n"
+            "            when \"'manual' != ../mode\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf e {\n"
+            "            must \"derived-from-or-self(../sub/type, 'sp:eth')\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf f {\n"
+            "            must \"derived-from(../sub/type, 'eth')\";\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf g {\n"
+            "            when \"../mode = 'manual' or ../mode = 'auto'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+    const struct lysc_node *node;
+    struct lyd_node *tree;
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    /* recognized expressions */
+    node = lys_find_path(UTEST_LYCTX, NULL, "/sp:c/a", 0);
+    assert_non_null(lysc_node_when(node)[0]->cond->spec);
+    assert_int_equal(LYXP_SPEC_ENUM_EQUAL, lysc_node_when(node)[0]->cond->spec->type);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/sp:c/b", 0);
+    assert_non_null(lysc_node_when(node)[0]->cond->spec);
+    assert_int_equal(LYXP_SPEC_ENUM_NEQUAL, lysc_node_when(node)[0]->cond->spec->type);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/sp:c/e", 0);
+    assert_non_null(lysc_node_musts(node)[0].cond->spec);
+    assert_int_equal(2, lysc_node_musts(node)[0].cond->spec->path_len);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/sp:c/f", 0);
+    assert_non_null(lysc_node_musts(node)[0].cond->spec);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/sp:c/g", 0);
+    assert_null(lysc_node_when(node)[0]->cond->spec);
+
+    /* enumerations */
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\"><mode>auto</mode><a>v</a><b>v</b><g>v</g></c>", LYD_XML, 0,
+            LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\"><mode>manual</mode><a>v</a></c>", LYD_XML, 0,
+            LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("When condition \"../mode = 'auto'\" not satisfied.", "/sp:c/a", 0);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\"><mode>manual</mode><b>v</b></c>", LYD_XML, 0,
+            LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("When condition \"'manual' != ../mode\" not satisfied.", "/sp:c/b", 0);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\"><b>v</b></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("When condition \"'manual' != ../mode\" not satisfied.", "/sp:c/b", 0);
+
+    /* identities */
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\" xmlns:sp=\"urn:tests:sp\"><sub><type>sp:eth</type></sub>"
+            "<e>v</e></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\" xmlns:sp=\"urn:tests:sp\"><sub><type>sp:fast-eth</type></sub>"
+            "<e>v</e><f>v</f></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\" xmlns:sp=\"urn:tests:sp\"><sub><type>sp:eth</type></sub>"
+            "<f>v</f></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Must condition \"derived-from(../sub/type, 'eth')\" not satisfied.", "/sp:c/f", 0);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:sp\" xmlns:sp=\"urn:tests:sp\"><sub><type>sp:other</type></sub>"
+            "<e>v</e></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Must condition \"derived-from-or-self(../sub/type, 'sp:eth')\" not satisfied.", "/sp:c/e", 0);
+}
+
 static void
 test_trim(void **state)
 {
@@ -1277,6 +1471,9 @@ main(void)
         UTEST(test_augment, setup),
         UTEST(test_variables, setup),
         UTEST(test_axes, setup),
+        UTEST(test_sort, setup),
+        UTEST(test_scnode_cache),
+        UTEST(test_specialized),
         UTEST(test_trim, setup),
         UTEST(test_mod, setup),
     };
@@ -25,7 +25,31 @@
 
 #define CHECK_PARSE_LYD_DIFF(INPUT_1, INPUT_2, OPTS, OUT_DIFF) \
         assert_int_equal(LY_SUCCESS, lyd_diff_siblings(INPUT_1, INPUT_2, OPTS, &OUT_DIFF));\
-        assert_non_null(OUT_DIFF)
+        assert_non_null(OUT_DIFF);\
+        check_diff_parallel(INPUT_1, INPUT_2, OPTS, 0, OUT_DIFF)
+
+/**
+ * @brief Check that a parallel diff is the same as the sequential one.
+ */
+static void
+check_diff_parallel(const struct lyd_node *first, const struct lyd_node *second, uint16_t options, ly_bool nosiblings,
+        const struct lyd_node *diff)
+{
+    struct lyd_node *par_diff;
+    char *str, *par_str;
+
+    if (nosiblings) {
+        assert_int_equal(LY_SUCCESS, lyd_diff_tree(first, second, options | LYD_DIFF_PARALLEL, &par_diff));
+    } else {
+        assert_int_equal(LY_SUCCESS, lyd_diff_siblings(first, second, options | LYD_DIFF_PARALLEL, &par_diff));
+    }
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str, diff, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&par_str, par_diff, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+    assert_string_equal(str, par_str);
+    free(str);
+    free(par_str);
+    lyd_free_all(par_diff);
+}
 
 #define TEST_DIFF_3(XML1, XML2, XML3, OPTS, DIFF1, DIFF2, MERGE) \
         { \
@@ -669,6 +693,57 @@ test_userord_llist(void **state)
     TEST_DIFF_3(xml1, xml2, xml3, 0, out_diff_1, out_diff_2, out_merge);
 }
 
+static void
+test_userord_llist_moves(void **state)
+{
+    (void) state;
+    const char *xml1 =
+            "<df xmlns=\"urn:libyang:tests:defaults\">\n"
+            "  <llist>1</llist>\n"
+            "  <llist>2</llist>\n"
+            "  <llist>3</llist>\n"
+            "  <llist>4</llist>\n"
+            "  <llist>5</llist>\n"
+            "</df>\n";
+    const char *xml2 =
+            "<df xmlns=\"urn:libyang:tests:defaults\">\n"
+            "  <llist>1</llist>\n"
+            "  <llist>3</llist>\n"
+            "  <llist>4</llist>\n"
+            "  <llist>5</llist>\n"
+            "  <llist>2</llist>\n"
+            "</df>\n";
+    const char *xml3 =
+            "<df xmlns=\"urn:libyang:tests:defaults\">\n"
+            "  <llist>5</llist>\n"
+            "  <llist>4</llist>\n"
+            "  <llist>3</llist>\n"
+            "  <llist>2</llist>\n"
+            "  <llist>1</llist>\n"
+            "</df>\n";
+
+    /* only the instances not in the longest kept subsequence are moved */
+    const char *out_diff_1 =
+            "<df xmlns=\"urn:libyang:tests:defaults\" xmlns:yang=\"urn:ietf:params:xml:ns:yang:1\" yang:operation=\"none\">\n"
+            "  <llist yang:operation=\"replace\" yang:orig-default=\"false\" yang:orig-value=\"1\" yang:value=\"5\">2</llist>\n"
+            "</df>\n";
+    const char *out_diff_2 =
+            "<df xmlns=\"urn:libyang:tests:defaults\" xmlns:yang=\"urn:ietf:params:xml:ns:yang:1\" yang:operation=\"none\">\n"
+            "  <llist yang:operation=\"replace\" yang:orig-default=\"false\" yang:orig-value=\"4\" yang:value=\"\">5</llist>\n"
+            "  <llist yang:operation=\"replace\" yang:orig-default=\"false\" yang:orig-value=\"3\" yang:value=\"5\">4</llist>\n"
+            "  <llist yang:operation=\"replace\" yang:orig-default=\"false\" yang:orig-value=\"4\" yang:value=\"2\">1</llist>\n"
+            "</df>\n";
+    const char *out_merge =
+            "<df xmlns=\"urn:libyang:tests:defaults\" xmlns:yang=\"urn:ietf:params:xml:ns:yang:1\" yang:operation=\"none\">\n"
+            "  <llist yang:operation=\"replace\" yang:orig-default=\"false\" yang:orig-value=\"1\" yang:value=\"5\">2</llist>\n"
+            "  <llist yang:orig-default=\"false\" yang:orig-value=\"4\" yang:value=\"\" yang:operation=\"replace\">5</llist>\n"
+            "  <llist yang:orig-default=\"false\" yang:orig-value=\"3\" yang:value=\"5\" yang:operation=\"replace\">4</llist>\n"
+            "  <llist yang:orig-default=\"false\" yang:orig-value=\"4\" yang:value=\"2\" yang:operation=\"replace\">1</llist>\n"
+            "</df>\n";
+
+    TEST_DIFF_3(xml1, xml2, xml3, 0, out_diff_1, out_diff_2, out_merge);
+}
+
 static void
 test_userord_llist2(void **state)
 {
@@ -1374,6 +1449,70 @@ test_metadata(void **state)
     TEST_DIFF_3(xml1, xml2, xml3, LYD_DIFF_META, out_diff_1, out_diff_2, out_merge);
 }
 
+static void
+test_parallel(void **state)
+{
+    (void) state;
+    struct lyd_node *data1, *data2, *diff;
+    char *xml1, *xml2;
+    uint32_t i, j;
+    int len1 = 0, len2 = 0;
+
+    xml1 = malloc(65536);
+    xml2 = malloc(65536);
+    assert_non_null(xml1);
+    assert_non_null(xml2);
+
+    /* many list instances with nested lists, some of them changed, and a reordered user-ordered list */
+    len1 += sprintf(xml1 + len1, "<df xmlns=\"urn:libyang:tests:defaults\">");
+    len2 += sprintf(xml2 + len2, "<df xmlns=\"urn:libyang:tests:defaults\">");
+    for (i = 0; i < 60; ++i) {
+        len1 += sprintf(xml1 + len1, "<list><name>n%" PRIu32 "</name><value>%" PRIu32 "</value>", i, i);
+        if (i % 7) {
+            len2 += sprintf(xml2 + len2, "<list><name>n%" PRIu32 "</name><value>%" PRIu32 "</value>", i, i % 3 ? i : i + 100);
+        }
+        for (j = 0; j < 4; ++j) {
+            len1 += sprintf(xml1 + len1, "<list2><name2>m%" PRIu32 "</name2><value2>%" PRIu32 "</value2></list2>", j, j);
+            if ((i % 7) && ((i + j) % 5)) {
+                len2 += sprintf(xml2 + len2, "<list2><name2>m%" PRIu32 "</name2><value2>%" PRIu32 "</value2></list2>",
+                        j, (i + j) % 4 ? j : j + 10);
+            }
+        }
+        len1 += sprintf(xml1 + len1, "</list>");
+        if (i % 7) {
+            len2 += sprintf(xml2 + len2, "<list2><name2>new</name2></list2></list>");
+        }
+    }
+    for (i = 0; i < 20; ++i) {
+        len1 += sprintf(xml1 + len1, "<ul><l1>u%" PRIu32 "</l1><cont><l3>%" PRIu32 "</l3></cont></ul>", i, i);
+        len2 += sprintf(xml2 + len2, "<ul><l1>u%" PRIu32 "</l1><cont><l3>%" PRIu32 "</l3></cont></ul>", 19 - i,
+                i % 4 ? 19 - i : i);
+    }
+    sprintf(xml1 + len1, "</df><hidden xmlns=\"urn:libyang:tests:defaults\"><foo>1</foo></hidden>");
+    sprintf(xml2 + len2, "</df><hidden xmlns=\"urn:libyang:tests:defaults\"><foo>2</foo></hidden>");
+
+    CHECK_PARSE_LYD(xml1, data1);
+    CHECK_PARSE_LYD(xml2, data2);
+    free(xml1);
+    free(xml2);
+
+    /* the same diff as the sequential one, both for all the siblings and a single subtree */
+    CHECK_PARSE_LYD_DIFF(data1, data2, 0, diff);
+    lyd_free_all(diff);
+    assert_int_equal(LY_SUCCESS, lyd_diff_tree(data1, data2, 0, &diff));
+    check_diff_parallel(data1, data2, 0, 1, diff);
+    lyd_free_all(diff);
+
+    /* apply the parallel diff */
+    assert_int_equal(LY_SUCCESS, lyd_diff_siblings(data1, data2, LYD_DIFF_PARALLEL, &diff));
+    assert_int_equal(LY_SUCCESS, lyd_diff_apply_all(&data1, diff));
+    CHECK_LYD(data1, data2);
+
+    lyd_free_all(data1);
+    lyd_free_all(data2);
+    lyd_free_all(diff);
+}
+
 int
 main(void)
 {
@@ -1389,6 +1528,7 @@ main(void)
         UTEST(test_nested_list, setup),
         UTEST(test_userord_llist, setup),
         UTEST(test_userord_llist2, setup),
+        UTEST(test_userord_llist_moves, setup),
         UTEST(test_userord_mix, setup),
         UTEST(test_userord_list, setup),
         UTEST(test_userord_list2, setup),
@@ -1397,6 +1537,7 @@ main(void)
         UTEST(test_state_llist, setup),
         UTEST(test_wd, setup),
         UTEST(test_metadata, setup),
+        UTEST(test_parallel, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
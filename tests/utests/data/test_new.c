@@ -523,6 +523,155 @@ test_path(void **state)
     lyd_free_siblings(root);
 }
 
+static void
+test_path_batch(void **state)
+{
+    LY_ERR ret;
+    struct lyd_node *root, *node;
+    char *str, bufs[20][32];
+    const char *many[20], *many_values[20];
+    uint32_t i;
+    const char *paths[] = {
+        "/a:l1[a='a1'][b='b1']/c",
+        "/a:c/x[.='v1']",
+        "/a:c/x[.='v2']",
+        "/a:c2/l3/x",
+        "/a:c2/l3/x",
+        "/a:c2/l3[2]/y",
+        "/a:l1[a='a1'][b='b2']/c",
+    };
+    const char *values[] = {"c1", NULL, NULL, "x1", "x2", "y2", "c2"};
+
+    UTEST_ADD_MODULE(schema_a, LYS_IN_YANG, NULL, NULL);
+
+    ret = lyd_new_paths(NULL, UTEST_LYCTX, paths, values, 7, 0, &root);
+    assert_int_equal(ret, LY_SUCCESS);
+    assert_non_null(root);
+
+    lyd_print_mem(&str, root, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+    assert_string_equal(str,
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b1</b><c>c1</c></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b2</b><c>c2</c></l1>"
+            "<c xmlns=\"urn:tests:a\"><x>v1</x><x>v2</x></c>"
+            "<c2 xmlns=\"urn:tests:a\"><l3><x>x1</x></l3><l3><x>x2</x><y>y2</y></l3></c2>");
+    free(str);
+
+    /* relative paths into an existing parent */
+    paths[0] = "c";
+    ret = lyd_new_paths(root, NULL, paths, NULL, 1, 0, NULL);
+    assert_int_equal(ret, LY_EEXIST);
+    CHECK_LOG_CTX("Path \"c\" already exists.", "/a:l1[a='a1'][b='b1']/c", 0);
+
+    /* all the paths are compiled before creating any nodes */
+    paths[0] = "/a:c/x[.='v3']";
+    paths[1] = "/a:c/y";
+    ret = lyd_new_paths(root, NULL, paths, NULL, 2, 0, NULL);
+    assert_int_equal(ret, LY_EVALID);
+    CHECK_LOG_CTX("Not found node \"y\" in path.", "/a:l1", 0);
+    assert_null(lyd_child(root->next->next)->next->next);
+
+    /* errors are reported for the whole path */
+    paths[0] = "/a:c/x[.='v3']";
+    paths[1] = "/a:c/x[.='v1']";
+    ret = lyd_new_paths(root, NULL, paths, NULL, 2, 0, NULL);
+    assert_int_equal(ret, LY_EEXIST);
+    CHECK_LOG_CTX("Path \"/a:c/x[.='v1']\" already exists.", "/a:c/x[.='v1']", 0);
+    assert_string_equal(lyd_get_value(lyd_child(root->next->next)->next->next), "v3");
+
+    lyd_free_siblings(root);
+
+    /* unsorted instances are inserted in bulk and sorted once, there are enough of them to be hashed */
+    for (i = 0; i < 20; ++i) {
+        sprintf(bufs[i], (i % 2) ? "/a:c/x[.='v%02" PRIu32 "']" : "/a:l11[a='%" PRIu32 "']/b", 20 - i);
+        many[i] = bufs[i];
+        many_values[i] = "7";
+    }
+    ret = lyd_new_paths(NULL, UTEST_LYCTX, many, many_values, 20, 0, &root);
+    assert_int_equal(ret, LY_SUCCESS);
+    for (i = 0, node = root; i < 10; ++i, node = node->next) {
+        assert_int_equal(((struct lyd_node_term *)lyd_child(node))->value.uint32, 2 * i + 2);
+    }
+    assert_string_equal(node->schema->name, "c");
+    for (i = 0, node = lyd_child(node); i < 10; ++i, node = node->next) {
+        sprintf(bufs[0], "v%02" PRIu32, 2 * i + 1);
+        assert_string_equal(lyd_get_value(node), bufs[0]);
+    }
+    assert_int_equal(lyd_find_path(root->prev, "x[.='v07']", 0, &node), LY_SUCCESS);
+    lyd_free_siblings(root);
+
+    /* invalid arguments */
+    paths[0] = "a:foo";
+    assert_int_equal(lyd_new_paths(NULL, UTEST_LYCTX, paths, NULL, 1, 0, &root), LY_EINVAL);
+    CHECK_LOG_CTX("Invalid argument paths (lyd_new_paths()).", NULL, 0);
+    assert_int_equal(lyd_new_paths(NULL, UTEST_LYCTX, paths, NULL, 1, 0, NULL), LY_EINVAL);
+    CHECK_LOG_CTX("Invalid argument parent || tree (lyd_new_paths()).", NULL, 0);
+}
+
+static void
+test_path_handle(void **state)
+{
+    LY_ERR ret;
+    struct lyd_node *root = NULL, *node, *match;
+    struct lyd_path_handle *handle, *rel_handle;
+    const char *args[2];
+    char *str;
+
+    UTEST_ADD_MODULE(schema_a, LYS_IN_YANG, NULL, NULL);
+
+    assert_int_equal(lyd_path_compile(UTEST_LYCTX, NULL, "/a:l1[a=$a][b=$b]/c", 0, &handle), LY_SUCCESS);
+    assert_int_equal(lyd_path_handle_var_count(handle), 2);
+
+    /* create */
+    args[0] = "a1";
+    args[1] = "b1";
+    ret = lyd_new_path_handle(NULL, handle, args, "c1", 0, &root);
+    assert_int_equal(ret, LY_SUCCESS);
+    args[1] = "b2";
+    ret = lyd_new_path_handle(root, handle, args, "c2", 0, &node);
+    assert_int_equal(ret, LY_SUCCESS);
+    assert_string_equal(node->schema->name, "l1");
+    ret = lyd_new_path_handle(root, handle, args, "c3", 0, NULL);
+    assert_int_equal(ret, LY_EEXIST);
+    CHECK_LOG_CTX("Path \"/a:l1[a=$a][b=$b]/c\" already exists.", "/a:l1[a='a1'][b='b2']/c", 0);
+    ret = lyd_new_path_handle(root, handle, args, "c3", LYD_NEW_PATH_UPDATE, NULL);
+    assert_int_equal(ret, LY_SUCCESS);
+
+    lyd_print_mem(&str, root, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+    assert_string_equal(str,
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b1</b><c>c1</c></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b2</b><c>c3</c></l1>");
+    free(str);
+
+    /* find */
+    args[1] = "b1";
+    assert_int_equal(lyd_find_path_handle(root, handle, args, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(match), "c1");
+    args[1] = "b2";
+    assert_int_equal(lyd_find_path_handle(root, handle, args, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(match), "c3");
+    args[1] = "b3";
+    assert_int_equal(lyd_find_path_handle(root, handle, args, &match), LY_ENOTFOUND);
+
+    /* missing argument */
+    assert_int_equal(lyd_find_path_handle(root, handle, NULL, &match), LY_EINVAL);
+    CHECK_LOG_CTX("Invalid argument args (lyd_path_handle_vars()).", NULL, 0);
+
+    /* relative handle */
+    assert_int_equal(lyd_path_compile(UTEST_LYCTX, root->schema, "c", 0, &rel_handle), LY_SUCCESS);
+    assert_int_equal(lyd_path_handle_var_count(rel_handle), 0);
+    assert_int_equal(lyd_find_path_handle(root, rel_handle, NULL, &match), LY_SUCCESS);
+    assert_string_equal(lyd_get_value(match), "c1");
+    assert_int_equal(lyd_find_path_handle(lyd_child(root), rel_handle, NULL, &match), LY_EINVAL);
+
+    lyd_path_handle_free(rel_handle);
+    lyd_path_handle_free(handle);
+    lyd_free_siblings(root);
+
+    /* invalid path */
+    assert_int_equal(lyd_path_compile(UTEST_LYCTX, NULL, "/a:l1[a=$a]", 0, &handle), LY_EVALID);
+    CHECK_LOG_CTX("Predicate missing for a key of list \"l1\" in path.", "/a:l1", 0);
+}
+
 static void
 test_path_ext(void **state)
 {
@@ -569,6 +718,8 @@ main(void)
         UTEST(test_top_level),
         UTEST(test_opaq),
         UTEST(test_path),
+        UTEST(test_path_batch),
+        UTEST(test_path_handle),
         UTEST(test_path_ext),
     };
 
@@ -1018,6 +1018,162 @@ test_subtree(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_parser_reuse(void **state)
+{
+    const char *data;
+    struct ly_in *in;
+    struct lyd_parser *parser;
+    struct lyd_node *tree, *op;
+    uint32_t i;
+
+    assert_non_null(ly_ctx_load_module(UTEST_LYCTX, "ietf-netconf", "2011-06-01", NULL));
+    assert_int_equal(LY_SUCCESS, lyd_parser_new(UTEST_LYCTX, &parser));
+
+    for (i = 0; i < 3; ++i) {
+        /* XML data */
+        data = "<l1 xmlns=\"urn:tests:a\"><a>val_a</a><b>val_b</b><c>1</c><cont><e>true</e></cont></l1>"
+                "<foo xmlns=\"urn:tests:a\">x</foo>";
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+        assert_int_equal(LY_SUCCESS, lyd_parser_parse_data(parser, NULL, in, LYD_XML, 0, LYD_VALIDATE_PRESENT, &tree));
+        ly_in_free(in, 0);
+        CHECK_LYD_STRING(tree, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK, data);
+        lyd_free_all(tree);
+
+        /* invalid XML data, the line is counted from the start of this input */
+        data = "<foo xmlns=\"urn:tests:a\">x</foo>\n<foo3 xmlns=\"urn:tests:a\">y</foo3>";
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+        assert_int_equal(LY_EVALID, lyd_parser_parse_data(parser, NULL, in, LYD_XML, 0, LYD_VALIDATE_PRESENT, &tree));
+        ly_in_free(in, 0);
+        assert_null(tree);
+        CHECK_LOG_CTX("Invalid type uint32 value \"y\".", "/a:foo3", 2);
+
+        /* JSON data */
+        data = "{\"a:foo\":\"x\",\"a:cp\":{\"z\":5}}";
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+        assert_int_equal(LY_SUCCESS, lyd_parser_parse_data(parser, NULL, in, LYD_JSON, 0, LYD_VALIDATE_PRESENT, &tree));
+        ly_in_free(in, 0);
+        CHECK_LYD_STRING_PARAM(tree, data, LYD_JSON, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_SHRINK);
+        lyd_free_all(tree);
+
+        /* NETCONF RPC */
+        data = "<rpc message-id=\"25\" xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\">"
+                "<get-config><source><running/></source></get-config></rpc>";
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+        assert_int_equal(LY_SUCCESS, lyd_parser_parse_op(parser, NULL, in, LYD_XML, LYD_TYPE_RPC_NETCONF, &tree, &op));
+        ly_in_free(in, 0);
+        assert_string_equal(LYD_NAME(op), "get-config");
+        lyd_free_all(op);
+        lyd_free_all(tree);
+    }
+
+    lyd_parser_free(parser);
+}
+
+struct pipeline_result {
+    uint32_t count;
+    struct ly_in *in[20];
+    LY_ERR rc[20];
+    char *errmsg[20];
+    char *name[20];
+};
+
+static void
+test_pipeline_clb(struct ly_in *in, LY_ERR rc, const struct ly_err_item *err, struct lyd_node *tree,
+        struct lyd_node *op, void *user_data)
+{
+    struct pipeline_result *res = user_data;
+
+    res->in[res->count] = in;
+    res->rc[res->count] = rc;
+    res->errmsg[res->count] = err ? strdup(err->msg) : NULL;
+    res->name[res->count] = tree ? strdup(LYD_NAME(tree)) : NULL;
+    ++res->count;
+
+    if (op) {
+        /* NETCONF operation in a separate tree */
+        lyd_free_all(op);
+    }
+    lyd_free_all(tree);
+}
+
+static void
+test_pipeline(void **state)
+{
+    struct pipeline_result res = {0};
+    struct lyd_pipeline *pipeline;
+    struct ly_in *in[20];
+    uint32_t i;
+
+    assert_int_equal(LY_SUCCESS, lyd_pipeline_new(UTEST_LYCTX, LYD_XML, LYD_TYPE_DATA_YANG, 0, LYD_VALIDATE_PRESENT, 2, 2,
+            4, test_pipeline_clb, &res, &pipeline));
+
+    for (i = 0; i < 20; ++i) {
+        if (i % 7 == 3) {
+            /* parse error */
+            assert_int_equal(LY_SUCCESS, ly_in_new_memory("<foo3 xmlns=\"urn:tests:a\">y</foo3>", &in[i]));
+        } else if (i % 7 == 5) {
+            /* validation error */
+            assert_int_equal(LY_SUCCESS, ly_in_new_memory("<l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b><c>1</c></l1>"
+                    "<l1 xmlns=\"urn:tests:a\"><a>a</a><b>b</b><c>1</c></l1>", &in[i]));
+        } else {
+            assert_int_equal(LY_SUCCESS, ly_in_new_memory("<foo xmlns=\"urn:tests:a\">x</foo>", &in[i]));
+        }
+        assert_int_equal(LY_SUCCESS, lyd_pipeline_push(pipeline, in[i]));
+    }
+    lyd_pipeline_flush(pipeline);
+    lyd_pipeline_free(pipeline);
+
+    /* all the messages delivered in order */
+    assert_int_equal(res.count, 20);
+    for (i = 0; i < 20; ++i) {
+        assert_ptr_equal(res.in[i], in[i]);
+        if (i % 7 == 3) {
+            assert_int_equal(res.rc[i], LY_EVALID);
+            assert_string_equal(res.errmsg[i], "Invalid type uint32 value \"y\".");
+            assert_null(res.name[i]);
+        } else if (i % 7 == 5) {
+            assert_int_equal(res.rc[i], LY_EVALID);
+            assert_string_equal(res.errmsg[i], "Duplicate instance of \"l1\".");
+            assert_null(res.name[i]);
+        } else {
+            assert_int_equal(res.rc[i], LY_SUCCESS);
+            assert_null(res.errmsg[i]);
+            assert_string_equal(res.name[i], "foo");
+        }
+        free(res.errmsg[i]);
+        free(res.name[i]);
+        ly_in_free(in[i], 0);
+    }
+
+    /* nothing logged by the worker threads */
+    CHECK_LOG_CTX(NULL, NULL, 0);
+
+    /* NETCONF RPCs */
+    assert_non_null(ly_ctx_load_module(UTEST_LYCTX, "ietf-netconf", "2011-06-01", NULL));
+    memset(&res, 0, sizeof res);
+    assert_int_equal(LY_SUCCESS, lyd_pipeline_new(UTEST_LYCTX, LYD_XML, LYD_TYPE_RPC_NETCONF, 0, 0, 1, 1, 2,
+            test_pipeline_clb, &res, &pipeline));
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory("<rpc message-id=\"25\" xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\">"
+            "<get-config><source><running/></source></get-config></rpc>", &in[0]));
+    assert_int_equal(LY_SUCCESS, lyd_pipeline_push(pipeline, in[0]));
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory("<rpc message-id=\"26\" xmlns=\"urn:ietf:params:xml:ns:netconf:base:1.0\">"
+            "<get-config/></rpc>", &in[1]));
+    assert_int_equal(LY_SUCCESS, lyd_pipeline_push(pipeline, in[1]));
+    lyd_pipeline_free(pipeline);
+
+    assert_int_equal(res.count, 2);
+    assert_int_equal(res.rc[0], LY_SUCCESS);
+    assert_string_equal(res.name[0], "rpc");
+    assert_int_equal(res.rc[1], LY_EVALID);
+    assert_string_equal(res.errmsg[1], "Mandatory choice \"config-source\" data do not exist.");
+    for (i = 0; i < 2; ++i) {
+        free(res.errmsg[i]);
+        free(res.name[i]);
+        ly_in_free(in[i], 0);
+    }
+}
+
 int
 main(void)
 {
@@ -1041,6 +1197,8 @@ main(void)
         UTEST(test_data_skip, setup),
         UTEST(test_metadata, setup),
         UTEST(test_subtree, setup),
+        UTEST(test_parser_reuse, setup),
+        UTEST(test_pipeline, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -14,6 +14,8 @@
 #define _UTEST_MAIN_
 #include "utests.h"
 
+#include <pthread.h>
+
 #include "libyang.h"
 #include "ly_common.h"
 #include "path.h"
@@ -801,6 +803,197 @@ test_data_leafref_nodes2(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_lazy_canonical(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct lyd_value *val;
+    const char *schema, *data;
+
+    schema =
+            "module test-lazy {"
+            "  yang-version 1.1;"
+            "  namespace \"urn:tests:lazy\";"
+            "  prefix t;"
+            "  import ietf-inet-types {prefix inet;}"
+            "  container c {"
+            "    leaf i8 {type int8 {range \"-10..10\";}}"
+            "    leaf u32 {type uint32;}"
+            "    leaf d64 {type decimal64 {fraction-digits 2; range \"0..100\";}}"
+            "    leaf bin {type binary {length \"1..4\";}}"
+            "    leaf ip {type inet:ipv4-address;}"
+            "  }"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_LAZY_CANONICAL));
+
+    data =
+            "<c xmlns='urn:tests:lazy'>"
+            "  <i8>+05</i8>"
+            "  <u32>016</u32>"
+            "  <d64>1.50</d64>"
+            "  <bin>AQID</bin>"
+            "  <ip>10.0.0.1</ip>"
+            "</c>";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+
+    /* no canonical values generated while storing */
+    LY_LIST_FOR(lyd_child(tree), node) {
+        assert_null(((struct lyd_node_term *)node)->value._canonical);
+    }
+
+    /* generated and cached on first access */
+    node = lyd_child(tree);
+    val = &((struct lyd_node_term *)node)->value;
+    assert_string_equal(lyd_get_value(node), "5");
+    assert_non_null(val->_canonical);
+    assert_ptr_equal(lyd_get_value(node), val->_canonical);
+    node = node->next;
+    assert_string_equal(lyd_get_value(node), "16");
+    node = node->next;
+    assert_string_equal(lyd_get_value(node), "1.5");
+    node = node->next;
+    assert_string_equal(lyd_get_value(node), "AQID");
+    node = node->next;
+    assert_string_equal(lyd_get_value(node), "10.0.0.1");
+
+    CHECK_LYD_STRING_PARAM(tree, "<c xmlns=\"urn:tests:lazy\"><i8>5</i8><u32>16</u32><d64>1.5</d64><bin>AQID</bin>"
+            "<ip>10.0.0.1</ip></c>", LYD_XML, LYD_PRINT_SHRINK);
+    lyd_free_all(tree);
+
+    /* restrictions still report the canonical value */
+    data = "<c xmlns='urn:tests:lazy'><i8>+011</i8></c>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Unsatisfied range - value \"11\" is out of the allowed range.", "/test-lazy:c/i8", 1);
+    data = "<c xmlns='urn:tests:lazy'><d64>100.10</d64></c>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Unsatisfied range - value \"100.1\" is out of the allowed range.", "/test-lazy:c/d64", 1);
+    data = "<c xmlns='urn:tests:lazy'><bin>AQIDBAU=</bin></c>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Unsatisfied length - string \"AQIDBAU=\" length is not allowed.", "/test-lazy:c/bin", 1);
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_LAZY_CANONICAL));
+}
+
+struct frozen_arg {
+    const struct lyd_node *tree;
+    const struct lyd_node *dup;
+    const char *xml;
+    const char *json;
+    int fail;
+};
+
+static void *
+frozen_reader(void *arg)
+{
+    struct frozen_arg *farg = arg;
+    struct ly_set *set;
+    char *str;
+    uint32_t i;
+
+    for (i = 0; i < 20; ++i) {
+        if (lyd_find_xpath(farg->tree, "/t:c/l[u32 > 5]/ip", &set) || (set->count != 4)) {
+            ++farg->fail;
+        }
+        ly_set_free(set, NULL);
+
+        if (lyd_print_mem(&str, farg->tree, LYD_XML, LYD_PRINT_WITHSIBLINGS) || strcmp(str, farg->xml)) {
+            ++farg->fail;
+        }
+        free(str);
+        if (lyd_print_mem(&str, farg->tree, LYD_JSON, LYD_PRINT_WITHSIBLINGS) || strcmp(str, farg->json)) {
+            ++farg->fail;
+        }
+        free(str);
+        if (lyd_print_mem(&str, farg->tree, LYD_LYB, LYD_PRINT_WITHSIBLINGS)) {
+            ++farg->fail;
+        }
+        free(str);
+
+        if (lyd_compare_siblings(farg->tree, farg->dup, LYD_COMPARE_FULL_RECURSION)) {
+            ++farg->fail;
+        }
+    }
+
+    return NULL;
+}
+
+static void
+test_frozen(void **state)
+{
+    struct lyd_node *tree, *dup, *node;
+    struct frozen_arg args[4];
+    pthread_t threads[4];
+    char *xml, *json;
+    const char *schema, *data;
+    uint32_t i;
+
+    schema =
+            "module t {"
+            "  yang-version 1.1;"
+            "  namespace \"urn:tests:t\";"
+            "  prefix t;"
+            "  import ietf-inet-types {prefix inet;}"
+            "  container c {"
+            "    list l {"
+            "      key k;"
+            "      leaf k {type string;}"
+            "      leaf u32 {type uint32;}"
+            "      leaf d64 {type decimal64 {fraction-digits 2;}}"
+            "      leaf ip {type inet:ipv4-address;}"
+            "      leaf un {type union {type uint8; type string;}}"
+            "    }"
+            "  }"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_LAZY_CANONICAL));
+
+    data =
+            "<c xmlns='urn:tests:t'>"
+            "  <l><k>a</k><u32>01</u32><d64>1.50</d64><ip>10.0.0.1</ip><un>07</un></l>"
+            "  <l><k>b</k><u32>06</u32><d64>2.50</d64><ip>10.0.0.2</ip><un>x</un></l>"
+            "  <l><k>c</k><u32>07</u32><d64>3.50</d64><ip>10.0.0.3</ip><un>08</un></l>"
+            "  <l><k>d</k><u32>08</u32><d64>4.50</d64><ip>10.0.0.4</ip><un>y</un></l>"
+            "  <l><k>e</k><u32>09</u32><d64>5.50</d64><ip>10.0.0.5</ip><un>09</un></l>"
+            "</c>";
+    CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
+    assert_int_equal(LY_SUCCESS, lyd_dup_siblings(tree, NULL, LYD_DUP_RECURSIVE, &dup));
+
+    /* all the lazy values generated */
+    assert_int_equal(LY_SUCCESS, lyd_freeze(tree));
+    assert_int_equal(LY_SUCCESS, lyd_freeze(dup));
+    LYD_TREE_DFS_BEGIN(tree, node) {
+        if (node->schema->nodetype & LYD_NODE_TERM) {
+            assert_non_null(((struct lyd_node_term *)node)->value._canonical);
+        }
+        LYD_TREE_DFS_END(tree, node);
+    }
+
+    /* concurrent readers */
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&xml, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&json, tree, LYD_JSON, LYD_PRINT_WITHSIBLINGS));
+    for (i = 0; i < 4; ++i) {
+        args[i].tree = tree;
+        args[i].dup = dup;
+        args[i].xml = xml;
+        args[i].json = json;
+        args[i].fail = 0;
+        assert_int_equal(0, pthread_create(&threads[i], NULL, frozen_reader, &args[i]));
+    }
+    for (i = 0; i < 4; ++i) {
+        assert_int_equal(0, pthread_join(threads[i], NULL));
+        assert_int_equal(0, args[i].fail);
+    }
+
+    free(xml);
+    free(json);
+    lyd_free_all(tree);
+    lyd_free_all(dup);
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_LAZY_CANONICAL));
+}
+
 int
 main(void)
 {
@@ -816,6 +1009,8 @@ main(void)
         UTEST(test_lyxp_vars),
         UTEST(test_data_leafref_nodes),
         UTEST(test_data_leafref_nodes2),
+        UTEST(test_lazy_canonical),
+        UTEST(test_frozen),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
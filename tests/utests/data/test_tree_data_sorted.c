@@ -1593,6 +1593,86 @@ test_unlink_siblings(void **state)
     lyd_free_all(cont);
 }
 
+/**
+ * @brief Check that the leaf-list instances are sorted and count them.
+ */
+static uint32_t
+check_sorted_uint(const struct lyd_node *first)
+{
+    const struct lyd_node *iter;
+    uint32_t count = 0;
+
+    assert_true(first->meta && get_rbt(first->meta));
+    LY_LIST_FOR(first, iter) {
+        if (iter != first) {
+            assert_null(iter->meta);
+            assert_true(strtoul(lyd_get_value(iter->prev), NULL, 10) <= strtoul(lyd_get_value(iter), NULL, 10));
+        }
+        ++count;
+    }
+    return count;
+}
+
+static void
+test_many_instances(void **state)
+{
+    const char *schema;
+    struct lys_module *mod;
+    struct lyd_node *cont, *cont2, *node, *next, *second;
+    uint32_t i, count;
+    char val[16];
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container cn {leaf-list ll {type uint32;}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    /* many instances in random order, some of them equal */
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont), LY_SUCCESS);
+    for (i = 0; i < 8000; ++i) {
+        sprintf(val, "%" PRIu32, (i * 7919) % 6000);
+        assert_int_equal(lyd_new_term(cont, mod, "ll", val, 0, NULL), LY_SUCCESS);
+    }
+    assert_int_equal(check_sorted_uint(lyd_child(cont)), 8000);
+
+    /* remove most of them, the tree is rebalanced */
+    LY_LIST_FOR_SAFE(lyd_child(cont), next, node) {
+        if (strtoul(lyd_get_value(node), NULL, 10) % 8) {
+            lyd_free_tree(node);
+        }
+    }
+    count = check_sorted_uint(lyd_child(cont));
+    assert_int_equal(count, 1000);
+    for (i = 0; i < 6000; i += 3) {
+        sprintf(val, "%" PRIu32, i);
+        assert_int_equal(lyd_new_term(cont, mod, "ll", val, 0, NULL), LY_SUCCESS);
+    }
+    count = check_sorted_uint(lyd_child(cont));
+    assert_int_equal(count, 3000);
+    assert_int_equal(lyd_find_sibling_val(lyd_child(cont), lyd_child(cont)->schema, "5997", 4, &node), LY_SUCCESS);
+
+    /* unlink the second half and insert it back */
+    for (i = 0, second = lyd_child(cont); i < count / 2; ++i) {
+        second = second->next;
+    }
+    assert_int_equal(lyd_unlink_siblings(second), LY_SUCCESS);
+    assert_int_equal(check_sorted_uint(lyd_child(cont)), count / 2);
+    assert_int_equal(lyd_new_term(cont, mod, "ll", "5999", 0, NULL), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(cont, mod, "ll", "0", 0, NULL), LY_SUCCESS);
+    assert_int_equal(lyd_insert_child(cont, second), LY_SUCCESS);
+    assert_int_equal(check_sorted_uint(lyd_child(cont)), count + 2);
+
+    /* destructive merge reusing the tree nodes of the source */
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont2), LY_SUCCESS);
+    for (i = 1; i < 12000; i += 2) {
+        sprintf(val, "%" PRIu32, i);
+        assert_int_equal(lyd_new_term(cont2, mod, "ll", val, 0, NULL), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_merge_tree(&cont2, cont, LYD_MERGE_DESTRUCT), LY_SUCCESS);
+    count = check_sorted_uint(lyd_child(cont2));
+    assert_int_equal(lyd_find_sibling_val(lyd_child(cont2), lyd_child(cont2)->schema, "5952", 4, &node), LY_SUCCESS);
+    lyd_free_all(cont2);
+}
+
 static void
 test_order_violation(void **state)
 {
@@ -1643,6 +1723,150 @@ test_order_violation(void **state)
     lyd_free_all(first);
 }
 
+static void
+test_insert_bulk(void **state)
+{
+    const char *schema;
+    struct lys_module *mod;
+    struct lyd_node *cont, *src, *nodes[6], *node, *first;
+    uint32_t i;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container cn {leaf-list ll {type uint32;} list lst {key \"k\"; leaf k {type uint32;}}}"
+            "leaf-list tl {type uint32;}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    /* unsorted instances of a list and a leaf-list, interleaved */
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &src), LY_SUCCESS);
+    assert_int_equal(lyd_new_list(src, mod, "lst", 0, &nodes[0], "3"), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "20", 0, &nodes[1]), LY_SUCCESS);
+    assert_int_equal(lyd_new_list(src, mod, "lst", 0, &nodes[2], "1"), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "10", 0, &nodes[3]), LY_SUCCESS);
+    assert_int_equal(lyd_new_list(src, mod, "lst", 0, &nodes[4], "2"), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "10", 0, &nodes[5]), LY_SUCCESS);
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont), LY_SUCCESS);
+    assert_int_equal(lyd_insert_child_bulk(cont, nodes, 6), LY_SUCCESS);
+    assert_null(lyd_child(src));
+    lyd_free_tree(src);
+
+    /* sorted, equal values keep their order */
+    node = lyd_child(cont);
+    assert_ptr_equal(node, nodes[3]);
+    assert_true(node->meta && get_rbt(node->meta));
+    assert_ptr_equal(node->next, nodes[5]);
+    assert_null(node->next->meta);
+    assert_string_equal(lyd_get_value(node->next->next), "20");
+    node = node->next->next->next;
+    assert_true(node->meta && get_rbt(node->meta));
+    assert_string_equal(lyd_get_value(lyd_child(node)), "1");
+    assert_string_equal(lyd_get_value(lyd_child(node->next)), "2");
+    assert_string_equal(lyd_get_value(lyd_child(node->next->next)), "3");
+    assert_null(node->next->next->next);
+
+    /* hash lookup */
+    assert_int_equal(lyd_find_sibling_val(lyd_child(cont), nodes[0]->schema, "[k='3']", 0, &node), LY_SUCCESS);
+    assert_ptr_equal(node, nodes[0]);
+
+    /* the tree is usable for further inserts */
+    assert_int_equal(lyd_new_list(cont, mod, "lst", 0, &node, "0"), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(cont, mod, "ll", "15", 0, NULL), LY_SUCCESS);
+    node = lyd_child(cont);
+    assert_string_equal(lyd_get_value(node->next->next), "15");
+    node = node->next->next->next->next;
+    assert_true(node->meta && get_rbt(node->meta));
+    assert_string_equal(lyd_get_value(lyd_child(node)), "0");
+    assert_string_equal(lyd_get_value(lyd_child(node->next)), "1");
+    lyd_free_all(cont);
+
+    /* into a parent with a hash table, only the appended instances are inserted into the existing tree */
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont), LY_SUCCESS);
+    for (i = 0; i < 30; ++i) {
+        char val[4];
+
+        sprintf(val, "%" PRIu32, 2 * i + 2);
+        assert_int_equal(lyd_new_term(cont, mod, "ll", val, 0, NULL), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_new_list(cont, mod, "lst", 0, &first, "1"), LY_SUCCESS);
+    assert_non_null(((struct lyd_node_inner *)cont)->children_ht);
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &src), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "61", 0, &nodes[0]), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "7", 0, &nodes[1]), LY_SUCCESS);
+    assert_int_equal(lyd_new_term(src, mod, "ll", "1", 0, &nodes[2]), LY_SUCCESS);
+    assert_int_equal(lyd_insert_child_bulk(cont, nodes, 3), LY_SUCCESS);
+    lyd_free_tree(src);
+    node = lyd_child(cont);
+    assert_ptr_equal(node, nodes[2]);
+    assert_true(node->meta && get_rbt(node->meta));
+    for (i = 0; node->next->schema == node->schema; node = node->next, ++i) {
+        assert_null(node->next->meta);
+        assert_true(((struct lyd_node_term *)node)->value.uint32 < ((struct lyd_node_term *)node->next)->value.uint32);
+    }
+    assert_int_equal(i, 32);
+    assert_ptr_equal(node, nodes[0]);
+    assert_ptr_equal(node->next, first);
+    assert_int_equal(lyd_find_sibling_val(lyd_child(cont), nodes[0]->schema, NULL, 0, &node), LY_SUCCESS);
+    assert_ptr_equal(node, nodes[2]);
+    assert_int_equal(lyd_find_sibling_val(lyd_child(cont), nodes[0]->schema, "7", 0, &node), LY_SUCCESS);
+    assert_ptr_equal(node, nodes[1]);
+    lyd_free_all(cont);
+
+    /* top-level */
+    for (i = 0; i < 6; ++i) {
+        char val[4];
+
+        sprintf(val, "%" PRIu32, (i * 5) % 6);
+        assert_int_equal(lyd_new_term(NULL, mod, "tl", val, 0, &nodes[i]), LY_SUCCESS);
+    }
+    assert_int_equal(lyd_new_inner(NULL, mod, "cn", 0, &cont), LY_SUCCESS);
+    assert_int_equal(lyd_insert_sibling_bulk(cont, nodes, 6, &first), LY_SUCCESS);
+    assert_ptr_equal(first, cont);
+    node = cont->next;
+    assert_true(node->meta && get_rbt(node->meta));
+    for (i = 0; i < 6; ++i) {
+        assert_int_equal(((struct lyd_node_term *)node)->value.uint32, i);
+        node = node->next;
+    }
+    assert_null(node);
+    lyd_free_all(first);
+}
+
+static void
+test_parse_bulk(void **state)
+{
+    const char *schema, *data;
+    struct lys_module *mod;
+    struct lyd_node *tree, *tree2, *node;
+
+    schema = "module a {namespace urn:tests:a;prefix a;yang-version 1.1;revision 2014-05-08;"
+            "container cn {leaf-list ll {type uint32;} list lst {key \"k\"; leaf k {type uint32;}"
+            "leaf-list ll {type string;}}} leaf-list tl {type uint32;}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    data = "{\"a:tl\":[3,1,2],\"a:cn\":{\"lst\":[{\"k\":5,\"ll\":[\"b\",\"a\"]},{\"k\":4},{\"k\":6}],"
+            "\"ll\":[9,7,8]}}";
+    CHECK_PARSE_LYD_PARAM(data, LYD_JSON, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    CHECK_PARSE_LYD_PARAM(data, LYD_JSON, LYD_PARSE_BULK, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree2);
+    assert_int_equal(lyd_compare_siblings(tree, tree2, LYD_COMPARE_FULL_RECURSION), LY_SUCCESS);
+    CHECK_LYD(tree, tree2);
+    lyd_free_all(tree);
+
+    /* the trees and hash tables are usable */
+    assert_int_equal(lyd_find_path(tree2, "/a:cn/lst[k='5']/ll[.='a']", 0, &node), LY_SUCCESS);
+    assert_true(node->meta && get_rbt(node->meta));
+    assert_int_equal(lyd_new_path(tree2, NULL, "/a:cn/ll", "1", 0, &node), LY_SUCCESS);
+    assert_true(node->meta && get_rbt(node->meta));
+    assert_ptr_equal(lyd_child(lyd_parent(node)), node);
+    lyd_free_all(tree2);
+
+    data = "<cn xmlns=\"urn:tests:a\"><ll>9</ll><lst><k>5</k><ll>b</ll><ll>a</ll></lst><ll>7</ll><lst><k>4</k></lst>"
+            "<ll>8</ll></cn><tl xmlns=\"urn:tests:a\">2</tl><tl xmlns=\"urn:tests:a\">1</tl>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, LYD_PARSE_BULK, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree2);
+    CHECK_LYD(tree, tree2);
+    lyd_free_all(tree);
+    lyd_free_all(tree2);
+}
+
 int
 main(void)
 {
@@ -1684,7 +1908,10 @@ main(void)
         UTEST(test_move_part_list),
         UTEST(test_merge_whole_list),
         UTEST(test_unlink_siblings),
+        UTEST(test_many_instances),
         UTEST(test_order_violation),
+        UTEST(test_insert_bulk),
+        UTEST(test_parse_bulk),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -163,6 +163,64 @@ test_type_incomplete_when(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_when_shared(void **state)
+{
+    struct lys_module *mod;
+    struct lyd_node *tree, *node;
+    const char *schema =
+            "module a {\n"
+            "    namespace urn:tests:a;\n"
+            "    prefix a;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    leaf sw {\n"
+            "        type string;\n"
+            "    }\n"
+            "    container cont {\n"
+            "        leaf x {\n"
+            "            when \"../../sw = 'on'\";\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "    augment /cont {\n"
+            "        when \"../sw = 'on'\";\n"
+            "        list l {\n"
+            "            key k;\n"
+            "            leaf k {\n"
+            "                type string;\n"
+            "            }\n"
+            "        }\n"
+            "        leaf-list item {\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, &mod);
+
+    /* one condition shared by all the augment instances */
+    LYD_TREE_CREATE("<sw xmlns=\"urn:tests:a\">on</sw><cont xmlns=\"urn:tests:a\"><x>v</x>"
+            "<l><k>a</k></l><l><k>b</k></l><l><k>c</k></l><item>1</item><item>2</item></cont>", tree);
+    LY_LIST_FOR(lyd_child(tree->next), node) {
+        assert_int_equal(LYD_WHEN_TRUE, node->flags & LYD_WHEN_TRUE);
+    }
+    lyd_free_all(tree);
+
+    CHECK_PARSE_LYD_PARAM("<sw xmlns=\"urn:tests:a\">off</sw><cont xmlns=\"urn:tests:a\">"
+            "<l><k>a</k></l><l><k>b</k></l><item>1</item></cont>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("When condition \"../sw = 'on'\" not satisfied.", "/a:cont/item[.='1']", 0);
+
+    /* all the instances autodeleted */
+    LYD_TREE_CREATE("<sw xmlns=\"urn:tests:a\">on</sw><cont xmlns=\"urn:tests:a\"><x>v</x>"
+            "<l><k>a</k></l><l><k>b</k></l><item>1</item><item>2</item></cont>", tree);
+    assert_int_equal(LY_SUCCESS, lyd_change_term(tree, "off"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_module(&tree, mod, 0, NULL));
+    assert_string_equal(LYD_NAME(tree->next), "cont");
+    assert_null(lyd_child(tree->next));
+    lyd_free_all(tree);
+}
+
 static void
 test_unprefixed_ident(void **state)
 {
@@ -696,6 +754,99 @@ test_unique_nested(void **state)
             "/d:lt2[k='val3']", 0, "data-not-unique");
 }
 
+static void
+test_unique_index(void **state)
+{
+    struct lyd_node *tree, *node;
+
+    UTEST_ADD_MODULE(schema_d, LYS_IN_YANG, NULL, NULL);
+
+    /* the first validation creates the unique index */
+    LYD_TREE_CREATE("<lt2 xmlns=\"urn:tests:d\">\n"
+            "    <k>val1</k>\n"
+            "    <lt3>\n"
+            "        <kk>a</kk>\n"
+            "        <l3>1</l3>\n"
+            "    </lt3>\n"
+            "    <lt3>\n"
+            "        <kk>b</kk>\n"
+            "        <l3>2</l3>\n"
+            "    </lt3>\n"
+            "    <lt3>\n"
+            "        <kk>c</kk>\n"
+            "        <l3>3</l3>\n"
+            "    </lt3>\n"
+            "</lt2>", tree);
+
+    /* value change */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "lt3[kk='c']/l3", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "1"));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l3\" not satisfied in \"/d:lt2[k='val1']/lt3[kk='c']\" and "
+            "\"/d:lt2[k='val1']/lt3[kk='a']\".", "/d:lt2[k='val1']/lt3[kk='a']", 0, "data-not-unique");
+
+    /* the invalid instance is checked again */
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l3\" not satisfied in \"/d:lt2[k='val1']/lt3[kk='c']\" and "
+            "\"/d:lt2[k='val1']/lt3[kk='a']\".", "/d:lt2[k='val1']/lt3[kk='a']", 0, "data-not-unique");
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "3"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+
+    /* new instance */
+    assert_int_equal(LY_SUCCESS, lyd_new_path(tree, NULL, "lt3[kk='d']/l3", "2", 0, &node));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l3\" not satisfied in \"/d:lt2[k='val1']/lt3[kk='d']\" and "
+            "\"/d:lt2[k='val1']/lt3[kk='b']\".", "/d:lt2[k='val1']/lt3[kk='b']", 0, "data-not-unique");
+
+    /* unlinked instance */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "lt3[kk='b']", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+
+    /* removed unique leaf */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "lt3[kk='a']/l3", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "lt3[kk='c']/l3", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "1"));
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(tree, NULL, "lt3[kk='a']/l3", "1", 0, NULL));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l3\" not satisfied in \"/d:lt2[k='val1']/lt3[kk='a']\" and "
+            "\"/d:lt2[k='val1']/lt3[kk='c']\".", "/d:lt2[k='val1']/lt3[kk='c']", 0, "data-not-unique");
+
+    /* duplicated tree has its own index */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "lt3[kk='a']/l3", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_dup_single(tree, NULL, LYD_DUP_RECURSIVE, &node));
+    lyd_free_all(tree);
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&node, NULL, LYD_VALIDATE_PRESENT, NULL));
+    lyd_free_all(node);
+
+    /* top-level instances are indexed as well */
+    LYD_TREE_CREATE("<lt xmlns=\"urn:tests:d\"><k>val1</k><l1>1</l1></lt>\n"
+            "<lt xmlns=\"urn:tests:d\"><k>val2</k><l1>2</l1></lt>\n"
+            "<lt xmlns=\"urn:tests:d\"><k>val3</k><l1>3</l1></lt>", tree);
+    assert_int_equal(LY_SUCCESS, lyd_new_path(tree, NULL, "/d:lt[k='val4']/l1", "2", 0, NULL));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l1\" not satisfied in \"/d:lt[k='val4']\" and "
+            "\"/d:lt[k='val2']\".", "/d:lt[k='val2']", 0, "data-not-unique");
+
+    /* the first instance the index is found by is unlinked */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "/d:lt[k='val4']/l1", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "1"));
+    node = tree;
+    assert_string_equal("val1", lyd_get_value(lyd_child(node)));
+    tree = tree->next;
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_new_path(tree, NULL, "/d:lt[k='val0']/l1", "3", 0, NULL));
+    tree = lyd_first_sibling(tree);
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"l1\" not satisfied in \"/d:lt[k='val0']\" and "
+            "\"/d:lt[k='val3']\".", "/d:lt[k='val3']", 0, "data-not-unique");
+    lyd_free_all(tree);
+}
+
 static void
 test_dup(void **state)
 {
@@ -1546,6 +1697,419 @@ test_case(void **state)
     CHECK_LOG_CTX("Data for both cases \"v0\" and \"v2\" exist.", "/k:ch", 6);
 }
 
+static void
+test_profile(void **state)
+{
+    struct lyd_node *tree;
+    struct ly_out *out;
+    char *str;
+    const char *schema =
+            "module a {\n"
+            "    namespace urn:tests:a;\n"
+            "    prefix a;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    list l {\n"
+            "        key k;\n"
+            "        unique v;\n"
+            "        leaf k {\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf v {\n"
+            "            must \". > 0\";\n"
+            "            type int32;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_VAL_PROFILE));
+
+    LYD_TREE_CREATE("<l xmlns=\"urn:tests:a\"><k>a</k><v>1</v></l><l xmlns=\"urn:tests:a\"><k>b</k><v>2</v></l>", tree);
+    lyd_free_all(tree);
+
+    assert_int_equal(LY_SUCCESS, ly_out_new_memory(&str, 0, &out));
+    assert_int_equal(LY_SUCCESS, lyd_validate_profile_print(out, UTEST_LYCTX));
+    assert_non_null(strstr(str,
+            "      \"module\": \"a\",\n"
+            "      \"path\": \"/a:l/v\",\n"
+            "      \"kind\": \"must\",\n"
+            "      \"expression\": \". > 0\",\n"
+            "      \"count\": 2,\n"));
+    assert_non_null(strstr(str,
+            "      \"path\": \"/a:l\",\n"
+            "      \"kind\": \"unique\",\n"
+            "      \"unique\": [\"v\"],\n"
+            "      \"count\": 1,\n"));
+    assert_non_null(strstr(str, "\"kind\": \"type-store\""));
+
+    /* cleared statistics */
+    lyd_validate_profile_clear(UTEST_LYCTX);
+    ly_out_reset(out);
+    assert_int_equal(LY_SUCCESS, lyd_validate_profile_print(out, UTEST_LYCTX));
+    assert_string_equal(str, "{\n  \"records\": []\n}\n");
+
+    /* statistics discarded on recompilation */
+    LYD_TREE_CREATE("<l xmlns=\"urn:tests:a\"><k>a</k><v>1</v></l>", tree);
+    lyd_free_all(tree);
+    UTEST_ADD_MODULE("module b {namespace urn:tests:b; prefix b; import a {prefix a;}"
+            "augment /a:l {leaf c {type string;}}}", LYS_IN_YANG, NULL, NULL);
+    ly_out_reset(out);
+    assert_int_equal(LY_SUCCESS, lyd_validate_profile_print(out, UTEST_LYCTX));
+    assert_string_equal(str, "{\n  \"records\": []\n}\n");
+    ly_out_free(out, NULL, 1);
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_VAL_PROFILE));
+}
+
+static void
+test_virtual_defaults(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    char *str, *str2;
+    long double num;
+    ly_bool bln;
+    const char *schema =
+            "module v {\n"
+            "    namespace urn:tests:v;\n"
+            "    prefix v;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    list l {\n"
+            "        key k;\n"
+            "        unique u;\n"
+            "        leaf k {\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf u {\n"
+            "            type uint32;\n"
+            "            default 1;\n"
+            "        }\n"
+            "        leaf d {\n"
+            "            type string;\n"
+            "            default \"x\";\n"
+            "        }\n"
+            "        leaf dd {\n"
+            "            type uint32;\n"
+            "            when \"../d = 'y'\";\n"
+            "            default 5;\n"
+            "        }\n"
+            "        leaf-list ll {\n"
+            "            type string;\n"
+            "            default \"a\";\n"
+            "            default \"b\";\n"
+            "        }\n"
+            "        container c {\n"
+            "            leaf e {\n"
+            "                type string;\n"
+            "                default \"e\";\n"
+            "            }\n"
+            "        }\n"
+            "        choice ch {\n"
+            "            default c1;\n"
+            "            case c1 {\n"
+            "                leaf f {\n"
+            "                    type string;\n"
+            "                    default \"f\";\n"
+            "                }\n"
+            "            }\n"
+            "            case c2 {\n"
+            "                leaf g {\n"
+            "                    type string;\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "        leaf m {\n"
+            "            type string;\n"
+            "            must \"../d = 'x'\";\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_searchdir(UTEST_LYCTX, TESTS_DIR_MODULES_YANG));
+    assert_non_null(ly_ctx_load_module(UTEST_LYCTX, "ietf-netconf-with-defaults", "2011-06-01", NULL));
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+
+    /* must referencing a default */
+    LYD_TREE_CREATE("<l xmlns=\"urn:tests:v\"><k>a</k><m>z</m></l>"
+            "<l xmlns=\"urn:tests:v\"><k>b</k><u>2</u><d>y</d><g>g</g></l>", tree);
+
+    /* the when and must constraints did not create the defaults they use, unique uses the default value */
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "d", 0, &node));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "u", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "c", 0, &node));
+    assert_null(lyd_child(node));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "ll[.='a']", 0, &node));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "f", 0, &node));
+
+    /* XPath resolves virtual defaults on all the axes without creating them */
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(/v:l/v:d)", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, NULL, &num, NULL));
+    assert_int_equal(2, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(//v:d)", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, NULL, &num, NULL));
+    assert_int_equal(2, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(/descendant::v:e)", LY_VALUE_JSON, NULL, NULL,
+            NULL, NULL, NULL, &num, NULL));
+    assert_int_equal(2, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(//v:ll)", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, NULL, &num, NULL));
+    assert_int_equal(4, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(//v:dd)", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, NULL, &num, NULL));
+    assert_int_equal(1, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "count(/v:l[v:k='a']/* | /v:l[v:k='a']/v:ll)",
+            LY_VALUE_JSON, NULL, NULL, NULL, NULL, NULL, &num, NULL));
+    assert_int_equal(8, num);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "/v:l[v:k='a']/v:ll[.='b'] = 'b'", LY_VALUE_JSON,
+            NULL, NULL, NULL, NULL, NULL, NULL, &bln));
+    assert_true(bln);
+    assert_int_equal(LY_SUCCESS, lyd_eval_xpath4(tree, tree, NULL, "/v:l[v:k='a']/v:f", LY_VALUE_JSON, NULL, NULL, NULL,
+            NULL, &str, NULL, NULL));
+    assert_string_equal(str, "f");
+    free(str);
+
+    /* virtual defaults are not returned as nodes */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//v:d", &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal(lyd_get_value(set->dnodes[0]), "y");
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "d", 0, &node));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "ll[.='b']", 0, &node));
+
+    /* explicit lookup */
+    assert_int_equal(LY_SUCCESS, lyd_find_child_dflt(tree, lys_find_path(UTEST_LYCTX, NULL, "/v:l/f", 0), &node));
+    assert_string_equal(node->schema->name, "f");
+    assert_string_equal(lyd_get_value(node), "f");
+    assert_int_equal(LY_ENOTFOUND, lyd_find_child_dflt(tree->next, node->schema, &node));
+    assert_null(node);
+
+    /* printed the same as materialized defaults */
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_WD_IMPL_TAG));
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "ll[.='a']", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_new_implicit_tree(tree, 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "ll[.='a']", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_WD_IMPL_TAG));
+    assert_string_equal(str, str2);
+    free(str);
+    free(str2);
+    lyd_free_all(tree);
+
+    LYD_TREE_CREATE("<l xmlns=\"urn:tests:v\"><k>a</k><c/></l>", tree);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str, tree, LYD_JSON, LYD_PRINT_WD_ALL));
+    lyd_new_implicit_tree(tree, 0, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, LYD_JSON, LYD_PRINT_WD_ALL));
+    assert_string_equal(str, str2);
+    free(str);
+    free(str2);
+    lyd_free_all(tree);
+
+    /* unique with default values */
+    CHECK_PARSE_LYD_PARAM("<l xmlns=\"urn:tests:v\"><k>a</k></l><l xmlns=\"urn:tests:v\"><k>b</k></l>", LYD_XML, 0,
+            LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX_APPTAG("Unique data leaf(s) \"u\" not satisfied in \"/v:l[k='a']\" and \"/v:l[k='b']\".",
+            "/v:l[k='b']", 0, "data-not-unique");
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+}
+
+static void
+test_virtual_defaults_leafref(void **state)
+{
+    struct lyd_node *tree, *node;
+    const char *schema =
+            "module vr {\n"
+            "    namespace urn:tests:vr;\n"
+            "    prefix vr;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    container top {\n"
+            "        leaf tgt {\n"
+            "            type string;\n"
+            "        }\n"
+            "        leaf ref {\n"
+            "            type leafref {\n"
+            "                path \"../tgt\";\n"
+            "            }\n"
+            "            default \"t\";\n"
+            "        }\n"
+            "        leaf plain {\n"
+            "            type string;\n"
+            "            default \"p\";\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+
+    /* leafref default is created to be validated, the plain one stays virtual */
+    LYD_TREE_CREATE("<top xmlns=\"urn:tests:vr\"><tgt>t</tgt></top>", tree);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "ref", 0, &node));
+    assert_true(node->flags & LYD_DEFAULT);
+    assert_int_equal(LY_ENOTFOUND, lyd_find_path(tree, "plain", 0, &node));
+    lyd_free_all(tree);
+
+    /* dangling leafref default */
+    CHECK_PARSE_LYD_PARAM("<top xmlns=\"urn:tests:vr\"><tgt>x</tgt></top>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID,
+            tree);
+    CHECK_LOG_CTX_APPTAG("Invalid leafref value \"t\" - no target instance \"../tgt\" with the same value.",
+            "/vr:top/ref", 0, "instance-required");
+
+    /* the created default is validated with the tree */
+    LYD_TREE_CREATE("<top xmlns=\"urn:tests:vr\"><tgt>t</tgt></top>", tree);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "tgt", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "x"));
+    assert_int_equal(LY_EVALID, lyd_validate_all(&tree, NULL, LYD_VALIDATE_PRESENT, NULL));
+    CHECK_LOG_CTX_APPTAG("Invalid leafref value \"t\" - no target instance \"../tgt\" with the same value.",
+            "/vr:top/ref", 0, "instance-required");
+    lyd_free_all(tree);
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+}
+
+static void
+test_virtual_defaults_print(void **state)
+{
+    struct lyd_node *tree, *node;
+    char *str, *str2;
+    uint32_t i, j;
+    const LYD_FORMAT formats[] = {LYD_XML, LYD_JSON};
+    const uint32_t wd_modes[] = {LYD_PRINT_WD_EXPLICIT, LYD_PRINT_WD_TRIM, LYD_PRINT_WD_ALL, LYD_PRINT_WD_ALL_TAG,
+        LYD_PRINT_WD_IMPL_TAG};
+    const char *data = "<top xmlns=\"urn:tests:vp\"><l><k>a</k></l><l><k>b</k><cb>x</cb></l></top>";
+    const char *schema =
+            "module vp {\n"
+            "    namespace urn:tests:vp;\n"
+            "    prefix vp;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    container top {\n"
+            "        leaf cfg {\n"
+            "            type string;\n"
+            "            default \"c\";\n"
+            "        }\n"
+            "        leaf st {\n"
+            "            config false;\n"
+            "            type string;\n"
+            "            default \"st\";\n"
+            "        }\n"
+            "        container state {\n"
+            "            config false;\n"
+            "            leaf s {\n"
+            "                type string;\n"
+            "                default \"s\";\n"
+            "            }\n"
+            "            leaf-list sl {\n"
+            "                type uint8;\n"
+            "                default 1;\n"
+            "                default 2;\n"
+            "            }\n"
+            "        }\n"
+            "        container np {\n"
+            "            leaf w {\n"
+            "                when \"../../cfg = 'c'\";\n"
+            "                type string;\n"
+            "                default \"w\";\n"
+            "            }\n"
+            "            leaf nw {\n"
+            "                when \"../../cfg = 'x'\";\n"
+            "                type string;\n"
+            "                default \"nw\";\n"
+            "            }\n"
+            "            leaf ro {\n"
+            "                when \"../../cfg = 'c'\";\n"
+            "                config false;\n"
+            "                type int8;\n"
+            "                default 3;\n"
+            "            }\n"
+            "        }\n"
+            "        container cfg-only {\n"
+            "            leaf e {\n"
+            "                type string;\n"
+            "                default \"e\";\n"
+            "            }\n"
+            "        }\n"
+            "        list l {\n"
+            "            key k;\n"
+            "            leaf k {\n"
+            "                type string;\n"
+            "            }\n"
+            "            leaf ld {\n"
+            "                type string;\n"
+            "                default \"ld\";\n"
+            "            }\n"
+            "            leaf lr {\n"
+            "                config false;\n"
+            "                type string;\n"
+            "                default \"lr\";\n"
+            "            }\n"
+            "            choice ch {\n"
+            "                default a;\n"
+            "                case a {\n"
+            "                    leaf ca {\n"
+            "                        type string;\n"
+            "                        default \"ca\";\n"
+            "                    }\n"
+            "                }\n"
+            "                case b {\n"
+            "                    leaf cb {\n"
+            "                        type string;\n"
+            "                    }\n"
+            "                    leaf cbd {\n"
+            "                        config false;\n"
+            "                        type string;\n"
+            "                        default \"cbd\";\n"
+            "                    }\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "    }\n"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_searchdir(UTEST_LYCTX, TESTS_DIR_MODULES_YANG));
+    assert_non_null(ly_ctx_load_module(UTEST_LYCTX, "ietf-netconf-with-defaults", "2011-06-01", NULL));
+
+    /* virtual defaults printed the same as created ones in all the with-defaults modes */
+    for (i = 0; i < sizeof formats / sizeof *formats; ++i) {
+        for (j = 0; j < sizeof wd_modes / sizeof *wd_modes; ++j) {
+            CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+            assert_int_equal(LY_SUCCESS, lyd_print_mem(&str, tree, formats[i], LYD_PRINT_WITHSIBLINGS | wd_modes[j]));
+            lyd_free_all(tree);
+
+            assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+            CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+            assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, formats[i], LYD_PRINT_WITHSIBLINGS | wd_modes[j]));
+            lyd_free_all(tree);
+            assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+
+            assert_string_equal(str, str2);
+            free(str);
+            free(str2);
+        }
+    }
+
+    /* neither printing (evaluating when conditions) nor freezing creates any defaults */
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_WD_ALL));
+    assert_int_equal(LY_SUCCESS, lyd_freeze(tree));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "np", 0, &node));
+    assert_null(lyd_child(node));
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "l[k='a']", 0, &node));
+    assert_string_equal(lyd_child(node)->schema->name, "k");
+    assert_null(lyd_child(node)->next);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS | LYD_PRINT_WD_ALL));
+    assert_string_equal(str, str2);
+    free(str);
+    free(str2);
+    lyd_free_all(tree);
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_VIRTUAL_DEFAULTS));
+}
+
 static void
 test_pattern(void **UNUSED(state))
 {
@@ -1568,10 +2132,12 @@ main(void)
         UTEST(test_mandatory),
         UTEST(test_mandatory_when),
         UTEST(test_type_incomplete_when),
+        UTEST(test_when_shared),
         UTEST(test_unprefixed_ident),
         UTEST(test_minmax),
         UTEST(test_unique),
         UTEST(test_unique_nested),
+        UTEST(test_unique_index),
         UTEST(test_dup),
         UTEST(test_defaults),
         UTEST(test_state),
@@ -1581,6 +2147,10 @@ main(void)
         UTEST(test_rpc),
         UTEST(test_reply),
         UTEST(test_case),
+        UTEST(test_profile),
+        UTEST(test_virtual_defaults),
+        UTEST(test_virtual_defaults_leafref),
+        UTEST(test_virtual_defaults_print),
         UTEST(test_pattern),
     };
 
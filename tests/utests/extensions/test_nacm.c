@@ -15,6 +15,7 @@
 #include "utests.h"
 
 #include "libyang.h"
+#include "nacm.h"
 
 static int
 setup(void **state)
@@ -112,12 +113,150 @@ test_deny_write(void **state)
             "/aa:l/{extension='nacm:default-deny-write'}", 0);
 }
 
+static void
+test_rules(void **state)
+{
+    struct lys_module *mod;
+    struct lyd_node *nacm_data, *tree, *tree2, *diff, *rpc;
+    const struct lyd_node *denied;
+    struct lyd_nacm *nacm;
+    struct ly_ctx *ctx2;
+    const char *groups[] = {"ext", NULL};
+
+    const char *schema = "module t {yang-version 1.1; namespace urn:tests:extensions:nacm:t; prefix t;"
+            "import ietf-netconf-acm {revision-date 2018-02-14; prefix nacm;}"
+            "container c {list l {key name; leaf name {type string;} leaf secret {type string;} leaf val {type string;}}"
+            "leaf pub {type string;} leaf hidden {type string; nacm:default-deny-all;}}"
+            "rpc r;}";
+    const char *rules = "<nacm xmlns=\"urn:ietf:params:xml:ns:yang:ietf-netconf-acm\">"
+            "<write-default>permit</write-default>"
+            "<groups><group><name>ops</name><user-name>alice</user-name></group></groups>"
+            "<rule-list><name>rl</name><group>ops</group><group>ext</group>"
+            "<rule><name>r1</name><module-name>t</module-name>"
+            "<path xmlns:t=\"urn:tests:extensions:nacm:t\">/t:c/t:l[t:name='b']</path>"
+            "<access-operations>read</access-operations><action>deny</action></rule>"
+            "<rule><name>r2</name><module-name>t</module-name>"
+            "<path xmlns:t=\"urn:tests:extensions:nacm:t\">/t:c/t:l/t:secret</path><action>deny</action></rule>"
+            "<rule><name>r3</name><module-name>t</module-name><rpc-name>r</rpc-name>"
+            "<access-operations>exec</access-operations><action>deny</action></rule>"
+            "</rule-list></nacm>";
+    const char *data = "<c xmlns=\"urn:tests:extensions:nacm:t\">"
+            "<l><name>a</name><secret>s</secret><val>1</val></l>"
+            "<l><name>b</name><val>2</val></l>"
+            "<pub>p</pub><hidden>h</hidden></c>";
+
+    assert_int_equal(LY_SUCCESS, lys_parse_mem(UTEST_LYCTX, schema, LYS_IN_YANG, &mod));
+    CHECK_PARSE_LYD_PARAM(rules, LYD_XML, 0, LYD_VALIDATE_PRESENT | LYD_VALIDATE_NO_STATE, LY_SUCCESS, nacm_data);
+
+    /* user in a group */
+    assert_int_equal(LY_SUCCESS, lyd_nacm_compile(UTEST_LYCTX, nacm_data, "alice", NULL, &nacm));
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, lyd_child(tree), LYD_NACM_READ));
+    assert_int_equal(LY_ENOT, lyd_nacm_check(nacm, lyd_child(tree)->next, LYD_NACM_READ));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, lyd_child(tree)->next, LYD_NACM_UPDATE));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_filter(nacm, &tree));
+    CHECK_LYD_STRING_PARAM(tree, "<c xmlns=\"urn:tests:extensions:nacm:t\">\n"
+            "  <l>\n"
+            "    <name>a</name>\n"
+            "    <val>1</val>\n"
+            "  </l>\n"
+            "  <pub>p</pub>\n"
+            "</c>\n", LYD_XML, LYD_PRINT_WITHSIBLINGS);
+
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "r", 0, &rpc));
+    assert_int_equal(LY_ENOT, lyd_nacm_check(nacm, rpc, LYD_NACM_EXEC));
+
+    /* edit checks */
+    lyd_free_siblings(tree);
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree2);
+    assert_int_equal(LY_SUCCESS, lyd_change_term(lyd_child(tree2)->next->next, "q"));
+    assert_int_equal(LY_SUCCESS, lyd_diff_siblings(tree, tree2, 0, &diff));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check_diff(nacm, diff, &denied));
+    assert_null(denied);
+    lyd_free_siblings(diff);
+    lyd_free_siblings(tree);
+
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_tree(lyd_child(lyd_child(tree2))->next);
+    assert_int_equal(LY_SUCCESS, lyd_diff_siblings(tree, tree2, 0, &diff));
+    assert_int_equal(LY_ENOT, lyd_nacm_check_diff(nacm, diff, &denied));
+    assert_string_equal("secret", denied->schema->name);
+    lyd_free_siblings(diff);
+    lyd_nacm_free(nacm);
+
+    /* user without a group, only the extension applies */
+    assert_int_equal(LY_SUCCESS, lyd_nacm_compile(UTEST_LYCTX, nacm_data, "bob", NULL, &nacm));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, rpc, LYD_NACM_EXEC));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_filter(nacm, &tree2));
+    CHECK_LYD_STRING_PARAM(tree2, "<c xmlns=\"urn:tests:extensions:nacm:t\">\n"
+            "  <l>\n"
+            "    <name>a</name>\n"
+            "    <val>1</val>\n"
+            "  </l>\n"
+            "  <l>\n"
+            "    <name>b</name>\n"
+            "    <val>2</val>\n"
+            "  </l>\n"
+            "  <pub>q</pub>\n"
+            "</c>\n", LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    lyd_nacm_free(nacm);
+
+    /* external group */
+    assert_int_equal(LY_SUCCESS, lyd_nacm_compile(UTEST_LYCTX, nacm_data, "bob", groups, &nacm));
+    assert_int_equal(LY_ENOT, lyd_nacm_check(nacm, rpc, LYD_NACM_EXEC));
+    lyd_nacm_free(nacm);
+
+    /* rules with a path not matching any schema node, created in a context with another module */
+    lyd_free_siblings(nacm_data);
+    assert_int_equal(LY_SUCCESS, ly_ctx_new(TESTS_DIR_MODULES_YANG, 0, &ctx2));
+    assert_non_null(ly_ctx_load_module(ctx2, "ietf-netconf-acm", "2018-02-14", NULL));
+    assert_int_equal(LY_SUCCESS, lys_parse_mem(ctx2, "module x {namespace urn:tests:extensions:nacm:x; prefix x;"
+            "leaf missing {type string;}}", LYS_IN_YANG, NULL));
+    assert_int_equal(LY_SUCCESS, lys_parse_mem(ctx2, schema, LYS_IN_YANG, NULL));
+    rules = "<nacm xmlns=\"urn:ietf:params:xml:ns:yang:ietf-netconf-acm\">"
+            "<rule-list><name>rl</name><group>*</group>"
+            "<rule><name>deny-missing</name><path xmlns:x=\"urn:tests:extensions:nacm:x\">/x:missing</path>"
+            "<action>deny</action></rule>"
+            "<rule><name>permit-missing</name><path xmlns:x=\"urn:tests:extensions:nacm:x\">/x:missing</path>"
+            "<action>permit</action></rule>"
+            "<rule><name>deny-pub</name><path xmlns:t=\"urn:tests:extensions:nacm:t\">/t:c/t:pub</path>"
+            "<access-operations>read</access-operations><action>deny</action></rule>"
+            "</rule-list></nacm>";
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(ctx2, rules, LYD_XML, 0, LYD_VALIDATE_PRESENT | LYD_VALIDATE_NO_STATE,
+            &nacm_data));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_compile(UTEST_LYCTX, nacm_data, "alice", NULL, &nacm));
+    CHECK_LOG_CTX("NACM rule \"permit-missing\" path \"/x:missing\" does not match any schema node, "
+            "the rule matches no data.", NULL, 0);
+    CHECK_LOG_CTX("NACM rule \"deny-missing\" path \"/x:missing\" does not match any schema node, "
+            "the rule matches no data.", NULL, 0);
+    assert_string_equal("deny-missing", lyd_nacm_unresolved_rule(nacm, 0));
+    assert_null(lyd_nacm_unresolved_rule(nacm, 1));
+    assert_int_equal(LY_ENOT, lyd_nacm_check(nacm, lyd_child(tree)->next->next, LYD_NACM_READ));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, lyd_child(tree), LYD_NACM_READ));
+    lyd_nacm_free(nacm);
+
+    /* no NACM data, write denied by default */
+    assert_int_equal(LY_SUCCESS, lyd_nacm_compile(UTEST_LYCTX, NULL, "alice", NULL, &nacm));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, lyd_child(tree), LYD_NACM_READ));
+    assert_int_equal(LY_ENOT, lyd_nacm_check(nacm, lyd_child(tree), LYD_NACM_CREATE));
+    assert_int_equal(LY_SUCCESS, lyd_nacm_check(nacm, rpc, LYD_NACM_EXEC));
+    lyd_nacm_free(nacm);
+
+    lyd_free_tree(rpc);
+    lyd_free_siblings(tree);
+    lyd_free_siblings(tree2);
+    lyd_free_siblings(nacm_data);
+    ly_ctx_destroy(ctx2);
+}
+
 int
 main(void)
 {
     const struct CMUnitTest tests[] = {
         UTEST(test_deny_all, setup),
         UTEST(test_deny_write, setup),
+        UTEST(test_rules, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -668,6 +668,106 @@ test_parse_inline(void **state)
     lyd_free_siblings(data);
 }
 
+static void
+test_parse_inline_cache(void **state)
+{
+    const char *xml;
+    struct lyd_node *data, *node;
+    const struct ly_ctx *ext_ctx;
+    const struct lys_module *mod;
+
+    /* modules in a different order than in test_parse_inline() */
+    ly_ctx_set_ext_data_clb(UTEST_LYCTX, test_ext_data_clb,
+            "<yang-library xmlns=\"urn:ietf:params:xml:ns:yang:ietf-yang-library\" "
+            "    xmlns:ds=\"urn:ietf:params:xml:ns:yang:ietf-datastores\">"
+            "  <module-set>"
+            "    <name>test-set</name>"
+            "    <import-only-module>"
+            "      <name>ietf-yang-types</name>"
+            "      <revision>2013-07-15</revision>"
+            "      <namespace>urn:ietf:params:xml:ns:yang:ietf-yang-types</namespace>"
+            "    </import-only-module>"
+            "    <module>"
+            "      <name>iana-if-type</name>"
+            "      <revision>2014-05-08</revision>"
+            "      <namespace>urn:ietf:params:xml:ns:yang:iana-if-type</namespace>"
+            "    </module>"
+            "    <module>"
+            "      <name>ietf-interfaces</name>"
+            "      <revision>2014-05-08</revision>"
+            "      <namespace>urn:ietf:params:xml:ns:yang:ietf-interfaces</namespace>"
+            "    </module>"
+            "    <module>"
+            "      <name>ietf-datastores</name>"
+            "      <revision>2018-02-14</revision>"
+            "      <namespace>urn:ietf:params:xml:ns:yang:ietf-datastores</namespace>"
+            "    </module>"
+            "    <module>"
+            "      <name>ietf-yang-library</name>"
+            "      <revision>2019-01-04</revision>"
+            "      <namespace>urn:ietf:params:xml:ns:yang:ietf-yang-library</namespace>"
+            "    </module>"
+            "  </module-set>"
+            "  <content-id>1</content-id>"
+            "</yang-library>"
+            "<modules-state xmlns=\"urn:ietf:params:xml:ns:yang:ietf-yang-library\">"
+            "  <module-set-id>1</module-set-id>"
+            "</modules-state>"
+            "<schema-mounts xmlns=\"urn:ietf:params:xml:ns:yang:ietf-yang-schema-mount\">"
+            "  <mount-point>"
+            "    <module>sm</module>"
+            "    <label>mnt-root</label>"
+            "    <inline/>"
+            "  </mount-point>"
+            "</schema-mounts>");
+    xml =
+            "<root3 xmlns=\"urn:sm\">\n"
+            "  <ls>\n"
+            "    <name>lne1</name>\n"
+            "    <interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "      <interface>\n"
+            "        <name>bu</name>\n"
+            "        <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "      </interface>\n"
+            "    </interfaces>\n"
+            "  </ls>\n"
+            "  <ls>\n"
+            "    <name>lne2</name>\n"
+            "    <interfaces xmlns=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">\n"
+            "      <interface>\n"
+            "        <name>bu</name>\n"
+            "        <type xmlns:ianaift=\"urn:ietf:params:xml:ns:yang:iana-if-type\">ianaift:ethernetCsmacd</type>\n"
+            "      </interface>\n"
+            "    </interfaces>\n"
+            "  </ls>\n"
+            "</root3>\n";
+    CHECK_PARSE_LYD_PARAM(xml, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, LY_SUCCESS, data);
+    CHECK_LYD_STRING_PARAM(data, xml, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+
+    /* both mount points use the same cached context */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data, "/sm:root3/ls[name='lne1']", 0, &node));
+    node = lyd_child(node)->next;
+    ext_ctx = LYD_CTX(node);
+    assert_ptr_not_equal(ext_ctx, UTEST_LYCTX);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data, "/sm:root3/ls[name='lne2']", 0, &node));
+    node = lyd_child(node)->next;
+    assert_ptr_equal(ext_ctx, LYD_CTX(node));
+
+    /* modules parsed in the parent context were not read again */
+    mod = ly_ctx_get_module(ext_ctx, "ietf-interfaces", "2014-05-08");
+    assert_non_null(mod);
+    assert_true(mod->implemented);
+    assert_null(mod->filepath);
+    lyd_free_siblings(data);
+
+    /* the same context is found again */
+    CHECK_PARSE_LYD_PARAM(xml, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, LY_SUCCESS, data);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(data, "/sm:root3/ls[name='lne1']", 0, &node));
+    node = lyd_child(node)->next;
+    assert_ptr_equal(ext_ctx, LYD_CTX(node));
+    lyd_free_siblings(data);
+}
+
 static void
 test_parse_shared(void **state)
 {
@@ -1893,6 +1993,7 @@ main(void)
         UTEST(test_schema),
         UTEST(test_parse_invalid, setup),
         UTEST(test_parse_inline, setup),
+        UTEST(test_parse_inline_cache, setup),
         UTEST(test_parse_shared, setup),
         UTEST(test_parse_shared_parent_ref, setup),
         UTEST(test_dup_shared, setup),
@@ -211,6 +211,14 @@ test_validation(void **state)
             "    type leafref {path /int8; require-instance true;}\n"
             "    type string;\n"
             "  }\n"
+            "}\n"
+            "typedef str-type {type string;}\n"
+            "leaf str {type str-type;}\n"
+            "leaf l3 {\n"
+            "  type union {\n"
+            "    type leafref {path /str; require-instance true;}\n"
+            "    type str-type;\n"
+            "  }\n"
             "}\n");
     UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
 
@@ -232,6 +240,17 @@ test_validation(void **state)
     free(out);
     lyd_free_all(tree);
 
+    /* LYB keeps the member type the value was stored as, even if the types share the realtype */
+    data = "<str xmlns=\"urn:tests:val\">a</str><l3 xmlns=\"urn:tests:val\">b</l3>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    assert_int_equal(1, ((struct lyd_node_term *)tree->next)->value.subvalue->type_idx);
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&out, tree, LYD_LYB, LYD_PRINT_SHRINK | LYD_PRINT_WITHSIBLINGS));
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM(out, LYD_LYB, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    free(out);
+    assert_int_equal(1, ((struct lyd_node_term *)tree->next)->value.subvalue->type_idx);
+    lyd_free_all(tree);
+
     schema = MODULE_CREATE_YANG("lref",
             "container test {\n"
             "    list a {\n"
@@ -217,6 +217,11 @@ help(int shortout)
     printf("  -J, --json-null\n"
             "                Allow usage of JSON empty values ('null') within input data\n\n");
 
+    printf("  -T FILE, --profile=FILE\n"
+            "                Measure the evaluation of every when, must, and unique constraint\n"
+            "                and type plugin callback while processing data and write the\n"
+            "                statistics in JSON to FILE, the most expensive first.\n\n");
+
     printf("  -k, --ext-inst\n"
             "                Name of extension instance in format: <module-name>:<extension-name>:<argument>.\n"
             "                Need to be used with -t ext parameter.\n\n");
@@ -501,6 +506,7 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
         {"extended-leafref",  no_argument,       NULL, 'X'},
         {"json-null",         no_argument,       NULL, 'J'},
         {"debug",             required_argument, NULL, 'G'},
+        {"profile",           required_argument, NULL, 'T'},
         {NULL,                0,                 NULL, 0}
     };
     uint8_t data_type_set = 0;
@@ -511,7 +517,7 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
     yo->line_length = 0;
 
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hvVQf:I:p:DF:iP:qs:neE:t:d:lL:o:O:R:myY:XJx:G:k:", options, &opt_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hvVQf:I:p:DF:iP:qs:neE:t:d:lL:o:O:R:myY:XJx:G:k:T:", options, &opt_index)) != -1) {
         switch (opt) {
         case 'h': /* --help */
             help(0);
@@ -695,6 +701,11 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
             yo->data_parse_options |= LYD_PARSE_JSON_NULL;
             break;
 
+        case 'T': /* --profile */
+            yo->ctx_options |= LY_CTX_VAL_PROFILE;
+            yo->profile_file = optarg;
+            break;
+
         case 'G':   /* --debug */
             if (set_debug_groups(optarg, yo)) {
                 return -1;
@@ -758,6 +769,28 @@ process_args(int argc, char *argv[], struct yl_opt *yo, struct ly_ctx **ctx)
     return 0;
 }
 
+/**
+ * @brief Write the validation profile collected in a context.
+ *
+ * @param[in] ctx Context with the profile.
+ * @param[in] path File to write into.
+ * @return 0 on success.
+ */
+static int
+print_profile(const struct ly_ctx *ctx, const char *path)
+{
+    struct ly_out *out;
+
+    if (ly_out_new_filepath(path, &out)) {
+        YLMSG_E("Unable to open profile file \"%s\" (%s).", path, strerror(errno));
+        return 1;
+    }
+    lyd_validate_profile_print(out, ctx);
+    ly_out_free(out, NULL, 0);
+
+    return 0;
+}
+
 int
 main_ni(int argc, char *argv[])
 {
@@ -808,12 +841,13 @@ main_ni(int argc, char *argv[])
 
     /* do the data validation despite the schema was printed */
     if (yo.data_inputs.size) {
-        if ((ret = cmd_data_process(ctx, &yo))) {
-            goto cleanup;
-        }
+        ret = cmd_data_process(ctx, &yo);
     }
 
 cleanup:
+    if (ctx && yo.profile_file && print_profile(ctx, yo.profile_file)) {
+        ret = EXIT_FAILURE;
+    }
     yl_opt_erase(&yo);
     ly_ctx_destroy(ctx);
     return ret;
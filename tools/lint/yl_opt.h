@@ -144,6 +144,9 @@ struct yl_opt {
     /* storage for --data-xpath */
     struct ly_set data_xpath;
 
+    /* file for the validation profile, option --profile */
+    char *profile_file;
+
     char **argv;
 };
 